@@ -301,6 +301,18 @@ public:
   virtual bool checkGroups();
 
   virtual bool processGroups();
+  /// Whether the base processGroups() may execute the members of the input
+  /// groups concurrently. Algorithms returning true must not depend on state
+  /// shared between executions, and each member's outputs must be written
+  /// only by that member.
+  virtual bool canProcessGroupsInParallel() const { return false; }
+
+  /// Whether the outputs of an execution may be reused by a later execution
+  /// with the same inputs, see AlgorithmResultCache. Algorithms returning true
+  /// must calculate their outputs from their properties and input workspaces
+  /// only, and must not modify their inputs. Executions that declare
+  /// properties in exec() are not cached.
+  virtual bool isCacheable() const { return false; }
 
   void copyNonWorkspaceProperties(IAlgorithm *alg, int periodNum);
 
@@ -315,6 +327,7 @@ protected:
   virtual const std::string workspaceMethodOnTypes() const { return ""; }
 
   void cacheWorkspaceProperties();
+  void settleOutputModificationStamps();
 
   friend class AlgorithmProxy;
   void initializeFromProxy(const AlgorithmProxy &);
@@ -399,6 +412,17 @@ private:
   bool executeAsyncImpl(const Poco::Void &i);
 
   bool doCallProcessGroups(Mantid::Kernel::DateAndTime &start_time);
+  bool processGroupsInParallel(
+      const std::vector<boost::shared_ptr<WorkspaceGroup>> &outGroups,
+      size_t nThreads, std::vector<boost::shared_ptr<Algorithm>> &algs,
+      std::vector<std::vector<std::string>> &outputWSNames);
+  boost::shared_ptr<Algorithm>
+  createGroupMemberAlgorithm(size_t entry,
+                             std::vector<std::string> &outputWSNames);
+  std::string groupMemberFailure(size_t entry, const std::exception &e) const;
+  size_t groupProcessingThreads() const;
+
+  std::string resultCacheKey() const;
 
   // Report that the algorithm has completed.
   void reportCompleted(const double &duration,
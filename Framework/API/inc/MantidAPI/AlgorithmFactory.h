@@ -9,6 +9,7 @@
 #include <sstream>
 #include "MantidAPI/DllConfig.h"
 #include "MantidKernel/DynamicFactory.h"
+#include "MantidKernel/LibraryManager.h"
 #include "MantidKernel/SingletonHolder.h"
 
 namespace Mantid {
@@ -89,23 +90,31 @@ public:
     boost::shared_ptr<IAlgorithm> tempAlg = instantiator->createInstance();
     const int version = extractAlgVersion(tempAlg);
     const std::string className = extractAlgName(tempAlg);
-    typename VersionMap::const_iterator it = m_vmap.find(className);
+    Kernel::LibraryManager::Instance().RegisterProvided("algorithm",
+                                                        className);
     if (!className.empty()) {
       const std::string key = createName(className, version);
-      if (it == m_vmap.end()) {
-        m_vmap[className] = version;
-      } else {
-        if (version == it->second && replaceExisting == ErrorIfExists) {
-          std::ostringstream os;
-          os << "Cannot register algorithm " << className
-             << " twice with the same version\n";
-          delete instantiator;
-          throw std::runtime_error(os.str());
-        }
-        if (version > it->second) {
+      bool registered = false;
+      {
+        Poco::ScopedWriteRWLock lock(m_mapLock);
+        auto it = m_vmap.find(className);
+        if (it == m_vmap.end()) {
           m_vmap[className] = version;
+        } else {
+          registered =
+              version == it->second && replaceExisting == ErrorIfExists;
+          if (version > it->second) {
+            it->second = version;
+          }
         }
       }
+      if (registered) {
+        std::ostringstream os;
+        os << "Cannot register algorithm " << className
+           << " twice with the same version\n";
+        delete instantiator;
+        throw std::runtime_error(os.str());
+      }
       Kernel::DynamicFactory<Algorithm>::subscribe(key, instantiator,
                                                    replaceExisting);
     } else {
@@ -149,6 +158,11 @@ private:
   /// Extract the version of an algorithm
   int extractAlgVersion(const boost::shared_ptr<IAlgorithm> alg) const;
 
+  /// Open the plugin library providing an algorithm that isn't registered
+  void openPluginIfUnknown(const std::string &name) const;
+  /// Look up the highest registered version of an algorithm
+  bool lookUpVersion(const std::string &name, int &version) const;
+
   /// Create an algorithm object with the specified name
   boost::shared_ptr<Algorithm> createAlgorithm(const std::string &name,
                                                const int version) const;
@@ -164,7 +178,8 @@ private:
 
   /// A typedef for the map of algorithm versions
   typedef std::map<std::string, int> VersionMap;
-  /// The map holding the registered class names and their highest versions
+  /// The map holding the registered class names and their highest versions,
+  /// guarded by m_mapLock
   VersionMap m_vmap;
 };
 
@@ -0,0 +1,112 @@
+#ifndef MANTID_API_ALGORITHMGRAPH_H_
+#define MANTID_API_ALGORITHMGRAPH_H_
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidAPI/IAlgorithm_fwd.h"
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/** AlgorithmGraph runs a set of algorithms whose workspace outputs are the
+  inputs of others. Each node of the graph is an algorithm whose properties
+  have been set, except the inputs that are connected to the outputs of other
+  nodes. execute() runs the nodes on a Kernel::ThreadPool: a node starts as
+  soon as the nodes it depends on have finished, so independent branches run
+  concurrently.
+
+  A connected output is an intermediate result. Once the last node that uses
+  it has finished, the graph clears the output property of its producer and
+  the input properties of its consumers, so the workspace is deleted as soon
+  as it is no longer needed unless it is kept with keepOutput(). Outputs that
+  are not connected are kept in their properties and can be fetched from the
+  algorithms after execute().
+
+  The nodes must be able to run at the same time as each other: they should
+  be child algorithms and no node may modify a workspace that another node
+  reads. The time and thread of every node are recorded for profiling, see
+  statistics() and toDot().
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_API_DLL AlgorithmGraph {
+public:
+  /// What happened to a node during the last execution
+  struct NodeStatistics {
+    /// true if the node ran to completion
+    bool executed = false;
+    /// The index of the thread that ran the node
+    size_t thread = 0;
+    /// When the node started, in seconds since the start of execute()
+    double start = 0.0;
+    /// When the node finished, in seconds since the start of execute()
+    double end = 0.0;
+  };
+
+  size_t addAlgorithm(IAlgorithm_sptr algorithm,
+                      const std::string &label = "");
+  void connect(size_t producer, const std::string &outputProperty,
+               size_t consumer, const std::string &inputProperty);
+  void keepOutput(size_t node, const std::string &outputProperty);
+
+  void execute(size_t nThreads = 0);
+
+  /// The number of nodes
+  size_t size() const { return m_nodes.size(); }
+  IAlgorithm_sptr algorithm(size_t node) const;
+  const std::string &label(size_t node) const;
+  std::vector<size_t> dependencies(size_t node) const;
+  const NodeStatistics &statistics(size_t node) const;
+  size_t maxConcurrency() const;
+  std::string toDot() const;
+
+private:
+  /// A workspace output of one node used as the input of another
+  struct Edge {
+    size_t producer;
+    std::string output;
+    size_t consumer;
+    std::string input;
+  };
+  /// An algorithm in the graph
+  struct Node {
+    IAlgorithm_sptr algorithm;
+    std::string label;
+    /// Output properties that are not cleared after their last use
+    std::vector<std::string> keptOutputs;
+    NodeStatistics statistics;
+  };
+  class Execution;
+
+  void checkNode(size_t node) const;
+  std::vector<size_t> sortedNodes() const;
+
+  std::vector<Node> m_nodes;
+  std::vector<Edge> m_edges;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_ALGORITHMGRAPH_H_ */
@@ -0,0 +1,135 @@
+#ifndef MANTID_API_ALGORITHMRESULTCACHE_H_
+#define MANTID_API_ALGORITHMRESULTCACHE_H_
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidAPI/Workspace_fwd.h"
+#include "MantidKernel/SingletonHolder.h"
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class Algorithm;
+class Workspace;
+
+/** AlgorithmResultCache keeps the outputs of algorithms that declare
+  themselves cacheable, so that executing one again with the same inputs
+  reuses its previous outputs instead of running it.
+
+  Results are keyed on the name and version of the algorithm, the values of
+  its input properties and the content hashes of its input workspaces. Only
+  MatrixWorkspaces have a content hash; an execution with any other input
+  workspace is not cached. Algorithms with workspace properties that are both
+  input and output are never cached.
+
+  The cache holds copies of the output workspaces made before their history
+  is filled in, and every hit returns a new copy. The histograms of copies
+  share their data until one of them is modified, so a hit doesn't copy the
+  data. The total memory size of the cached workspaces is limited by the
+  algorithms.cache.memory property, in MB. The least recently used results
+  are removed first. The cache is disabled if the limit is 0.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_API_DLL AlgorithmResultCacheImpl {
+public:
+  /// The outputs of an execution of an algorithm
+  struct Result {
+    /// Output workspaces by property name
+    std::vector<std::pair<std::string, Workspace_sptr>> workspaces;
+    /// Values of the other output properties by property name
+    std::vector<std::pair<std::string, std::string>> values;
+  };
+
+  AlgorithmResultCacheImpl(const AlgorithmResultCacheImpl &) = delete;
+  AlgorithmResultCacheImpl &
+  operator=(const AlgorithmResultCacheImpl &) = delete;
+
+  /// True if results are cached
+  bool isEnabled() const;
+  /// Set the maximum memory size of the cached workspaces in bytes
+  void setMemoryLimit(size_t bytes);
+  /// The maximum memory size of the cached workspaces in bytes
+  size_t memoryLimit() const;
+  /// The memory size of the cached workspaces in bytes
+  size_t memorySize() const;
+  /// The number of cached results
+  size_t size() const;
+  /// Remove all the results
+  void clear();
+
+  /// Create the key of the current inputs of an algorithm
+  std::string createKey(const Algorithm &alg) const;
+  /// Record the current outputs of an algorithm
+  void insert(const std::string &key, const Algorithm &alg);
+  /// Set the outputs recorded for a key to an algorithm
+  bool restore(const std::string &key, Algorithm &alg);
+
+private:
+  friend struct Mantid::Kernel::CreateUsingNew<AlgorithmResultCacheImpl>;
+
+  AlgorithmResultCacheImpl();
+  ~AlgorithmResultCacheImpl() = default;
+
+  /// A cached result
+  struct Entry {
+    std::string key;
+    Result result;
+    size_t memorySize;
+  };
+  typedef std::list<Entry> EntryList;
+
+  /// Remove least recently used results until the memory size is below a
+  /// limit. Must be called with the mutex locked.
+  void evict(size_t limit);
+
+  /// The results, most recently used first
+  EntryList m_entries;
+  /// The results by key
+  std::unordered_map<std::string, EntryList::iterator> m_index;
+  /// The memory size of the cached workspaces
+  size_t m_memorySize;
+  /// The maximum memory size of the cached workspaces
+  size_t m_memoryLimit;
+  /// Guards the results
+  mutable std::mutex m_mutex;
+};
+
+typedef Mantid::Kernel::SingletonHolder<AlgorithmResultCacheImpl>
+    AlgorithmResultCache;
+
+} // namespace API
+} // namespace Mantid
+
+namespace Mantid {
+namespace Kernel {
+EXTERN_MANTID_API template class MANTID_API_DLL
+    Mantid::Kernel::SingletonHolder<Mantid::API::AlgorithmResultCacheImpl>;
+}
+}
+
+#endif /* MANTID_API_ALGORITHMRESULTCACHE_H_ */
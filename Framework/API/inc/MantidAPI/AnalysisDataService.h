@@ -11,6 +11,9 @@
 
 #include <Poco/AutoPtr.h>
 
+#include <set>
+#include <unordered_set>
+
 namespace Mantid {
 
 namespace API {
@@ -124,6 +127,12 @@ public:
   virtual void rename(const std::string &oldName, const std::string &newName);
   /// Overridden remove member to delete its name held by the workspace itself
   virtual void remove(const std::string &name);
+  /// Overridden addObjects member to attach the names to the workspaces
+  void addObjects(const std::vector<std::pair<std::string, Workspace_sptr>> &
+                      workspaces) override;
+  /// Overridden removeObjects member to delete the names held by the
+  /// workspaces
+  void removeObjects(const std::vector<std::string> &names) override;
 
   /** Retrieve a workspace and cast it to the given WSTYPE
    *
@@ -163,6 +172,23 @@ public:
 private:
   /// Checks the name is valid, throwing if not
   void verifyName(const std::string &name);
+  /// Adds the members of a group that are not in the service yet
+  void addGroupMembers(const std::string &name, WorkspaceGroup &group);
+  /// The names of the workspaces listed for adding
+  typedef std::set<std::string, Kernel::CaseInsensitiveCmp> ListedNames;
+  /// The workspaces listed for adding
+  typedef std::unordered_set<const Workspace *> ListedWorkspaces;
+  /// Lists the members of a group and its subgroups that need adding
+  void listGroupMembers(
+      const std::string &name, WorkspaceGroup &group,
+      std::vector<std::pair<std::string, Workspace_sptr>> &objects,
+      ListedNames &listedNames, ListedWorkspaces &listedWorkspaces) const;
+  /// Adds a list of workspaces at once, attaching their names
+  void addListed(
+      const std::vector<std::pair<std::string, Workspace_sptr>> &objects);
+  /// Lists the names of the members of a group and its subgroups
+  static void collectGroupNames(WorkspaceGroup &group,
+                                std::vector<std::string> &names);
 
   friend struct Mantid::Kernel::CreateUsingNew<AnalysisDataServiceImpl>;
   /// Constructor
@@ -0,0 +1,87 @@
+#ifndef MANTID_API_COMPILEDEXPRESSION_H_
+#define MANTID_API_COMPILEDEXPRESSION_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidAPI/DllConfig.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class Expression;
+
+/** A mathematical formula of one array variable and a set of scalar
+    parameters, compiled into a tree that is evaluated for a whole array of
+    variable values at a time. Parts of the formula that do not depend on
+    the variable are calculated once per call. The derivatives with respect
+    to the parameters are derived symbolically when the formula is compiled.
+
+    The supported syntax is a subset of muParser's: numbers, the constants
+    _pi and _e, the operators + - * / ^, and the functions sin, cos, tan,
+    asin, acos, atan, sinh, cosh, tanh, exp, ln, log, log10, sqrt, abs,
+    sign, erf and erfc. Anything else throws std::invalid_argument, so that
+    the caller can fall back to muParser.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_API_DLL CompiledExpression {
+public:
+  /// A node of the expression tree, defined in the source file
+  struct Node;
+  /// Pointer to a node
+  typedef std::shared_ptr<const Node> NodePtr;
+
+  /// Compile a formula
+  CompiledExpression(const std::string &formula, const std::string &variable,
+                     const std::vector<std::string> &parameters);
+
+  /// The number of parameters
+  size_t nParams() const { return m_derivatives.size(); }
+  /// Evaluate the formula
+  void evaluate(const double *x, size_t n, const double *parameters,
+                double *out) const;
+  /// Evaluate the derivative of the formula with respect to a parameter
+  void derivative(size_t iParam, const double *x, size_t n,
+                  const double *parameters, double *out) const;
+
+private:
+  /// Evaluate a tree
+  static void evaluateTree(const Node &root, const double *x, size_t n,
+                           const double *parameters, double *out);
+  /// Build the tree of an expression
+  static NodePtr build(const Expression &expr, const std::string &variable,
+                       const std::vector<std::string> &parameters);
+
+  /// The tree of the formula
+  NodePtr m_root;
+  /// The trees of the derivatives with respect to each parameter
+  std::vector<NodePtr> m_derivatives;
+};
+
+} // namespace API
+} // namespace Mantid
+
+#endif /* MANTID_API_COMPILEDEXPRESSION_H_ */
@@ -8,6 +8,7 @@
 #include "MantidGeometry/Instrument_fwd.h"
 
 #include "MantidKernel/DeltaEMode.h"
+#include "MantidKernel/ModificationStamp.h"
 #include "MantidKernel/cow_ptr.h"
 
 #include <list>
@@ -168,6 +169,12 @@ public:
   void invalidateSpectrumDefinition(const size_t index);
   void updateSpectrumDefinitionIfNecessary(const size_t index) const;
 
+  uint64_t metadataModificationStamp() const;
+  void markMetadataModified();
+  void markSpectrumModified();
+  uint64_t spectraModificationStamp() const;
+  bool settleExperimentInfoModificationStamps();
+
   virtual size_t groupOfDetectorID(const detid_t detID) const;
 
 protected:
@@ -231,6 +238,11 @@ private:
   // This vector stores boolean flags but uses char to do so since
   // std::vector<bool> is not thread-safe.
   mutable std::vector<char> m_spectrumDefinitionNeedsUpdate;
+
+  /// Updated by modifications of the experiment information
+  Kernel::ModificationStamp m_modificationStamp;
+  /// Updated by modifications of the spectra
+  Kernel::ModificationStamp m_spectraModificationStamp;
 };
 
 /// Shared pointer to ExperimentInfo
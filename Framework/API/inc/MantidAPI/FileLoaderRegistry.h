@@ -3,11 +3,13 @@
 
 #include "MantidAPI/AlgorithmFactory.h"
 #include "MantidAPI/IFileLoader.h"
+#include "MantidKernel/LibraryManager.h"
 #include "MantidKernel/SingletonHolder.h"
 
 #ifndef Q_MOC_RUN
 #include <boost/type_traits/is_base_of.hpp>
 #endif
+#include <Poco/RWLock.h>
 
 #include <map>
 #include <string>
@@ -59,7 +61,10 @@ public:
 
 public:
   /// @returns the number of entries in the registry
-  inline size_t size() const { return m_totalSize; }
+  inline size_t size() const {
+    Poco::ScopedReadRWLock lock(m_namesLock);
+    return m_totalSize;
+  }
 
   /**
    * Registers a loader whose format is one of the known formats given in
@@ -76,8 +81,13 @@ public:
     SubscriptionValidator<Type>::check(format);
     const auto nameVersion = AlgorithmFactory::Instance().subscribe<Type>();
     // If the factory didn't throw then the name is valid
-    m_names[format].insert(nameVersion);
-    m_totalSize += 1;
+    {
+      Poco::ScopedWriteRWLock lock(m_namesLock);
+      m_names[format].insert(nameVersion);
+      m_totalSize += 1;
+    }
+    Kernel::LibraryManager::Instance().RegisterProvided("loader",
+                                                        nameVersion.first);
     m_log.debug() << "Registered '" << nameVersion.first << "' version '"
                   << nameVersion.second << "' as file loader\n";
   }
@@ -130,6 +140,8 @@ private:
     }
   };
 
+  /// Copy the names of the loaders of a format
+  std::multimap<std::string, int> loaderNames(LoaderFormat format) const;
   /// Remove a named algorithm & version from the given map
   void removeAlgorithm(const std::string &name, const int version,
                        std::multimap<std::string, int> &typedLoaders);
@@ -139,6 +151,9 @@ private:
   std::vector<std::multimap<std::string, int>> m_names;
   /// Total number of names registered
   size_t m_totalSize;
+  /// Guards the names against libraries subscribing loaders while they are
+  /// read. It must not be held while algorithms are created.
+  mutable Poco::RWLock m_namesLock;
 
   /// Reference to a logger
   mutable Kernel::Logger m_log;
@@ -586,12 +586,25 @@ protected:
   Kernel::ProgressBase *m_progReporter;
 
 private:
+  /// Get the copies of the function to calculate numerical derivatives in
+  /// parallel
+  const std::vector<boost::shared_ptr<IFunction>> &
+  numericalDerivCopies(const FunctionDomain &domain,
+                       const FunctionValues &values, size_t nCopies);
+  /// Make copies of the function to calculate numerical derivatives in
+  /// parallel
+  std::vector<boost::shared_ptr<IFunction>>
+  cloneForNumericalDeriv(const FunctionDomain &domain,
+                         const FunctionValues &values, size_t nCopies) const;
+
   /// The declared attributes
   std::map<std::string, API::IFunction::Attribute> m_attrs;
   /// The covariance matrix of the fitting parameters
   boost::shared_ptr<Kernel::Matrix<double>> m_covar;
   /// The chi-squared of the last fit
   double m_chiSquared;
+  /// The copies used to calculate numerical derivatives in parallel
+  std::vector<boost::shared_ptr<IFunction>> m_derivCopies;
 };
 
 /// shared pointer to the function base class
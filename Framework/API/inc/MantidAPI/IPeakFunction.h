@@ -67,6 +67,9 @@ public:
   virtual std::pair<double, double>
   getDomainInterval(double level = DEFAULT_SEARCH_LEVEL) const;
 
+  /// Get the interval outside which the peak and its derivatives are zero
+  virtual std::pair<double, double> getSupportInterval(int peakRadius) const;
+
   /// Function evaluation method to be implemented in the inherited classes
   virtual void functionLocal(double *out, const double *xValues,
                              const size_t nData) const = 0;
@@ -3,6 +3,7 @@
 
 #include "MantidGeometry/IDTypes.h"
 #include "MantidHistogramData/Histogram.h"
+#include "MantidKernel/ModificationStamp.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
 
@@ -106,22 +107,22 @@ public:
     // Check for the special case EventList, it only accepts histograms without
     // Y and E data.
     checkAndSanitizeHistogram(histogram);
-    mutableHistogramRef() = std::move(histogram);
+    modifiedHistogramRef() = std::move(histogram);
   }
 
   HistogramData::Histogram::YMode yMode() const {
     return histogramRef().yMode();
   }
   void setYMode(HistogramData::Histogram::YMode ymode) {
-    mutableHistogramRef().setYMode(ymode);
+    modifiedHistogramRef().setYMode(ymode);
   }
   void convertToCounts() {
     checkIsYAndEWritable();
-    mutableHistogramRef().convertToCounts();
+    modifiedHistogramRef().convertToCounts();
   }
   void convertToFrequencies() {
     checkIsYAndEWritable();
-    mutableHistogramRef().convertToFrequencies();
+    modifiedHistogramRef().convertToFrequencies();
   }
 
   HistogramData::BinEdges binEdges() const { return histogramRef().binEdges(); }
@@ -130,20 +131,20 @@ public:
     return histogramRef().pointStandardDeviations();
   }
   template <typename... T> void setBinEdges(T &&... data) & {
-    mutableHistogramRef().setBinEdges(std::forward<T>(data)...);
+    modifiedHistogramRef().setBinEdges(std::forward<T>(data)...);
   }
   template <typename... T> void setPoints(T &&... data) & {
     // Check for the special case EventList, it only works with BinEdges.
     checkWorksWithPoints();
-    mutableHistogramRef().setPoints(std::forward<T>(data)...);
+    modifiedHistogramRef().setPoints(std::forward<T>(data)...);
   }
   template <typename... T> void setPointVariances(T &&... data) & {
     // Note that we can set point variances even if storage mode is BinEdges, Dx
     // is *always* one value *per bin*.
-    mutableHistogramRef().setPointVariances(std::forward<T>(data)...);
+    modifiedHistogramRef().setPointVariances(std::forward<T>(data)...);
   }
   template <typename... T> void setPointStandardDeviations(T &&... data) & {
-    mutableHistogramRef().setPointStandardDeviations(std::forward<T>(data)...);
+    modifiedHistogramRef().setPointStandardDeviations(std::forward<T>(data)...);
   }
   virtual HistogramData::Counts counts() const {
     return histogramRef().counts();
@@ -168,27 +169,27 @@ public:
   template <typename... T> void setCounts(T &&... data) & {
     // Check for the special case EventList, cannot set Y and E there.
     checkIsYAndEWritable();
-    mutableHistogramRef().setCounts(std::forward<T>(data)...);
+    modifiedHistogramRef().setCounts(std::forward<T>(data)...);
   }
   template <typename... T> void setCountVariances(T &&... data) & {
     checkIsYAndEWritable();
-    mutableHistogramRef().setCountVariances(std::forward<T>(data)...);
+    modifiedHistogramRef().setCountVariances(std::forward<T>(data)...);
   }
   template <typename... T> void setCountStandardDeviations(T &&... data) & {
     checkIsYAndEWritable();
-    mutableHistogramRef().setCountStandardDeviations(std::forward<T>(data)...);
+    modifiedHistogramRef().setCountStandardDeviations(std::forward<T>(data)...);
   }
   template <typename... T> void setFrequencies(T &&... data) & {
     checkIsYAndEWritable();
-    mutableHistogramRef().setFrequencies(std::forward<T>(data)...);
+    modifiedHistogramRef().setFrequencies(std::forward<T>(data)...);
   }
   template <typename... T> void setFrequencyVariances(T &&... data) & {
     checkIsYAndEWritable();
-    mutableHistogramRef().setFrequencyVariances(std::forward<T>(data)...);
+    modifiedHistogramRef().setFrequencyVariances(std::forward<T>(data)...);
   }
   template <typename... T> void setFrequencyStandardDeviations(T &&... data) & {
     checkIsYAndEWritable();
-    mutableHistogramRef().setFrequencyStandardDeviations(
+    modifiedHistogramRef().setFrequencyStandardDeviations(
         std::forward<T>(data)...);
   }
   const HistogramData::HistogramX &x() const { return histogramRef().x(); }
@@ -200,18 +201,18 @@ public:
   }
   const HistogramData::HistogramDx &dx() const { return histogramRef().dx(); }
   HistogramData::HistogramX &mutableX() & {
-    return mutableHistogramRef().mutableX();
+    return modifiedHistogramRef().mutableX();
   }
   HistogramData::HistogramDx &mutableDx() & {
-    return mutableHistogramRef().mutableDx();
+    return modifiedHistogramRef().mutableDx();
   }
   HistogramData::HistogramY &mutableY() & {
     checkIsYAndEWritable();
-    return mutableHistogramRef().mutableY();
+    return modifiedHistogramRef().mutableY();
   }
   HistogramData::HistogramE &mutableE() & {
     checkIsYAndEWritable();
-    return mutableHistogramRef().mutableE();
+    return modifiedHistogramRef().mutableE();
   }
   Kernel::cow_ptr<HistogramData::HistogramX> sharedX() const {
     return histogramRef().sharedX();
@@ -226,22 +227,29 @@ public:
     return histogramRef().sharedDx();
   }
   void setSharedX(const Kernel::cow_ptr<HistogramData::HistogramX> &x) & {
-    mutableHistogramRef().setSharedX(x);
+    modifiedHistogramRef().setSharedX(x);
   }
   void setSharedDx(const Kernel::cow_ptr<HistogramData::HistogramDx> &dx) & {
-    mutableHistogramRef().setSharedDx(dx);
+    modifiedHistogramRef().setSharedDx(dx);
   }
   void setSharedY(const Kernel::cow_ptr<HistogramData::HistogramY> &y) & {
     checkIsYAndEWritable();
-    mutableHistogramRef().setSharedY(y);
+    modifiedHistogramRef().setSharedY(y);
   }
   void setSharedE(const Kernel::cow_ptr<HistogramData::HistogramE> &e) & {
     checkIsYAndEWritable();
-    mutableHistogramRef().setSharedE(e);
+    modifiedHistogramRef().setSharedE(e);
   }
 
   void setExperimentInfo(ExperimentInfo *experimentInfo, const size_t index);
 
+  /// The stamp of the last modification of this spectrum
+  uint64_t modificationStamp() const { return m_modificationStamp.value(); }
+  void markModified();
+  /// Record that the modifications of this spectrum are complete
+  void settleModificationStamp() const { m_modificationStamp.settle(); }
+  virtual size_t contentHash() const;
+
 protected:
   virtual void checkAndSanitizeHistogram(HistogramData::Histogram &) {}
   virtual void checkWorksWithPoints() const {}
@@ -257,6 +265,11 @@ protected:
 private:
   virtual const HistogramData::Histogram &histogramRef() const = 0;
   virtual HistogramData::Histogram &mutableHistogramRef() = 0;
+  /// Returns the histogram for modification and records the modification.
+  HistogramData::Histogram &modifiedHistogramRef() {
+    markModified();
+    return mutableHistogramRef();
+  }
 
   void updateExperimentInfo() const;
   ExperimentInfo *m_experimentInfo{nullptr};
@@ -268,6 +281,10 @@ private:
 
   /// Set of the detector IDs associated with this spectrum
   std::set<detid_t> detectorIDs;
+
+  /// Updated by every modification of this spectrum. Mutable so that the
+  /// spectra of a const workspace can be settled.
+  mutable Kernel::ModificationStamp m_modificationStamp;
 };
 
 } // namespace API
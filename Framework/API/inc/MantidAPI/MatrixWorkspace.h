@@ -134,6 +134,10 @@ public:
   size_t getMemorySize() const override;
   virtual size_t getMemorySizeForXAxes() const;
 
+  uint64_t modificationStamp() const override;
+  void settleModificationStamps() override;
+  size_t contentHash() const;
+
   // Section required for iteration
   /// Returns the number of single indexable items in the workspace
   virtual std::size_t size() const = 0;
@@ -603,6 +607,20 @@ private:
   /// containing workspace (null if none).
   boost::shared_ptr<MatrixWorkspace> m_monitorWorkspace;
 
+  /// The hashes of the parts of the workspace, kept by contentHash() so that
+  /// it only hashes again what has been modified since it was last called
+  struct ContentHashCache {
+    uint64_t metadataStamp{0};
+    size_t metadataHash{0};
+    uint64_t spectraStamp{0};
+    size_t spectraHash{0};
+    /// The stamp and the hash of each spectrum
+    std::vector<std::pair<uint64_t, size_t>> spectra;
+  };
+  mutable ContentHashCache m_contentHashCache;
+  /// Guards m_contentHashCache
+  mutable std::mutex m_contentHashMutex;
+
 protected:
   /// Getter for the dimension id based on the axis.
   std::string getDimensionIdFromAxis(const int &axisIndex) const;
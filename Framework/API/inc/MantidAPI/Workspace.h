@@ -5,6 +5,7 @@
 #include "MantidAPI/DllConfig.h"
 #include "MantidKernel/DataItem.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/ModificationStamp.h"
 
 namespace Mantid {
 
@@ -88,6 +89,13 @@ public:
   /// Returns the memory footprint in sensible units
   std::string getMemorySizeAsStr() const;
 
+  /// Returns a stamp that changes whenever the workspace is modified
+  virtual uint64_t modificationStamp() const;
+  /// Records a modification of the workspace
+  void markModified();
+  /// Records that the modifications of the workspace are complete
+  virtual void settleModificationStamps();
+
   /// Returns a reference to the WorkspaceHistory
   WorkspaceHistory &history() { return *m_history; }
   /// Returns a reference to the WorkspaceHistory const
@@ -108,6 +116,8 @@ private:
   std::string m_name;
   /// The history of the workspace, algorithm and environment
   std::unique_ptr<WorkspaceHistory> m_history;
+  /// Updated by modifications of the workspace
+  Kernel::ModificationStamp m_modificationStamp;
 
   /// Virtual clone method. Not implemented to force implementation in childs.
   virtual Workspace *doClone() const = 0;
@@ -100,10 +100,13 @@ private:
   AlgorithmHistory_sptr parseAlgorithmHistory(const std::string &rawData);
   /// Find the history entries at this level in the file.
   std::set<int> findHistoryEntries(::NeXus::File *file);
+  /// The algorithm histories, copied first if another history shares them
+  AlgorithmHistories &mutableAlgorithms();
   /// The environment of the workspace
   const Kernel::EnvironmentHistory m_environment;
-  /// The algorithms which have been called on the workspace
-  Mantid::API::AlgorithmHistories m_algorithms;
+  /// The algorithms which have been called on the workspace. Copies of the
+  /// history share them until one of the copies is modified.
+  boost::shared_ptr<AlgorithmHistories> m_algorithms;
 };
 
 MANTID_API_DLL std::ostream &operator<<(std::ostream &,
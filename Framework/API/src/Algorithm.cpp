@@ -1,6 +1,7 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/AlgorithmHistory.h"
 #include "MantidAPI/AlgorithmProxy.h"
+#include "MantidAPI/AlgorithmResultCache.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/DeprecatedAlgorithm.h"
 #include "MantidAPI/AlgorithmManager.h"
@@ -10,9 +11,14 @@
 
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/FunctionTask.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Profiler.h"
+#include "MantidKernel/make_unique.h"
 #include "MantidKernel/Strings.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadScheduler.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/UsageService.h"
 
@@ -29,6 +35,7 @@
 #include <json/json.h>
 
 #include <map>
+#include <mutex>
 
 using namespace Mantid::Kernel;
 
@@ -325,6 +332,22 @@ void Algorithm::cacheWorkspaceProperties() {
   }   // each property
 }
 
+//---------------------------------------------------------------------------------------------
+/** Settle the modification stamps of the output workspaces once exec() has
+ * finished modifying them, see Workspace::settleModificationStamps().
+ */
+void Algorithm::settleOutputModificationStamps() {
+  for (auto wsProp : m_outputWorkspaceProps) {
+    Workspace_sptr ws = wsProp->getWorkspace();
+    if (auto group = boost::dynamic_pointer_cast<WorkspaceGroup>(ws)) {
+      for (size_t i = 0; i < group->size(); ++i)
+        group->getItem(i)->settleModificationStamps();
+    } else if (ws) {
+      ws->settleModificationStamps();
+    }
+  }
+}
+
 //=============================================================================================
 //================================== Execution
 //================================================
@@ -436,6 +459,13 @@ bool Algorithm::execute() {
     throw std::runtime_error("Algorithm is not initialised:" + this->name());
   }
 
+  // Record the execution, including any child algorithms, when profiling
+  std::unique_ptr<ProfilerImpl::Scope> profile;
+  if (Profiler::Instance().isEnabled()) {
+    profile = Kernel::make_unique<ProfilerImpl::Scope>(
+        name() + " v" + std::to_string(version()), "algorithm");
+  }
+
   // Cache the workspace in/out properties for later use
   cacheWorkspaceProperties();
 
@@ -544,8 +574,18 @@ bool Algorithm::execute() {
       startTime = Mantid::Kernel::DateAndTime::getCurrentTime();
       // Start a timer
       Timer timer;
-      // Call the concrete algorithm's exec method
-      this->exec();
+      // Call the concrete algorithm's exec method, unless the outputs of a
+      // previous execution with the same inputs can be reused
+      const std::string cacheKey = resultCacheKey();
+      if (cacheKey.empty() ||
+          !AlgorithmResultCache::Instance().restore(cacheKey, *this)) {
+        const size_t nProperties = getProperties().size();
+        this->exec();
+        settleOutputModificationStamps();
+        // Properties declared by exec() would be missing after a cache hit
+        if (!cacheKey.empty() && getProperties().size() == nProperties)
+          AlgorithmResultCache::Instance().insert(cacheKey, *this);
+      }
       registerFeatureUsage();
       // Check for a cancellation request in case the concrete algorithm doesn't
       interruption_point();
@@ -1256,6 +1296,11 @@ bool Algorithm::doCallProcessGroups(Mantid::Kernel::DateAndTime &startTime) {
  * If there are several group input workspaces, then the member of each group
  * is executed pair-wise.
  *
+ * If the algorithm can process groups in parallel (see
+ * canProcessGroupsInParallel()) the members are executed concurrently
+ * instead. The output groups are filled in the order of the members in
+ * either case.
+ *
  * @return true - if all the workspace members are executed.
  */
 bool Algorithm::processGroups() {
@@ -1275,121 +1320,304 @@ bool Algorithm::processGroups() {
     }
   }
 
-  double progress_proportion = 1.0 / static_cast<double>(m_groupSize);
-  // Go through each entry in the input group(s)
-  for (size_t entry = 0; entry < m_groupSize; entry++) {
-    // use create Child Algorithm that look like this one
-    Algorithm_sptr alg_sptr = this->createChildAlgorithm(
-        this->name(), progress_proportion * static_cast<double>(entry),
-        progress_proportion * (1 + static_cast<double>(entry)),
-        this->isLogging(), this->version());
-    // Don't make the new algorithm a child so that it's workspaces are stored
-    // correctly
-    alg_sptr->setChild(false);
-
-    alg_sptr->setRethrows(true);
-
-    IAlgorithm *alg = alg_sptr.get();
-    // Set all non-workspace properties
-    this->copyNonWorkspaceProperties(alg, int(entry) + 1);
-
-    std::string outputBaseName;
-
-    // ---------- Set all the input workspaces ----------------------------
-    for (size_t iwp = 0; iwp < m_groups.size(); iwp++) {
-      std::vector<Workspace_sptr> &thisGroup = m_groups[iwp];
-      if (!thisGroup.empty()) {
-        // By default (for a single group) point to the first/only workspace
-        Workspace_sptr ws = thisGroup[0];
-
-        if ((m_singleGroup == int(iwp)) || m_singleGroup < 0) {
-          // Either: this is the single group
-          // OR: all inputs are groups
-          // ... so get then entry^th workspace in this group
-          ws = thisGroup[entry];
+  // The member algorithms, if they have been set up for parallel processing
+  std::vector<boost::shared_ptr<Algorithm>> algs;
+  std::vector<std::vector<std::string>> outputWSNames;
+  const size_t nThreads = groupProcessingThreads();
+  if (nThreads < 2 ||
+      !processGroupsInParallel(outGroups, nThreads, algs, outputWSNames)) {
+    double progress_proportion = 1.0 / static_cast<double>(m_groupSize);
+    algs.resize(m_groupSize);
+    outputWSNames.resize(m_groupSize);
+    // Go through each entry in the input group(s)
+    for (size_t entry = 0; entry < m_groupSize; entry++) {
+      auto &alg = algs[entry];
+      if (alg) {
+        // Inputs are retrieved from the ADS when they are set. Set them again
+        // in case an earlier entry has replaced one of them.
+        for (auto inputProp : m_inputWorkspaceProps) {
+          auto prop = dynamic_cast<Property *>(inputProp);
+          if (!prop)
+            continue;
+          const std::string inName = alg->getPropertyValue(prop->name());
+          if (!inName.empty())
+            alg->setPropertyValue(prop->name(), inName);
         }
-        // Append the names together
-        if (!outputBaseName.empty())
-          outputBaseName += "_";
-        outputBaseName += ws->getName();
-
-        // Set the property using the name of that workspace
-        if (Property *prop =
-                dynamic_cast<Property *>(m_inputWorkspaceProps[iwp])) {
-          alg->setPropertyValue(prop->name(), ws->getName());
-        } else {
-          throw std::logic_error("Found a Workspace property which doesn't "
-                                 "inherit from Property.");
-        }
-      } // not an empty (i.e. optional) input
-    }   // for each InputWorkspace property
+      } else {
+        alg = createGroupMemberAlgorithm(entry, outputWSNames[entry]);
+      }
+      alg->addObserver(this->progressObserver());
+      setChildStartProgress(progress_proportion * static_cast<double>(entry));
+      setChildEndProgress(progress_proportion *
+                          (1 + static_cast<double>(entry)));
+
+      // ------------ Execute the algo --------------
+      try {
+        alg->execute();
+      } catch (std::exception &e) {
+        throw std::runtime_error(groupMemberFailure(entry, e));
+      }
+
+      // ------------ Fill in the output workspace group ------------------
+      // this has to be done after execute() because a workspace must exist
+      // when it is added to a group
+      for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
+        // And add it to the output group
+        outGroups[owp]->add(outputWSNames[entry][owp]);
+      }
+    } // for each entry in each group
+  }
+
+  // restore group notifications
+  for (auto &outGroup : outGroups) {
+    outGroup->observeADSNotifications(true);
+  }
+
+  return true;
+}
+
+//--------------------------------------------------------------------------------------------
+/** Execute the members of the input group(s) concurrently on a pool of
+ * threads.
+ *
+ * All the member algorithms are set up before any of them runs. Progress is
+ * reported by this algorithm as members finish. If some members fail, the
+ * error of the first of them is thrown after all have finished. The OpenMP
+ * threads of each member are limited so that the members together don't use
+ * more threads than a single algorithm would.
+ *
+ * @param outGroups :: The output groups, filled in the order of the members
+ * @param nThreads :: The maximum number of threads to use
+ * @param algs :: Set to the member algorithms
+ * @param outputWSNames :: Set to the names of the output workspaces of each
+ * member
+ * @return false, without executing anything, if a member would modify an
+ * input of another member. The members are then executed one by one.
+ */
+bool Algorithm::processGroupsInParallel(
+    const std::vector<WorkspaceGroup_sptr> &outGroups, size_t nThreads,
+    std::vector<boost::shared_ptr<Algorithm>> &algs,
+    std::vector<std::vector<std::string>> &outputWSNames) {
+  algs.resize(m_groupSize);
+  outputWSNames.resize(m_groupSize);
+  for (size_t entry = 0; entry < m_groupSize; entry++) {
+    // The members don't report progress, this algorithm does
+    algs[entry] = createGroupMemberAlgorithm(entry, outputWSNames[entry]);
+  }
+
+  // Members must not modify the inputs of other members. Inputs that are not
+  // groups are read by all the members.
+  std::map<std::string, size_t> inputEntries;
+  for (size_t iwp = 0; iwp < m_groups.size(); iwp++) {
+    const auto &group = m_groups[iwp];
+    const bool shared = m_singleGroup >= 0 && m_singleGroup != int(iwp);
+    auto prop = dynamic_cast<Property *>(m_inputWorkspaceProps[iwp]);
+    if (shared && !group.empty() && prop &&
+        prop->direction() == Kernel::Direction::InOut) {
+      return false;
+    }
+    for (size_t entry = 0; entry < group.size(); entry++) {
+      inputEntries.emplace(group[entry]->getName(),
+                           shared ? m_groupSize : entry);
+    }
+  }
+  for (size_t entry = 0; entry < m_groupSize; entry++) {
+    for (const auto &outName : outputWSNames[entry]) {
+      auto input = inputEntries.find(outName);
+      if (input != inputEntries.end() && input->second != entry) {
+        g_log.debug() << "Output " << outName << " of group entry "
+                      << (entry + 1) << " is an input of other entries. "
+                      << "Processing the entries one by one.\n";
+        return false;
+      }
+    }
+  }
 
-    std::vector<std::string> outputWSNames(m_pureOutputWorkspaceProps.size());
-    // ---------- Set all the output workspaces ----------------------------
+  std::vector<std::string> errors(m_groupSize);
+  std::mutex progressMutex;
+  size_t nFinished = 0;
+  const int memberThreads =
+      std::max(1, PARALLEL_GET_MAX_THREADS / static_cast<int>(nThreads));
+  ThreadPool pool(new ThreadSchedulerFIFO(), nThreads);
+  for (size_t entry = 0; entry < m_groupSize; entry++) {
+    pool.schedule(new FunctionTask([&, entry]() {
+      // The setting belongs to the pool thread, which ends with the pool
+      PARALLEL_SET_NUM_THREADS(memberThreads);
+      try {
+        algs[entry]->execute();
+      } catch (std::exception &e) {
+        errors[entry] = groupMemberFailure(entry, e);
+      }
+      std::lock_guard<std::mutex> lock(progressMutex);
+      ++nFinished;
+      progress(static_cast<double>(nFinished) /
+                   static_cast<double>(m_groupSize),
+               "Processed group entry " + Strings::toString(entry + 1));
+    }));
+  }
+  pool.joinAll();
+
+  for (const auto &error : errors) {
+    if (!error.empty())
+      throw std::runtime_error(error);
+  }
+
+  // ------------ Fill in the output workspace groups in entry order ----------
+  for (size_t entry = 0; entry < m_groupSize; entry++) {
     for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
-      if (Property *prop =
-              dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp])) {
-        // Default name = "in1_in2_out"
-        const std::string inName = prop->value();
-        std::string outName;
-        if (m_groupsHaveSimilarNames)
-          outName = inName + "_" + Strings::toString(entry + 1);
-        else
-          outName = outputBaseName + "_" + inName;
-
-        auto inputProp = std::find_if(m_inputWorkspaceProps.begin(),
-                                      m_inputWorkspaceProps.end(),
-                                      WorkspacePropertyValueIs(inName));
-
-        // Overwrite workspaces in any input property if they have the same
-        // name as an output (i.e. copy name button in algorithm dialog used)
-        // (only need to do this for a single input, multiple will be handled
-        // by ADS)
-        if (inputProp != m_inputWorkspaceProps.end()) {
-          const auto &inputGroup =
-              m_groups[inputProp - m_inputWorkspaceProps.begin()];
-          if (!inputGroup.empty())
-            outName = inputGroup[entry]->getName();
-        }
-        // Except if all inputs had similar names, then the name is "out_1"
+      outGroups[owp]->add(outputWSNames[entry][owp]);
+    }
+  }
+  return true;
+}
 
-        // Set in the output
-        alg->setPropertyValue(prop->name(), outName);
+//--------------------------------------------------------------------------------------------
+/** Create and set up the algorithm processing one member of the input
+ * group(s). It doesn't report progress to this algorithm.
+ *
+ * @param entry :: The index of the member
+ * @param outputWSNames :: Set to the names of the output workspaces
+ * @return The algorithm, ready to execute
+ */
+boost::shared_ptr<Algorithm>
+Algorithm::createGroupMemberAlgorithm(size_t entry,
+                                      std::vector<std::string> &outputWSNames) {
+  // use create Child Algorithm that look like this one
+  Algorithm_sptr alg_sptr = this->createChildAlgorithm(
+      this->name(), -1., -1., this->isLogging(), this->version());
+  // Don't make the new algorithm a child so that it's workspaces are stored
+  // correctly
+  alg_sptr->setChild(false);
+
+  alg_sptr->setRethrows(true);
+
+  IAlgorithm *alg = alg_sptr.get();
+  // Set all non-workspace properties
+  this->copyNonWorkspaceProperties(alg, int(entry) + 1);
+
+  std::string outputBaseName;
+
+  // ---------- Set all the input workspaces ----------------------------
+  for (size_t iwp = 0; iwp < m_groups.size(); iwp++) {
+    std::vector<Workspace_sptr> &thisGroup = m_groups[iwp];
+    if (!thisGroup.empty()) {
+      // By default (for a single group) point to the first/only workspace
+      Workspace_sptr ws = thisGroup[0];
+
+      if ((m_singleGroup == int(iwp)) || m_singleGroup < 0) {
+        // Either: this is the single group
+        // OR: all inputs are groups
+        // ... so get then entry^th workspace in this group
+        ws = thisGroup[entry];
+      }
+      // Append the names together
+      if (!outputBaseName.empty())
+        outputBaseName += "_";
+      outputBaseName += ws->getName();
 
-        outputWSNames[owp] = outName;
+      // Set the property using the name of that workspace
+      if (Property *prop =
+              dynamic_cast<Property *>(m_inputWorkspaceProps[iwp])) {
+        alg->setPropertyValue(prop->name(), ws->getName());
       } else {
-        throw std::logic_error(
-            "Found a Workspace property which doesn't inherit from Property.");
+        throw std::logic_error("Found a Workspace property which doesn't "
+                               "inherit from Property.");
+      }
+    } // not an empty (i.e. optional) input
+  }   // for each InputWorkspace property
+
+  outputWSNames.resize(m_pureOutputWorkspaceProps.size());
+  // ---------- Set all the output workspaces ----------------------------
+  for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
+    if (Property *prop =
+            dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp])) {
+      // Default name = "in1_in2_out"
+      const std::string inName = prop->value();
+      std::string outName;
+      if (m_groupsHaveSimilarNames)
+        outName = inName + "_" + Strings::toString(entry + 1);
+      else
+        outName = outputBaseName + "_" + inName;
+
+      auto inputProp = std::find_if(m_inputWorkspaceProps.begin(),
+                                    m_inputWorkspaceProps.end(),
+                                    WorkspacePropertyValueIs(inName));
+
+      // Overwrite workspaces in any input property if they have the same
+      // name as an output (i.e. copy name button in algorithm dialog used)
+      // (only need to do this for a single input, multiple will be handled
+      // by ADS)
+      if (inputProp != m_inputWorkspaceProps.end()) {
+        const auto &inputGroup =
+            m_groups[inputProp - m_inputWorkspaceProps.begin()];
+        if (!inputGroup.empty())
+          outName = inputGroup[entry]->getName();
       }
-    } // for each OutputWorkspace property
+      // Except if all inputs had similar names, then the name is "out_1"
 
-    // ------------ Execute the algo --------------
-    try {
-      alg->execute();
-    } catch (std::exception &e) {
-      std::ostringstream msg;
-      msg << "Execution of " << this->name() << " for group entry "
-          << (entry + 1) << " failed: ";
-      msg << e.what(); // Add original message
-      throw std::runtime_error(msg.str());
-    }
+      // Set in the output
+      alg->setPropertyValue(prop->name(), outName);
 
-    // ------------ Fill in the output workspace group ------------------
-    // this has to be done after execute() because a workspace must exist
-    // when it is added to a group
-    for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
-      // And add it to the output group
-      outGroups[owp]->add(outputWSNames[owp]);
+      outputWSNames[owp] = outName;
+    } else {
+      throw std::logic_error(
+          "Found a Workspace property which doesn't inherit from Property.");
     }
+  } // for each OutputWorkspace property
 
-  } // for each entry in each group
+  return alg_sptr;
+}
 
-  // restore group notifications
-  for (auto &outGroup : outGroups) {
-    outGroup->observeADSNotifications(true);
+//--------------------------------------------------------------------------------------------
+/** Make the error message of a failed group member.
+ *
+ * @param entry :: The index of the member
+ * @param e :: The exception thrown by the member
+ * @return The message
+ */
+std::string Algorithm::groupMemberFailure(size_t entry,
+                                          const std::exception &e) const {
+  std::ostringstream msg;
+  msg << "Execution of " << this->name() << " for group entry " << (entry + 1)
+      << " failed: ";
+  msg << e.what(); // Add original message
+  return msg.str();
+}
+
+//--------------------------------------------------------------------------------------------
+/** Get the number of threads to process the members of the input group(s)
+ * with.
+ *
+ * The members are processed in parallel only if the algorithm allows it and
+ * the groups have more than one member. The number of threads is limited by the
+ * algorithms.groups.maxthreads property (0 for the number of cores) and by
+ * MultiThreaded.MaxCores.
+ *
+ * @return The number of threads, 1 to process the members one by one
+ */
+size_t Algorithm::groupProcessingThreads() const {
+  if (m_groupSize < 2 || !canProcessGroupsInParallel())
+    return 1;
+
+  size_t nThreads = ThreadPool::getNumPhysicalCores();
+  int maxThreads = 0;
+  if (ConfigService::Instance().getValue("algorithms.groups.maxthreads",
+                                         maxThreads) &&
+      maxThreads > 0) {
+    nThreads = std::min(nThreads, static_cast<size_t>(maxThreads));
   }
+  return std::min(nThreads, m_groupSize);
+}
 
-  return true;
+/**
+ * The key of the current inputs in the AlgorithmResultCache.
+ * @return The key, or an empty string if the outputs of this execution are
+ * not to be cached
+ */
+std::string Algorithm::resultCacheKey() const {
+  if (!isCacheable() || !AlgorithmResultCache::Instance().isEnabled())
+    return "";
+  return AlgorithmResultCache::Instance().createKey(*this);
 }
 
 //--------------------------------------------------------------------------------------------
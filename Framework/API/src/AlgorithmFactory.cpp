@@ -18,7 +18,7 @@ Kernel::Logger g_log("AlgorithmFactory");
 }
 
 AlgorithmFactoryImpl::AlgorithmFactoryImpl()
-    : Kernel::DynamicFactory<Algorithm>(), m_vmap() {
+    : Kernel::DynamicFactory<Algorithm>("algorithm"), m_vmap() {
   // we need to make sure the library manager has been loaded before we
   // are constructed so that it is destroyed after us and thus does
   // not close any loaded DLLs with loaded algorithms in them
@@ -36,16 +36,14 @@ AlgorithmFactoryImpl::~AlgorithmFactoryImpl() = default;
 boost::shared_ptr<Algorithm>
 AlgorithmFactoryImpl::create(const std::string &name,
                              const int &version) const {
+  openPluginIfUnknown(name);
   int local_version = version;
   if (version < 0) {
     if (version == -1) // get latest version since not supplied
     {
-      auto it = m_vmap.find(name);
       if (!name.empty()) {
-        if (it == m_vmap.end())
+        if (!lookUpVersion(name, local_version))
           throw std::runtime_error("Algorithm not registered " + name);
-        else
-          local_version = it->second;
       } else
         throw std::runtime_error(
             "Algorithm not registered (empty algorithm name)");
@@ -54,13 +52,13 @@ AlgorithmFactoryImpl::create(const std::string &name,
   try {
     return this->createAlgorithm(name, local_version);
   } catch (Kernel::Exception::NotFoundError &) {
-    auto it = m_vmap.find(name);
-    if (it == m_vmap.end())
+    int highest = 0;
+    if (!lookUpVersion(name, highest))
       throw std::runtime_error("algorithm not registered " + name);
     else {
       g_log.error() << "algorithm " << name << " version " << version
                     << " is not registered \n";
-      g_log.error() << "the latest registered version is " << it->second
+      g_log.error() << "the latest registered version is " << highest
                     << '\n';
       throw std::runtime_error("algorithm not registered " +
                                createName(name, local_version));
@@ -80,6 +78,7 @@ void AlgorithmFactoryImpl::unsubscribe(const std::string &algorithmName,
   try {
     Kernel::DynamicFactory<Algorithm>::unsubscribe(key);
     // Update version map accordingly
+    Poco::ScopedWriteRWLock lock(m_mapLock);
     auto it = m_vmap.find(algorithmName);
     if (it != m_vmap.end()) {
       int highest_version = it->second;
@@ -105,15 +104,45 @@ void AlgorithmFactoryImpl::unsubscribe(const std::string &algorithmName,
  */
 bool AlgorithmFactoryImpl::exists(const std::string &algorithmName,
                                   const int version) {
+  openPluginIfUnknown(algorithmName);
   if (version == -1) // Find anything
   {
-    return (m_vmap.find(algorithmName) != m_vmap.end());
+    int highest = 0;
+    return lookUpVersion(algorithmName, highest);
   } else {
     std::string key = this->createName(algorithmName, version);
     return Kernel::DynamicFactory<Algorithm>::exists(key);
   }
 }
 
+/**
+ * Open the plugin library providing an algorithm if no version of it is
+ * registered yet
+ * @param name :: The name of the algorithm
+ */
+void AlgorithmFactoryImpl::openPluginIfUnknown(const std::string &name) const {
+  int highest = 0;
+  // The lock is released before the library subscribes its algorithms
+  if (!name.empty() && !lookUpVersion(name, highest))
+    openPluginProviding(name);
+}
+
+/**
+ * Look up the highest registered version of an algorithm
+ * @param name :: The name of the algorithm
+ * @param version :: Set to the highest version if the algorithm is registered
+ * @returns True if a version of the algorithm is registered
+ */
+bool AlgorithmFactoryImpl::lookUpVersion(const std::string &name,
+                                         int &version) const {
+  Poco::ScopedReadRWLock lock(m_mapLock);
+  auto it = m_vmap.find(name);
+  if (it == m_vmap.end())
+    return false;
+  version = it->second;
+  return true;
+}
+
 /** Creates a mangled name for interal storage
 * @param name :: the name of the Algrorithm
 * @param version :: the version of the algroithm
@@ -224,9 +253,10 @@ AlgorithmFactoryImpl::getKeys(bool includeHidden) const {
  */
 int AlgorithmFactoryImpl::highestVersion(
     const std::string &algorithmName) const {
-  auto viter = m_vmap.find(algorithmName);
-  if (viter != m_vmap.end())
-    return viter->second;
+  openPluginIfUnknown(algorithmName);
+  int highest = 0;
+  if (lookUpVersion(algorithmName, highest))
+    return highest;
   else {
     throw std::invalid_argument(
         "AlgorithmFactory::highestVersion() - Unknown algorithm '" +
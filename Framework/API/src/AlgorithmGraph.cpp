@@ -0,0 +1,389 @@
+#include "MantidAPI/AlgorithmGraph.h"
+#include "MantidAPI/IAlgorithm.h"
+#include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/Property.h"
+#include "MantidKernel/ThreadPool.h"
+#include "MantidKernel/ThreadScheduler.h"
+#include "MantidKernel/Timer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+using namespace Mantid::Kernel;
+
+namespace Mantid {
+namespace API {
+namespace {
+/// static logger
+Logger g_log("AlgorithmGraph");
+
+/// Get a workspace property of an algorithm, checking its direction
+IWorkspaceProperty &workspaceProperty(const IAlgorithm &alg,
+                                      const std::string &name, bool input) {
+  if (!alg.existsProperty(name))
+    throw std::invalid_argument(alg.name() + " has no property " + name);
+  Property *prop = alg.getPointerToProperty(name);
+  auto wsProp = dynamic_cast<IWorkspaceProperty *>(prop);
+  if (!wsProp)
+    throw std::invalid_argument(name + " is not a workspace property of " +
+                                alg.name());
+  const bool isInput = prop->direction() == Direction::Input;
+  const bool isOutput = prop->direction() == Direction::Output ||
+                        prop->direction() == Direction::InOut;
+  if (input && !isInput)
+    throw std::invalid_argument(name + " is not an input of " + alg.name());
+  if (!input && !isOutput)
+    throw std::invalid_argument(name + " is not an output of " + alg.name());
+  return *wsProp;
+}
+} // namespace
+
+/** The state of one execution of the graph, shared by the worker threads.
+ *
+ * Each worker takes a node that is ready to run, runs it and then passes its
+ * outputs to the nodes that use them. Nodes whose inputs are all available
+ * become ready. The workers stop when no node is ready or running. */
+class AlgorithmGraph::Execution {
+public:
+  explicit Execution(AlgorithmGraph &graph)
+      : m_graph(graph), m_waiting(graph.size(), 0),
+        m_errors(graph.size()) {
+    for (const auto &edge : m_graph.m_edges) {
+      ++m_waiting[edge.consumer];
+      ++m_uses[std::make_pair(edge.producer, edge.output)];
+    }
+    for (size_t node = 0; node < m_graph.size(); ++node) {
+      m_graph.m_nodes[node].statistics = NodeStatistics();
+      if (m_waiting[node] == 0)
+        m_ready.push_back(node);
+    }
+  }
+
+  /// Run nodes until there are none left to run
+  void work(size_t thread) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_condition.wait(lock,
+                       [this] { return !m_ready.empty() || m_running == 0; });
+      if (m_ready.empty()) {
+        // Nothing is running, so no node can become ready
+        m_condition.notify_all();
+        return;
+      }
+      const size_t node = m_ready.front();
+      m_ready.pop_front();
+      ++m_running;
+      lock.unlock();
+
+      auto &stats = m_graph.m_nodes[node].statistics;
+      stats.thread = thread;
+      stats.start = m_timer.elapsed_no_reset();
+      std::string error;
+      auto &alg = *m_graph.m_nodes[node].algorithm;
+      try {
+        if (!alg.execute())
+          error = "Unable to successfully run " + alg.name();
+      } catch (std::exception &e) {
+        error = e.what();
+      } catch (...) {
+        error = "Unknown exception";
+      }
+      stats.end = m_timer.elapsed_no_reset();
+
+      lock.lock();
+      --m_running;
+      if (error.empty()) {
+        try {
+          finished(node);
+          stats.executed = true;
+        } catch (std::exception &e) {
+          error = e.what();
+        } catch (...) {
+          error = "Unknown exception";
+        }
+      }
+      if (!error.empty()) {
+        m_errors[node] = "Execution of " + alg.name() +
+                         " in the algorithm graph failed: " + error;
+        // Let the running nodes finish but don't start any more
+        m_ready.clear();
+        m_failed = true;
+      }
+      m_condition.notify_all();
+    }
+  }
+
+  /// Throw the error of the first node that failed, if any
+  void rethrow() const {
+    for (const auto &error : m_errors) {
+      if (!error.empty())
+        throw std::runtime_error(error);
+    }
+  }
+
+private:
+  /// Pass the outputs of a node to its consumers and release the inputs it
+  /// no longer needs. Called with the lock held.
+  /// @throws std::runtime_error if an output was not set
+  void finished(size_t node) {
+    auto &graph = m_graph;
+    for (const auto &edge : graph.m_edges) {
+      if (edge.producer == node) {
+        auto &producer = *graph.m_nodes[node].algorithm;
+        auto ws =
+            workspaceProperty(producer, edge.output, false).getWorkspace();
+        if (!ws)
+          throw std::runtime_error("The output " + edge.output +
+                                   " was not set");
+        graph.m_nodes[edge.consumer].algorithm->setProperty(edge.input, ws);
+        if (--m_waiting[edge.consumer] == 0 && !m_failed)
+          m_ready.push_back(edge.consumer);
+      }
+    }
+    for (const auto &edge : graph.m_edges) {
+      if (edge.consumer != node)
+        continue;
+      auto &consumer = *graph.m_nodes[node].algorithm;
+      workspaceProperty(consumer, edge.input, true).clear();
+      const auto &producerNode = graph.m_nodes[edge.producer];
+      const auto &kept = producerNode.keptOutputs;
+      if (--m_uses[std::make_pair(edge.producer, edge.output)] == 0 &&
+          std::find(kept.begin(), kept.end(), edge.output) == kept.end()) {
+        g_log.debug() << "Releasing " << edge.output << " of "
+                      << producerNode.algorithm->name() << '\n';
+        workspaceProperty(*producerNode.algorithm, edge.output, false).clear();
+      }
+    }
+  }
+
+  AlgorithmGraph &m_graph;
+  Timer m_timer;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  /// Nodes whose inputs are all available, in the order they became ready
+  std::deque<size_t> m_ready;
+  /// The number of nodes that are running
+  size_t m_running = 0;
+  /// The number of inputs each node is waiting for
+  std::vector<size_t> m_waiting;
+  /// The number of nodes that have still to use each connected output
+  std::map<std::pair<size_t, std::string>, size_t> m_uses;
+  std::vector<std::string> m_errors;
+  bool m_failed = false;
+};
+
+/**
+ * Add an algorithm to the graph.
+ * @param algorithm :: An initialized algorithm. Its inputs that will be
+ * connected to other nodes don't have to be set.
+ * @param label :: An optional name for the node, used in toDot(). The name of
+ * the algorithm is used if it is empty.
+ * @return The index of the new node
+ */
+size_t AlgorithmGraph::addAlgorithm(IAlgorithm_sptr algorithm,
+                                    const std::string &label) {
+  if (!algorithm)
+    throw std::invalid_argument("Cannot add a null algorithm to a graph");
+  Node node;
+  node.label = label.empty() ? algorithm->name() : label;
+  node.algorithm = std::move(algorithm);
+  m_nodes.push_back(std::move(node));
+  return m_nodes.size() - 1;
+}
+
+/**
+ * Make a workspace output of one node an input of another.
+ * @param producer :: The node that creates the workspace
+ * @param outputProperty :: The output property of the producer
+ * @param consumer :: The node that uses the workspace
+ * @param inputProperty :: The input property of the consumer
+ * @throws std::invalid_argument if a property doesn't exist or has the wrong
+ * direction, or if the input is already connected
+ */
+void AlgorithmGraph::connect(size_t producer, const std::string &outputProperty,
+                             size_t consumer,
+                             const std::string &inputProperty) {
+  checkNode(producer);
+  checkNode(consumer);
+  if (producer == consumer)
+    throw std::invalid_argument("Cannot connect a node to itself");
+  workspaceProperty(*m_nodes[producer].algorithm, outputProperty, false);
+  workspaceProperty(*m_nodes[consumer].algorithm, inputProperty, true);
+  for (const auto &edge : m_edges) {
+    if (edge.consumer == consumer && edge.input == inputProperty)
+      throw std::invalid_argument(inputProperty + " of " +
+                                  m_nodes[consumer].label +
+                                  " is already connected");
+  }
+  m_edges.push_back({producer, outputProperty, consumer, inputProperty});
+}
+
+/**
+ * Keep a connected output after all the nodes that use it have finished.
+ * @param node :: The node that creates the workspace
+ * @param outputProperty :: The output property of the node
+ */
+void AlgorithmGraph::keepOutput(size_t node,
+                                const std::string &outputProperty) {
+  checkNode(node);
+  workspaceProperty(*m_nodes[node].algorithm, outputProperty, false);
+  m_nodes[node].keptOutputs.push_back(outputProperty);
+}
+
+/**
+ * Run all the nodes. If a node fails, the nodes that are running are allowed
+ * to finish and no other node is started.
+ * @param nThreads :: The maximum number of nodes to run at once. 0 means the
+ * number of cores, see Kernel::ThreadPool::getNumPhysicalCores().
+ * @throws std::runtime_error if the graph has a cycle or a node fails. The
+ * error of the failed node with the lowest index is thrown.
+ */
+void AlgorithmGraph::execute(size_t nThreads) {
+  if (m_nodes.empty())
+    return;
+  sortedNodes();
+  if (nThreads == 0)
+    nThreads = ThreadPool::getNumPhysicalCores();
+  nThreads = std::min(nThreads, m_nodes.size());
+
+  Execution execution(*this);
+  ThreadPool pool(new ThreadSchedulerFIFO(), nThreads);
+  for (size_t thread = 0; thread < nThreads; ++thread) {
+    pool.schedule(new FunctionTask(
+        [&execution, thread]() { execution.work(thread); }));
+  }
+  pool.joinAll();
+  execution.rethrow();
+
+  if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
+    for (const auto &node : m_nodes) {
+      g_log.debug() << node.label << " ran on thread " << node.statistics.thread
+                    << " from " << node.statistics.start << " to "
+                    << node.statistics.end << " s\n";
+    }
+  }
+}
+
+/// @param node :: The index of a node
+/// @return The algorithm of the node
+IAlgorithm_sptr AlgorithmGraph::algorithm(size_t node) const {
+  checkNode(node);
+  return m_nodes[node].algorithm;
+}
+
+/// @param node :: The index of a node
+/// @return The label of the node
+const std::string &AlgorithmGraph::label(size_t node) const {
+  checkNode(node);
+  return m_nodes[node].label;
+}
+
+/// @param node :: The index of a node
+/// @return The nodes whose outputs are inputs of the node, in increasing order
+std::vector<size_t> AlgorithmGraph::dependencies(size_t node) const {
+  checkNode(node);
+  std::vector<size_t> producers;
+  for (const auto &edge : m_edges) {
+    if (edge.consumer == node)
+      producers.push_back(edge.producer);
+  }
+  std::sort(producers.begin(), producers.end());
+  producers.erase(std::unique(producers.begin(), producers.end()),
+                  producers.end());
+  return producers;
+}
+
+/// @param node :: The index of a node
+/// @return What happened to the node during the last execution
+const AlgorithmGraph::NodeStatistics &
+AlgorithmGraph::statistics(size_t node) const {
+  checkNode(node);
+  return m_nodes[node].statistics;
+}
+
+/// @return The largest number of nodes that ran at the same time during the
+/// last execution
+size_t AlgorithmGraph::maxConcurrency() const {
+  // Sweep over the start (+1) and end (-1) times, ends first
+  std::vector<std::pair<double, int>> events;
+  for (const auto &node : m_nodes) {
+    if (node.statistics.executed) {
+      events.emplace_back(node.statistics.start, 1);
+      events.emplace_back(node.statistics.end, -1);
+    }
+  }
+  std::sort(events.begin(), events.end());
+  int running = 0;
+  int maxRunning = 0;
+  for (const auto &event : events) {
+    running += event.second;
+    maxRunning = std::max(maxRunning, running);
+  }
+  return static_cast<size_t>(maxRunning);
+}
+
+/**
+ * Describe the graph in the dot language of Graphviz. The nodes show the
+ * thread and times of the last execution and the edges the properties they
+ * connect.
+ * @return The dot source
+ */
+std::string AlgorithmGraph::toDot() const {
+  std::ostringstream dot;
+  dot << "digraph AlgorithmGraph {\n";
+  for (size_t i = 0; i < m_nodes.size(); ++i) {
+    const auto &node = m_nodes[i];
+    dot << "  n" << i << " [label=\"" << node.label;
+    if (node.statistics.executed) {
+      dot << "\\nthread " << node.statistics.thread << ", "
+          << node.statistics.start << " - " << node.statistics.end << " s";
+    }
+    dot << "\"];\n";
+  }
+  for (const auto &edge : m_edges) {
+    dot << "  n" << edge.producer << " -> n" << edge.consumer << " [label=\""
+        << edge.output << " -> " << edge.input << "\"];\n";
+  }
+  dot << "}\n";
+  return dot.str();
+}
+
+/// Throw std::out_of_range if a node index is not in the graph
+void AlgorithmGraph::checkNode(size_t node) const {
+  if (node >= m_nodes.size())
+    throw std::out_of_range("Node " + std::to_string(node) +
+                            " is not in the algorithm graph");
+}
+
+/// @return The nodes in an order where every node comes after the nodes it
+/// depends on
+/// @throws std::runtime_error if the graph has a cycle
+std::vector<size_t> AlgorithmGraph::sortedNodes() const {
+  std::vector<size_t> waiting(m_nodes.size(), 0);
+  for (const auto &edge : m_edges)
+    ++waiting[edge.consumer];
+  std::vector<size_t> sorted;
+  for (size_t node = 0; node < m_nodes.size(); ++node) {
+    if (waiting[node] == 0)
+      sorted.push_back(node);
+  }
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    for (const auto &edge : m_edges) {
+      if (edge.producer == sorted[i] && --waiting[edge.consumer] == 0)
+        sorted.push_back(edge.consumer);
+    }
+  }
+  if (sorted.size() != m_nodes.size())
+    throw std::runtime_error("The algorithm graph has a cycle");
+  return sorted;
+}
+
+} // namespace API
+} // namespace Mantid
@@ -0,0 +1,227 @@
+#include "MantidAPI/AlgorithmResultCache.h"
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Logger.h"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace Mantid {
+namespace API {
+namespace {
+/// static logger
+Kernel::Logger g_log("AlgorithmResultCache");
+
+/// Append a field to a key, prefixed by its length so that the fields of
+/// different keys cannot run together
+void appendField(std::string &key, const std::string &field) {
+  key += std::to_string(field.size());
+  key += ':';
+  key += field;
+}
+} // namespace
+
+/// Constructor
+AlgorithmResultCacheImpl::AlgorithmResultCacheImpl()
+    : m_memorySize(0), m_memoryLimit(0) {
+  double limitInMB = 0.0;
+  Kernel::ConfigService::Instance().getValue("algorithms.cache.memory",
+                                             limitInMB);
+  if (limitInMB > 0.0) {
+    m_memoryLimit = static_cast<size_t>(limitInMB * 1024.0 * 1024.0);
+  }
+}
+
+/// @return true if results are cached
+bool AlgorithmResultCacheImpl::isEnabled() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memoryLimit > 0;
+}
+
+/**
+ * Set the maximum memory size of the cached workspaces. The least recently
+ * used results are removed if they don't fit.
+ * @param bytes :: The limit in bytes. 0 disables the cache.
+ */
+void AlgorithmResultCacheImpl::setMemoryLimit(size_t bytes) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_memoryLimit = bytes;
+  if (m_memoryLimit == 0) {
+    m_entries.clear();
+    m_index.clear();
+    m_memorySize = 0;
+  } else {
+    evict(m_memoryLimit);
+  }
+}
+
+/// @return The maximum memory size of the cached workspaces in bytes
+size_t AlgorithmResultCacheImpl::memoryLimit() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memoryLimit;
+}
+
+/// @return The memory size of the cached workspaces in bytes
+size_t AlgorithmResultCacheImpl::memorySize() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memorySize;
+}
+
+/// @return The number of cached results
+size_t AlgorithmResultCacheImpl::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+/// Remove all the results
+void AlgorithmResultCacheImpl::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+  m_index.clear();
+  m_memorySize = 0;
+}
+
+/**
+ * Create the key of the current inputs of an algorithm.
+ * @param alg :: An algorithm whose properties have been set
+ * @return The key, or an empty string if the inputs cannot be keyed
+ */
+std::string
+AlgorithmResultCacheImpl::createKey(const Algorithm &alg) const {
+  std::string key;
+  appendField(key, alg.name());
+  appendField(key, std::to_string(alg.version()));
+  for (const auto *prop : alg.getProperties()) {
+    const auto *wsProp = dynamic_cast<const IWorkspaceProperty *>(prop);
+    if (!wsProp) {
+      if (prop->direction() != Kernel::Direction::Output) {
+        appendField(key, prop->name());
+        appendField(key, prop->value());
+      }
+      continue;
+    }
+    if (prop->direction() == Kernel::Direction::InOut) {
+      return "";
+    }
+    if (prop->direction() != Kernel::Direction::Input) {
+      continue;
+    }
+    appendField(key, prop->name());
+    auto ws = wsProp->getWorkspace();
+    if (!ws) {
+      appendField(key, "");
+      continue;
+    }
+    auto matrixWS = boost::dynamic_pointer_cast<const MatrixWorkspace>(ws);
+    if (!matrixWS) {
+      return "";
+    }
+    std::ostringstream hash;
+    hash << std::hex << matrixWS->contentHash();
+    appendField(key, hash.str());
+  }
+  return key;
+}
+
+/**
+ * Record the current outputs of an algorithm. Nothing is recorded if the
+ * output workspaces are larger than the memory limit.
+ * @param key :: The key of the inputs the outputs were calculated from
+ * @param alg :: An algorithm that has been executed
+ */
+void AlgorithmResultCacheImpl::insert(const std::string &key,
+                                      const Algorithm &alg) {
+  Entry entry;
+  entry.key = key;
+  entry.memorySize = 0;
+  try {
+    for (const auto *prop : alg.getProperties()) {
+      if (prop->direction() == Kernel::Direction::Input) {
+        continue;
+      }
+      const auto *wsProp = dynamic_cast<const IWorkspaceProperty *>(prop);
+      if (!wsProp) {
+        entry.result.values.emplace_back(prop->name(), prop->value());
+        continue;
+      }
+      auto ws = wsProp->getWorkspace();
+      if (ws) {
+        Workspace_sptr copy(ws->clone());
+        entry.memorySize += copy->getMemorySize();
+        entry.result.workspaces.emplace_back(prop->name(), copy);
+      }
+    }
+  } catch (std::exception &e) {
+    g_log.debug() << "Cannot cache the outputs of " << alg.name() << ": "
+                  << e.what() << '\n';
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (entry.memorySize > m_memoryLimit) {
+    g_log.debug() << "The outputs of " << alg.name()
+                  << " are too large to cache\n";
+    return;
+  }
+  auto existing = m_index.find(key);
+  if (existing != m_index.end()) {
+    m_memorySize -= existing->second->memorySize;
+    m_entries.erase(existing->second);
+    m_index.erase(existing);
+  }
+  evict(m_memoryLimit - entry.memorySize);
+  m_memorySize += entry.memorySize;
+  m_entries.push_front(std::move(entry));
+  m_index[key] = m_entries.begin();
+}
+
+/**
+ * Set the outputs recorded for a key to an algorithm. The algorithm gets new
+ * copies of the recorded workspaces.
+ * @param key :: The key of the current inputs of the algorithm
+ * @param alg :: The algorithm to set the outputs of
+ * @return true if outputs were recorded for the key
+ */
+bool AlgorithmResultCacheImpl::restore(const std::string &key,
+                                       Algorithm &alg) {
+  Result result;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_index.find(key);
+    if (found == m_index.end()) {
+      return false;
+    }
+    // Move the result to the front of the list
+    m_entries.splice(m_entries.begin(), m_entries, found->second);
+    result = found->second->result;
+  }
+  for (const auto &output : result.workspaces) {
+    Workspace_sptr copy(output.second->clone());
+    alg.setProperty(output.first, copy);
+  }
+  for (const auto &output : result.values) {
+    alg.setPropertyValue(output.first, output.second);
+  }
+  g_log.debug() << "Reused the result of a previous execution of "
+                << alg.name() << '\n';
+  return true;
+}
+
+/**
+ * Remove the least recently used results until the memory size of the
+ * remaining ones is at most the given limit.
+ * @param limit :: The memory size to reduce the results to in bytes
+ */
+void AlgorithmResultCacheImpl::evict(size_t limit) {
+  while (!m_entries.empty() && m_memorySize > limit) {
+    const auto &entry = m_entries.back();
+    m_memorySize -= entry.memorySize;
+    m_index.erase(entry.key);
+    m_entries.pop_back();
+  }
+}
+
+} // namespace API
+} // namespace Mantid
@@ -1,6 +1,8 @@
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/WorkspaceGroup.h"
+#include <set>
 #include <sstream>
+#include <unordered_set>
 
 namespace Mantid {
 namespace API {
@@ -74,23 +76,8 @@ void AnalysisDataServiceImpl::add(
 
   // if a group is added add its members as well
   auto group = boost::dynamic_pointer_cast<WorkspaceGroup>(workspace);
-  if (!group)
-    return;
-  group->observeADSNotifications(true);
-  for (size_t i = 0; i < group->size(); ++i) {
-    auto ws = group->getItem(i);
-    std::string wsName = ws->getName();
-    // if anonymous make up a name and add
-    if (wsName.empty()) {
-      wsName = name + "_" + std::to_string(i + 1);
-    } else if (doesExist(wsName)) { // if ws is already there do nothing
-      wsName.clear();
-    }
-    // add member workspace if needed
-    if (!wsName.empty()) {
-      add(wsName, ws);
-    }
-  }
+  if (group)
+    addGroupMembers(name, *group);
 }
 
 /**
@@ -164,6 +151,52 @@ void AnalysisDataServiceImpl::remove(const std::string &name) {
   }
 }
 
+/**
+ * Overridden addObjects member to attach the names to the workspaces. Either
+ * all of the workspaces, including the members of groups that are not in the
+ * ADS yet, are added or none are. The notifications for all of the workspaces
+ * are sent at the end.
+ * @param workspaces Pairs of names and the shared pointers to the workspaces
+ */
+void AnalysisDataServiceImpl::addObjects(
+    const std::vector<std::pair<std::string, Workspace_sptr>> &workspaces) {
+  auto objects = workspaces;
+  ListedNames listedNames;
+  ListedWorkspaces listedWorkspaces;
+  for (const auto &item : workspaces) {
+    listedNames.insert(item.first);
+    listedWorkspaces.insert(item.second.get());
+  }
+  for (const auto &item : workspaces) {
+    if (auto group = boost::dynamic_pointer_cast<WorkspaceGroup>(item.second))
+      listGroupMembers(item.first, *group, objects, listedNames,
+                       listedWorkspaces);
+  }
+  addListed(objects);
+}
+
+/**
+ * Overridden removeObjects member to delete the names held by the workspaces
+ * themselves.
+ * @param names The names of the workspaces to remove.
+ */
+void AnalysisDataServiceImpl::removeObjects(
+    const std::vector<std::string> &names) {
+  std::vector<Workspace_sptr> workspaces;
+  workspaces.reserve(names.size());
+  for (const auto &name : names) {
+    try {
+      workspaces.push_back(retrieve(name));
+    } catch (const Kernel::Exception::NotFoundError &) {
+      // do nothing - removeObjects will do what's needed
+    }
+  }
+  Kernel::DataService<API::Workspace>::removeObjects(names);
+  for (const auto &ws : workspaces) {
+    ws->setName("");
+  }
+}
+
 /**
  * Sort members by Workspace name. The group must be in the ADS.
  * @param groupName :: A group name.
@@ -175,7 +208,7 @@ void AnalysisDataServiceImpl::sortGroupByName(const std::string &groupName) {
                              " is not a workspace group.");
   }
   group->sortMembersByName();
-  notificationCenter.postNotification(new GroupUpdatedNotification(groupName));
+  postNotification(new GroupUpdatedNotification(groupName));
 }
 
 /**
@@ -192,7 +225,7 @@ void AnalysisDataServiceImpl::addToGroup(const std::string &groupName,
   }
   auto ws = retrieve(wsName);
   group->addWorkspace(ws);
-  notificationCenter.postNotification(new GroupUpdatedNotification(groupName));
+  postNotification(new GroupUpdatedNotification(groupName));
 }
 
 /**
@@ -205,18 +238,10 @@ void AnalysisDataServiceImpl::deepRemoveGroup(const std::string &name) {
     throw std::runtime_error("Workspace " + name +
                              " is not a workspace group.");
   }
-  group->observeADSNotifications(false);
-  for (size_t i = 0; i < group->size(); ++i) {
-    auto ws = group->getItem(i);
-    WorkspaceGroup_sptr gws = boost::dynamic_pointer_cast<WorkspaceGroup>(ws);
-    if (gws) {
-      // if a member is a group remove its items as well
-      deepRemoveGroup(gws->getName());
-    } else {
-      remove(ws->getName());
-    }
-  }
-  remove(name);
+  std::vector<std::string> names;
+  collectGroupNames(*group, names);
+  names.back() = name;
+  removeObjects(names);
 }
 
 /**
@@ -237,7 +262,7 @@ void AnalysisDataServiceImpl::removeFromGroup(const std::string &groupName,
                              " does not containt workspace " + wsName);
   }
   group->removeByADS(wsName);
-  notificationCenter.postNotification(new GroupUpdatedNotification(groupName));
+  postNotification(new GroupUpdatedNotification(groupName));
 }
 
 /**
@@ -312,6 +337,95 @@ void AnalysisDataServiceImpl::setIllegalCharacterList(
   m_illegalChars = illegalChars;
 }
 
+/**
+ * Adds the members of a group that are not in the ADS yet. Anonymous members
+ * are named after the group.
+ * @param name The name of the group
+ * @param group The group
+ */
+void AnalysisDataServiceImpl::addGroupMembers(const std::string &name,
+                                              WorkspaceGroup &group) {
+  std::vector<std::pair<std::string, Workspace_sptr>> objects;
+  ListedNames listedNames{name};
+  ListedWorkspaces listedWorkspaces{&group};
+  listGroupMembers(name, group, objects, listedNames, listedWorkspaces);
+  group.observeADSNotifications(true);
+  addListed(objects);
+}
+
+/**
+ * List the members of a group and its subgroups that are not in the ADS yet
+ * and have not been listed already. Anonymous members are named after the
+ * group; if that name is taken adding the list fails.
+ * @param name The name of the group
+ * @param group The group
+ * @param objects The list to append the names and members to
+ * @param listedNames The names already in the list
+ * @param listedWorkspaces The workspaces already in the list
+ */
+void AnalysisDataServiceImpl::listGroupMembers(
+    const std::string &name, WorkspaceGroup &group,
+    std::vector<std::pair<std::string, Workspace_sptr>> &objects,
+    ListedNames &listedNames, ListedWorkspaces &listedWorkspaces) const {
+  for (size_t i = 0; i < group.size(); ++i) {
+    auto ws = group.getItem(i);
+    // a member in several groups is only added once
+    if (!listedWorkspaces.insert(ws.get()).second)
+      continue;
+    std::string wsName = ws->getName();
+    if (wsName.empty()) { // if anonymous make up a name
+      wsName = name + "_" + std::to_string(i + 1);
+      listedNames.insert(wsName);
+    } else if (doesExist(wsName) || !listedNames.insert(wsName).second) {
+      continue; // if ws is already there do nothing
+    }
+    objects.emplace_back(wsName, ws);
+    if (auto gws = boost::dynamic_pointer_cast<WorkspaceGroup>(ws))
+      listGroupMembers(wsName, *gws, objects, listedNames, listedWorkspaces);
+  }
+}
+
+/**
+ * Add a list of workspaces in one go and attach their names to them. Groups
+ * in the list start observing the ADS.
+ * @param objects Pairs of names and the shared pointers to the workspaces
+ */
+void AnalysisDataServiceImpl::addListed(
+    const std::vector<std::pair<std::string, Workspace_sptr>> &objects) {
+  if (objects.empty())
+    return;
+  for (const auto &item : objects) {
+    verifyName(item.first);
+  }
+  NotificationBatch batch(*this);
+  Kernel::DataService<API::Workspace>::addObjects(objects);
+  for (const auto &item : objects) {
+    item.second->setName(item.first);
+    if (auto group = boost::dynamic_pointer_cast<WorkspaceGroup>(item.second))
+      group->observeADSNotifications(true);
+  }
+}
+
+/**
+ * Stop a group and the groups in it observing the ADS and list the names of
+ * their members, each group following its members.
+ * @param group A group
+ * @param names The list to append the names to
+ */
+void AnalysisDataServiceImpl::collectGroupNames(
+    WorkspaceGroup &group, std::vector<std::string> &names) {
+  group.observeADSNotifications(false);
+  for (size_t i = 0; i < group.size(); ++i) {
+    auto ws = group.getItem(i);
+    // if a member is a group remove its items as well
+    if (auto gws = boost::dynamic_pointer_cast<WorkspaceGroup>(ws))
+      collectGroupNames(*gws, names);
+    else
+      names.push_back(ws->getName());
+  }
+  names.push_back(group.getName());
+}
+
 /**
  * Checks the name is valid
  * @param name A string containing the name to check. If the name is invalid a
@@ -0,0 +1,641 @@
+#include "MantidAPI/CompiledExpression.h"
+#include "MantidAPI/Expression.h"
+
+#include <gsl/gsl_sf_erf.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+namespace Mantid {
+namespace API {
+
+namespace {
+/// Operations of the expression tree
+enum class Op {
+  Constant,
+  Variable,
+  Parameter,
+  Add,
+  Subtract,
+  Multiply,
+  Divide,
+  Power,
+  Negate,
+  Sin,
+  Cos,
+  Tan,
+  Asin,
+  Acos,
+  Atan,
+  Sinh,
+  Cosh,
+  Tanh,
+  Exp,
+  Log,
+  Log10,
+  Sqrt,
+  Abs,
+  Sign,
+  Erf,
+  Erfc
+};
+
+/// Functions of one argument known to the compiler (same names as muParser)
+const std::map<std::string, Op> FUNCTIONS = {
+    {"sin", Op::Sin},     {"cos", Op::Cos},     {"tan", Op::Tan},
+    {"asin", Op::Asin},   {"acos", Op::Acos},   {"atan", Op::Atan},
+    {"sinh", Op::Sinh},   {"cosh", Op::Cosh},   {"tanh", Op::Tanh},
+    {"exp", Op::Exp},     {"ln", Op::Log},      {"log", Op::Log},
+    {"log10", Op::Log10}, {"sqrt", Op::Sqrt},   {"abs", Op::Abs},
+    {"sign", Op::Sign},   {"erf", Op::Erf},     {"erfc", Op::Erfc}};
+
+/// Number of variable values evaluated together. Keeps the intermediate
+/// buffers small enough to stay in the cache.
+const size_t CHUNK_SIZE = 256;
+} // namespace
+
+/// A node of the expression tree
+struct CompiledExpression::Node {
+  Node(Op o, double v, size_t i, std::vector<NodePtr> a)
+      : op(o), value(v), index(i), args(std::move(a)),
+        dependsOnVariable(o == Op::Variable) {
+    for (auto &arg : args) {
+      dependsOnVariable = dependsOnVariable || arg->dependsOnVariable;
+    }
+  }
+  /// The operation
+  Op op;
+  /// The value of a constant
+  double value;
+  /// The index of a parameter
+  size_t index;
+  /// The arguments of an operation
+  std::vector<NodePtr> args;
+  /// True if the value of this node changes with the variable
+  bool dependsOnVariable;
+};
+
+namespace {
+using Node = CompiledExpression::Node;
+using NodePtr = CompiledExpression::NodePtr;
+
+NodePtr constant(double value) {
+  return std::make_shared<Node>(Op::Constant, value, 0, std::vector<NodePtr>());
+}
+
+bool isConstant(const NodePtr &node, double value) {
+  return node->op == Op::Constant && node->value == value;
+}
+
+double muParserSign(double v) { return v > 0.0 ? 1.0 : (v < 0.0 ? -1.0 : 0.0); }
+
+/// Evaluate a function of one argument
+double function(Op op, double v) {
+  switch (op) {
+  case Op::Negate:
+    return -v;
+  case Op::Sin:
+    return std::sin(v);
+  case Op::Cos:
+    return std::cos(v);
+  case Op::Tan:
+    return std::tan(v);
+  case Op::Asin:
+    return std::asin(v);
+  case Op::Acos:
+    return std::acos(v);
+  case Op::Atan:
+    return std::atan(v);
+  case Op::Sinh:
+    return std::sinh(v);
+  case Op::Cosh:
+    return std::cosh(v);
+  case Op::Tanh:
+    return std::tanh(v);
+  case Op::Exp:
+    return std::exp(v);
+  case Op::Log:
+    return std::log(v);
+  case Op::Log10:
+    return std::log10(v);
+  case Op::Sqrt:
+    return std::sqrt(v);
+  case Op::Abs:
+    return std::fabs(v);
+  case Op::Sign:
+    return muParserSign(v);
+  case Op::Erf:
+    return gsl_sf_erf(v);
+  case Op::Erfc:
+    return gsl_sf_erfc(v);
+  default:
+    throw std::logic_error("CompiledExpression: not a function.");
+  }
+}
+
+/// Evaluate a binary operator
+double binary(Op op, double a, double b) {
+  switch (op) {
+  case Op::Add:
+    return a + b;
+  case Op::Subtract:
+    return a - b;
+  case Op::Multiply:
+    return a * b;
+  case Op::Divide:
+    return a / b;
+  case Op::Power:
+    return std::pow(a, b);
+  default:
+    throw std::logic_error("CompiledExpression: not a binary operator.");
+  }
+}
+
+/// Evaluate a node which doesn't depend on the variable
+double evaluateScalar(const Node &node, const double *parameters) {
+  switch (node.op) {
+  case Op::Constant:
+    return node.value;
+  case Op::Parameter:
+    return parameters[node.index];
+  case Op::Variable:
+    throw std::logic_error("CompiledExpression: node depends on variable.");
+  case Op::Add:
+  case Op::Subtract:
+  case Op::Multiply:
+  case Op::Divide:
+  case Op::Power:
+    return binary(node.op, evaluateScalar(*node.args[0], parameters),
+                  evaluateScalar(*node.args[1], parameters));
+  default:
+    return function(node.op, evaluateScalar(*node.args[0], parameters));
+  }
+}
+
+/// Apply a unary operation to each element of an array in place
+template <typename F> void transform(double *out, size_t n, F f) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = f(out[i]);
+  }
+}
+
+/// Apply a unary operation of the given kind to an array in place. The
+/// operation is selected once per array, not once per element.
+void applyFunction(Op op, double *out, size_t n) {
+  switch (op) {
+  case Op::Negate:
+    transform(out, n, [](double v) { return -v; });
+    break;
+  case Op::Sin:
+    transform(out, n, [](double v) { return std::sin(v); });
+    break;
+  case Op::Cos:
+    transform(out, n, [](double v) { return std::cos(v); });
+    break;
+  case Op::Exp:
+    transform(out, n, [](double v) { return std::exp(v); });
+    break;
+  case Op::Sqrt:
+    transform(out, n, [](double v) { return std::sqrt(v); });
+    break;
+  default:
+    transform(out, n, [op](double v) { return function(op, v); });
+  }
+}
+
+/// Combine an array with a scalar or another array
+template <typename F>
+void combine(double *out, size_t n, const double *a, double aScalar,
+             const double *b, double bScalar, F f) {
+  if (!a) {
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = f(aScalar, b[i]);
+    }
+  } else if (!b) {
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = f(a[i], bScalar);
+    }
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = f(a[i], b[i]);
+    }
+  }
+}
+
+/// Apply a binary operator. Either a or b (but not both) can be null in
+/// which case the corresponding scalar is used.
+void applyBinary(Op op, double *out, size_t n, const double *a,
+                 double aScalar, const double *b, double bScalar) {
+  switch (op) {
+  case Op::Add:
+    combine(out, n, a, aScalar, b, bScalar,
+            [](double u, double v) { return u + v; });
+    break;
+  case Op::Subtract:
+    combine(out, n, a, aScalar, b, bScalar,
+            [](double u, double v) { return u - v; });
+    break;
+  case Op::Multiply:
+    combine(out, n, a, aScalar, b, bScalar,
+            [](double u, double v) { return u * v; });
+    break;
+  case Op::Divide:
+    combine(out, n, a, aScalar, b, bScalar,
+            [](double u, double v) { return u / v; });
+    break;
+  case Op::Power:
+    if (!b && bScalar == 2.0) {
+      combine(out, n, a, aScalar, b, bScalar,
+              [](double u, double) { return u * u; });
+    } else {
+      combine(out, n, a, aScalar, b, bScalar,
+              [](double u, double v) { return std::pow(u, v); });
+    }
+    break;
+  default:
+    throw std::logic_error("CompiledExpression: not a binary operator.");
+  }
+}
+
+/// The number of levels of a tree
+size_t treeDepth(const Node &node) {
+  size_t depth = 0;
+  for (auto &arg : node.args) {
+    depth = std::max(depth, treeDepth(*arg));
+  }
+  return depth + 1;
+}
+
+/// Evaluate a node for a chunk of variable values.
+/// @param node :: The node to evaluate.
+/// @param x :: The variable values.
+/// @param n :: The number of values, not more than CHUNK_SIZE.
+/// @param parameters :: The parameter values.
+/// @param out :: The output buffer.
+/// @param scratch :: Buffers for intermediate results, one per tree level.
+/// @param depth :: The current tree level.
+void evaluateChunk(const Node &node, const double *x, size_t n,
+                   const double *parameters, double *out,
+                   std::vector<std::vector<double>> &scratch, size_t depth) {
+  if (!node.dependsOnVariable) {
+    std::fill(out, out + n, evaluateScalar(node, parameters));
+    return;
+  }
+  switch (node.op) {
+  case Op::Variable:
+    std::copy(x, x + n, out);
+    return;
+  case Op::Add:
+  case Op::Subtract:
+  case Op::Multiply:
+  case Op::Divide:
+  case Op::Power: {
+    const Node &a = *node.args[0];
+    const Node &b = *node.args[1];
+    if (!a.dependsOnVariable) {
+      evaluateChunk(b, x, n, parameters, out, scratch, depth);
+      applyBinary(node.op, out, n, nullptr, evaluateScalar(a, parameters),
+                  out, 0.0);
+    } else if (!b.dependsOnVariable) {
+      evaluateChunk(a, x, n, parameters, out, scratch, depth);
+      applyBinary(node.op, out, n, out, 0.0, nullptr,
+                  evaluateScalar(b, parameters));
+    } else {
+      evaluateChunk(a, x, n, parameters, out, scratch, depth + 1);
+      evaluateChunk(b, x, n, parameters, scratch[depth].data(), scratch,
+                    depth + 1);
+      applyBinary(node.op, out, n, out, 0.0, scratch[depth].data(), 0.0);
+    }
+    return;
+  }
+  default:
+    evaluateChunk(*node.args[0], x, n, parameters, out, scratch, depth);
+    applyFunction(node.op, out, n);
+  }
+}
+
+//----------------------------------------------------------------------
+// Construction of the trees with simple constant folding.
+//----------------------------------------------------------------------
+
+NodePtr makeNode(Op op, std::vector<NodePtr> args) {
+  bool allConstant = std::all_of(
+      args.begin(), args.end(),
+      [](const NodePtr &arg) { return arg->op == Op::Constant; });
+  auto node = std::make_shared<Node>(op, 0.0, 0, std::move(args));
+  if (allConstant) {
+    return constant(evaluateScalar(*node, nullptr));
+  }
+  return node;
+}
+
+NodePtr func(Op op, const NodePtr &a) { return makeNode(op, {a}); }
+
+NodePtr neg(const NodePtr &a) {
+  if (a->op == Op::Negate) {
+    return a->args[0];
+  }
+  return makeNode(Op::Negate, {a});
+}
+
+NodePtr add(const NodePtr &a, const NodePtr &b) {
+  if (isConstant(a, 0.0)) {
+    return b;
+  }
+  if (isConstant(b, 0.0)) {
+    return a;
+  }
+  return makeNode(Op::Add, {a, b});
+}
+
+NodePtr sub(const NodePtr &a, const NodePtr &b) {
+  if (isConstant(b, 0.0)) {
+    return a;
+  }
+  if (isConstant(a, 0.0)) {
+    return neg(b);
+  }
+  return makeNode(Op::Subtract, {a, b});
+}
+
+NodePtr mul(const NodePtr &a, const NodePtr &b) {
+  if (isConstant(a, 0.0) || isConstant(b, 0.0)) {
+    return constant(0.0);
+  }
+  if (isConstant(a, 1.0)) {
+    return b;
+  }
+  if (isConstant(b, 1.0)) {
+    return a;
+  }
+  return makeNode(Op::Multiply, {a, b});
+}
+
+NodePtr divide(const NodePtr &a, const NodePtr &b) {
+  if (isConstant(a, 0.0)) {
+    return constant(0.0);
+  }
+  if (isConstant(b, 1.0)) {
+    return a;
+  }
+  return makeNode(Op::Divide, {a, b});
+}
+
+NodePtr power(const NodePtr &a, const NodePtr &b) {
+  if (isConstant(b, 1.0)) {
+    return a;
+  }
+  return makeNode(Op::Power, {a, b});
+}
+
+/// Check if a tree contains a parameter
+bool refersTo(const Node &node, size_t iParam) {
+  if (node.op == Op::Parameter) {
+    return node.index == iParam;
+  }
+  return std::any_of(node.args.begin(), node.args.end(),
+                     [iParam](const NodePtr &arg) {
+                       return refersTo(*arg, iParam);
+                     });
+}
+
+/// Differentiate a tree with respect to a parameter
+NodePtr differentiate(const NodePtr &node, size_t iParam) {
+  if (!refersTo(*node, iParam)) {
+    return constant(0.0);
+  }
+  if (node->op == Op::Parameter) {
+    return constant(1.0);
+  }
+  const NodePtr &a = node->args[0];
+  NodePtr da = differentiate(a, iParam);
+  switch (node->op) {
+  case Op::Add:
+    return add(da, differentiate(node->args[1], iParam));
+  case Op::Subtract:
+    return sub(da, differentiate(node->args[1], iParam));
+  case Op::Multiply: {
+    const NodePtr &b = node->args[1];
+    return add(mul(da, b), mul(a, differentiate(b, iParam)));
+  }
+  case Op::Divide: {
+    const NodePtr &b = node->args[1];
+    if (!refersTo(*b, iParam)) {
+      return divide(da, b);
+    }
+    return sub(divide(da, b),
+               divide(mul(a, differentiate(b, iParam)), mul(b, b)));
+  }
+  case Op::Power: {
+    const NodePtr &b = node->args[1];
+    if (!refersTo(*b, iParam)) {
+      return mul(mul(b, power(a, sub(b, constant(1.0)))), da);
+    }
+    return mul(node, add(mul(differentiate(b, iParam), func(Op::Log, a)),
+                         divide(mul(b, da), a)));
+  }
+  case Op::Negate:
+    return neg(da);
+  case Op::Sin:
+    return mul(func(Op::Cos, a), da);
+  case Op::Cos:
+    return neg(mul(func(Op::Sin, a), da));
+  case Op::Tan: {
+    auto c = func(Op::Cos, a);
+    return divide(da, mul(c, c));
+  }
+  case Op::Asin:
+    return divide(da, func(Op::Sqrt, sub(constant(1.0), mul(a, a))));
+  case Op::Acos:
+    return neg(divide(da, func(Op::Sqrt, sub(constant(1.0), mul(a, a)))));
+  case Op::Atan:
+    return divide(da, add(constant(1.0), mul(a, a)));
+  case Op::Sinh:
+    return mul(func(Op::Cosh, a), da);
+  case Op::Cosh:
+    return mul(func(Op::Sinh, a), da);
+  case Op::Tanh:
+    return mul(sub(constant(1.0), mul(node, node)), da);
+  case Op::Exp:
+    return mul(node, da);
+  case Op::Log:
+    return divide(da, a);
+  case Op::Log10:
+    return divide(da, mul(a, constant(std::log(10.0))));
+  case Op::Sqrt:
+    return divide(da, mul(constant(2.0), node));
+  case Op::Abs:
+    return mul(func(Op::Sign, a), da);
+  case Op::Sign:
+    return constant(0.0);
+  case Op::Erf:
+  case Op::Erfc: {
+    auto d = mul(mul(constant(2.0 / std::sqrt(M_PI)),
+                     func(Op::Exp, neg(mul(a, a)))),
+                 da);
+    return node->op == Op::Erf ? d : neg(d);
+  }
+  default:
+    throw std::logic_error("CompiledExpression: cannot differentiate.");
+  }
+}
+} // namespace
+
+/**
+ * Compile a formula.
+ * @param formula :: The formula in muParser syntax.
+ * @param variable :: The name of the array variable.
+ * @param parameters :: The names of the parameters. Their order defines the
+ *   order of the values passed to evaluate() and derivative().
+ * @throw std::invalid_argument if the formula uses syntax that isn't
+ *   supported.
+ */
+CompiledExpression::CompiledExpression(
+    const std::string &formula, const std::string &variable,
+    const std::vector<std::string> &parameters) {
+  Expression expr;
+  try {
+    expr.parse(formula);
+  } catch (Expression::ParsingError &e) {
+    throw std::invalid_argument(e.what());
+  }
+  m_root = build(expr, variable, parameters);
+  m_derivatives.reserve(parameters.size());
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    m_derivatives.push_back(differentiate(m_root, i));
+  }
+}
+
+/**
+ * Build the tree of an expression.
+ * @param expr :: A parsed expression.
+ * @param variable :: The name of the array variable.
+ * @param parameters :: The names of the parameters.
+ */
+CompiledExpression::NodePtr
+CompiledExpression::build(const Expression &expr, const std::string &variable,
+                          const std::vector<std::string> &parameters) {
+  const Expression &e = expr.bracketsRemoved();
+  const std::string name = e.name();
+
+  if (!e.isFunct()) {
+    if (name == variable) {
+      return std::make_shared<Node>(Op::Variable, 0.0, 0,
+                                    std::vector<NodePtr>());
+    }
+    auto it = std::find(parameters.begin(), parameters.end(), name);
+    if (it != parameters.end()) {
+      return std::make_shared<Node>(
+          Op::Parameter, 0.0, static_cast<size_t>(it - parameters.begin()),
+          std::vector<NodePtr>());
+    }
+    if (name == "_pi") {
+      return constant(M_PI);
+    }
+    if (name == "_e") {
+      return constant(M_E);
+    }
+    try {
+      size_t end = 0;
+      double value = std::stod(name, &end);
+      if (end == name.size()) {
+        return constant(value);
+      }
+    } catch (std::logic_error &) {
+      // not a number
+    }
+    throw std::invalid_argument("Unknown name " + name + " in formula.");
+  }
+
+  if (e.size() == 1 && (name == "-" || name == "+")) {
+    auto arg = build(e[0], variable, parameters);
+    return name == "-" ? neg(arg) : arg;
+  }
+
+  if (name == "+" || name == "*") {
+    NodePtr result = build(e[0], variable, parameters);
+    for (size_t i = 1; i < e.size(); ++i) {
+      auto term = build(e[i], variable, parameters);
+      const std::string op = e[i].operator_name();
+      if (op == "+") {
+        result = makeNode(Op::Add, {result, term});
+      } else if (op == "-") {
+        result = makeNode(Op::Subtract, {result, term});
+      } else if (op == "*") {
+        result = makeNode(Op::Multiply, {result, term});
+      } else {
+        result = makeNode(Op::Divide, {result, term});
+      }
+    }
+    return result;
+  }
+
+  if (name == "^") {
+    if (e.size() != 2) {
+      throw std::invalid_argument("Chained ^ operators are not supported.");
+    }
+    return makeNode(Op::Power, {build(e[0], variable, parameters),
+                                build(e[1], variable, parameters)});
+  }
+
+  auto known = FUNCTIONS.find(name);
+  if (known != FUNCTIONS.end() && e.size() == 1) {
+    return makeNode(known->second, {build(e[0], variable, parameters)});
+  }
+  throw std::invalid_argument("Unsupported operation " + name + " in formula.");
+}
+
+/**
+ * Evaluate a tree for an array of variable values.
+ * @param root :: The root of the tree.
+ * @param x :: The variable values.
+ * @param n :: The number of values.
+ * @param parameters :: The parameter values.
+ * @param out :: The output buffer of size n.
+ */
+void CompiledExpression::evaluateTree(const Node &root, const double *x,
+                                      size_t n, const double *parameters,
+                                      double *out) {
+  if (!root.dependsOnVariable) {
+    std::fill(out, out + n, evaluateScalar(root, parameters));
+    return;
+  }
+  std::vector<std::vector<double>> scratch(treeDepth(root),
+                                           std::vector<double>(CHUNK_SIZE));
+  for (size_t start = 0; start < n; start += CHUNK_SIZE) {
+    const size_t size = std::min(CHUNK_SIZE, n - start);
+    evaluateChunk(root, x + start, size, parameters, out + start, scratch, 0);
+  }
+}
+
+/**
+ * Evaluate the formula.
+ * @param x :: The variable values.
+ * @param n :: The number of values.
+ * @param parameters :: The parameter values, nParams() of them.
+ * @param out :: The output buffer of size n.
+ */
+void CompiledExpression::evaluate(const double *x, size_t n,
+                                  const double *parameters,
+                                  double *out) const {
+  evaluateTree(*m_root, x, n, parameters, out);
+}
+
+/**
+ * Evaluate the derivative of the formula with respect to a parameter.
+ * @param iParam :: The index of the parameter.
+ * @param x :: The variable values.
+ * @param n :: The number of values.
+ * @param parameters :: The parameter values, nParams() of them.
+ * @param out :: The output buffer of size n.
+ */
+void CompiledExpression::derivative(size_t iParam, const double *x, size_t n,
+                                    const double *parameters,
+                                    double *out) const {
+  evaluateTree(*m_derivatives.at(iParam), x, n, parameters, out);
+}
+
+} // namespace API
+} // namespace Mantid
@@ -5,6 +5,8 @@
 #include "MantidAPI/ParameterTie.h"
 #include "MantidAPI/IConstraint.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/IPeakFunction.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
 
@@ -12,6 +14,7 @@
 #include <boost/shared_array.hpp>
 #include <sstream>
 #include <algorithm>
+#include <memory>
 
 namespace Mantid {
 namespace API {
@@ -19,6 +22,75 @@ namespace API {
 namespace {
 /// static logger
 Kernel::Logger g_log("CompositeFunction");
+
+/**
+ * Get the domain as a 1D domain if peaks can be evaluated on parts of it:
+ * its arguments must be sorted. Histogram domains are excluded.
+ * @param domain :: A domain passed to a composite function.
+ * @return A pointer to the 1D domain or null.
+ */
+const FunctionDomain1D *getSortedDomain1D(const FunctionDomain &domain) {
+  if (dynamic_cast<const FunctionDomain1DHistogram *>(&domain)) {
+    return nullptr;
+  }
+  auto domain1D = dynamic_cast<const FunctionDomain1D *>(&domain);
+  if (!domain1D || domain1D->size() == 0) {
+    return nullptr;
+  }
+  const double *begin = domain1D->getPointerAt(0);
+  if (!std::is_sorted(begin, begin + domain1D->size())) {
+    return nullptr;
+  }
+  return domain1D;
+}
+
+/**
+ * Find the range of indices of a sorted domain where a member function can
+ * be non-zero.
+ * @param fun :: A member of a composite function.
+ * @param domain :: A sorted 1D domain.
+ * @param start :: Set to the index of the first point of the range.
+ * @param n :: Set to the number of points in the range.
+ * @return true if the function is a peak and the range doesn't cover the
+ *  whole domain.
+ */
+bool getSupportRange(const IFunction &fun, const FunctionDomain1D &domain,
+                     size_t &start, size_t &n) {
+  auto peak = dynamic_cast<const IPeakFunction *>(&fun);
+  if (!peak) {
+    return false;
+  }
+  auto interval = peak->getSupportInterval(domain.getPeakRadius());
+  const double *begin = domain.getPointerAt(0);
+  const double *end = begin + domain.size();
+  auto lb = std::lower_bound(begin, end, interval.first);
+  auto ub = std::upper_bound(lb, end, interval.second);
+  start = static_cast<size_t>(std::distance(begin, lb));
+  n = static_cast<size_t>(std::distance(lb, ub));
+  return n < domain.size();
+}
+
+/**
+ * Create a domain from a range of points of a 1D domain. The peak radius and
+ * the workspace index of a spectrum are kept.
+ * @param domain :: A 1D domain.
+ * @param start :: The index of the first point of the range.
+ * @param n :: The number of points in the range.
+ */
+std::unique_ptr<FunctionDomain1D>
+createSubDomain(const FunctionDomain1D &domain, size_t start, size_t n) {
+  std::unique_ptr<FunctionDomain1D> subDomain;
+  const double *x = domain.getPointerAt(start);
+  auto spectrum = dynamic_cast<const FunctionDomain1DSpectrum *>(&domain);
+  if (spectrum) {
+    subDomain.reset(new FunctionDomain1DSpectrum(
+        spectrum->getWorkspaceIndex(), std::vector<double>(x, x + n)));
+  } else {
+    subDomain.reset(new FunctionDomain1DView(x, n));
+  }
+  subDomain->setPeakRadius(domain.getPeakRadius());
+  return subDomain;
+}
 }
 
 using std::size_t;
@@ -137,7 +209,9 @@ void CompositeFunction::setMatrixWorkspace(
   }
 }
 
-/** Function you want to fit to.
+/** Function you want to fit to. Peak functions on a sorted 1D domain are
+ *  evaluated only on the part of the domain where they can be non-zero (see
+ *  IPeakFunction::getSupportInterval()).
  *  @param domain :: An instance of FunctionDomain with the function arguments.
  *  @param values :: A FunctionValues instance for storing the calculated
  * values.
@@ -146,7 +220,19 @@ void CompositeFunction::function(const FunctionDomain &domain,
                                  FunctionValues &values) const {
   FunctionValues tmp(domain);
   values.zeroCalculated();
+  auto domain1D = getSortedDomain1D(domain);
   for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
+    size_t start = 0;
+    size_t n = 0;
+    if (domain1D && getSupportRange(*m_functions[iFun], *domain1D, start, n)) {
+      if (n > 0) {
+        auto subDomain = createSubDomain(*domain1D, start, n);
+        FunctionValues localValues(*subDomain);
+        m_functions[iFun]->function(*subDomain, localValues);
+        values.addToCalculated(start, localValues);
+      }
+      continue;
+    }
     m_functions[iFun]->function(domain, tmp);
     values += tmp;
   }
@@ -162,7 +248,30 @@ void CompositeFunction::functionDeriv(const FunctionDomain &domain,
   if (getAttribute("NumDeriv").asBool()) {
     calNumericalDeriv(domain, jacobian);
   } else {
+    auto domain1D = getSortedDomain1D(domain);
     for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
+      size_t start = 0;
+      size_t n = 0;
+      if (domain1D &&
+          getSupportRange(*m_functions[iFun], *domain1D, start, n)) {
+        // The derivatives are zero outside the support of the peak
+        const size_t iP0 = paramOffset(iFun);
+        const size_t np = m_functions[iFun]->nParams();
+        for (size_t i = 0; i < domain1D->size(); ++i) {
+          if (i >= start && i < start + n) {
+            continue;
+          }
+          for (size_t ip = 0; ip < np; ++ip) {
+            jacobian.set(i, iP0 + ip, 0.0);
+          }
+        }
+        if (n > 0) {
+          auto subDomain = createSubDomain(*domain1D, start, n);
+          PartialJacobian J(&jacobian, start, iP0);
+          getFunction(iFun)->functionDeriv(*subDomain, J);
+        }
+        continue;
+      }
       PartialJacobian J(&jacobian, paramOffset(iFun));
       getFunction(iFun)->functionDeriv(domain, J);
     }
@@ -6,7 +6,7 @@ namespace Mantid {
 namespace API {
 
 CostFunctionFactoryImpl::CostFunctionFactoryImpl()
-    : Kernel::DynamicFactory<ICostFunction>() {
+    : Kernel::DynamicFactory<ICostFunction>("costfunction") {
   // we need to make sure the library manager has been loaded before we
   // are constructed so that it is destroyed after us and thus does
   // not close any loaded DLLs with loaded algorithms in them
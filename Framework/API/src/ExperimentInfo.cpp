@@ -60,6 +60,8 @@ ExperimentInfo::ExperimentInfo()
       sptr_instrument(new Instrument()),
       m_detectorInfo(boost::make_shared<Beamline::DetectorInfo>(0)) {
   m_parmap->setDetectorInfo(m_detectorInfo);
+  // Spectra may be modified before they are attached to the workspace
+  m_spectraModificationStamp.update();
 }
 
 /**
@@ -215,6 +217,7 @@ void ExperimentInfo::setInstrument(const Instrument_const_sptr &instr) {
     sptr_instrument = instr;
     m_parmap = boost::make_shared<ParameterMap>();
   }
+  markMetadataModified();
   m_detectorInfo = makeDetectorInfo(*sptr_instrument, *instr);
   m_parmap->setDetectorInfo(m_detectorInfo);
   // Detector IDs that were previously dropped because they were not part of the
@@ -243,6 +246,7 @@ Instrument_const_sptr ExperimentInfo::getInstrument() const {
 */
 Geometry::ParameterMap &ExperimentInfo::instrumentParameters() {
   populateIfNotLoaded();
+  markMetadataModified();
   // TODO: Here duplicates cow_ptr. Figure out if there's a better way
 
   // Use a double-check for sharing so that we only
@@ -408,6 +412,7 @@ void ExperimentInfo::replaceInstrumentParameters(
   m_detectorInfoWrapper = nullptr;
   this->m_parmap.reset(new ParameterMap(pmap));
   m_parmap->setDetectorInfo(m_detectorInfo);
+  markMetadataModified();
 }
 
 /**
@@ -423,6 +428,7 @@ void ExperimentInfo::swapInstrumentParameters(Geometry::ParameterMap &pmap) {
   m_detectorInfoWrapper = nullptr;
   this->m_parmap->swap(pmap);
   m_parmap->setDetectorInfo(m_detectorInfo);
+  markMetadataModified();
 }
 
 /**
@@ -505,6 +511,7 @@ void ExperimentInfo::setModeratorModel(ModeratorModel *source) {
         "ExperimentInfo::setModeratorModel - NULL source object found.");
   }
   m_moderatorModel = boost::shared_ptr<ModeratorModel>(source);
+  markMetadataModified();
 }
 
 /// Returns a reference to the source properties object
@@ -542,6 +549,7 @@ void ExperimentInfo::setChopperModel(ChopperModel *chopper,
   {
     m_choppers.insert(iter, boost::shared_ptr<ChopperModel>(chopper));
   }
+  markMetadataModified();
 }
 
 /**
@@ -581,6 +589,7 @@ const Sample &ExperimentInfo::sample() const {
 */
 Sample &ExperimentInfo::mutableSample() {
   populateIfNotLoaded();
+  markMetadataModified();
   // Use a double-check for sharing so that we only
   // enter the critical region if absolutely necessary
   if (!m_sample.unique()) {
@@ -612,6 +621,7 @@ const Run &ExperimentInfo::run() const {
 */
 Run &ExperimentInfo::mutableRun() {
   populateIfNotLoaded();
+  markMetadataModified();
   // Use a double-check for sharing so that we only
   // enter the critical region if absolutely necessary
   if (!m_run.unique()) {
@@ -1107,6 +1117,7 @@ const SpectrumInfo &ExperimentInfo::spectrumInfo() const {
  */
 SpectrumInfo &ExperimentInfo::mutableSpectrumInfo() {
   populateIfNotLoaded();
+  markMetadataModified();
   // Creating SpectrumInfo with a non-const reference to a MatrixWorkspace will
   // call ExperimentInfo::mutableDetectorInfo() which will later be used by
   // modifications. This will trigger a copy if required. Note that the
@@ -1156,6 +1167,45 @@ void ExperimentInfo::invalidateSpectrumDefinition(const size_t index) {
   m_spectrumDefinitionNeedsUpdate.at(index) = 1;
 }
 
+/** Returns the stamp of the last modification of the experiment information.
+ *
+ * The stamp changes whenever the instrument, its parameters, the run, the
+ * sample or the moderator and chopper models may have been modified, i.e.
+ * whenever a non-const accessor to one of them is called. The spectra of a
+ * MatrixWorkspace have their own stamps. */
+uint64_t ExperimentInfo::metadataModificationStamp() const {
+  return m_modificationStamp.value();
+}
+
+/// Records a modification of the experiment information.
+void ExperimentInfo::markMetadataModified() { m_modificationStamp.update(); }
+
+/** Notifies the ExperimentInfo that one of the spectra of the workspace has
+ * been modified.
+ *
+ * This is called by ISpectrum for every modification, possibly from many
+ * threads at once. Only the first call after the stamp has been settled
+ * writes to it. */
+void ExperimentInfo::markSpectrumModified() {
+  m_spectraModificationStamp.update();
+}
+
+/** Returns a stamp that changes whenever one of the spectra of the workspace
+ * may have been modified since it was last called. */
+uint64_t ExperimentInfo::spectraModificationStamp() const {
+  return m_spectraModificationStamp.value();
+}
+
+/** Records that the modifications of the experiment information and of the
+ * spectra are complete, so that their stamps keep their values until the
+ * next modification. The stamps of the spectra themselves are settled by
+ * MatrixWorkspace.
+ * @return true if a spectrum may have been modified since the last call */
+bool ExperimentInfo::settleExperimentInfoModificationStamps() {
+  m_modificationStamp.settle();
+  return m_spectraModificationStamp.settle();
+}
+
 void ExperimentInfo::updateSpectrumDefinitionIfNecessary(
     const size_t index) const {
   if (m_spectrumDefinitionNeedsUpdate.at(index) != 0)
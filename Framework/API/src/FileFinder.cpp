@@ -59,7 +59,7 @@ FileFinderImpl::FileFinderImpl() {
   std::string libpath =
       Kernel::ConfigService::Instance().getString("plugins.directory");
   if (!libpath.empty()) {
-    Kernel::LibraryManager::Instance().OpenAllLibraries(libpath);
+    Kernel::LibraryManager::Instance().OpenLibrariesOnDemand(libpath);
   }
 
 // determine from Mantid property how sensitive Mantid should be
@@ -80,6 +80,7 @@ searchForLoader(const std::string &filename,
  */
 void FileLoaderRegistryImpl::unsubscribe(const std::string &name,
                                          const int version) {
+  Poco::ScopedWriteRWLock lock(m_namesLock);
   auto iend = m_names.end();
   for (auto it = m_names.begin(); it != iend; ++it) {
     removeAlgorithm(name, version, *it);
@@ -100,6 +101,8 @@ FileLoaderRegistryImpl::chooseLoader(const std::string &filename) const {
   using Kernel::NexusDescriptor;
 
   m_log.debug() << "Trying to find loader for '" << filename << "'\n";
+  // Every loader must be asked, including those in plugins not opened yet
+  Kernel::LibraryManager::Instance().OpenLibrariesProviding("loader");
 
   IAlgorithm_sptr bestLoader;
   if (NexusDescriptor::isHDF(filename)) {
@@ -107,11 +110,11 @@ FileLoaderRegistryImpl::chooseLoader(const std::string &filename) const {
         << filename
         << " looks like a Nexus file. Checking registered Nexus loaders\n";
     bestLoader = searchForLoader<NexusDescriptor, IFileLoader<NexusDescriptor>>(
-        filename, m_names[Nexus], m_log);
+        filename, loaderNames(Nexus), m_log);
   } else {
     m_log.debug() << "Checking registered non-HDF loaders\n";
     bestLoader = searchForLoader<FileDescriptor, IFileLoader<FileDescriptor>>(
-        filename, m_names[Generic], m_log);
+        filename, loaderNames(Generic), m_log);
   }
 
   if (!bestLoader) {
@@ -134,12 +137,17 @@ bool FileLoaderRegistryImpl::canLoad(const std::string &algorithmName,
   using Kernel::FileDescriptor;
   using Kernel::NexusDescriptor;
 
+  Kernel::LibraryManager::Instance().OpenLibraryProviding("loader",
+                                                         algorithmName);
   // Check if it is in one of our lists
   bool nexus(false), nonHDF(false);
-  if (m_names[Nexus].find(algorithmName) != m_names[Nexus].end())
-    nexus = true;
-  else if (m_names[Generic].find(algorithmName) != m_names[Generic].end())
-    nonHDF = true;
+  {
+    Poco::ScopedReadRWLock lock(m_namesLock);
+    if (m_names[Nexus].find(algorithmName) != m_names[Nexus].end())
+      nexus = true;
+    else if (m_names[Generic].find(algorithmName) != m_names[Generic].end())
+      nonHDF = true;
+  }
 
   if (!nexus && !nonHDF)
     throw std::invalid_argument(
@@ -174,6 +182,18 @@ FileLoaderRegistryImpl::FileLoaderRegistryImpl()
  */
 FileLoaderRegistryImpl::~FileLoaderRegistryImpl() = default;
 
+/**
+ * The loaders are created from a copy so that libraries opened meanwhile can
+ * subscribe their own loaders.
+ * @param format The format of the loaders
+ * @returns A copy of the names and versions of the loaders of the format
+ */
+std::multimap<std::string, int>
+FileLoaderRegistryImpl::loaderNames(LoaderFormat format) const {
+  Poco::ScopedReadRWLock lock(m_namesLock);
+  return m_names[format];
+}
+
 /**
  * @param name A string containing the algorithm name
  * @param version The version to remove. -1 indicates all instances
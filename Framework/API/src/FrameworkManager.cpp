@@ -190,7 +190,7 @@ void FrameworkManagerImpl::loadPluginsUsingKey(const std::string &key) {
   std::string pluginDir = config.getString(key);
   if (pluginDir.length() > 0) {
     g_log.debug("Loading libraries from \"" + pluginDir + "\"");
-    Kernel::LibraryManager::Instance().OpenAllLibraries(pluginDir, false);
+    Kernel::LibraryManager::Instance().OpenLibrariesOnDemand(pluginDir);
   } else {
     g_log.debug("No library directory found in key \"" + key + "\"");
   }
@@ -9,7 +9,7 @@ namespace Mantid {
 namespace API {
 
 FuncMinimizerFactoryImpl::FuncMinimizerFactoryImpl()
-    : Kernel::DynamicFactory<IFuncMinimizer>() {
+    : Kernel::DynamicFactory<IFuncMinimizer>("minimizer") {
   // we need to make sure the library manager has been loaded before we
   // are constructed so that it is destroyed after us and thus does
   // not close any loaded DLLs with loaded algorithms in them
@@ -30,6 +30,7 @@
 
 #include <MantidKernel/StringTokenizer.h>
 
+#include <exception>
 #include <limits>
 #include <sstream>
 #include <algorithm>
@@ -670,61 +671,214 @@ std::string IFunction::descriptionOfActive(size_t i) const {
   return parameterDescription(i);
 }
 
-/** Calculate numerical derivatives.
+namespace {
+/// Minimum number of active parameters for which the columns of a numerical
+/// Jacobian are calculated in parallel
+const size_t MIN_PARAMS_FOR_PARALLEL_DERIV = 8;
+
+/**
+ * Calculate one column of a numerical Jacobian.
+ * @param fun :: The function, its parameters are restored on return
  * @param domain :: The domain of the function
- * @param jacobian :: A Jacobian matrix. It is expected to have dimensions of
- * domain.size() by nParams().
+ * @param iP :: Index of an active parameter
+ * @param minusStep :: The values of the function at the current parameters
+ * @param plusStep :: Buffer for the values of the function after the step
+ * @param jacobian :: The Jacobian to set the column of
  */
-void IFunction::calNumericalDeriv(const FunctionDomain &domain,
-                                  Jacobian &jacobian) {
+void numericalDerivColumn(IFunction &fun, const FunctionDomain &domain,
+                          size_t iP, const FunctionValues &minusStep,
+                          FunctionValues &plusStep, Jacobian &jacobian) {
   const double minDouble = std::numeric_limits<double>::min();
   const double epsilon = std::numeric_limits<double>::epsilon() * 100;
   double stepPercentage = 0.001; // step percentage
   double step;                   // real step
   double cutoff = 100.0 * minDouble / stepPercentage;
-  size_t nParam = nParams();
-  size_t nData = getValuesSize(domain);
 
-  FunctionValues minusStep(nData);
-  FunctionValues plusStep(nData);
+  const double val = fun.activeParameter(iP);
+  if (fabs(val) < cutoff) {
+    step = epsilon;
+  } else {
+    step = val * stepPercentage;
+  }
 
-  // PARALLEL_CRITICAL(numeric_deriv)
-  {
-    applyTies(); // just in case
-    function(domain, minusStep);
+  double paramPstep = val + step;
+
+  fun.setActiveParameter(iP, paramPstep);
+  fun.applyTies();
+  fun.function(domain, plusStep);
+  fun.setActiveParameter(iP, val);
+
+  step = paramPstep - val;
+  const size_t nData = minusStep.size();
+  for (size_t i = 0; i < nData; i++) {
+    jacobian.set(i, iP,
+                 (plusStep.getCalculated(i) - minusStep.getCalculated(i)) /
+                     step);
   }
+}
 
-  if (nData == 0) {
-    nData = minusStep.size();
+/**
+ * Check that a copy of a function gives exactly the same values.
+ * @param copy :: The copy
+ * @param domain :: The domain of the function
+ * @param values :: The values of the original function on the domain
+ * @return true if the copy reproduces the values
+ */
+bool reproducesValues(IFunction &copy, const FunctionDomain &domain,
+                      const FunctionValues &values) {
+  FunctionValues check(values.size());
+  copy.function(domain, check);
+  if (check.size() != values.size())
+    return false;
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (check.getCalculated(i) != values.getCalculated(i))
+      return false;
   }
+  return true;
+}
+} // namespace
+
+/** Calculate numerical derivatives.
+ * If the function has enough active parameters and is not already used in
+ * parallel, the columns are calculated concurrently, each thread using its
+ * own copy of the function.
+ * @param domain :: The domain of the function
+ * @param jacobian :: A Jacobian matrix. It is expected to have dimensions of
+ * domain.size() by nParams().
+ */
+void IFunction::calNumericalDeriv(const FunctionDomain &domain,
+                                  Jacobian &jacobian) {
+  size_t nParam = nParams();
+  const size_t nValues = getValuesSize(domain);
+
+  FunctionValues minusStep(nValues);
 
+  applyTies(); // just in case
+  function(domain, minusStep);
+
+  std::vector<size_t> activeParams;
   for (size_t iP = 0; iP < nParam; iP++) {
-    if (isActive(iP)) {
-      const double val = activeParameter(iP);
-      if (fabs(val) < cutoff) {
-        step = epsilon;
-      } else {
-        step = val * stepPercentage;
+    if (isActive(iP))
+      activeParams.push_back(iP);
+  }
+  const int64_t nActive = static_cast<int64_t>(activeParams.size());
+
+  if (!m_isParallel && activeParams.size() >= MIN_PARAMS_FOR_PARALLEL_DERIV &&
+      PARALLEL_NUMBER_OF_THREADS == 1 && PARALLEL_GET_MAX_THREADS > 1) {
+    const auto &copies = numericalDerivCopies(
+        domain, minusStep, static_cast<size_t>(PARALLEL_GET_MAX_THREADS));
+    if (!copies.empty()) {
+      std::vector<FunctionValues> plusSteps(copies.size(),
+                                            FunctionValues(nValues));
+      std::exception_ptr error;
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int64_t k = 0; k < nActive; ++k) {
+        try {
+          const size_t thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
+          numericalDerivColumn(*copies[thread], domain, activeParams[k],
+                               minusStep, plusSteps[thread], jacobian);
+        } catch (...) {
+          PARALLEL_CRITICAL(numeric_deriv) {
+            if (!error)
+              error = std::current_exception();
+          }
+        }
       }
+      if (error)
+        std::rethrow_exception(error);
+      return;
+    }
+  }
 
-      double paramPstep = val + step;
+  FunctionValues plusStep(nValues);
+  for (auto iP : activeParams) {
+    numericalDerivColumn(*this, domain, iP, minusStep, plusStep, jacobian);
+  }
+}
 
-      // PARALLEL_CRITICAL(numeric_deriv)
-      {
-        setActiveParameter(iP, paramPstep);
-        applyTies();
-        function(domain, plusStep);
-        setActiveParameter(iP, val);
+/** Get the copies of this function used to calculate numerical derivatives
+ * in parallel. The copies made for a previous call are reused with the
+ * current parameters if the first of them still has the same definition,
+ * including ties, constraints and attributes, and reproduces the values of
+ * this function, otherwise new copies are made.
+ * @param domain :: The domain of the function
+ * @param values :: The values of this function on the domain
+ * @param nCopies :: The number of copies needed
+ * @return the copies, or an empty vector if they cannot be used
+ */
+const std::vector<boost::shared_ptr<IFunction>> &
+IFunction::numericalDerivCopies(const FunctionDomain &domain,
+                                const FunctionValues &values,
+                                size_t nCopies) {
+  if (m_derivCopies.size() == nCopies) {
+    try {
+      bool usable = true;
+      for (auto &copy : m_derivCopies) {
+        if (copy->nParams() != nParams()) {
+          usable = false;
+          break;
+        }
+        for (size_t i = 0; i < nParams(); ++i) {
+          copy->setParameter(i, getParameter(i), isExplicitlySet(i));
+        }
+        copy->applyTies();
       }
+      // The copies were made and updated in the same way, so checking one
+      // of them is enough
+      const auto &front = *m_derivCopies.front();
+      if (usable && front.asString() == asString() &&
+          reproducesValues(front, domain, values))
+        return m_derivCopies;
+    } catch (...) {
+      // make new copies below
+    }
+  }
+  m_derivCopies = cloneForNumericalDeriv(domain, values, nCopies);
+  return m_derivCopies;
+}
 
-      step = paramPstep - val;
-      for (size_t i = 0; i < nData; i++) {
-        jacobian.set(i, iP,
-                     (plusStep.getCalculated(i) - minusStep.getCalculated(i)) /
-                         step);
+/** Make copies of this function to calculate numerical derivatives in
+ * parallel. A copy is only usable if it gives exactly the same values as this
+ * function, which is not the case for functions with a state that is not
+ * reproduced by clone().
+ * @param domain :: The domain of the function
+ * @param values :: The values of this function on the domain
+ * @param nCopies :: The number of copies to make
+ * @return the copies, or an empty vector if they cannot be used
+ */
+std::vector<boost::shared_ptr<IFunction>>
+IFunction::cloneForNumericalDeriv(const FunctionDomain &domain,
+                                  const FunctionValues &values,
+                                  size_t nCopies) const {
+  std::vector<boost::shared_ptr<IFunction>> copies(nCopies);
+  try {
+    for (auto &copy : copies) {
+      copy = clone();
+      if (!copy || copy->nParams() != nParams())
+        return {};
+      // The string representation may not keep all the digits
+      for (size_t i = 0; i < nParams(); ++i) {
+        copy->setParameter(i, getParameter(i), isExplicitlySet(i));
       }
+      copy->applyTies();
+    }
+  } catch (...) {
+    return {};
+  }
+
+  // Each copy must reproduce the values of this function exactly
+  std::vector<char> reproduced(nCopies, 0);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t k = 0; k < static_cast<int64_t>(nCopies); ++k) {
+    try {
+      reproduced[k] = reproducesValues(*copies[k], domain, values);
+    } catch (...) {
+      reproduced[k] = 0;
     }
   }
+  if (std::find(reproduced.begin(), reproduced.end(), 0) != reproduced.end())
+    return {};
+  return copies;
 }
 
 /** Initialize the function providing it the workspace
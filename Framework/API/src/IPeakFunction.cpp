@@ -172,6 +172,27 @@ void IPeakFunction::setPeakRadius(int r) const {
   }
 }
 
+/**
+ * Get the interval outside which the values and the derivatives of the peak
+ * are zero. Composite functions evaluate the peak only on this interval. The
+ * default implementation matches function1D(): a number of FWHMs around the
+ * centre given by the peak radius, or the whole real axis if the radius isn't
+ * set. Peaks that override function1D() must override this method too if
+ * they are zero on a different interval.
+ * @param peakRadius :: The peak radius of the domain in FWHMs, 0 if not set.
+ * @return A pair of doubles giving the bounds of the interval.
+ */
+std::pair<double, double>
+IPeakFunction::getSupportInterval(int peakRadius) const {
+  if (peakRadius <= 0) {
+    const double inf = std::numeric_limits<double>::infinity();
+    return std::make_pair(-inf, inf);
+  }
+  const double c = this->centre();
+  const double dx = fabs(peakRadius * this->fwhm());
+  return std::make_pair(c - dx, c + dx);
+}
+
 /// Returns the integral intensity of the peak function, using the peak radius
 /// to determine integration borders.
 double IPeakFunction::intensity() const {
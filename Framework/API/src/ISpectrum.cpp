@@ -3,8 +3,18 @@
 #include "MantidHistogramData/Histogram.h"
 #include "MantidKernel/System.h"
 
+#include <boost/functional/hash.hpp>
+
 namespace Mantid {
 namespace API {
+namespace {
+/// Hash the values of a histogram array
+template <class T> void hashValues(size_t &seed, const T &values) {
+  const auto &data = values.rawData();
+  boost::hash_combine(seed, data.size());
+  boost::hash_range(seed, data.begin(), data.end());
+}
+} // namespace
 
 /** Constructor with spectrum number
  * @param specNo :: spectrum # of the spectrum
@@ -19,6 +29,7 @@ ISpectrum::ISpectrum(const specnum_t specNo) : m_specNo(specNo) {}
 void ISpectrum::copyInfoFrom(const ISpectrum &other) {
   m_specNo = other.m_specNo;
   detectorIDs = other.detectorIDs;
+  markModified();
   updateExperimentInfo();
 }
 
@@ -45,8 +56,10 @@ const MantidVec &ISpectrum::readE() const { return this->dataE(); }
 void ISpectrum::addDetectorID(const detid_t detID) {
   size_t oldSize = detectorIDs.size();
   this->detectorIDs.insert(detID);
-  if (detectorIDs.size() != oldSize)
+  if (detectorIDs.size() != oldSize) {
+    markModified();
     updateExperimentInfo();
+  }
 }
 
 /** Add a set of detector IDs to the set of detector IDs
@@ -56,8 +69,10 @@ void ISpectrum::addDetectorID(const detid_t detID) {
 void ISpectrum::addDetectorIDs(const std::set<detid_t> &detIDs) {
   size_t oldSize = detectorIDs.size();
   this->detectorIDs.insert(detIDs.begin(), detIDs.end());
-  if (detectorIDs.size() != oldSize)
+  if (detectorIDs.size() != oldSize) {
+    markModified();
     updateExperimentInfo();
+  }
 }
 
 /** Add a vector of detector IDs to the set of detector IDs
@@ -67,8 +82,10 @@ void ISpectrum::addDetectorIDs(const std::set<detid_t> &detIDs) {
 void ISpectrum::addDetectorIDs(const std::vector<detid_t> &detIDs) {
   size_t oldSize = detectorIDs.size();
   this->detectorIDs.insert(detIDs.begin(), detIDs.end());
-  if (detectorIDs.size() != oldSize)
+  if (detectorIDs.size() != oldSize) {
+    markModified();
     updateExperimentInfo();
+  }
 }
 
 /** Clear the list of detector IDs, then add one.
@@ -78,6 +95,7 @@ void ISpectrum::addDetectorIDs(const std::vector<detid_t> &detIDs) {
 void ISpectrum::setDetectorID(const detid_t detID) {
   this->detectorIDs.clear();
   this->detectorIDs.insert(detID);
+  markModified();
   updateExperimentInfo();
 }
 
@@ -87,6 +105,7 @@ void ISpectrum::setDetectorID(const detid_t detID) {
  */
 void ISpectrum::setDetectorIDs(const std::set<detid_t> &detIDs) {
   detectorIDs = detIDs;
+  markModified();
   updateExperimentInfo();
 }
 
@@ -96,6 +115,7 @@ void ISpectrum::setDetectorIDs(const std::set<detid_t> &detIDs) {
  */
 void ISpectrum::setDetectorIDs(std::set<detid_t> &&detIDs) {
   detectorIDs = std::move(detIDs);
+  markModified();
   updateExperimentInfo();
 }
 
@@ -114,6 +134,7 @@ const std::set<detid_t> &ISpectrum::getDetectorIDs() const {
  */
 void ISpectrum::clearDetectorIDs() {
   this->detectorIDs.clear();
+  markModified();
   updateExperimentInfo();
 }
 
@@ -122,7 +143,10 @@ specnum_t ISpectrum::getSpectrumNo() const { return m_specNo; }
 
 /** Sets the the spectrum number of this spectrum
  * @param num :: the spectrum number of this spectrum */
-void ISpectrum::setSpectrumNo(specnum_t num) { m_specNo = num; }
+void ISpectrum::setSpectrumNo(specnum_t num) {
+  m_specNo = num;
+  markModified();
+}
 
 /**
  * Gets the value of the use flag.
@@ -133,18 +157,20 @@ bool ISpectrum::hasDx() const { return bool(histogramRef().sharedDx()); }
 /**
  * Resets the hasDx flag
  */
-void ISpectrum::resetHasDx() { mutableHistogramRef().setSharedDx(nullptr); }
+void ISpectrum::resetHasDx() { modifiedHistogramRef().setSharedDx(nullptr); }
 
 /// Copy constructor.
 ISpectrum::ISpectrum(const ISpectrum &other)
-    : m_specNo(other.m_specNo), detectorIDs(other.detectorIDs) {
+    : m_specNo(other.m_specNo), detectorIDs(other.detectorIDs),
+      m_modificationStamp(other.m_modificationStamp) {
   // m_experimentInfo and m_index are not copied: A copy should not refer to the
   // parent of the source. m_experimentInfo will be nullptr.
 }
 
 /// Move constructor.
 ISpectrum::ISpectrum(ISpectrum &&other)
-    : m_specNo(other.m_specNo), detectorIDs(std::move(other.detectorIDs)) {
+    : m_specNo(other.m_specNo), detectorIDs(std::move(other.detectorIDs)),
+      m_modificationStamp(other.m_modificationStamp) {
   // m_experimentInfo and m_index are not copied: A copy should not refer to the
   // parent of the source. m_experimentInfo will be nullptr.
 }
@@ -155,6 +181,7 @@ ISpectrum &ISpectrum::operator=(const ISpectrum &other) {
   detectorIDs = other.detectorIDs;
   // m_experimentInfo and m_index are not assigned: The lhs of the assignment
   // keeps its current values.
+  markModified();
   updateExperimentInfo();
   return *this;
 }
@@ -165,6 +192,7 @@ ISpectrum &ISpectrum::operator=(ISpectrum &&other) {
   detectorIDs = std::move(other.detectorIDs);
   // m_experimentInfo and m_index are not assigned: The lhs of the assignment
   // keeps its current values.
+  markModified();
   updateExperimentInfo();
   return *this;
 }
@@ -179,6 +207,37 @@ void ISpectrum::setExperimentInfo(ExperimentInfo *experimentInfo,
                                   const size_t index) {
   m_experimentInfo = experimentInfo;
   m_index = index;
+  // The caller holds a mutable reference, which may be used to modify the
+  // spectrum in ways that are not recorded, e.g. through an EventList.
+  markModified();
+}
+
+/** Record a modification of this spectrum.
+ *
+ * Updates the modification stamp and tells the owning workspace, if any, that
+ * one of its spectra has changed. All the mutators call this, as does getting
+ * a mutable reference to a spectrum from a MatrixWorkspace. */
+void ISpectrum::markModified() {
+  m_modificationStamp.update();
+  if (m_experimentInfo)
+    m_experimentInfo->markSpectrumModified();
+}
+
+/** Returns a hash of the content of this spectrum: the spectrum number, the
+ * detector IDs and the data. Equal spectra have equal hashes.
+ * @return The hash */
+size_t ISpectrum::contentHash() const {
+  size_t seed = 0;
+  boost::hash_combine(seed, m_specNo);
+  boost::hash_range(seed, detectorIDs.begin(), detectorIDs.end());
+  boost::hash_combine(seed, static_cast<int>(yMode()));
+  hashValues(seed, x());
+  hashValues(seed, y());
+  hashValues(seed, e());
+  boost::hash_combine(seed, hasDx());
+  if (hasDx())
+    hashValues(seed, dx());
+  return seed;
 }
 
 /// Updates detector IDs in the owning ExperimentInfo.
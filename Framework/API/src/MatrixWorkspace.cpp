@@ -1,22 +1,29 @@
 #include "MantidAPI/BinEdgeAxis.h"
+#include "MantidAPI/DetectorInfo.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/MatrixWorkspaceMDIterator.h"
 #include "MantidAPI/NumericAxis.h"
 #include "MantidAPI/Run.h"
+#include "MantidAPI/Sample.h"
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidGeometry/MDGeometry/MDFrame.h"
 #include "MantidGeometry/MDGeometry/GeneralFrame.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/MDUnit.h"
 #include "MantidKernel/Strings.h"
+#include "MantidKernel/Unit.h"
 #include "MantidKernel/make_unique.h"
 #include "MantidIndexing/IndexInfo.h"
 
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
 #include <cmath>
 
 #include <functional>
@@ -825,6 +832,7 @@ void MatrixWorkspace::replaceAxis(const std::size_t &axisIndex,
   // If we're OK, then delete the old axis and set the pointer to the new one
   delete m_axes[axisIndex];
   m_axes[axisIndex] = newAxis;
+  markModified();
 }
 
 /// Returns the units of the data in the workspace
@@ -833,6 +841,7 @@ std::string MatrixWorkspace::YUnit() const { return m_YUnit; }
 /// Sets a new unit for the data (Y axis) in the workspace
 void MatrixWorkspace::setYUnit(const std::string &newUnit) {
   m_YUnit = newUnit;
+  markModified();
 }
 
 /// Returns a caption for the units of the data in the workspace
@@ -1005,6 +1014,7 @@ void MatrixWorkspace::flagMasked(const size_t &index, const size_t &binIndex,
       binList.erase(it);
     }
     binList.emplace(binIndex, weight);
+    markModified();
   }
 }
 
@@ -1072,6 +1082,127 @@ size_t MatrixWorkspace::getMemorySize() const {
   return 3 * size() * sizeof(double) + run().getMemorySize();
 }
 
+/** Returns a stamp that changes whenever the workspace is modified: its
+* spectra, units, masked bins or experiment information.
+*
+* Modifications are recorded by the mutable accessors, e.g. getSpectrum(),
+* mutableY(), dataY() and instrumentParameters(), when they are called. Since
+* the references they return may go on being used, the stamp changes on every
+* call until settleModificationStamps() is called. A reference must not be
+* used to modify the workspace after that. Changes to an axis through the
+* pointer returned by getAxis() are not recorded, since getAxis() is const.
+* @return The stamp
+*/
+uint64_t MatrixWorkspace::modificationStamp() const {
+  return std::max({Workspace::modificationStamp(), metadataModificationStamp(),
+                   spectraModificationStamp()});
+}
+
+/** Records that the modifications of the workspace, its experiment
+* information and its spectra are complete. Only the spectra modified since
+* the last call are written to, and the spectra are not visited at all if
+* none of them has been modified.
+*/
+void MatrixWorkspace::settleModificationStamps() {
+  Workspace::settleModificationStamps();
+  if (!settleExperimentInfoModificationStamps())
+    return;
+  const auto nHist = static_cast<int>(getNumberHistograms());
+  const MatrixWorkspace &constThis = *this;
+  for (int i = 0; i < nHist; ++i) {
+    constThis.getSpectrum(i).settleModificationStamp();
+  }
+}
+
+/** Returns a hash of the content of the workspace. Workspaces with the same
+* data, spectrum numbers, detector IDs, axes, units, masking, instrument
+* parameters and logs have the same hash.
+*
+* The hashes of the spectra and of the rest of the workspace are kept with
+* the modification stamps they were calculated at, so only the spectra that
+* have been modified since the last call are hashed again. If no spectrum has
+* been modified the spectra are not visited at all. Spectra that have not
+* been settled since they were modified are hashed on every call. The axes
+* are always hashed, see modificationStamp().
+* @return The hash
+*/
+size_t MatrixWorkspace::contentHash() const {
+  std::lock_guard<std::mutex> lock(m_contentHashMutex);
+  auto &cache = m_contentHashCache;
+
+  const uint64_t metadataStamp =
+      std::max(Workspace::modificationStamp(), metadataModificationStamp());
+  if (metadataStamp != cache.metadataStamp) {
+    size_t seed = 0;
+    boost::hash_combine(seed, id());
+    boost::hash_combine(seed, m_YUnit);
+    for (const auto &masks : m_masks) {
+      boost::hash_combine(seed, masks.first);
+      for (const auto &mask : masks.second) {
+        boost::hash_combine(seed, mask.first);
+        boost::hash_combine(seed, mask.second);
+      }
+    }
+    const auto instrument = getInstrument();
+    boost::hash_combine(seed, instrument->getName());
+    boost::hash_combine(seed, instrument->getFilename());
+    boost::hash_combine(seed, constInstrumentParameters().asString());
+    const auto &detInfo = detectorInfo();
+    for (size_t i = 0; i < detInfo.size(); ++i) {
+      boost::hash_combine(seed, detInfo.isMasked(i));
+    }
+    boost::hash_combine(seed, sample().getName());
+    for (const auto *log : run().getProperties()) {
+      boost::hash_combine(seed, log->name());
+      boost::hash_combine(seed, log->value());
+    }
+    cache.metadataHash = seed;
+    cache.metadataStamp = metadataStamp;
+  }
+
+  const uint64_t spectraStamp = spectraModificationStamp();
+  const size_t nHist = getNumberHistograms();
+  if (spectraStamp != cache.spectraStamp || cache.spectra.size() != nHist) {
+    // New entries have stamp 0, which is never used
+    cache.spectra.resize(nHist);
+    auto &spectra = cache.spectra;
+    PARALLEL_FOR_IF(this->threadSafe())
+    for (int i = 0; i < static_cast<int>(nHist); ++i) {
+      const auto &spectrum = getSpectrum(i);
+      auto &entry = spectra[i];
+      const uint64_t stamp = spectrum.modificationStamp();
+      if (entry.first != stamp) {
+        entry.first = stamp;
+        entry.second = spectrum.contentHash();
+      }
+    }
+    size_t seed = nHist;
+    for (const auto &entry : spectra) {
+      boost::hash_combine(seed, entry.second);
+    }
+    cache.spectraHash = seed;
+    cache.spectraStamp = spectraStamp;
+  }
+
+  size_t seed = cache.metadataHash;
+  boost::hash_combine(seed, cache.spectraHash);
+  for (size_t i = 0; i < m_axes.size(); ++i) {
+    const Axis *axis = m_axes[i];
+    const auto &unit = axis->unit();
+    boost::hash_combine(seed, unit ? unit->unitID() : std::string());
+    // The values of the X axis are hashed with the spectra
+    if (i == 0 || axis->isSpectra())
+      continue;
+    for (size_t j = 0; j < axis->length(); ++j) {
+      if (axis->isText())
+        boost::hash_combine(seed, axis->label(j));
+      else
+        boost::hash_combine(seed, (*axis)(j));
+    }
+  }
+  return seed;
+}
+
 /** Returns the memory used (in bytes) by the X axes, handling ragged bins.
 * @return bytes used
 */
@@ -17,7 +17,8 @@ Workspace::~Workspace() = default;
 Workspace::Workspace(const Workspace &other)
     : Kernel::DataItem(other), m_title(other.m_title),
       m_comment(other.m_comment), m_name(other.m_name),
-      m_history(Kernel::make_unique<WorkspaceHistory>(other.getHistory())) {}
+      m_history(Kernel::make_unique<WorkspaceHistory>(other.getHistory())),
+      m_modificationStamp(other.m_modificationStamp) {}
 
 /** Set the title of the workspace
  *
@@ -25,6 +26,29 @@ Workspace::Workspace(const Workspace &other)
  */
 void Workspace::setTitle(const std::string &t) { m_title = t; }
 
+/** Returns a stamp that changes whenever the workspace is modified.
+ *
+ * Stamps are taken from a single counter, so a later stamp means a later
+ * modification and a copy has the stamp of the workspace it was copied from
+ * until either of them is modified. The base class only records calls to
+ * markModified(). Derived classes combine it with the stamps of their data.
+ *
+ *  @return The stamp
+ */
+uint64_t Workspace::modificationStamp() const {
+  return m_modificationStamp.value();
+}
+
+/// Records a modification of the workspace
+void Workspace::markModified() { m_modificationStamp.update(); }
+
+/** Records that the modifications of the workspace are complete, i.e. that
+ * the references obtained from its mutable accessors are not used any more.
+ * Until then modificationStamp() gives a new value every time it is called.
+ * Algorithms call this for their output workspaces when they have executed.
+ */
+void Workspace::settleModificationStamps() { m_modificationStamp.settle(); }
+
 /** Set the comment field of the workspace
  *
  *  @param c :: The comment
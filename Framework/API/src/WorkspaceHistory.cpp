@@ -8,10 +8,13 @@
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <boost/make_shared.hpp>
 
 #include "Poco/DateTime.h"
 #include <Poco/DateTimeParser.h>
 
+#include <algorithm>
+
 using Mantid::Kernel::EnvironmentHistory;
 using boost::algorithm::split;
 
@@ -23,24 +26,25 @@ Kernel::Logger g_log("WorkspaceHistory");
 }
 
 /// Default Constructor
-WorkspaceHistory::WorkspaceHistory() : m_environment() {}
+WorkspaceHistory::WorkspaceHistory()
+    : m_environment(), m_algorithms(boost::make_shared<AlgorithmHistories>()) {
+}
 
 /// Destructor
 WorkspaceHistory::~WorkspaceHistory() = default;
 
 /**
-  Standard Copy Constructor
+  Standard Copy Constructor. The algorithm histories are shared with the
+  original until either is modified.
   @param A :: WorkspaceHistory Item to copy
  */
 WorkspaceHistory::WorkspaceHistory(const WorkspaceHistory &A)
-    : m_environment(A.m_environment) {
-  m_algorithms = A.m_algorithms;
-}
+    : m_environment(A.m_environment), m_algorithms(A.m_algorithms) {}
 
 /// Returns a const reference to the algorithmHistory
 const Mantid::API::AlgorithmHistories &
 WorkspaceHistory::getAlgorithmHistories() const {
-  return m_algorithms;
+  return *m_algorithms;
 }
 /// Returns a const reference to the EnvironmentHistory
 const Kernel::EnvironmentHistory &
@@ -55,32 +59,48 @@ void WorkspaceHistory::addHistory(const WorkspaceHistory &otherHistory) {
     return;
   }
 
-  // Merge the histories
   const AlgorithmHistories &otherAlgorithms =
       otherHistory.getAlgorithmHistories();
-  m_algorithms.insert(otherAlgorithms.begin(), otherAlgorithms.end());
+  // A copy that is unchanged, or only one history having entries, is common
+  // and needs no merging. Share the histories in that case.
+  if (m_algorithms == otherHistory.m_algorithms || otherAlgorithms.empty())
+    return;
+  const auto compare = m_algorithms->value_comp();
+  if (std::includes(otherAlgorithms.begin(), otherAlgorithms.end(),
+                    m_algorithms->begin(), m_algorithms->end(), compare)) {
+    m_algorithms = otherHistory.m_algorithms;
+    return;
+  }
+  if (std::includes(m_algorithms->begin(), m_algorithms->end(),
+                    otherAlgorithms.begin(), otherAlgorithms.end(), compare))
+    return;
+
+  // Merge the histories
+  mutableAlgorithms().insert(otherAlgorithms.begin(), otherAlgorithms.end());
 }
 
 /// Append an AlgorithmHistory to this WorkspaceHistory
 void WorkspaceHistory::addHistory(AlgorithmHistory_sptr algHistory) {
-  m_algorithms.insert(std::move(algHistory));
+  mutableAlgorithms().insert(std::move(algHistory));
 }
 
 /*
  Return the history length
  */
-size_t WorkspaceHistory::size() const { return m_algorithms.size(); }
+size_t WorkspaceHistory::size() const { return m_algorithms->size(); }
 
 /**
  * Query if the history is empty or not
  * @returns True if the list is empty, false otherwise
  */
-bool WorkspaceHistory::empty() const { return m_algorithms.empty(); }
+bool WorkspaceHistory::empty() const { return m_algorithms->empty(); }
 
 /**
  * Empty the list of algorithm history objects.
  */
-void WorkspaceHistory::clearHistory() { m_algorithms.clear(); }
+void WorkspaceHistory::clearHistory() {
+  m_algorithms = boost::make_shared<AlgorithmHistories>();
+}
 
 /**
  * Retrieve an algorithm history by index
@@ -94,7 +114,7 @@ WorkspaceHistory::getAlgorithmHistory(const size_t index) const {
     throw std::out_of_range(
         "WorkspaceHistory::getAlgorithmHistory() - Index out of range");
   }
-  return *std::next(m_algorithms.cbegin(), index);
+  return *std::next(m_algorithms->cbegin(), index);
 }
 
 /**
@@ -123,7 +143,7 @@ WorkspaceHistory::getAlgorithm(const size_t index) const {
  * @returns A shared pointer to the algorithm
  */
 boost::shared_ptr<IAlgorithm> WorkspaceHistory::lastAlgorithm() const {
-  if (m_algorithms.empty()) {
+  if (m_algorithms->empty()) {
     throw std::out_of_range(
         "WorkspaceHistory::lastAlgorithm() - History contains no algorithms.");
   }
@@ -142,7 +162,7 @@ void WorkspaceHistory::printSelf(std::ostream &os, const int indent) const {
   AlgorithmHistories::const_iterator it;
   os << std::string(indent, ' ') << "Histories:\n";
 
-  for (const auto &algorithm : m_algorithms) {
+  for (const auto &algorithm : *m_algorithms) {
     os << '\n';
     algorithm->printSelf(os, indent + 2);
   }
@@ -177,7 +197,7 @@ void WorkspaceHistory::saveNexus(::NeXus::File *file) const {
 
   // Algorithm History
   int algCount = 0;
-  for (const auto &algorithm : m_algorithms) {
+  for (const auto &algorithm : *m_algorithms) {
     algorithm->saveNexus(file, algCount);
   }
 
@@ -408,6 +428,17 @@ WorkspaceHistory::parseAlgorithmHistory(const std::string &rawData) {
   return history;
 }
 
+/**
+ * The histories are shared between copies of a WorkspaceHistory, so copy
+ * them before they are modified unless this is the only user.
+ * @returns The algorithm histories of this WorkspaceHistory only
+ */
+AlgorithmHistories &WorkspaceHistory::mutableAlgorithms() {
+  if (!m_algorithms.unique())
+    m_algorithms = boost::make_shared<AlgorithmHistories>(*m_algorithms);
+  return *m_algorithms;
+}
+
 //-------------------------------------------------------------------------------------------------
 /** Create a flat view of the workspaces algorithm history
  */
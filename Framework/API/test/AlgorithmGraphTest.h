@@ -0,0 +1,254 @@
+#ifndef MANTID_API_ALGORITHMGRAPHTEST_H_
+#define MANTID_API_ALGORITHMGRAPHTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmGraph.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidKernel/make_unique.h"
+#include "MantidTestHelpers/FakeObjects.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace Mantid::API;
+using namespace Mantid::Kernel;
+
+/// Scales its input, or a new single value workspace if there is no input
+class GraphTestScale : public Algorithm {
+public:
+  const std::string name() const override { return "GraphTestScale"; }
+  int version() const override { return 1; }
+  const std::string summary() const override { return "Test summary"; }
+
+  void init() override {
+    declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
+        "InputWorkspace", "", Direction::Input, PropertyMode::Optional));
+    declareProperty("Factor", 1.0);
+    declareProperty("WaitFor", 0);
+    declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
+        "OutputWorkspace", "", Direction::Output));
+  }
+
+  void exec() override {
+    const double factor = getProperty("Factor");
+    if (factor < -1.0)
+      throw factor; // Not a std::exception
+    if (factor < 0.0)
+      throw std::runtime_error("Negative factor");
+    // Wait until the given number of instances are running
+    const int waitFor = getProperty("WaitFor");
+    ++running;
+    const auto timeout =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (running < waitFor && std::chrono::steady_clock::now() < timeout)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    MatrixWorkspace_const_sptr input = getProperty("InputWorkspace");
+    MatrixWorkspace_sptr output;
+    if (input) {
+      output = input->clone();
+    } else {
+      output = boost::make_shared<WorkspaceTester>();
+      output->initialize(1, 1, 1);
+    }
+    output->mutableY(0)[0] *= factor;
+    setProperty("OutputWorkspace", output);
+  }
+
+  static std::atomic<int> running;
+};
+
+std::atomic<int> GraphTestScale::running{0};
+
+/// Adds its two inputs
+class GraphTestPlus : public Algorithm {
+public:
+  const std::string name() const override { return "GraphTestPlus"; }
+  int version() const override { return 1; }
+  const std::string summary() const override { return "Test summary"; }
+
+  void init() override {
+    declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
+        "LHSWorkspace", "", Direction::Input));
+    declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
+        "RHSWorkspace", "", Direction::Input));
+    declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
+        "OutputWorkspace", "", Direction::Output));
+  }
+
+  void exec() override {
+    MatrixWorkspace_const_sptr lhs = getProperty("LHSWorkspace");
+    MatrixWorkspace_const_sptr rhs = getProperty("RHSWorkspace");
+    MatrixWorkspace_sptr output = lhs->clone();
+    output->mutableY(0)[0] += rhs->y(0)[0];
+    setProperty("OutputWorkspace", output);
+  }
+};
+
+class AlgorithmGraphTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlgorithmGraphTest *createSuite() { return new AlgorithmGraphTest(); }
+  static void destroySuite(AlgorithmGraphTest *suite) { delete suite; }
+
+  AlgorithmGraphTest() { FrameworkManager::Instance(); }
+
+  void setUp() override { GraphTestScale::running = 0; }
+
+  void test_chain_passes_outputs_and_releases_intermediates() {
+    AlgorithmGraph graph;
+    const auto first = graph.addAlgorithm(scale(2.0), "first");
+    const auto second = graph.addAlgorithm(scale(3.0));
+    graph.connect(first, "OutputWorkspace", second, "InputWorkspace");
+    TS_ASSERT_THROWS_NOTHING(graph.execute());
+
+    MatrixWorkspace_sptr result =
+        graph.algorithm(second)->getProperty("OutputWorkspace");
+    TS_ASSERT(result);
+    TS_ASSERT_EQUALS(result->y(0)[0], 6.0);
+    MatrixWorkspace_sptr intermediate =
+        graph.algorithm(first)->getProperty("OutputWorkspace");
+    TS_ASSERT(!intermediate);
+    MatrixWorkspace_sptr input =
+        graph.algorithm(second)->getProperty("InputWorkspace");
+    TS_ASSERT(!input);
+    TS_ASSERT(graph.statistics(first).executed);
+    TS_ASSERT(graph.statistics(second).executed);
+    TS_ASSERT_LESS_THAN_EQUALS(graph.statistics(first).end,
+                               graph.statistics(second).start);
+  }
+
+  void test_keepOutput_keeps_an_intermediate() {
+    AlgorithmGraph graph;
+    const auto first = graph.addAlgorithm(scale(2.0));
+    const auto second = graph.addAlgorithm(scale(3.0));
+    graph.connect(first, "OutputWorkspace", second, "InputWorkspace");
+    graph.keepOutput(first, "OutputWorkspace");
+    graph.execute();
+    MatrixWorkspace_sptr intermediate =
+        graph.algorithm(first)->getProperty("OutputWorkspace");
+    TS_ASSERT(intermediate);
+    TS_ASSERT_EQUALS(intermediate->y(0)[0], 2.0);
+  }
+
+  void test_independent_branches_run_concurrently() {
+    AlgorithmGraph graph;
+    const auto lhs = graph.addAlgorithm(scale(2.0, 2));
+    const auto rhs = graph.addAlgorithm(scale(5.0, 2));
+    const auto plus = graph.addAlgorithm(algorithm<GraphTestPlus>());
+    graph.connect(lhs, "OutputWorkspace", plus, "LHSWorkspace");
+    graph.connect(rhs, "OutputWorkspace", plus, "RHSWorkspace");
+    graph.execute(2);
+
+    MatrixWorkspace_sptr result =
+        graph.algorithm(plus)->getProperty("OutputWorkspace");
+    TS_ASSERT_EQUALS(result->y(0)[0], 7.0);
+    TS_ASSERT_EQUALS(graph.maxConcurrency(), 2);
+    TS_ASSERT_DIFFERS(graph.statistics(lhs).thread,
+                      graph.statistics(rhs).thread);
+    TS_ASSERT_EQUALS(graph.dependencies(plus),
+                     std::vector<size_t>({lhs, rhs}));
+  }
+
+  void test_one_thread_runs_the_nodes_one_by_one() {
+    AlgorithmGraph graph;
+    graph.addAlgorithm(scale(2.0));
+    graph.addAlgorithm(scale(5.0));
+    graph.execute(1);
+    TS_ASSERT_EQUALS(graph.maxConcurrency(), 1);
+  }
+
+  void test_failure_is_rethrown_and_later_nodes_do_not_run() {
+    AlgorithmGraph graph;
+    const auto first = graph.addAlgorithm(scale(-1.0));
+    const auto second = graph.addAlgorithm(scale(3.0));
+    graph.connect(first, "OutputWorkspace", second, "InputWorkspace");
+    TS_ASSERT_THROWS_EQUALS(graph.execute(), const std::runtime_error &e,
+                            std::string(e.what()),
+                            "Execution of GraphTestScale in the algorithm "
+                            "graph failed: Negative factor");
+    TS_ASSERT(!graph.statistics(first).executed);
+    TS_ASSERT(!graph.statistics(second).executed);
+  }
+
+  void test_failure_with_unknown_exception_is_rethrown() {
+    AlgorithmGraph graph;
+    const auto first = graph.addAlgorithm(scale(-2.0));
+    const auto second = graph.addAlgorithm(scale(3.0));
+    graph.connect(first, "OutputWorkspace", second, "InputWorkspace");
+    TS_ASSERT_THROWS_EQUALS(graph.execute(), const std::runtime_error &e,
+                            std::string(e.what()),
+                            "Execution of GraphTestScale in the algorithm "
+                            "graph failed: Unknown exception");
+    TS_ASSERT(!graph.statistics(second).executed);
+  }
+
+  void test_cycles_are_rejected() {
+    AlgorithmGraph graph;
+    const auto first = graph.addAlgorithm(scale(2.0));
+    const auto second = graph.addAlgorithm(scale(3.0));
+    graph.connect(first, "OutputWorkspace", second, "InputWorkspace");
+    graph.connect(second, "OutputWorkspace", first, "InputWorkspace");
+    TS_ASSERT_THROWS(graph.execute(), std::runtime_error);
+  }
+
+  void test_connect_checks_the_properties() {
+    AlgorithmGraph graph;
+    const auto first = graph.addAlgorithm(scale(2.0));
+    const auto second = graph.addAlgorithm(scale(3.0));
+    TS_ASSERT_THROWS(
+        graph.connect(first, "InputWorkspace", second, "InputWorkspace"),
+        std::invalid_argument);
+    TS_ASSERT_THROWS(
+        graph.connect(first, "OutputWorkspace", second, "OutputWorkspace"),
+        std::invalid_argument);
+    TS_ASSERT_THROWS(graph.connect(first, "OutputWorkspace", second, "Factor"),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(graph.connect(first, "OutputWorkspace", second, "Nope"),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(
+        graph.connect(first, "OutputWorkspace", 2, "InputWorkspace"),
+        std::out_of_range);
+    graph.connect(first, "OutputWorkspace", second, "InputWorkspace");
+    TS_ASSERT_THROWS(
+        graph.connect(first, "OutputWorkspace", second, "InputWorkspace"),
+        std::invalid_argument);
+  }
+
+  void test_toDot_shows_the_nodes_and_edges() {
+    AlgorithmGraph graph;
+    const auto first = graph.addAlgorithm(scale(2.0), "sample");
+    const auto second = graph.addAlgorithm(scale(3.0));
+    graph.connect(first, "OutputWorkspace", second, "InputWorkspace");
+    const std::string dot = graph.toDot();
+    TS_ASSERT_DIFFERS(dot.find("n0 [label=\"sample\"]"), std::string::npos);
+    TS_ASSERT_DIFFERS(dot.find("n1 [label=\"GraphTestScale\"]"),
+                      std::string::npos);
+    TS_ASSERT_DIFFERS(
+        dot.find("n0 -> n1 [label=\"OutputWorkspace -> InputWorkspace\"]"),
+        std::string::npos);
+  }
+
+private:
+  template <typename T> boost::shared_ptr<T> algorithm() {
+    auto alg = boost::make_shared<T>();
+    alg->setChild(true);
+    alg->initialize();
+    alg->setPropertyValue("OutputWorkspace", "out");
+    return alg;
+  }
+
+  boost::shared_ptr<GraphTestScale> scale(double factor, int waitFor = 0) {
+    auto alg = algorithm<GraphTestScale>();
+    alg->setProperty("Factor", factor);
+    alg->setProperty("WaitFor", waitFor);
+    return alg;
+  }
+};
+
+#endif /* MANTID_API_ALGORITHMGRAPHTEST_H_ */
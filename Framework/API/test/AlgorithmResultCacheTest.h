@@ -0,0 +1,217 @@
+#ifndef MANTID_API_ALGORITHMRESULTCACHETEST_H_
+#define MANTID_API_ALGORITHMRESULTCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/AlgorithmResultCache.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidKernel/make_unique.h"
+#include "MantidTestHelpers/FakeObjects.h"
+
+using namespace Mantid::API;
+using namespace Mantid::Kernel;
+
+/// Scales its input and counts its executions
+class CacheTestAlgorithm : public Algorithm {
+public:
+  const std::string name() const override { return "CacheTestAlgorithm"; }
+  int version() const override { return 1; }
+  const std::string summary() const override { return "Test summary"; }
+  bool isCacheable() const override { return m_cacheable; }
+
+  void init() override {
+    declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
+        "InputWorkspace", "", Direction::Input));
+    declareProperty("Factor", 1.0);
+    declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
+        "OutputWorkspace", "", Direction::Output));
+    declareProperty("Sum", 0.0, Direction::Output);
+  }
+
+  void exec() override {
+    ++executions;
+    MatrixWorkspace_const_sptr input = getProperty("InputWorkspace");
+    const double factor = getProperty("Factor");
+    MatrixWorkspace_sptr output = input->clone();
+    double sum = 0.0;
+    for (size_t i = 0; i < output->getNumberHistograms(); ++i) {
+      for (auto &y : output->mutableY(i)) {
+        y *= factor;
+        sum += y;
+      }
+    }
+    setProperty("OutputWorkspace", output);
+    setProperty("Sum", sum);
+    if (m_declareInExec && !existsProperty("Extra")) {
+      declareProperty("Extra", sum, Direction::Output);
+    }
+  }
+
+  static int executions;
+  bool m_cacheable = true;
+  bool m_declareInExec = false;
+};
+
+int CacheTestAlgorithm::executions = 0;
+
+class AlgorithmResultCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlgorithmResultCacheTest *createSuite() {
+    return new AlgorithmResultCacheTest();
+  }
+  static void destroySuite(AlgorithmResultCacheTest *suite) { delete suite; }
+
+  AlgorithmResultCacheTest() { FrameworkManager::Instance(); }
+
+  void setUp() override {
+    m_limit = AlgorithmResultCache::Instance().memoryLimit();
+    AlgorithmResultCache::Instance().clear();
+    AlgorithmResultCache::Instance().setMemoryLimit(1024 * 1024);
+    CacheTestAlgorithm::executions = 0;
+    m_input = boost::make_shared<WorkspaceTester>();
+    m_input->initialize(3, 11, 10);
+  }
+
+  void tearDown() override {
+    AlgorithmResultCache::Instance().clear();
+    AlgorithmResultCache::Instance().setMemoryLimit(m_limit);
+  }
+
+  void test_second_execution_reuses_the_outputs() {
+    auto first = run(m_input, 2.0);
+    auto second = run(m_input, 2.0);
+    TS_ASSERT_EQUALS(CacheTestAlgorithm::executions, 1);
+    TS_ASSERT_EQUALS(AlgorithmResultCache::Instance().size(), 1);
+
+    MatrixWorkspace_sptr firstOutput = first->getProperty("OutputWorkspace");
+    MatrixWorkspace_sptr secondOutput = second->getProperty("OutputWorkspace");
+    TS_ASSERT_DIFFERS(firstOutput, secondOutput);
+    TS_ASSERT_EQUALS(secondOutput->y(1)[0], 2.0);
+    TS_ASSERT_EQUALS(secondOutput->getNumberHistograms(), 3);
+    const double sum = second->getProperty("Sum");
+    TS_ASSERT_EQUALS(sum, 60.0);
+  }
+
+  void test_modifying_an_output_does_not_change_the_cached_one() {
+    auto first = run(m_input, 2.0);
+    MatrixWorkspace_sptr firstOutput = first->getProperty("OutputWorkspace");
+    firstOutput->mutableY(0)[0] = 100.0;
+    auto second = run(m_input, 2.0);
+    MatrixWorkspace_sptr secondOutput = second->getProperty("OutputWorkspace");
+    TS_ASSERT_EQUALS(secondOutput->y(0)[0], 2.0);
+    secondOutput->mutableY(0)[1] = 100.0;
+    auto third = run(m_input, 2.0);
+    MatrixWorkspace_sptr thirdOutput = third->getProperty("OutputWorkspace");
+    TS_ASSERT_EQUALS(thirdOutput->y(0)[1], 2.0);
+    TS_ASSERT_EQUALS(CacheTestAlgorithm::executions, 1);
+  }
+
+  void test_different_property_values_are_not_reused() {
+    run(m_input, 2.0);
+    auto second = run(m_input, 3.0);
+    TS_ASSERT_EQUALS(CacheTestAlgorithm::executions, 2);
+    const double sum = second->getProperty("Sum");
+    TS_ASSERT_EQUALS(sum, 90.0);
+  }
+
+  void test_modified_input_is_not_reused() {
+    run(m_input, 2.0);
+    m_input->mutableY(2)[5] = 3.0;
+    auto second = run(m_input, 2.0);
+    TS_ASSERT_EQUALS(CacheTestAlgorithm::executions, 2);
+    const double sum = second->getProperty("Sum");
+    TS_ASSERT_EQUALS(sum, 64.0);
+  }
+
+  void test_equal_copy_of_input_is_reused() {
+    run(m_input, 2.0);
+    MatrixWorkspace_sptr copy = m_input->clone();
+    run(copy, 2.0);
+    TS_ASSERT_EQUALS(CacheTestAlgorithm::executions, 1);
+  }
+
+  void test_algorithms_that_are_not_cacheable_always_execute() {
+    run(m_input, 2.0, false);
+    run(m_input, 2.0, false);
+    TS_ASSERT_EQUALS(CacheTestAlgorithm::executions, 2);
+    TS_ASSERT_EQUALS(AlgorithmResultCache::Instance().size(), 0);
+  }
+
+  void test_executions_declaring_properties_are_not_cached() {
+    for (int i = 0; i < 2; ++i) {
+      auto alg = create(m_input, 2.0);
+      alg->m_declareInExec = true;
+      alg->execute();
+      TS_ASSERT(alg->isExecuted());
+      TS_ASSERT(alg->existsProperty("Extra"));
+    }
+    TS_ASSERT_EQUALS(CacheTestAlgorithm::executions, 2);
+    TS_ASSERT_EQUALS(AlgorithmResultCache::Instance().size(), 0);
+  }
+
+  void test_nothing_is_cached_when_disabled() {
+    AlgorithmResultCache::Instance().setMemoryLimit(0);
+    TS_ASSERT(!AlgorithmResultCache::Instance().isEnabled());
+    run(m_input, 2.0);
+    run(m_input, 2.0);
+    TS_ASSERT_EQUALS(CacheTestAlgorithm::executions, 2);
+  }
+
+  void test_least_recently_used_result_is_removed() {
+    run(m_input, 1.0);
+    const size_t resultSize = AlgorithmResultCache::Instance().memorySize();
+    TS_ASSERT(resultSize > 0);
+    AlgorithmResultCache::Instance().setMemoryLimit(2 * resultSize);
+    run(m_input, 2.0);
+    // Use the first result so that the second is the least recently used
+    run(m_input, 1.0);
+    run(m_input, 3.0);
+    TS_ASSERT_EQUALS(CacheTestAlgorithm::executions, 3);
+    TS_ASSERT_EQUALS(AlgorithmResultCache::Instance().size(), 2);
+    TS_ASSERT_EQUALS(AlgorithmResultCache::Instance().memorySize(),
+                     2 * resultSize);
+
+    run(m_input, 1.0);
+    TS_ASSERT_EQUALS(CacheTestAlgorithm::executions, 3);
+    run(m_input, 2.0);
+    TS_ASSERT_EQUALS(CacheTestAlgorithm::executions, 4);
+  }
+
+  void test_results_larger_than_the_limit_are_not_cached() {
+    AlgorithmResultCache::Instance().setMemoryLimit(1);
+    run(m_input, 2.0);
+    TS_ASSERT_EQUALS(AlgorithmResultCache::Instance().size(), 0);
+    TS_ASSERT_EQUALS(AlgorithmResultCache::Instance().memorySize(), 0);
+  }
+
+private:
+  boost::shared_ptr<CacheTestAlgorithm> run(MatrixWorkspace_sptr input,
+                                            double factor,
+                                            bool cacheable = true) {
+    auto alg = create(input, factor, cacheable);
+    alg->execute();
+    TS_ASSERT(alg->isExecuted());
+    return alg;
+  }
+
+  boost::shared_ptr<CacheTestAlgorithm>
+  create(MatrixWorkspace_sptr input, double factor, bool cacheable = true) {
+    auto alg = boost::make_shared<CacheTestAlgorithm>();
+    alg->m_cacheable = cacheable;
+    alg->setChild(true);
+    alg->initialize();
+    alg->setProperty("InputWorkspace", input);
+    alg->setProperty("Factor", factor);
+    alg->setPropertyValue("OutputWorkspace", "out");
+    return alg;
+  }
+
+  size_t m_limit;
+  boost::shared_ptr<WorkspaceTester> m_input;
+};
+
+#endif /* MANTID_API_ALGORITHMRESULTCACHETEST_H_ */
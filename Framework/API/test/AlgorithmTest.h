@@ -68,6 +68,16 @@ public:
 };
 DECLARE_ALGORITHM(StubbedWorkspaceAlgorithm)
 
+/**
+ * StubbedWorkspaceAlgorithm processing the members of groups concurrently
+ */
+class ParallelGroupsAlgorithm : public StubbedWorkspaceAlgorithm {
+public:
+  const std::string name() const override { return "ParallelGroupsAlgorithm"; }
+  bool canProcessGroupsInParallel() const override { return true; }
+};
+DECLARE_ALGORITHM(ParallelGroupsAlgorithm)
+
 class StubbedWorkspaceAlgorithm2 : public Algorithm {
 public:
   StubbedWorkspaceAlgorithm2() : Algorithm() {}
@@ -159,6 +169,18 @@ const std::string FailingAlgorithm::FAIL_MSG("Algorithm failed as requested");
 
 DECLARE_ALGORITHM(FailingAlgorithm)
 
+/**
+ * FailingAlgorithm processing the members of groups concurrently
+ */
+class ParallelFailingAlgorithm : public FailingAlgorithm {
+public:
+  const std::string name() const override {
+    return "ParallelFailingAlgorithm";
+  }
+  bool canProcessGroupsInParallel() const override { return true; }
+};
+DECLARE_ALGORITHM(ParallelFailingAlgorithm)
+
 class AlgorithmTest : public CxxTest::TestSuite {
 public:
   // This pair of boilerplate methods prevent the suite being created statically
@@ -709,6 +731,59 @@ public:
     }
   }
 
+  void test_processGroups_inParallel_keepsEntryOrder() {
+    Mantid::API::AnalysisDataService::Instance().clear();
+    std::string contents;
+    for (int i = 1; i <= 20; ++i) {
+      if (i > 1)
+        contents += ",";
+      contents += "A_" + Strings::toString(i);
+    }
+    makeWorkspaceGroup("A", contents);
+    makeWorkspaceGroup("B", "");
+
+    ParallelGroupsAlgorithm alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace1", "A");
+    alg.setPropertyValue("InputWorkspace2", "B");
+    alg.setPropertyValue("Number", "234");
+    alg.setPropertyValue("OutputWorkspace1", "D");
+    alg.setPropertyValue("OutputWorkspace2", "E");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    auto group =
+        AnalysisDataService::Instance().retrieveWS<WorkspaceGroup>("D");
+    TS_ASSERT_EQUALS(group->getNumberOfEntries(), 20);
+    for (int i = 0; i < group->getNumberOfEntries(); ++i) {
+      const std::string index = Strings::toString(i + 1);
+      auto ws = group->getItem(static_cast<size_t>(i));
+      TS_ASSERT_EQUALS(ws->getName(), "D_" + index);
+      TS_ASSERT_EQUALS(ws->getTitle(), "A_" + index + "+B+");
+      TS_ASSERT(AnalysisDataService::Instance().doesExist("E_" + index));
+    }
+  }
+
+  void test_processGroups_inParallel_failOnGroupMemberErrorMessage() {
+    makeWorkspaceGroup("A", "A_1,A_2,A_3,A_4");
+
+    ParallelFailingAlgorithm alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setLogging(false);
+    alg.setPropertyValue("InputWorkspace", "A");
+    alg.setPropertyValue("WsNameToFail", "A_3");
+
+    try {
+      alg.execute();
+      TS_FAIL("Exception wasn't thrown");
+    } catch (std::runtime_error &e) {
+      std::string msg(e.what());
+      TS_ASSERT(msg.find("for group entry 3 failed") != std::string::npos);
+      TS_ASSERT(msg.find(FailingAlgorithm::FAIL_MSG) != std::string::npos);
+    }
+  }
+
   /// Rewrite first input group
   void test_processGroups_rewriteFirstGroup() {
     Mantid::API::AnalysisDataService::Instance().clear();
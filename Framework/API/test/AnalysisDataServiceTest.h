@@ -349,6 +349,76 @@ public:
     ads.clear();
   }
 
+  void test_addObjects_names_workspaces_and_adds_group_members() {
+    Workspace_sptr ws(new MockWorkspace);
+    WorkspaceGroup_sptr group(new WorkspaceGroup);
+    group->addWorkspace(MockWorkspace_sptr(new MockWorkspace));
+    ads.addObjects({{"ws", ws}, {"group", group}});
+    TS_ASSERT_EQUALS(ads.size(), 3);
+    TS_ASSERT_EQUALS(ws->getName(), "ws");
+    TS_ASSERT_EQUALS(group->getName(), "group");
+    TS_ASSERT(ads.doesExist("group_1"));
+
+    // Invalid names stop anything being added
+    ads.setIllegalCharacterList("@");
+    Workspace_sptr other(new MockWorkspace);
+    TS_ASSERT_THROWS(ads.addObjects({{"other", other}, {"bad@name", other}}),
+                     std::invalid_argument);
+    TS_ASSERT(!ads.doesExist("other"));
+    ads.setIllegalCharacterList("");
+
+    ads.removeObjects({"ws", "group_1"});
+    TS_ASSERT_EQUALS(ads.size(), 1);
+    TS_ASSERT_EQUALS(ws->getName(), "");
+    // The group observes the ADS and drops the removed member
+    TS_ASSERT_EQUALS(group->size(), 0);
+    ads.clear();
+  }
+
+  void test_addObjects_adds_nested_group_members_at_once() {
+    WorkspaceGroup_sptr inner(new WorkspaceGroup);
+    inner->addWorkspace(MockWorkspace_sptr(new MockWorkspace));
+    Workspace_sptr shared(new MockWorkspace);
+    inner->addWorkspace(shared);
+    WorkspaceGroup_sptr group(new WorkspaceGroup);
+    group->addWorkspace(inner);
+    group->addWorkspace(shared);
+    Workspace_sptr ws(new MockWorkspace);
+    ads.addObjects({{"group", group}, {"ws", ws}});
+    // group, group_1, group_1_1, group_1_2 and ws; the shared member is only
+    // added once
+    TS_ASSERT_EQUALS(ads.size(), 5);
+    TS_ASSERT_EQUALS(inner->getName(), "group_1");
+    TS_ASSERT_EQUALS(shared->getName(), "group_1_2");
+    TS_ASSERT(ads.doesExist("group_1_1"));
+    ads.clear();
+  }
+
+  void test_addObjects_throws_if_the_name_of_an_anonymous_member_exists() {
+    ads.add("group_1", Workspace_sptr(new MockWorkspace));
+    WorkspaceGroup_sptr group(new WorkspaceGroup);
+    Workspace_sptr member(new MockWorkspace);
+    group->addWorkspace(member);
+    TS_ASSERT_THROWS(ads.addObjects({{"group", group}}), std::runtime_error);
+    TS_ASSERT(!ads.doesExist("group"));
+    TS_ASSERT_EQUALS(member->getName(), "");
+    ads.clear();
+  }
+
+  void test_addObjects_adds_no_group_members_if_a_name_exists() {
+    ads.add("ws", Workspace_sptr(new MockWorkspace));
+    WorkspaceGroup_sptr group(new WorkspaceGroup);
+    Workspace_sptr member(new MockWorkspace);
+    group->addWorkspace(member);
+    Workspace_sptr other(new MockWorkspace);
+    TS_ASSERT_THROWS(ads.addObjects({{"group", group}, {"ws", other}}),
+                     std::runtime_error);
+    TS_ASSERT_EQUALS(ads.size(), 1);
+    TS_ASSERT(!ads.doesExist("group_1"));
+    TS_ASSERT_EQUALS(member->getName(), "");
+    ads.clear();
+  }
+
   void test_removeFromGroup() {
     auto group = addGroupToADS("group");
     TS_ASSERT_EQUALS(ads.size(), 3);
@@ -0,0 +1,102 @@
+#ifndef MANTID_API_COMPILEDEXPRESSIONTEST_H_
+#define MANTID_API_COMPILEDEXPRESSIONTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/CompiledExpression.h"
+
+#include <cmath>
+#include <stdexcept>
+
+using Mantid::API::CompiledExpression;
+
+class CompiledExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompiledExpressionTest *createSuite() {
+    return new CompiledExpressionTest();
+  }
+  static void destroySuite(CompiledExpressionTest *suite) { delete suite; }
+
+  void test_evaluate() {
+    CompiledExpression expr("a*sin(b*x)/(1+x^2)-_pi", "x", {"a", "b"});
+    TS_ASSERT_EQUALS(expr.nParams(), 2);
+    auto x = makeX(600);
+    const double params[] = {1.3, 0.8};
+    std::vector<double> out(x.size());
+    expr.evaluate(x.data(), x.size(), params, out.data());
+    for (size_t i = 0; i < x.size(); ++i) {
+      const double expected =
+          1.3 * sin(0.8 * x[i]) / (1 + x[i] * x[i]) - M_PI;
+      TS_ASSERT_DELTA(out[i], expected, 1e-14);
+    }
+  }
+
+  void test_evaluate_formula_without_variable() {
+    CompiledExpression expr("2*a - exp(b)", "x", {"a", "b"});
+    auto x = makeX(10);
+    const double params[] = {1.5, 0.0};
+    std::vector<double> out(x.size());
+    expr.evaluate(x.data(), x.size(), params, out.data());
+    for (auto value : out) {
+      TS_ASSERT_EQUALS(value, 2.0);
+    }
+  }
+
+  void test_derivatives_match_finite_differences() {
+    CompiledExpression expr(
+        "h*exp(-((x-c)/s)^2/2) + sqrt(1+abs(a*x)) + a^x - log10(2+cos(c*x))",
+        "x", {"h", "c", "s", "a"});
+    auto x = makeX(300);
+    std::vector<double> params{2.1, 0.4, 0.9, 1.7};
+    std::vector<double> deriv(x.size()), plus(x.size()), minus(x.size());
+    for (size_t iParam = 0; iParam < params.size(); ++iParam) {
+      expr.derivative(iParam, x.data(), x.size(), params.data(),
+                      deriv.data());
+      const double step = 1e-6;
+      auto shifted = params;
+      shifted[iParam] += step;
+      expr.evaluate(x.data(), x.size(), shifted.data(), plus.data());
+      shifted[iParam] -= 2 * step;
+      expr.evaluate(x.data(), x.size(), shifted.data(), minus.data());
+      for (size_t i = 0; i < x.size(); ++i) {
+        const double numerical = (plus[i] - minus[i]) / (2 * step);
+        TS_ASSERT_DELTA(deriv[i], numerical, 1e-6 * (1 + fabs(numerical)));
+      }
+    }
+  }
+
+  void test_derivative_of_parameter_not_in_formula_is_zero() {
+    CompiledExpression expr("a*x", "x", {"a", "b"});
+    auto x = makeX(5);
+    const double params[] = {1.0, 2.0};
+    std::vector<double> out(x.size(), 1.0);
+    expr.derivative(1, x.data(), x.size(), params, out.data());
+    for (auto value : out) {
+      TS_ASSERT_EQUALS(value, 0.0);
+    }
+  }
+
+  void test_unsupported_formulas_throw() {
+    TS_ASSERT_THROWS(CompiledExpression("a*min(x,1)", "x", {"a"}),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(CompiledExpression("a*y", "x", {"a"}),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(CompiledExpression("x>a", "x", {"a"}),
+                     std::invalid_argument);
+    TS_ASSERT_THROWS(CompiledExpression("a*(x", "x", {"a"}),
+                     std::invalid_argument);
+  }
+
+private:
+  std::vector<double> makeX(size_t n) {
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) {
+      x[i] = -3.0 + 6.0 * static_cast<double>(i) / static_cast<double>(n);
+    }
+    return x;
+  }
+};
+
+#endif /* MANTID_API_COMPILEDEXPRESSIONTEST_H_ */
@@ -11,8 +11,12 @@
 #include "MantidAPI/ParamFunction.h"
 #include "MantidAPI/IFunction1D.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidTestHelpers/FakeObjects.h"
 
+#include <boost/make_shared.hpp>
+
 using namespace Mantid;
 using namespace Mantid::API;
 
@@ -131,6 +135,34 @@ public:
   void setFwhm(const double w) override { setParameter(2, w); }
 };
 
+/// A Gauss that records the number of points of its last evaluation
+class CountingGauss : public Gauss {
+public:
+  CountingGauss() : nEvaluated(0) {}
+  void function1D(double *out, const double *xValues,
+                  const size_t nData) const override {
+    nEvaluated = nData;
+    IPeakFunction::function1D(out, xValues, nData);
+  }
+  mutable size_t nEvaluated;
+};
+
+/// A dense Jacobian
+class CompositeFunctionTest_Jacobian : public Jacobian {
+public:
+  CompositeFunctionTest_Jacobian(size_t ny, size_t np)
+      : m_np(np), m_data(ny * np, -1.0) {}
+  void set(size_t iY, size_t iP, double value) override {
+    m_data[iY * m_np + iP] = value;
+  }
+  double get(size_t iY, size_t iP) override { return m_data[iY * m_np + iP]; }
+  void zero() override { m_data.assign(m_data.size(), 0.0); }
+
+private:
+  size_t m_np;
+  std::vector<double> m_data;
+};
+
 class Linear : public ParamFunction, public IFunction1D {
 public:
   Linear() {
@@ -1192,6 +1224,86 @@ public:
     b = fun->getAttribute("NumDeriv").asBool();
     TS_ASSERT(!b);
   }
+
+  void test_peaks_are_evaluated_on_their_support() {
+    CompositeFunction mfun;
+    auto bk = boost::make_shared<Linear>();
+    bk->setParameter("a", 0.5);
+    bk->setParameter("b", 0.1);
+    auto g1 = boost::make_shared<CountingGauss>();
+    g1->setParameter("c", -5.05);
+    g1->setParameter("h", 2.0);
+    g1->setParameter("s", 1.0);
+    auto g2 = boost::make_shared<CountingGauss>();
+    g2->setParameter("c", 6.05);
+    g2->setParameter("h", 3.0);
+    g2->setParameter("s", 0.5);
+    mfun.addFunction(bk);
+    mfun.addFunction(g1);
+    mfun.addFunction(g2);
+
+    FunctionDomain1DVector x(-10.0, 10.0, 201);
+    x.setPeakRadius(3);
+    FunctionValues values(x);
+    mfun.function(x, values);
+    // Only the points within 3 "FWHMs" of the centres are evaluated
+    TS_ASSERT_EQUALS(g1->nEvaluated, 60);
+    TS_ASSERT_EQUALS(g2->nEvaluated, 30);
+
+    FunctionValues bkValues(x), g1Values(x), g2Values(x);
+    bk->function(x, bkValues);
+    g1->function(x, g1Values);
+    g2->function(x, g2Values);
+    TS_ASSERT_EQUALS(g1->nEvaluated, 201);
+    for (size_t i = 0; i < x.size(); ++i) {
+      TS_ASSERT_DELTA(values[i], bkValues[i] + g1Values[i] + g2Values[i],
+                      1e-15);
+    }
+
+    CompositeFunctionTest_Jacobian jacobian(x.size(), mfun.nParams());
+    mfun.functionDeriv(x, jacobian);
+    CompositeFunctionTest_Jacobian expected(x.size(), mfun.nParams());
+    PartialJacobian bkJ(&expected, 0);
+    bk->functionDeriv(x, bkJ);
+    PartialJacobian g1J(&expected, 2);
+    g1->functionDeriv(x, g1J);
+    PartialJacobian g2J(&expected, 5);
+    g2->functionDeriv(x, g2J);
+    for (size_t i = 0; i < x.size(); ++i) {
+      for (size_t ip = 0; ip < mfun.nParams(); ++ip) {
+        TS_ASSERT_EQUALS(jacobian.get(i, ip), expected.get(i, ip));
+      }
+    }
+  }
+
+  void test_peaks_are_evaluated_everywhere_without_peak_radius() {
+    CompositeFunction mfun;
+    auto g = boost::make_shared<CountingGauss>();
+    g->setParameter("c", 1.0);
+    mfun.addFunction(g);
+    mfun.addFunction(boost::make_shared<Linear>());
+
+    FunctionDomain1DVector x(-10.0, 10.0, 201);
+    FunctionValues values(x);
+    mfun.function(x, values);
+    TS_ASSERT_EQUALS(g->nEvaluated, 201);
+  }
+
+  void test_peaks_are_evaluated_everywhere_on_unsorted_domain() {
+    CompositeFunction mfun;
+    auto g = boost::make_shared<CountingGauss>();
+    g->setParameter("c", 1.0);
+    mfun.addFunction(g);
+
+    std::vector<double> xValues{3.0, -2.0, 1.0, 0.0, 20.0};
+    FunctionDomain1DVector x(xValues);
+    x.setPeakRadius(2);
+    FunctionValues values(x);
+    mfun.function(x, values);
+    TS_ASSERT_EQUALS(g->nEvaluated, 5);
+    TS_ASSERT_DELTA(values[2], 1.0, 1e-15);
+    TS_ASSERT_EQUALS(values[4], 0.0);
+  }
 };
 
 #endif /*COMPOSITEFUNCTIONTEST_H_*/
@@ -83,4 +83,24 @@ public:
   }
 };
 
+class FrameworkManagerTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static FrameworkManagerTestPerformance *createSuite() {
+    return new FrameworkManagerTestPerformance();
+  }
+  static void destroySuite(FrameworkManagerTestPerformance *suite) {
+    delete suite;
+  }
+
+  void test_create_algorithms_from_plugins() {
+    // With plugins.lazyLoading the libraries providing these are opened now
+    TS_ASSERT_THROWS_NOTHING(
+        FrameworkManager::Instance().createAlgorithm("Load"));
+    TS_ASSERT_THROWS_NOTHING(
+        FrameworkManager::Instance().createAlgorithm("SaveNexus"));
+  }
+};
+
 #endif /*FRAMEWORKMANAGERTEST_H_*/
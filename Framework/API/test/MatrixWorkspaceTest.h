@@ -895,6 +895,99 @@ public:
                !ws->monitorWorkspace())
   }
 
+  void test_modificationStamp_changes_with_mutable_access_only() {
+    auto ws = makeWorkspaceWithDetectors(3, 2);
+    ws->settleModificationStamps();
+    const auto &constWS = *ws;
+    uint64_t stamp = ws->modificationStamp();
+    const uint64_t stamp0 = constWS.getSpectrum(0).modificationStamp();
+    const uint64_t stamp1 = constWS.getSpectrum(1).modificationStamp();
+    TS_ASSERT_EQUALS(constWS.y(1)[0], 1.0);
+    TS_ASSERT_EQUALS(constWS.run().getProperties().size(), 0);
+    TS_ASSERT_EQUALS(ws->modificationStamp(), stamp);
+
+    ws->mutableY(1)[0] = 2.0;
+    TS_ASSERT_LESS_THAN(stamp, ws->modificationStamp());
+    TS_ASSERT_LESS_THAN(stamp1, constWS.getSpectrum(1).modificationStamp());
+    TS_ASSERT_EQUALS(constWS.getSpectrum(0).modificationStamp(), stamp0);
+
+    stamp = ws->modificationStamp();
+    ws->instrumentParameters();
+    TS_ASSERT_LESS_THAN(stamp, ws->modificationStamp());
+    stamp = ws->modificationStamp();
+    ws->mutableRun();
+    TS_ASSERT_LESS_THAN(stamp, ws->modificationStamp());
+    stamp = ws->modificationStamp();
+    ws->setYUnit("Counts");
+    TS_ASSERT_LESS_THAN(stamp, ws->modificationStamp());
+  }
+
+  void test_settleModificationStamps_settles_the_modified_spectra() {
+    auto ws = makeWorkspaceWithDetectors(3, 2);
+    ws->settleModificationStamps();
+    const auto &constWS = *ws;
+    ws->mutableY(2)[0] = 2.0;
+    ws->settleModificationStamps();
+    const uint64_t stamp = constWS.getSpectrum(2).modificationStamp();
+    TS_ASSERT_EQUALS(constWS.getSpectrum(2).modificationStamp(), stamp);
+    // Nothing has been modified, so the spectra are left alone
+    ws->settleModificationStamps();
+    TS_ASSERT_EQUALS(constWS.getSpectrum(2).modificationStamp(), stamp);
+  }
+
+  void test_clone_keeps_the_contentHash() {
+    auto ws = makeWorkspaceWithDetectors(3, 2);
+    ws->mutableY(2)[1] = 5.0;
+    MatrixWorkspace_sptr copy = ws->clone();
+    TS_ASSERT_EQUALS(copy->contentHash(), ws->contentHash());
+  }
+
+  void test_contentHash_changes_with_the_content() {
+    auto ws = makeWorkspaceWithDetectors(3, 2);
+    const size_t hash = ws->contentHash();
+    TS_ASSERT_EQUALS(ws->contentHash(), hash);
+
+    ws->mutableY(1)[0] = 2.0;
+    TS_ASSERT_DIFFERS(ws->contentHash(), hash);
+    ws->mutableY(1)[0] = 1.0;
+    TS_ASSERT_EQUALS(ws->contentHash(), hash);
+
+    ws->getSpectrum(2).setSpectrumNo(42);
+    TS_ASSERT_DIFFERS(ws->contentHash(), hash);
+    ws->getSpectrum(2).setSpectrumNo(3);
+    TS_ASSERT_EQUALS(ws->contentHash(), hash);
+
+    ws->mutableRun().addProperty("Temperature", 4.0);
+    TS_ASSERT_DIFFERS(ws->contentHash(), hash);
+  }
+
+  void test_contentHash_after_a_modification_equals_a_new_hash() {
+    auto ws = makeWorkspaceWithDetectors(100, 2);
+    ws->contentHash();
+    ws->mutableY(17)[1] = 3.0;
+    ws->getSpectrum(42).setDetectorID(7);
+    ws->setYUnit("Counts");
+    // The copy has no hashes to reuse
+    MatrixWorkspace_sptr copy = ws->clone();
+    TS_ASSERT_EQUALS(ws->contentHash(), copy->contentHash());
+  }
+
+  void test_contentHash_sees_writes_through_a_held_reference() {
+    auto ws = makeWorkspaceWithDetectors(3, 2);
+    ws->settleModificationStamps();
+    auto &y = ws->mutableY(1);
+    const size_t hash = ws->contentHash();
+    y[0] = 2.0;
+    TS_ASSERT_DIFFERS(ws->contentHash(), hash);
+
+    ws->settleModificationStamps();
+    const uint64_t stamp = ws->modificationStamp();
+    const size_t settledHash = ws->contentHash();
+    TS_ASSERT_EQUALS(ws->modificationStamp(), stamp);
+    MatrixWorkspace_sptr copy = ws->clone();
+    TS_ASSERT_EQUALS(copy->contentHash(), settledHash);
+  }
+
   void test_getXIndex() {
     WorkspaceTester ws;
     ws.initialize(1, 4, 3);
@@ -58,6 +58,13 @@ private:
     }
   };
 
+  /// Create an algorithm history with the given execution count
+  static AlgorithmHistory_sptr makeHistory(const std::string &name,
+                                           std::size_t execCount) {
+    return boost::make_shared<AlgorithmHistory>(
+        name, 1, DateAndTime::defaultTime(), -1.0, execCount);
+  }
+
 public:
   void test_New_History_Is_Empty() {
     WorkspaceHistory history;
@@ -124,6 +131,67 @@ public:
     Mantid::API::AlgorithmFactory::Instance().unsubscribe("SimpleSum2", 1);
   }
 
+  void test_Copies_Share_Histories_Until_Modified() {
+    WorkspaceHistory history;
+    history.addHistory(makeHistory("FirstAlgorithm", 0));
+    WorkspaceHistory copy(history);
+    TS_ASSERT_EQUALS(&copy.getAlgorithmHistories(),
+                     &history.getAlgorithmHistories());
+
+    copy.addHistory(makeHistory("SecondAlgorithm", 1));
+    TS_ASSERT_DIFFERS(&copy.getAlgorithmHistories(),
+                      &history.getAlgorithmHistories());
+    TS_ASSERT_EQUALS(history.size(), 1);
+    TS_ASSERT_EQUALS(copy.size(), 2);
+    // The entries themselves are still shared
+    TS_ASSERT_EQUALS(copy.getAlgorithmHistory(0),
+                     history.getAlgorithmHistory(0));
+  }
+
+  void test_Adding_A_Subset_Or_Superset_Shares_The_Larger_History() {
+    WorkspaceHistory input;
+    input.addHistory(makeHistory("FirstAlgorithm", 0));
+    input.addHistory(makeHistory("SecondAlgorithm", 1));
+    WorkspaceHistory output;
+    output.addHistory(input);
+    TS_ASSERT_EQUALS(&output.getAlgorithmHistories(),
+                     &input.getAlgorithmHistories());
+
+    WorkspaceHistory earlier;
+    earlier.addHistory(input.getAlgorithmHistory(0));
+    output.addHistory(earlier);
+    TS_ASSERT_EQUALS(&output.getAlgorithmHistories(),
+                     &input.getAlgorithmHistories());
+    earlier.addHistory(input);
+    TS_ASSERT_EQUALS(&earlier.getAlgorithmHistories(),
+                     &input.getAlgorithmHistories());
+  }
+
+  void test_Adding_Different_Histories_Merges_Them() {
+    WorkspaceHistory lhs;
+    lhs.addHistory(makeHistory("FirstAlgorithm", 0));
+    lhs.addHistory(makeHistory("ThirdAlgorithm", 2));
+    WorkspaceHistory rhs;
+    rhs.addHistory(makeHistory("SecondAlgorithm", 1));
+    WorkspaceHistory copy(lhs);
+    lhs.addHistory(rhs);
+
+    TS_ASSERT_EQUALS(lhs.size(), 3);
+    TS_ASSERT_EQUALS(lhs.getAlgorithmHistory(1)->name(), "SecondAlgorithm");
+    TS_ASSERT_EQUALS(lhs.getAlgorithmHistory(2)->name(), "ThirdAlgorithm");
+    TS_ASSERT_EQUALS(copy.size(), 2);
+    TS_ASSERT_EQUALS(rhs.size(), 1);
+  }
+
+  void test_clearHistory_does_not_affect_copies() {
+    WorkspaceHistory history;
+    history.addHistory(makeHistory("FirstAlgorithm", 0));
+    WorkspaceHistory copy(history);
+    copy.clearHistory();
+    TS_ASSERT(copy.empty());
+    TS_ASSERT_EQUALS(history.size(), 1);
+  }
+
   void test_Empty_History_Throws_When_Retrieving_Attempting_To_Algorithms() {
     WorkspaceHistory emptyHistory;
     TS_ASSERT_THROWS(emptyHistory.lastAlgorithm(), std::out_of_range);
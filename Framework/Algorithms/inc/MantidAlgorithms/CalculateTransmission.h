@@ -94,6 +94,11 @@ private:
   /// Execution code
   void exec() override;
 
+  /// Create a child algorithm that sums some spectra of a workspace
+  API::IAlgorithm_sptr sumSpectra(API::MatrixWorkspace_sptr ws,
+                                  const std::vector<size_t> &indices,
+                                  double startProgress = -1.,
+                                  double endProgress = -1.);
   /// Pull out a single spectrum from a 2D workspace
   API::MatrixWorkspace_sptr extractSpectra(API::MatrixWorkspace_sptr ws,
                                            const std::vector<size_t> &indices);
@@ -82,6 +82,8 @@ public:
   const std::string category() const override {
     return "Transforms\\Splitting";
   }
+  /// The members of input groups are processed independently
+  bool canProcessGroupsInParallel() const override { return true; }
 
 private:
   /// Initialisation code
@@ -69,6 +69,8 @@ public:
   const std::string category() const override { return "Transforms\\Rebin"; }
   /// Algorithm's aliases
   const std::string alias() const override { return "rebin"; }
+  /// The members of input groups are processed independently
+  bool canProcessGroupsInParallel() const override { return true; }
 
   static std::vector<double>
   rebinParamsFromInput(const std::vector<double> &inParams,
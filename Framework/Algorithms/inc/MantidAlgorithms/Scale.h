@@ -62,6 +62,8 @@ public:
   const std::string category() const override {
     return "Arithmetic;CorrectionFunctions";
   }
+  /// The members of input groups are processed independently
+  bool canProcessGroupsInParallel() const override { return true; }
 
 private:
   /// Initialisation code
@@ -61,6 +61,8 @@ public:
   const std::string category() const override {
     return "CorrectionFunctions\\InstrumentCorrections";
   }
+  /// The outputs depend on the inputs only
+  bool isCacheable() const override { return true; }
 
 private:
   // Overridden Algorithm methods
@@ -3,6 +3,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAlgorithms/CalculateTransmission.h"
+#include "MantidAPI/AlgorithmGraph.h"
 #include "MantidAPI/CommonBinsValidator.h"
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/HistogramValidator.h"
@@ -194,28 +195,41 @@ void CalculateTransmission::exec() {
                                     transPropName + ".");
   }
 
-  MatrixWorkspace_sptr sampleInc;
-  if (normaliseToMonitor)
-    sampleInc = this->extractSpectra(sampleWS,
-                                     std::vector<size_t>(1, beamMonitorIndex));
-  MatrixWorkspace_sptr sampleTrans =
-      this->extractSpectra(sampleWS, transmissionIndices);
-
-  MatrixWorkspace_sptr directInc;
-  if (normaliseToMonitor)
-    directInc = this->extractSpectra(directWS,
-                                     std::vector<size_t>(1, beamMonitorIndex));
-  MatrixWorkspace_sptr directTrans =
-      this->extractSpectra(directWS, transmissionIndices);
-
   double start = m_done;
-  Progress progress(this, start, m_done += 0.2, 2);
+  Progress progress(this, start, m_done += 0.6, 2);
   progress.report("CalculateTransmission: Dividing transmission by incident");
 
-  // The main calculation
-  MatrixWorkspace_sptr transmission = sampleTrans / directTrans;
-  if (normaliseToMonitor)
-    transmission = transmission * (directInc / sampleInc);
+  // The main calculation. The spectra of the two runs are summed
+  // concurrently, as are the divisions that only depend on the sums.
+  AlgorithmGraph graph;
+  const auto sampleTrans = graph.addAlgorithm(
+      sumSpectra(sampleWS, transmissionIndices), "SampleTransmission");
+  const auto directTrans = graph.addAlgorithm(
+      sumSpectra(directWS, transmissionIndices), "DirectTransmission");
+  auto transmissionNode = graph.addAlgorithm(createChildAlgorithm("Divide"));
+  graph.connect(sampleTrans, "OutputWorkspace", transmissionNode,
+                "LHSWorkspace");
+  graph.connect(directTrans, "OutputWorkspace", transmissionNode,
+                "RHSWorkspace");
+  if (normaliseToMonitor) {
+    const std::vector<size_t> beamMonitorIndices(1, beamMonitorIndex);
+    const auto sampleInc = graph.addAlgorithm(
+        sumSpectra(sampleWS, beamMonitorIndices), "SampleIncident");
+    const auto directInc = graph.addAlgorithm(
+        sumSpectra(directWS, beamMonitorIndices), "DirectIncident");
+    const auto incident = graph.addAlgorithm(createChildAlgorithm("Divide"));
+    graph.connect(directInc, "OutputWorkspace", incident, "LHSWorkspace");
+    graph.connect(sampleInc, "OutputWorkspace", incident, "RHSWorkspace");
+    const auto normalised =
+        graph.addAlgorithm(createChildAlgorithm("Multiply"));
+    graph.connect(transmissionNode, "OutputWorkspace", normalised,
+                  "LHSWorkspace");
+    graph.connect(incident, "OutputWorkspace", normalised, "RHSWorkspace");
+    transmissionNode = normalised;
+  }
+  graph.execute();
+  MatrixWorkspace_sptr transmission =
+      graph.algorithm(transmissionNode)->getProperty("OutputWorkspace");
 
   // This workspace is now a distribution
   progress.report("CalculateTransmission: Dividing transmission by incident");
@@ -248,19 +262,20 @@ void CalculateTransmission::exec() {
 }
 
 /**
- * Extracts multiple spectra from a Workspace2D into a new workspaces, using
- *SumSpectra.
+ * Creates a SumSpectra child algorithm that sums multiple spectra of a
+ * workspace. The algorithm is not executed.
  *
- * @param ws      :: The workspace containing the spectrum to extract
- * @param indices :: The workspace index of the spectrum to extract
+ * @param ws      :: The workspace containing the spectra to sum
+ * @param indices :: The workspace indices of the spectra to sum
+ * @param startProgress :: The progress of this algorithm when the child starts
+ * @param endProgress :: The progress of this algorithm when the child ends
  *
- * @returns a Workspace2D containing the extracted spectrum
- * @throws runtime_error if the ExtractSingleSpectrum algorithm fails during
- *execution
+ * @returns the SumSpectra algorithm
  */
-API::MatrixWorkspace_sptr
-CalculateTransmission::extractSpectra(API::MatrixWorkspace_sptr ws,
-                                      const std::vector<size_t> &indices) {
+API::IAlgorithm_sptr
+CalculateTransmission::sumSpectra(API::MatrixWorkspace_sptr ws,
+                                  const std::vector<size_t> &indices,
+                                  double startProgress, double endProgress) {
   // Compile a comma separated list of indices that we can pass to SumSpectra.
   std::vector<std::string> indexStrings(indices.size());
   // A bug in boost 1.53: https://svn.boost.org/trac/boost/ticket/7421
@@ -274,11 +289,29 @@ CalculateTransmission::extractSpectra(API::MatrixWorkspace_sptr ws,
       static_cast<from_size_t>(boost::lexical_cast<std::string, size_t>));
   const std::string commaIndexList = boost::algorithm::join(indexStrings, ",");
 
-  double start = m_done;
   IAlgorithm_sptr childAlg =
-      createChildAlgorithm("SumSpectra", start, m_done += 0.1);
+      createChildAlgorithm("SumSpectra", startProgress, endProgress);
   childAlg->setProperty<MatrixWorkspace_sptr>("InputWorkspace", ws);
   childAlg->setPropertyValue("ListOfWorkspaceIndices", commaIndexList);
+  return childAlg;
+}
+
+/**
+ * Extracts multiple spectra from a Workspace2D into a new workspaces, using
+ *SumSpectra.
+ *
+ * @param ws      :: The workspace containing the spectrum to extract
+ * @param indices :: The workspace index of the spectrum to extract
+ *
+ * @returns a Workspace2D containing the extracted spectrum
+ * @throws runtime_error if the ExtractSingleSpectrum algorithm fails during
+ *execution
+ */
+API::MatrixWorkspace_sptr
+CalculateTransmission::extractSpectra(API::MatrixWorkspace_sptr ws,
+                                      const std::vector<size_t> &indices) {
+  double start = m_done;
+  IAlgorithm_sptr childAlg = sumSpectra(ws, indices, start, m_done += 0.1);
   childAlg->executeAsChildAlg();
 
   // Only get to here if successful
@@ -9,13 +9,12 @@
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/EqualBinsChecker.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/Math/FFT.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/UnitLabelTypes.h"
 
 #include <boost/shared_array.hpp>
 
-#include <gsl/gsl_errno.h>
-
 #include <algorithm>
 #include <cmath>
 #include <functional>
@@ -116,9 +115,6 @@ void FFT::exec() {
 
   const int dys = nPoints % 2;
 
-  m_wavetable = gsl_fft_complex_wavetable_alloc(nPoints);
-  m_workspace = gsl_fft_complex_workspace_alloc(nPoints);
-
   // Hardcoded "centerShift == true" means that the zero on the x axis is
   // assumed to be in the centre, at point with index i = ySize/2.
   // Set to false to make zero at i = 0.
@@ -140,9 +136,6 @@ void FFT::exec() {
     m_outWS->setSharedX(m_iAbs, m_outWS->sharedX(m_iRe));
   }
 
-  gsl_fft_complex_wavetable_free(m_wavetable);
-  gsl_fft_complex_workspace_free(m_workspace);
-
   setProperty("OutputWorkspace", m_outWS);
 }
 
@@ -175,7 +168,7 @@ void FFT::transformForward(boost::shared_array<double> &data, const int xSize,
   double shift = getPhaseShift(
       m_inWS->points(iReal)); // extra phase to be applied to the transform
 
-  gsl_fft_complex_forward(data.get(), 1, ySize, m_wavetable, m_workspace);
+  Kernel::FFT::complexForward(data.get(), ySize);
 
   /* The Fourier transform overwrites array 'data'. Recall that the Fourier
   * transform is
@@ -236,7 +229,7 @@ void FFT::transformBackward(boost::shared_array<double> &data, const int xSize,
     data[2 * i + 1] = isComplex ? m_inImagWS->y(iImag)[j] : 0.;
   }
 
-  gsl_fft_complex_inverse(data.get(), 1, ySize, m_wavetable, m_workspace);
+  Kernel::FFT::complexInverse(data.get(), ySize);
 
   for (int i = 0; i < ySize; i++) {
     double x = df * i;
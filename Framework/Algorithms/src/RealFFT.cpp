@@ -8,9 +8,6 @@
 #include "MantidKernel/Exception.h"
 
 #include <boost/shared_array.hpp>
-#include <gsl/gsl_errno.h>
-#include <gsl/gsl_fft_halfcomplex.h>
-#include <gsl/gsl_fft_real.h>
 
 #define REAL(z, i) ((z)[2 * (i)])
 #define IMAG(z, i) ((z)[2 * (i) + 1])
@@ -23,6 +20,7 @@
 
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/Math/FFT.h"
 
 #include "MantidHistogramData/LinearGenerator.h"
 
@@ -105,7 +103,6 @@ void RealFFT::exec() {
     tAxis->setLabel(2, "Modulus");
     outWS->replaceAxis(1, tAxis);
 
-    gsl_fft_real_workspace *workspace = gsl_fft_real_workspace_alloc(ySize);
     boost::shared_array<double> data(new double[2 * ySize]);
 
     auto &yData = inWS->mutableY(spec);
@@ -113,10 +110,7 @@ void RealFFT::exec() {
       data[i] = yData[i];
     }
 
-    gsl_fft_real_wavetable *wavetable = gsl_fft_real_wavetable_alloc(ySize);
-    gsl_fft_real_transform(data.get(), 1, ySize, wavetable, workspace);
-    gsl_fft_real_wavetable_free(wavetable);
-    gsl_fft_real_workspace_free(workspace);
+    Kernel::FFT::realForward(data.get(), ySize);
 
     auto &x = outWS->mutableX(0);
     auto &y1 = outWS->mutableY(0);
@@ -156,8 +150,6 @@ void RealFFT::exec() {
     tAxis->setLabel(0, "Real");
     outWS->replaceAxis(1, tAxis);
 
-    gsl_fft_real_workspace *workspace = gsl_fft_real_workspace_alloc(yOutSize);
-
     auto &xData = outWS->mutableX(0);
     auto &yData = outWS->mutableY(0);
     auto &y0 = inWS->mutableY(0);
@@ -175,13 +167,7 @@ void RealFFT::exec() {
       }
     }
 
-    gsl_fft_halfcomplex_wavetable *wavetable =
-        gsl_fft_halfcomplex_wavetable_alloc(yOutSize);
-
-    // &(yData[0]) because gsl func wants non const double data[]
-    gsl_fft_halfcomplex_inverse(&(yData[0]), 1, yOutSize, wavetable, workspace);
-    gsl_fft_halfcomplex_wavetable_free(wavetable);
-    gsl_fft_real_workspace_free(workspace);
+    Kernel::FFT::halfComplexInverse(&(yData[0]), yOutSize);
 
     std::generate(xData.begin(), xData.end(),
                   HistogramData::LinearGenerator(0, df));
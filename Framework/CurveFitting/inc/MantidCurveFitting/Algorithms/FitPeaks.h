@@ -0,0 +1,106 @@
+#ifndef MANTID_CURVEFITTING_FITPEAKS_H_
+#define MANTID_CURVEFITTING_FITPEAKS_H_
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+
+namespace Mantid {
+namespace CurveFitting {
+namespace Algorithms {
+
+/** FitPeaks : fit peaks at known positions in all spectra of a workspace.
+
+  Each peak is fitted with a peak function on a linear (flat or quadratic)
+  background inside its fit window. The minimizer is called directly on a
+  cost function instead of running a Fit child algorithm for every peak.
+
+  The spectra are split into blocks of neighbouring spectra which are fitted
+  in parallel. Within a block the spectra are fitted in order and the fitted
+  peak shape of a spectrum is the starting point for the same peak in the
+  next spectrum. The blocks don't depend on the number of threads, so
+  neither do the results.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport FitPeaks : public API::Algorithm {
+public:
+  const std::string name() const override { return "FitPeaks"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "Optimization"; }
+  const std::string summary() const override {
+    return "Fits peaks at known positions in all spectra of a workspace.";
+  }
+
+  /// The status of a fitted peak, in the status column of the table
+  enum Status {
+    /// The peak has been fitted
+    Success = 0,
+    /// The fit window has too few points or no signal above the background
+    NoSignal = 1,
+    /// The fitted centre is outside the fit window
+    CentreOutsideWindow = 2,
+    /// The fitted peak has a non-positive height or width
+    BadShape = 3,
+    /// The minimizer failed or chi squared is not finite
+    FitFailed = 4
+  };
+
+  /// The result of fitting one peak
+  struct PeakResult {
+    /// Whether the peak has been fitted or why not
+    Status status = Success;
+    double centre = 0.0;
+    double height = 0.0;
+    double fwhm = 0.0;
+    double intensity = 0.0;
+    /// The background parameters A0, A1 and A2
+    double background[3] = {0.0, 0.0, 0.0};
+    /// Chi squared divided by the degrees of freedom
+    double chi2 = 0.0;
+  };
+
+private:
+  void init() override;
+  void exec() override;
+  std::map<std::string, std::string> validateInputs() override;
+
+  /// Get the fit windows of the peaks
+  std::vector<double> getFitWindows(const std::vector<double> &centres) const;
+  /// Fit the peaks in a block of neighbouring spectra
+  void fitBlock(const API::MatrixWorkspace &ws, size_t first, size_t last,
+                const std::vector<double> &windows, PeakResult *results) const;
+
+  /// The name of the peak function
+  std::string m_peakFunction;
+  /// The name of the background function
+  std::string m_backgroundFunction;
+  /// The minimizer and its settings
+  std::string m_minimizer;
+  /// The maximum number of iterations of each fit
+  size_t m_maxIterations = 0;
+};
+
+} // namespace Algorithms
+} // namespace CurveFitting
+} // namespace Mantid
+
+#endif /* MANTID_CURVEFITTING_FITPEAKS_H_ */
@@ -78,6 +78,17 @@ class DLLExport PlotPeakByLogValue : public API::Algorithm {
     std::vector<int> indx; ///< a list of ws indices to fit if i and spec < 0
   };
 
+  /** Structure to identify a single spectrum to fit
+    */
+  struct FitJob {
+    std::string name;             ///< Name of a workspace or file
+    API::MatrixWorkspace_sptr ws; ///< shared pointer to the workspace
+    int index;                    ///< Workspace index of the spectrum
+    double logValue;              ///< Value of the log (or axis) to plot
+    std::string minimizer;        ///< The minimizer string for this fit
+    std::string wsBaseName;       ///< Base name of the output of the fit
+  };
+
 public:
   /// Algorithm's name for identification overriding a virtual method
   const std::string name() const override { return "PlotPeakByLogValue"; }
@@ -99,6 +110,10 @@ private:
   /// Get a workspace
   InputData getWorkspace(const InputData &data);
 
+  /// Fit a single spectrum
+  API::IFunction_sptr fitSpectrum(const FitJob &job, API::IFunction_sptr fun,
+                                  double &chi2) const;
+
   /// Set any WorkspaceIndex attributes in the fitting function
   void setWorkspaceIndexAttribute(API::IFunction_sptr fun, int wsIndex) const;
 
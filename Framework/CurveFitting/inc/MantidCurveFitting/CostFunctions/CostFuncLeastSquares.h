@@ -72,6 +72,22 @@ public:
   void drop();
 
 protected:
+  /// Storage reused by the calculations on a domain, so that nothing is
+  /// allocated in each iteration of a fit
+  struct Buffers {
+    /// The fitting weights
+    std::vector<double> weights;
+    /// The weighted residuals
+    std::vector<double> residuals;
+    /// The derivatives of the fitting function, a row per data point, scaled
+    /// by the weights
+    std::vector<double> jacobian;
+    /// The derivatives of the cost function for all parameters
+    std::vector<double> der;
+    /// The Hessian for all parameters
+    std::vector<double> hessian;
+  };
+
   void calActiveCovarianceMatrix(GSLMatrix &covar,
                                  double epsrel = 1e-8) override;
 
@@ -81,10 +97,22 @@ protected:
                           API::FunctionDomain_sptr domain,
                           API::FunctionValues_sptr values,
                           bool evalDeriv = true, bool evalHessian = true) const;
+  /// Calculate the contribution of a domain to the cost function value
+  double calVal(API::IFunction_sptr function, API::FunctionDomain_sptr domain,
+                API::FunctionValues_sptr values, Buffers &buffers) const;
+  /// Add the contributions of a domain to the given value, derivatives and
+  /// Hessian
+  void calValDerivHessian(API::IFunction_sptr function,
+                          API::FunctionDomain_sptr domain,
+                          API::FunctionValues_sptr values, bool evalHessian,
+                          double &value, GSLVector &der, GSLMatrix &hessian,
+                          Buffers &buffers) const;
 
   /// Get mapped weights from FunctionValues
-  virtual std::vector<double>
-  getFitWeights(API::FunctionValues_sptr values) const;
+  std::vector<double> getFitWeights(API::FunctionValues_sptr values) const;
+  /// Get mapped weights from FunctionValues into a buffer
+  virtual void getFitWeights(API::FunctionValues_sptr values,
+                             std::vector<double> &weights) const;
 
   /// Flag to include constraint in cost function value
   bool m_includePenalty;
@@ -97,6 +125,9 @@ protected:
   mutable double m_pushedValue;
   mutable GSLVector m_pushedParams;
 
+  /// Buffers for the calculations that are not shared between threads
+  mutable Buffers m_buffers;
+
   friend class CurveFitting::SeqDomain;
   friend class CurveFitting::ParDomain;
 
@@ -56,8 +56,9 @@ public:
   std::string shortName() const override { return "Rwp"; }
 
 private:
-  std::vector<double>
-  getFitWeights(API::FunctionValues_sptr values) const override;
+  using CostFuncLeastSquares::getFitWeights;
+  void getFitWeights(API::FunctionValues_sptr values,
+                     std::vector<double> &weights) const override;
 
   /// Get weight (1/sigma)
   double getWeight(API::FunctionValues_sptr values, size_t i,
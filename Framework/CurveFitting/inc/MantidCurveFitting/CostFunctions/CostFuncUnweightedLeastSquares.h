@@ -48,8 +48,9 @@ public:
 
 protected:
   void calActiveCovarianceMatrix(GSLMatrix &covar, double epsrel) override;
-  std::vector<double>
-  getFitWeights(API::FunctionValues_sptr values) const override;
+  using CostFuncLeastSquares::getFitWeights;
+  void getFitWeights(API::FunctionValues_sptr values,
+                     std::vector<double> &weights) const override;
 
   double getResidualVariance() const;
 };
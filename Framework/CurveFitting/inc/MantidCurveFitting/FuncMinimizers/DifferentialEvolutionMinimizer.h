@@ -0,0 +1,95 @@
+#ifndef MANTID_CURVEFITTING_DIFFERENTIALEVOLUTIONMINIMIZER_H_
+#define MANTID_CURVEFITTING_DIFFERENTIALEVOLUTIONMINIMIZER_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidAPI/IFuncMinimizer.h"
+#include "MantidKernel/MersenneTwister.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace CurveFitting {
+namespace FuncMinimisers {
+/** A global minimizer using differential evolution (DE/rand/1/bin).
+
+    A population of parameter sets is spread around the starting values. In
+    each iteration every member is crossed with a mutant made from three
+    other members, and the trial replaces the member if its cost is not
+    larger. The first member starts at the starting values, so the result is
+    never worse than the starting point.
+
+    The costs of the trials of one generation are independent and are
+    calculated in parallel, each thread using its own copy of the cost
+    function and of the fitting function. The trials are generated serially
+    from a seeded random number generator, so the result doesn't depend on
+    the number of threads. Cost functions that cannot be copied exactly are
+    evaluated serially.
+
+    Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+    National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>.
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport DifferentialEvolutionMinimizer : public API::IFuncMinimizer {
+public:
+  /// Constructor
+  DifferentialEvolutionMinimizer();
+
+  /// Name of the minimizer.
+  std::string name() const override { return "DifferentialEvolution"; }
+  /// Initialize minimizer, i.e. pass a function to minimize.
+  void initialize(API::ICostFunction_sptr function,
+                  size_t maxIterations = 0) override;
+  /// Evolve the population by one generation
+  bool iterate(size_t) override;
+  /// Return the lowest cost found
+  double costFunctionVal() override;
+  /// True if the costs are calculated in parallel
+  bool isParallel() const { return !m_copies.empty(); }
+
+private:
+  /// Make copies of the cost function to use in parallel
+  void createCopies(const std::vector<double> &start, double startCost);
+  /// Calculate the costs of a set of points
+  void evaluate(const std::vector<std::vector<double>> &points,
+                std::vector<double> &costs);
+  /// Set the best point to the cost function
+  void updateBest();
+
+  /// The cost function to minimize
+  API::ICostFunction_sptr m_costFunction;
+  /// Copies of the cost function, one for each thread
+  std::vector<API::ICostFunction_sptr> m_copies;
+  /// The parameter sets of the population
+  std::vector<std::vector<double>> m_population;
+  /// The costs of the members of the population
+  std::vector<double> m_costs;
+  /// Index of the member with the lowest cost
+  size_t m_best;
+  /// The random number generator
+  Kernel::MersenneTwister m_random;
+};
+
+} // namespace FuncMinimisers
+} // namespace CurveFitting
+} // namespace Mantid
+
+#endif /*MANTID_CURVEFITTING_DIFFERENTIALEVOLUTIONMINIMIZER_H_*/
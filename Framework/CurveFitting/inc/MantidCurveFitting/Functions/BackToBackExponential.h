@@ -5,6 +5,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAPI/IPeakFunction.h"
+#include "MantidCurveFitting/Functions/TabulatedPeakProfile.h"
 
 namespace Mantid {
 namespace CurveFitting {
@@ -74,6 +75,7 @@ public:
                   const size_t nData) const override;
   void functionDeriv1D(API::Jacobian *jacobian, const double *xValues,
                        const size_t nData) override;
+  std::pair<double, double> getSupportInterval(int peakRadius) const override;
 
 protected:
   /// overwrite IFunction base class method, which declare function parameters
@@ -84,6 +86,11 @@ protected:
   void functionDerivLocal(API::Jacobian *, const double *,
                           const size_t) override {}
   double expWidth() const;
+  double supportHalfWidth() const;
+
+private:
+  /// Cache of the peak shape
+  TabulatedPeakProfile m_profile;
 };
 
 typedef boost::shared_ptr<BackToBackExponential> BackToBackExponential_sptr;
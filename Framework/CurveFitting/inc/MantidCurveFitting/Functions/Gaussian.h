@@ -60,6 +60,7 @@ public:
   void setHeight(const double h) override;
   void setFwhm(const double w) override;
   void setIntensity(const double i) override;
+  std::pair<double, double> getSupportInterval(int peakRadius) const override;
 
   void fixCentre() override;
   void unfixCentre() override;
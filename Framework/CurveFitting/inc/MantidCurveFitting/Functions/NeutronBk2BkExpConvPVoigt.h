@@ -3,6 +3,7 @@
 
 #include "MantidKernel/System.h"
 #include "MantidAPI/IPowderDiffPeakFunction.h"
+#include "MantidCurveFitting/Functions/TabulatedPeakProfile.h"
 
 namespace Mantid {
 namespace CurveFitting {
@@ -100,6 +101,10 @@ private:
                   const double sigma2, const double invert_sqrt2sigma,
                   const bool explicitoutput = false) const;
 
+  /// Calculate the peak from a table of its shape
+  bool calTabulated(const double *xValues, const size_t nData,
+                    double *out) const;
+
   static int s_peakRadius;
 
   /// Set 2 functions to be hidden from client
@@ -127,6 +132,9 @@ private:
   /// Thermal/Epithermal neutron related
   mutable double m_eta;
   mutable double m_N;
+
+  /// Cache of the peak shape
+  TabulatedPeakProfile m_profile;
 };
 
 } // namespace Functions
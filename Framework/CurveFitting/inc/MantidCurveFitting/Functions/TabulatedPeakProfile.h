@@ -0,0 +1,98 @@
+#ifndef MANTID_CURVEFITTING_TABULATEDPEAKPROFILE_H_
+#define MANTID_CURVEFITTING_TABULATEDPEAKPROFILE_H_
+
+#include "MantidCurveFitting/DllConfig.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace CurveFitting {
+namespace Functions {
+
+/**
+  A cache of the shape of an expensive peak function, tabulated on a uniform
+  grid over the peak's support window and interpolated with cubic
+  polynomials through the four nearest grid points.
+
+  The shape is identified by a key, a vector of the parameters it depends
+  on. Changing only the height or the centre of the peak reuses the table.
+  The table is built the first time a key is requested, so that all the
+  values of a shape, for example within one numerical Jacobian, are
+  interpolated.
+  The grid is refined until the interpolation error at the midpoints of the
+  grid intervals is below the tolerance times the peak maximum. If that
+  needs too many points, or the shape is not finite, the shape is not
+  tabulated and the caller evaluates it directly.
+
+  The tolerance is set by the curvefitting.peakProfileTolerance property. A
+  value of 0, the default, switches tabulation off. Interpolated values
+  differ slightly from direct ones, so turning it on changes fit results.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_CURVEFITTING_DLL TabulatedPeakProfile {
+public:
+  /// The shape of a peak of unit height centred at zero
+  typedef std::function<double(double)> Shape;
+
+  TabulatedPeakProfile();
+  /// Copies start with an empty cache
+  TabulatedPeakProfile(const TabulatedPeakProfile &other);
+  TabulatedPeakProfile &operator=(const TabulatedPeakProfile &other);
+
+  /// Evaluate a peak using a table of its shape, if there is one
+  bool evaluate(const std::vector<double> &key, const Shape &shape,
+                double halfWidth, double centre, double scale,
+                const double *xValues, size_t nData, double *out) const;
+
+  /// Set the relative interpolation error allowed, less than 1 (0 disables
+  /// tabulation)
+  void setTolerance(double tolerance);
+  /// Get the relative interpolation error allowed
+  double tolerance() const { return m_tolerance; }
+  /// Number of points in the current table, 0 if there is none
+  size_t tableSize() const;
+
+private:
+  struct Table;
+  /// Build a table of a shape
+  std::shared_ptr<const Table> makeTable(const Shape &shape,
+                                         double halfWidth) const;
+
+  /// The relative interpolation error allowed
+  double m_tolerance;
+  /// Guards the cached state
+  mutable std::mutex m_mutex;
+  /// The key of the last requested shape, with the half-width appended
+  mutable std::vector<double> m_key;
+  /// The table of the last key, null if it isn't tabulated
+  mutable std::shared_ptr<const Table> m_table;
+};
+
+} // namespace Functions
+} // namespace CurveFitting
+} // namespace Mantid
+
+#endif /* MANTID_CURVEFITTING_TABULATEDPEAKPROFILE_H_ */
@@ -3,6 +3,7 @@
 
 #include "MantidKernel/System.h"
 #include "MantidAPI/IPowderDiffPeakFunction.h"
+#include "MantidCurveFitting/Functions/TabulatedPeakProfile.h"
 
 #include <complex>
 
@@ -135,6 +136,10 @@ private:
                   const double sigma2, const double invert_sqrt2sigma,
                   const bool explicitoutput = false) const;
 
+  /// Calculate the peak from a table of its shape
+  bool calTabulated(const double *xValues, const size_t nData,
+                    double *out) const;
+
   /// Set 2 functions to be hidden from client
   /*
   virtual void setCentre(const double c);
@@ -161,6 +166,9 @@ private:
   mutable double m_eta;
   mutable double m_N;
 
+  /// Cache of the peak shape
+  TabulatedPeakProfile m_profile;
+
   /// Override setting a new value to the
 
   //-----------  For Parallelization -----------------------------------------
@@ -8,11 +8,16 @@
 #include "MantidAPI/IFunction1D.h"
 #include <boost/shared_array.hpp>
 
+#include <memory>
+
 namespace mu {
 class Parser;
 }
 
 namespace Mantid {
+namespace API {
+class CompiledExpression;
+}
 namespace CurveFitting {
 namespace Functions {
 /**
@@ -94,8 +99,15 @@ private:
   /// Temporary data storage used in functionDeriv
   mutable boost::shared_array<double> m_tmp1;
 
+  /// The formula compiled for evaluation on arrays, if it is supported
+  std::unique_ptr<API::CompiledExpression> m_compiled;
+
   /// mu::Parser callback function for setting variables.
   static double *AddVariable(const char *varName, void *pufun);
+  /// Compile the formula and check it against muParser
+  void compileFormula();
+  /// The current parameter values
+  std::vector<double> parameterValues() const;
 };
 
 } // namespace Functions
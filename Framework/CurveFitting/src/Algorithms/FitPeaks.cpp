@@ -0,0 +1,408 @@
+#include "MantidCurveFitting/Algorithms/FitPeaks.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
+
+#include "MantidAPI/CompositeFunction.h"
+#include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/IFuncMinimizer.h"
+#include "MantidAPI/IPeakFunction.h"
+#include "MantidAPI/ITableWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/TableRow.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/ListValidator.h"
+#include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Mantid {
+namespace CurveFitting {
+namespace Algorithms {
+using namespace API;
+using namespace Kernel;
+
+DECLARE_ALGORITHM(FitPeaks)
+
+namespace {
+/// The number of neighbouring spectra fitted in order by one thread
+const size_t BLOCK_SIZE = 64;
+
+/// The names of the background functions for the BackgroundType values
+const std::map<std::string, std::string> BACKGROUND_FUNCTIONS{
+    {"Flat", "FlatBackground"},
+    {"Linear", "LinearBackground"},
+    {"Quadratic", "Quadratic"}};
+
+/// The functions fitted to one peak, reused for all spectra of a block
+struct PeakModel {
+  IPeakFunction_sptr peak;
+  IFunction_sptr background;
+  boost::shared_ptr<CompositeFunction> composite;
+  /// The default parameters of the peak
+  std::vector<double> defaults;
+  /// True if the peak has been fitted in the previous spectrum
+  bool previousFitted;
+};
+
+/**
+ * Estimate the starting values of the peak and background parameters from
+ * the data in a fit window. The background is the line through the end
+ * points and the peak is at the highest point above it. The width is
+ * estimated at half of the maximum unless the peak shape of the previous
+ * spectrum is kept.
+ * @param model :: The functions to set the starting values to.
+ * @param x :: The x values in the window.
+ * @param y :: The y values in the window.
+ * @param n :: The number of points in the window.
+ * @return false if there is no signal above the background.
+ */
+bool estimate(PeakModel &model, const double *x, const double *y, size_t n) {
+  const double slope = (y[n - 1] - y[0]) / (x[n - 1] - x[0]);
+  const double intercept = y[0] - slope * x[0];
+  size_t iMax = 0;
+  double height = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    const double signal = y[i] - (intercept + slope * x[i]);
+    if (signal > height) {
+      height = signal;
+      iMax = i;
+    }
+  }
+  if (!(height > 0.0) || !std::isfinite(height)) {
+    return false;
+  }
+
+  auto &background = *model.background;
+  for (size_t i = 0; i < background.nParams(); ++i) {
+    background.setParameter(i, 0.0);
+  }
+  if (background.nParams() == 1) {
+    background.setParameter(0, 0.5 * (y[0] + y[n - 1]));
+  } else {
+    background.setParameter(0, intercept);
+    background.setParameter(1, slope);
+  }
+
+  auto &peak = *model.peak;
+  if (!model.previousFitted) {
+    for (size_t i = 0; i < peak.nParams(); ++i) {
+      peak.setParameter(i, model.defaults[i]);
+    }
+    const double halfMax = 0.5 * height;
+    size_t left = iMax;
+    while (left > 0 && y[left] - (intercept + slope * x[left]) > halfMax) {
+      --left;
+    }
+    size_t right = iMax;
+    while (right < n - 1 &&
+           y[right] - (intercept + slope * x[right]) > halfMax) {
+      ++right;
+    }
+    double fwhm = x[right] - x[left];
+    if (!(fwhm > 0.0)) {
+      fwhm = (x[n - 1] - x[0]) / static_cast<double>(n - 1);
+    }
+    peak.setFwhm(fwhm);
+  }
+  peak.setCentre(x[iMax]);
+  peak.setHeight(height);
+  return true;
+}
+} // namespace
+
+void FitPeaks::init() {
+  declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
+                      "InputWorkspace", "", Direction::Input),
+                  "The workspace with the peaks to fit.");
+  auto mustBeNonNegative = boost::make_shared<BoundedValidator<int>>();
+  mustBeNonNegative->setLower(0);
+  declareProperty("StartWorkspaceIndex", 0, mustBeNonNegative,
+                  "The first spectrum to fit.");
+  declareProperty("StopWorkspaceIndex", EMPTY_INT(), mustBeNonNegative,
+                  "The last spectrum to fit. The default is the last "
+                  "spectrum of the workspace.");
+  declareProperty(
+      make_unique<ArrayProperty<double>>(
+          "PeakCentres",
+          boost::make_shared<MandatoryValidator<std::vector<double>>>()),
+      "The expected centres of the peaks, in increasing order.");
+  declareProperty(make_unique<ArrayProperty<double>>("FitWindowBoundaryList"),
+                  "The left and right boundaries of the fit window of each "
+                  "peak. If empty, the windows end half way between "
+                  "neighbouring peaks.");
+
+  auto peakFunctionValidator = boost::make_shared<StringListValidator>(
+      FunctionFactory::Instance().getFunctionNames<IPeakFunction>());
+  declareProperty("PeakFunction", "Gaussian", peakFunctionValidator,
+                  "The function fitted to each peak.");
+  std::vector<std::string> backgroundTypes{"Flat", "Linear", "Quadratic"};
+  declareProperty("BackgroundType", "Linear",
+                  boost::make_shared<StringListValidator>(backgroundTypes),
+                  "The background fitted under each peak.");
+  declareProperty("Minimizer", "Levenberg-MarquardtMD",
+                  "The minimizer and its settings.");
+  auto mustBePositive = boost::make_shared<BoundedValidator<int>>();
+  mustBePositive->setLower(1);
+  declareProperty("MaxIterations", 50, mustBePositive,
+                  "The maximum number of iterations of each fit.");
+
+  declareProperty(make_unique<WorkspaceProperty<MatrixWorkspace>>(
+                      "OutputWorkspace", "", Direction::Output),
+                  "A workspace with a spectrum for each fitted spectrum and "
+                  "a point for each peak. The Y values are the fitted centres "
+                  "or NaN if the peak couldn't be fitted.");
+  declareProperty(make_unique<WorkspaceProperty<ITableWorkspace>>(
+                      "FittedPeakParametersWorkspace", "", Direction::Output),
+                  "A table with the fitted peak and background parameters.");
+}
+
+/// Check the peak centres and the fit windows.
+std::map<std::string, std::string> FitPeaks::validateInputs() {
+  std::map<std::string, std::string> issues;
+  const std::vector<double> centres = getProperty("PeakCentres");
+  if (!std::is_sorted(centres.begin(), centres.end())) {
+    issues["PeakCentres"] = "The peak centres must be in increasing order.";
+  }
+  const std::vector<double> windows = getProperty("FitWindowBoundaryList");
+  if (windows.empty()) {
+    if (centres.size() < 2) {
+      issues["FitWindowBoundaryList"] =
+          "The fit window must be given for a single peak.";
+    }
+  } else if (windows.size() != 2 * centres.size()) {
+    issues["FitWindowBoundaryList"] =
+        "There must be two boundaries for each peak.";
+  } else {
+    for (size_t i = 0; i < centres.size(); ++i) {
+      if (!(windows[2 * i] < centres[i] && centres[i] < windows[2 * i + 1])) {
+        issues["FitWindowBoundaryList"] =
+            "Each fit window must contain its peak centre.";
+        break;
+      }
+    }
+  }
+  const int start = getProperty("StartWorkspaceIndex");
+  const int stop = getProperty("StopWorkspaceIndex");
+  if (!isEmpty(stop) && stop < start) {
+    issues["StopWorkspaceIndex"] =
+        "StopWorkspaceIndex must not be less than StartWorkspaceIndex.";
+  }
+  return issues;
+}
+
+void FitPeaks::exec() {
+  MatrixWorkspace_const_sptr inputWS = getProperty("InputWorkspace");
+  const std::vector<double> centres = getProperty("PeakCentres");
+  const auto windows = getFitWindows(centres);
+  const size_t nPeaks = centres.size();
+
+  const int startIndex = getProperty("StartWorkspaceIndex");
+  const size_t start = static_cast<size_t>(startIndex);
+  int stopIndex = getProperty("StopWorkspaceIndex");
+  const size_t nHistograms = inputWS->getNumberHistograms();
+  if (isEmpty(stopIndex)) {
+    stopIndex = static_cast<int>(nHistograms) - 1;
+  }
+  const size_t stop = static_cast<size_t>(stopIndex);
+  if (start >= nHistograms || stop >= nHistograms) {
+    throw std::invalid_argument("The workspace indices are out of range.");
+  }
+  const size_t nSpectra = stop - start + 1;
+
+  m_peakFunction = getPropertyValue("PeakFunction");
+  m_backgroundFunction =
+      BACKGROUND_FUNCTIONS.at(getPropertyValue("BackgroundType"));
+  m_minimizer = getPropertyValue("Minimizer");
+  const int maxIterations = getProperty("MaxIterations");
+  m_maxIterations = static_cast<size_t>(maxIterations);
+
+  std::vector<PeakResult> results(nSpectra * nPeaks);
+  const size_t nBlocks = (nSpectra + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  Progress progress(this, 0.0, 1.0, nBlocks);
+  PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS))
+  for (int64_t block = 0; block < static_cast<int64_t>(nBlocks); ++block) {
+    PARALLEL_START_INTERUPT_REGION
+    const size_t first = start + static_cast<size_t>(block) * BLOCK_SIZE;
+    const size_t last = std::min(first + BLOCK_SIZE, stop + 1);
+    fitBlock(*inputWS, first, last, windows,
+             &results[(first - start) * nPeaks]);
+    progress.report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  auto outputWS = WorkspaceFactory::Instance().create("Workspace2D", nSpectra,
+                                                      nPeaks, nPeaks);
+  auto table = WorkspaceFactory::Instance().createTable("TableWorkspace");
+  table->addColumn("int", "wsindex");
+  table->addColumn("int", "peakindex");
+  table->addColumn("int", "status");
+  table->addColumn("double", "centre");
+  table->addColumn("double", "height");
+  table->addColumn("double", "fwhm");
+  table->addColumn("double", "intensity");
+  table->addColumn("double", "A0");
+  table->addColumn("double", "A1");
+  table->addColumn("double", "A2");
+  table->addColumn("double", "chi2");
+  for (size_t i = 0; i < nSpectra; ++i) {
+    outputWS->mutableX(i) = centres;
+    auto &y = outputWS->mutableY(i);
+    for (size_t p = 0; p < nPeaks; ++p) {
+      const auto &result = results[i * nPeaks + p];
+      y[p] = result.status == Success
+                 ? result.centre
+                 : std::numeric_limits<double>::quiet_NaN();
+      TableRow row = table->appendRow();
+      row << static_cast<int>(start + i) << static_cast<int>(p)
+          << static_cast<int>(result.status) << result.centre << result.height
+          << result.fwhm << result.intensity << result.background[0]
+          << result.background[1] << result.background[2] << result.chi2;
+    }
+  }
+
+  setProperty("OutputWorkspace", outputWS);
+  setProperty("FittedPeakParametersWorkspace", table);
+}
+
+/**
+ * Get the fit windows of the peaks, from the FitWindowBoundaryList property
+ * or half way between neighbouring peaks. The outer windows are as wide on
+ * both sides of their peaks.
+ * @param centres :: The expected peak centres.
+ * @return The left and right boundary of each window.
+ */
+std::vector<double>
+FitPeaks::getFitWindows(const std::vector<double> &centres) const {
+  std::vector<double> windows = getProperty("FitWindowBoundaryList");
+  if (!windows.empty()) {
+    return windows;
+  }
+  const size_t nPeaks = centres.size();
+  windows.resize(2 * nPeaks);
+  for (size_t i = 0; i + 1 < nPeaks; ++i) {
+    const double middle = 0.5 * (centres[i] + centres[i + 1]);
+    windows[2 * i + 1] = middle;
+    windows[2 * i + 2] = middle;
+  }
+  windows.front() = 2.0 * centres.front() - windows[1];
+  windows.back() = 2.0 * centres.back() - windows[2 * nPeaks - 2];
+  return windows;
+}
+
+/**
+ * Fit the peaks in a block of neighbouring spectra. The spectra are fitted in
+ * order and each peak starts from its fitted shape in the previous spectrum
+ * if that fit succeeded.
+ * @param ws :: The input workspace.
+ * @param first :: The index of the first spectrum of the block.
+ * @param last :: The index after the last spectrum of the block.
+ * @param windows :: The fit windows of the peaks.
+ * @param results :: The results of the block, for each spectrum and peak.
+ */
+void FitPeaks::fitBlock(const MatrixWorkspace &ws, size_t first, size_t last,
+                        const std::vector<double> &windows,
+                        PeakResult *results) const {
+  const size_t nPeaks = windows.size() / 2;
+
+  std::vector<PeakModel> models(nPeaks);
+  for (auto &model : models) {
+    model.peak = boost::dynamic_pointer_cast<IPeakFunction>(
+        FunctionFactory::Instance().createFunction(m_peakFunction));
+    model.background =
+        FunctionFactory::Instance().createFunction(m_backgroundFunction);
+    model.composite = boost::make_shared<CompositeFunction>();
+    model.composite->addFunction(model.peak);
+    model.composite->addFunction(model.background);
+    for (size_t i = 0; i < model.peak->nParams(); ++i) {
+      model.defaults.push_back(model.peak->getParameter(i));
+    }
+    model.previousFitted = false;
+  }
+
+  PeakResult *result = results;
+  for (size_t wi = first; wi < last; ++wi) {
+    const auto points = ws.points(wi);
+    const auto &x = points.rawData();
+    const auto &y = ws.y(wi).rawData();
+    const auto &e = ws.e(wi).rawData();
+    for (size_t p = 0; p < nPeaks; ++p, ++result) {
+      auto &model = models[p];
+      const double left = windows[2 * p];
+      const double right = windows[2 * p + 1];
+      const size_t iStart = static_cast<size_t>(
+          std::lower_bound(x.begin(), x.end(), left) - x.begin());
+      const size_t iEnd = static_cast<size_t>(
+          std::upper_bound(x.begin(), x.end(), right) - x.begin());
+      const size_t n = iEnd > iStart ? iEnd - iStart : 0;
+      if (n <= model.composite->nParams() ||
+          !estimate(model, &x[iStart], &y[iStart], n)) {
+        result->status = NoSignal;
+        model.previousFitted = false;
+        continue;
+      }
+
+      auto domain = boost::make_shared<FunctionDomain1DVector>(
+          x.begin() + iStart, x.begin() + iEnd);
+      auto values = boost::make_shared<FunctionValues>(*domain);
+      for (size_t i = 0; i < n; ++i) {
+        const double error = e[iStart + i];
+        values->setFitData(i, y[iStart + i]);
+        values->setFitWeight(i, error > 0.0 ? 1.0 / error : 1.0);
+      }
+      auto costFunction =
+          boost::make_shared<CostFunctions::CostFuncLeastSquares>();
+      costFunction->setFittingFunction(model.composite, domain, values);
+      double chi2 = std::numeric_limits<double>::quiet_NaN();
+      try {
+        auto minimizer =
+            FuncMinimizerFactory::Instance().createMinimizer(m_minimizer);
+        minimizer->initialize(costFunction, m_maxIterations);
+        if (minimizer->minimize(m_maxIterations)) {
+          const double dof = static_cast<double>(n - costFunction->nParams());
+          chi2 = minimizer->costFunctionVal() / dof;
+        } else {
+          g_log.debug() << "Fit of peak " << p << " in spectrum " << wi
+                        << " failed: " << minimizer->getError() << '\n';
+        }
+      } catch (std::exception &ex) {
+        // A bad peak only fails its own fit, see FitFailed below
+        g_log.debug() << "Fit of peak " << p << " in spectrum " << wi
+                      << " failed: " << ex.what() << '\n';
+      }
+      const auto &peak = *model.peak;
+      result->centre = peak.centre();
+      result->height = peak.height();
+      result->fwhm = std::fabs(peak.fwhm());
+      result->intensity = peak.intensity();
+      for (size_t i = 0; i < model.background->nParams(); ++i) {
+        result->background[i] = model.background->getParameter(i);
+      }
+      result->chi2 = chi2;
+
+      model.previousFitted = false;
+      if (!std::isfinite(chi2)) {
+        result->status = FitFailed;
+      } else if (!(result->centre >= left && result->centre <= right)) {
+        result->status = CentreOutsideWindow;
+      } else if (!(result->height > 0.0) || !(result->fwhm > 0.0)) {
+        result->status = BadShape;
+      } else {
+        result->status = Success;
+        model.previousFitted = true;
+      }
+    }
+  }
+}
+
+} // namespace Algorithms
+} // namespace CurveFitting
+} // namespace Mantid
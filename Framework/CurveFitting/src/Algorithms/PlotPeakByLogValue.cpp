@@ -27,6 +27,7 @@
 #include "MantidAPI/WorkspaceFactory.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 
 namespace {
 Mantid::Kernel::Logger g_log("PlotPeakByLogValue");
@@ -131,6 +132,10 @@ void PlotPeakByLogValue::init() {
                   "If true and CreateOutput is true then the value of each "
                   "member of a Composite Function is also output.");
 
+  declareProperty("Parallel", false,
+                  "If true and FitType is 'Individual' the spectra are "
+                  "fitted concurrently.\n"
+                  "Sequential fits are always run one after another.");
   declareProperty(
       make_unique<Kernel::PropertyWithValue<bool>>("ConvolveMembers", false),
       "If true and OutputCompositeMembers is true members of any "
@@ -160,8 +165,6 @@ void PlotPeakByLogValue::exec() {
   bool individual = getPropertyValue("FitType") == "Individual";
   bool passWSIndexToFunction = getProperty("PassWSIndexToFunction");
   bool createFitOutput = getProperty("CreateOutput");
-  bool outputCompositeMembers = getProperty("OutputCompositeMembers");
-  bool outputConvolvedMembers = getProperty("ConvolveMembers");
   m_baseName = getPropertyValue("OutputWorkspace");
 
   bool isDataName = false; // if true first output column is of type string and
@@ -205,8 +208,8 @@ void PlotPeakByLogValue::exec() {
   std::vector<std::string> fit_workspaces;
   std::vector<std::string> parameter_workspaces;
 
-  double dProg = 1. / static_cast<double>(wsNames.size());
-  double Prog = 0.;
+  // Collect the spectra to fit, in the order of the output rows
+  std::vector<FitJob> jobs;
   for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
     InputData data = getWorkspace(wsNames[i]);
 
@@ -230,26 +233,22 @@ void PlotPeakByLogValue::exec() {
       jend = data.indx.back() + 1;
     }
 
-    if (createFitOutput) {
-      covariance_workspaces.reserve(covariance_workspaces.size() + jend);
-      fit_workspaces.reserve(fit_workspaces.size() + jend);
-      parameter_workspaces.reserve(parameter_workspaces.size() + jend);
-    }
-
-    dProg /= abs(jend - j);
     for (; j < jend; ++j) {
-
+      FitJob job;
+      job.name = wsNames[i].name;
+      job.ws = data.ws;
+      job.index = j;
       // Find the log value: it is either a log-file value or simply the
       // workspace number
-      double logValue = 0;
+      job.logValue = 0;
       if (logName.empty()) {
         API::Axis *axis = data.ws->getAxis(1);
         if (dynamic_cast<BinEdgeAxis *>(axis)) {
           double lowerEdge((*axis)(j));
           double upperEdge((*axis)(j + 1));
-          logValue = lowerEdge + (upperEdge - lowerEdge) / 2;
+          job.logValue = lowerEdge + (upperEdge - lowerEdge) / 2;
         } else
-          logValue = (*axis)(j);
+          job.logValue = (*axis)(j);
       } else if (logName != "SourceName") {
         Kernel::Property *prop = data.ws->run().getLogData(logName);
         if (!prop) {
@@ -262,102 +261,86 @@ void PlotPeakByLogValue::exec() {
           throw std::runtime_error("Failed to cast " + logName +
                                    " to TimeSeriesProperty");
         }
-        logValue = logp->lastValue();
-      }
-
-      double chi2;
-
-      try {
-        if (passWSIndexToFunction) {
-          setWorkspaceIndexAttribute(ifun, j);
-        }
-
-        g_log.debug() << "Fitting " << data.ws->getName() << " index " << j
-                      << " with \n";
-        g_log.debug() << ifun->asString() << '\n';
-
-        const std::string spectrum_index = std::to_string(j);
-        std::string wsBaseName;
-
-        if (createFitOutput)
-          wsBaseName = wsNames[i].name + "_" + spectrum_index;
-
-        bool histogramFit = getPropertyValue("EvaluationType") == "Histogram";
-
-        // Fit the function
-        API::IAlgorithm_sptr fit =
-            AlgorithmManager::Instance().createUnmanaged("Fit");
-        fit->initialize();
-        fit->setPropertyValue("EvaluationType",
-                              getPropertyValue("EvaluationType"));
-        fit->setProperty("Function", ifun);
-        fit->setProperty("InputWorkspace", data.ws);
-        fit->setProperty("WorkspaceIndex", j);
-        fit->setPropertyValue("StartX", getPropertyValue("StartX"));
-        fit->setPropertyValue("EndX", getPropertyValue("EndX"));
-        fit->setPropertyValue(
-            "Minimizer", getMinimizerString(wsNames[i].name, spectrum_index));
-        fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
-        fit->setPropertyValue("MaxIterations",
-                              getPropertyValue("MaxIterations"));
-        fit->setPropertyValue("PeakRadius", getPropertyValue("PeakRadius"));
-        fit->setProperty("CalcErrors", true);
-        fit->setProperty("CreateOutput", createFitOutput);
-        if (!histogramFit) {
-          fit->setProperty("OutputCompositeMembers", outputCompositeMembers);
-          fit->setProperty("ConvolveMembers", outputConvolvedMembers);
-        }
-        fit->setProperty("Output", wsBaseName);
-        fit->execute();
-
-        if (!fit->isExecuted()) {
-          throw std::runtime_error("Fit child algorithm failed: " +
-                                   data.ws->getName());
-        }
-
-        ifun = fit->getProperty("Function");
-        chi2 = fit->getProperty("OutputChi2overDoF");
-
-        if (createFitOutput) {
-          covariance_workspaces.push_back(wsBaseName +
-                                          "_NormalisedCovarianceMatrix");
-          parameter_workspaces.push_back(wsBaseName + "_Parameters");
-          fit_workspaces.push_back(wsBaseName + "_Workspace");
-        }
-
-        g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
-                      << ' ' << chi2 << '\n';
-
-      } catch (...) {
-        g_log.error("Error in Fit ChildAlgorithm");
-        throw;
+        job.logValue = logp->lastValue();
       }
-
-      // Extract the fitted parameters and put them into the result table
-      TableRow row = result->appendRow();
-      if (isDataName) {
-        row << wsNames[i].name;
-      } else {
-        row << logValue;
+      const std::string spectrum_index = std::to_string(j);
+      if (createFitOutput) {
+        job.wsBaseName = wsNames[i].name + "_" + spectrum_index;
+        covariance_workspaces.push_back(job.wsBaseName +
+                                        "_NormalisedCovarianceMatrix");
+        parameter_workspaces.push_back(job.wsBaseName + "_Parameters");
+        fit_workspaces.push_back(job.wsBaseName + "_Workspace");
       }
+      job.minimizer = getMinimizerString(wsNames[i].name, spectrum_index);
+      jobs.push_back(job);
+    }
+  }
 
-      for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
-        row << ifun->getParameter(iPar) << ifun->getError(iPar);
+  // Fitted parameters, their errors and the chi squared of every fit
+  const size_t nParams = ifun->nParams();
+  std::vector<std::vector<double>> fitResults(
+      jobs.size(), std::vector<double>(2 * nParams + 1));
+  auto storeResult = [nParams](const IFunction &fitted, double chi2,
+                               std::vector<double> &out) {
+    for (size_t iPar = 0; iPar < nParams; ++iPar) {
+      out[2 * iPar] = fitted.getParameter(iPar);
+      out[2 * iPar + 1] = fitted.getError(iPar);
+    }
+    out[2 * nParams] = chi2;
+  };
+
+  Progress prog(this, 0.0, 1.0, jobs.size());
+  bool parallel = getProperty("Parallel");
+  if (parallel && individual) {
+    // The fits are independent: fit them concurrently, with one copy of the
+    // function per thread that is reset before each fit.
+    std::vector<IFunction_sptr> threadFunctions(PARALLEL_GET_MAX_THREADS);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t k = 0; k < static_cast<int64_t>(jobs.size()); ++k) {
+      PARALLEL_START_INTERUPT_REGION
+      auto &threadFun = threadFunctions[PARALLEL_THREAD_NUMBER];
+      if (!threadFun)
+        threadFun = FunctionFactory::Instance().createInitialized(fun);
+      for (size_t iPar = 0; iPar < initialParams.size(); ++iPar)
+        threadFun->setParameter(iPar, initialParams[iPar]);
+      if (passWSIndexToFunction)
+        setWorkspaceIndexAttribute(threadFun, jobs[k].index);
+      double chi2;
+      threadFun = fitSpectrum(jobs[k], threadFun, chi2);
+      storeResult(*threadFun, chi2, fitResults[k]);
+      prog.report("Fitting Workspace: " + jobs[k].name);
+      PARALLEL_END_INTERUPT_REGION
+    }
+    PARALLEL_CHECK_INTERUPT_REGION
+  } else {
+    for (size_t k = 0; k < jobs.size(); ++k) {
+      if (passWSIndexToFunction) {
+        setWorkspaceIndexAttribute(ifun, jobs[k].index);
       }
-      row << chi2;
-
-      Prog += dProg;
-      std::string current = std::to_string(i);
-      progress(Prog, ("Fitting Workspace: (" + current + ") - "));
+      double chi2;
+      ifun = fitSpectrum(jobs[k], ifun, chi2);
+      storeResult(*ifun, chi2, fitResults[k]);
+      prog.report("Fitting Workspace: " + jobs[k].name);
       interruption_point();
-
       if (individual) {
         for (size_t i = 0; i < initialParams.size(); ++i) {
           ifun->setParameter(i, initialParams[i]);
         }
       }
+    }
+  }
 
-    } // for(;j < jend;++j)
+  // Put the fitted parameters into the result table
+  for (size_t k = 0; k < jobs.size(); ++k) {
+    TableRow row = result->appendRow();
+    if (isDataName) {
+      row << jobs[k].name;
+    } else {
+      row << jobs[k].logValue;
+    }
+    for (auto value : fitResults[k]) {
+      row << value;
+    }
   }
 
   if (createFitOutput) {
@@ -394,6 +377,60 @@ void PlotPeakByLogValue::exec() {
   }
 }
 
+/** Fit one spectrum with the Fit algorithm.
+  * @param job :: The spectrum to fit
+  * @param fun :: The function to fit, with its initial parameters
+  * @param chi2 :: Set to the chi squared over the degrees of freedom
+  * @return the fitted function
+  */
+IFunction_sptr PlotPeakByLogValue::fitSpectrum(const FitJob &job,
+                                               IFunction_sptr fun,
+                                               double &chi2) const {
+  try {
+    g_log.debug() << "Fitting " << job.ws->getName() << " index " << job.index
+                  << " with \n";
+    g_log.debug() << fun->asString() << '\n';
+    bool createFitOutput = getProperty("CreateOutput");
+    bool histogramFit = getPropertyValue("EvaluationType") == "Histogram";
+    // Fit the function
+    API::IAlgorithm_sptr fit =
+        AlgorithmManager::Instance().createUnmanaged("Fit");
+    fit->initialize();
+    fit->setPropertyValue("EvaluationType", getPropertyValue("EvaluationType"));
+    fit->setProperty("Function", fun);
+    fit->setProperty("InputWorkspace", job.ws);
+    fit->setProperty("WorkspaceIndex", job.index);
+    fit->setPropertyValue("StartX", getPropertyValue("StartX"));
+    fit->setPropertyValue("EndX", getPropertyValue("EndX"));
+    fit->setPropertyValue("Minimizer", job.minimizer);
+    fit->setPropertyValue("CostFunction", getPropertyValue("CostFunction"));
+    fit->setPropertyValue("MaxIterations", getPropertyValue("MaxIterations"));
+    fit->setPropertyValue("PeakRadius", getPropertyValue("PeakRadius"));
+    fit->setProperty("CalcErrors", true);
+    fit->setProperty("CreateOutput", createFitOutput);
+    if (!histogramFit) {
+      bool outputCompositeMembers = getProperty("OutputCompositeMembers");
+      bool outputConvolvedMembers = getProperty("ConvolveMembers");
+      fit->setProperty("OutputCompositeMembers", outputCompositeMembers);
+      fit->setProperty("ConvolveMembers", outputConvolvedMembers);
+    }
+    fit->setProperty("Output", job.wsBaseName);
+    fit->execute();
+    if (!fit->isExecuted()) {
+      throw std::runtime_error("Fit child algorithm failed: " +
+                               job.ws->getName());
+    }
+    fun = fit->getProperty("Function");
+    chi2 = fit->getProperty("OutputChi2overDoF");
+    g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
+                  << ' ' << chi2 << '\n';
+  } catch (...) {
+    g_log.error("Error in Fit ChildAlgorithm");
+    throw;
+  }
+  return fun;
+}
+
 /** Get a workspace identified by an InputData structure.
   * @param data :: InputData with name and either spec or i fields defined.
   * @return InputData structure with the ws field set if everything was OK.
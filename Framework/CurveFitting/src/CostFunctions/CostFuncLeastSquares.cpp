@@ -2,13 +2,17 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
-#include "MantidCurveFitting/Jacobian.h"
 #include "MantidCurveFitting/SeqDomain.h"
 #include "MantidAPI/IConstraint.h"
 #include "MantidAPI/CompositeDomain.h"
 #include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/Jacobian.h"
 #include "MantidKernel/Logger.h"
-#include "MantidKernel/MultiThreaded.h"
+
+#include <gsl/gsl_blas.h>
+
+#include <algorithm>
+#include <stdexcept>
 
 namespace Mantid {
 namespace CurveFitting {
@@ -16,7 +20,54 @@ namespace CostFunctions {
 namespace {
 /// static logger
 Kernel::Logger g_log("CostFuncLeastSquares");
-}
+
+/// A Jacobian stored row by row in a buffer that is reused between fit
+/// iterations. It behaves like CurveFitting::Jacobian.
+class BufferJacobian : public API::Jacobian {
+public:
+  /// Constructor. Resizes the buffer and sets all the derivatives to zero.
+  /// @param data :: The buffer
+  /// @param ny :: Number of data points
+  /// @param np :: Number of parameters
+  BufferJacobian(std::vector<double> &data, size_t ny, size_t np)
+      : m_data(data), m_ny(ny), m_np(np) {
+    m_data.assign(ny * np, 0.0);
+  }
+  void set(size_t iY, size_t iP, double value) override {
+    checkIndices(iY, iP);
+    m_data[iY * m_np + iP] = value;
+  }
+  double get(size_t iY, size_t iP) override {
+    checkIndices(iY, iP);
+    return m_data[iY * m_np + iP];
+  }
+  void zero() override { std::fill(m_data.begin(), m_data.end(), 0.0); }
+  /// Add a penalty to the first, last and every 10th point
+  void addNumberToColumn(const double &value, const size_t &iP) override {
+    if (iP >= m_np) {
+      throw std::runtime_error("Try to add number to column of Jacobian matrix "
+                               "which does not exist.");
+    }
+    m_data[iP] += value;
+    m_data[(m_ny - 1) * m_np + iP] += value;
+    for (size_t iY = 9; iY < m_ny; iY += 10)
+      m_data[iY * m_np + iP] += value;
+  }
+
+private:
+  void checkIndices(size_t iY, size_t iP) const {
+    if (iY >= m_ny) {
+      throw std::out_of_range("Data index in Jacobian is out of range");
+    }
+    if (iP >= m_np) {
+      throw std::out_of_range("Parameter index in Jacobian is out of range");
+    }
+  }
+  std::vector<double> &m_data;
+  const size_t m_ny;
+  const size_t m_np;
+};
+} // namespace
 
 DECLARE_COSTFUNCTION(CostFuncLeastSquares, Least squares)
 
@@ -74,12 +125,29 @@ double CostFuncLeastSquares::val() const {
  */
 void CostFuncLeastSquares::addVal(API::FunctionDomain_sptr domain,
                                   API::FunctionValues_sptr values) const {
-  m_function->function(*domain, *values);
+  m_value += calVal(m_function, domain, values, m_buffers);
+}
+
+/**
+ * Calculate the contribution to the cost function value from the fitting
+ * function evaluated on a particular domain.
+ * @param function :: The fitting function or a copy of it
+ * @param domain :: A domain
+ * @param values :: Values
+ * @param buffers :: Storage for the weights
+ * @return the contribution to the value
+ */
+double CostFuncLeastSquares::calVal(API::IFunction_sptr function,
+                                    API::FunctionDomain_sptr domain,
+                                    API::FunctionValues_sptr values,
+                                    Buffers &buffers) const {
+  function->function(*domain, *values);
   size_t ny = values->size();
 
   double retVal = 0.0;
 
-  std::vector<double> weights = getFitWeights(values);
+  getFitWeights(values, buffers.weights);
+  const double *weights = buffers.weights.data();
 
   for (size_t i = 0; i < ny; i++) {
     double val =
@@ -87,8 +155,7 @@ void CostFuncLeastSquares::addVal(API::FunctionDomain_sptr domain,
     retVal += val * val;
   }
 
-  PARALLEL_ATOMIC
-  m_value += m_factor * retVal;
+  return m_factor * retVal;
 }
 
 /** Calculate the derivatives of the cost function
@@ -225,43 +292,90 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
                                               bool evalDeriv,
                                               bool evalHessian) const {
   UNUSED_ARG(evalDeriv);
+  calValDerivHessian(function, domain, values, evalHessian, m_value, m_der,
+                     m_hessian, m_buffers);
+}
+
+/**
+ * Calculate the contributions of a domain to the cost function, its
+ * derivatives and the Hessian and add them to the given sums. The sums are
+ * not shared, so this can be called from several threads if each has its own
+ * buffers.
+ *
+ * The rows of the Jacobian are scaled by the weights in place. The
+ * derivatives are then J^T r, where r are the weighted residuals, and the
+ * Hessian is J^T J. Both are calculated by the BLAS routines of GSL for all
+ * parameters before the active ones are picked out.
+ * @param function :: Function to use to calculate the value and the derivatives
+ * @param domain :: The domain.
+ * @param values :: The fit function values
+ * @param evalHessian :: Flag to evaluate the Hessian
+ * @param value :: The value to add to
+ * @param der :: The derivatives to add to
+ * @param hessian :: The Hessian to add to; unused if evalHessian is false
+ * @param buffers :: Storage for the intermediate results
+ */
+void CostFuncLeastSquares::calValDerivHessian(
+    API::IFunction_sptr function, API::FunctionDomain_sptr domain,
+    API::FunctionValues_sptr values, bool evalHessian, double &value,
+    GSLVector &der, GSLMatrix &hessian, Buffers &buffers) const {
   function->function(*domain, *values);
   size_t np = function->nParams(); // number of parameters
   size_t ny = values->size();      // number of data points
-  Jacobian jacobian(ny, np);
+  if (np == 0 || ny == 0) {
+    return;
+  }
+  BufferJacobian jacobian(buffers.jacobian, ny, np);
   function->functionDeriv(*domain, jacobian);
 
-  size_t iActiveP = 0;
+  getFitWeights(values, buffers.weights);
+  const double *weights = buffers.weights.data();
+  buffers.residuals.resize(ny);
+  double *residuals = buffers.residuals.data();
+  const double *calculated = values->getPointerToCalculated(0);
   double fVal = 0.0;
-  std::vector<double> weights = getFitWeights(values);
+  for (size_t i = 0; i < ny; ++i) {
+    const double y = (calculated[i] - values->getFitData(i)) * weights[i];
+    residuals[i] = y;
+    fVal += y * y;
+  }
+  value += 0.5 * fVal;
+
+  double *jac = buffers.jacobian.data();
+  for (size_t i = 0; i < ny; ++i) {
+    const double w = weights[i];
+    double *row = jac + i * np;
+    for (size_t ip = 0; ip < np; ++ip) {
+      row[ip] *= w;
+    }
+  }
 
+  gsl_matrix_view jView = gsl_matrix_view_array(jac, ny, np);
+  gsl_vector_view rView = gsl_vector_view_array(residuals, ny);
+  buffers.der.resize(np);
+  gsl_vector_view dView = gsl_vector_view_array(buffers.der.data(), np);
+  gsl_blas_dgemv(CblasTrans, 1.0, &jView.matrix, &rView.vector, 0.0,
+                 &dView.vector);
+
+  size_t iActiveP = 0;
   for (size_t ip = 0; ip < np; ++ip) {
     if (!function->isActive(ip))
       continue;
-    double d = 0.0;
-    for (size_t i = 0; i < ny; ++i) {
-      double calc = values->getCalculated(i);
-      double obs = values->getFitData(i);
-      double w = weights[i];
-      double y = (calc - obs) * w;
-      d += y * jacobian.get(i, ip) * w;
-      if (iActiveP == 0) {
-        fVal += y * y;
-      }
-    }
-    PARALLEL_CRITICAL(der_set) {
-      double der = m_der.get(iActiveP);
-      m_der.set(iActiveP, der + d);
-    }
+    der.set(iActiveP, der.get(iActiveP) + buffers.der[ip]);
     ++iActiveP;
   }
 
-  PARALLEL_ATOMIC
-  m_value += 0.5 * fVal;
-
   if (!evalHessian)
     return;
 
+  // Only the lower triangle is calculated
+  buffers.hessian.resize(np * np);
+  gsl_matrix_view hView =
+      gsl_matrix_view_array(buffers.hessian.data(), np, np);
+  gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, &jView.matrix, 0.0,
+                 &hView.matrix);
+  const double *h = buffers.hessian.data();
+
   size_t i1 = 0;                  // active parameter index
   for (size_t i = 0; i < np; ++i) // over parameters
   {
@@ -272,18 +386,10 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
     {
       if (!function->isActive(j))
         continue;
-      double d = 0.0;
-      for (size_t k = 0; k < ny; ++k) // over fitting data
-      {
-        double w = weights[k];
-        d += jacobian.get(k, i) * jacobian.get(k, j) * w * w;
-      }
-      PARALLEL_CRITICAL(hessian_set) {
-        double h = m_hessian.get(i1, i2);
-        m_hessian.set(i1, i2, h + d);
-        if (i1 != i2) {
-          m_hessian.set(i2, i1, h + d);
-        }
+      const double d = hessian.get(i1, i2) + h[i * np + j];
+      hessian.set(i1, i2, d);
+      if (i1 != i2) {
+        hessian.set(i2, i1, d);
       }
       ++i2;
     }
@@ -291,14 +397,30 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
   }
 }
 
+/**
+ * Get the fitting weights of the values.
+ * @param values :: The fit function values
+ * @return The weights
+ */
 std::vector<double>
 CostFuncLeastSquares::getFitWeights(API::FunctionValues_sptr values) const {
-  std::vector<double> weights(values->size());
+  std::vector<double> weights;
+  getFitWeights(values, weights);
+  return weights;
+}
+
+/**
+ * Get the fitting weights of the values into a buffer, which is resized to
+ * the number of values.
+ * @param values :: The fit function values
+ * @param weights :: The buffer for the weights
+ */
+void CostFuncLeastSquares::getFitWeights(API::FunctionValues_sptr values,
+                                         std::vector<double> &weights) const {
+  weights.resize(values->size());
   for (size_t i = 0; i < weights.size(); ++i) {
     weights[i] = values->getFitWeight(i);
   }
-
-  return weights;
 }
 
 /**
@@ -27,16 +27,14 @@ CostFuncRwp::CostFuncRwp() : CostFuncLeastSquares() {
   m_factor = 1.;
 }
 
-std::vector<double>
-CostFuncRwp::getFitWeights(API::FunctionValues_sptr values) const {
+void CostFuncRwp::getFitWeights(API::FunctionValues_sptr values,
+                                std::vector<double> &weights) const {
   double sqrtW = calSqrtW(values);
 
-  std::vector<double> weights(values->size());
+  weights.resize(values->size());
   for (size_t i = 0; i < weights.size(); ++i) {
     weights[i] = getWeight(values, i, sqrtW);
   }
-
-  return weights;
 }
 
 //----------------------------------------------------------------------------------------------
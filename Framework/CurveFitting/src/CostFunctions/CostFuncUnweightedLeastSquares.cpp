@@ -41,10 +41,10 @@ void CostFuncUnweightedLeastSquares::calActiveCovarianceMatrix(GSLMatrix &covar,
   }
 }
 
-/// Return unit weights for all data points.
-std::vector<double> CostFuncUnweightedLeastSquares::getFitWeights(
-    API::FunctionValues_sptr values) const {
-  return std::vector<double>(values->size(), 1.0);
+/// Set unit weights for all data points.
+void CostFuncUnweightedLeastSquares::getFitWeights(
+    API::FunctionValues_sptr values, std::vector<double> &weights) const {
+  weights.assign(values->size(), 1.0);
 }
 
 /// Calculates the residual variance from the internally stored FunctionValues.
@@ -0,0 +1,314 @@
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidCurveFitting/FuncMinimizers/DifferentialEvolutionMinimizer.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncFitting.h"
+
+#include "MantidAPI/CostFunctionFactory.h"
+#include "MantidAPI/FuncMinimizerFactory.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/IFunction.h"
+
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/Logger.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+
+namespace Mantid {
+namespace CurveFitting {
+namespace FuncMinimisers {
+namespace {
+/// static logger
+Kernel::Logger g_log("DifferentialEvolutionMinimizer");
+
+/// The smallest population that can make mutants from three other members
+const size_t MIN_POPULATION_SIZE = 4;
+/// The population size per parameter if it isn't set
+const size_t DEFAULT_POPULATION_PER_PARAMETER = 10;
+
+/**
+ * Set a point to a cost function and apply the ties of the fitting function.
+ * @param costFunction :: A cost function.
+ * @param point :: The values of the parameters.
+ */
+void setPoint(API::ICostFunction &costFunction,
+              const std::vector<double> &point) {
+  for (size_t i = 0; i < point.size(); ++i) {
+    costFunction.setParameter(i, point[i]);
+  }
+  auto fitting = dynamic_cast<CostFunctions::CostFuncFitting *>(&costFunction);
+  if (fitting) {
+    fitting->applyTies();
+  }
+}
+
+/**
+ * Calculate the cost of a point.
+ * @param costFunction :: A cost function.
+ * @param point :: The values of the parameters.
+ * @return The cost, or infinity if it isn't finite.
+ */
+double evaluatePoint(API::ICostFunction &costFunction,
+                     const std::vector<double> &point) {
+  setPoint(costFunction, point);
+  const double value = costFunction.val();
+  return std::isfinite(value) ? value : std::numeric_limits<double>::infinity();
+}
+} // namespace
+
+DECLARE_FUNCMINIMIZER(DifferentialEvolutionMinimizer, DifferentialEvolution)
+
+/// Constructor
+DifferentialEvolutionMinimizer::DifferentialEvolutionMinimizer()
+    : m_costFunction(), m_best(0) {
+  auto mustBeNonNegative = boost::make_shared<Kernel::BoundedValidator<int>>();
+  mustBeNonNegative->setLower(0);
+  declareProperty("PopulationSize", 0, mustBeNonNegative,
+                  "The number of parameter sets in the population. 0 means "
+                  "10 times the number of parameters.");
+  auto mustBeBetween0And2 =
+      boost::make_shared<Kernel::BoundedValidator<double>>(0.0, 2.0);
+  declareProperty("DifferentialWeight", 0.7, mustBeBetween0And2,
+                  "The factor multiplying the difference of two members "
+                  "when making a mutant.");
+  auto mustBeProbability =
+      boost::make_shared<Kernel::BoundedValidator<double>>(0.0, 1.0);
+  declareProperty("CrossoverProbability", 0.9, mustBeProbability,
+                  "The probability that a parameter of a trial is taken "
+                  "from the mutant.");
+  auto mustBePositive = boost::make_shared<Kernel::BoundedValidator<double>>();
+  mustBePositive->setLower(0.0);
+  declareProperty("InitialSpread", 0.5, mustBePositive,
+                  "The half-width of the initial population around the "
+                  "starting values, relative to them (absolute for starting "
+                  "values of zero).");
+  declareProperty("RelError", 1e-6, mustBePositive,
+                  "Stop when the costs of all members differ from the lowest "
+                  "cost by less than this fraction of it.");
+  declareProperty("Seed", 1, mustBeNonNegative,
+                  "The seed of the random number generator.");
+}
+
+/**
+ * Create the initial population and calculate its costs.
+ * @param function :: The cost function to minimize.
+ * @param maxIterations :: Not used.
+ */
+void DifferentialEvolutionMinimizer::initialize(
+    API::ICostFunction_sptr function, size_t maxIterations) {
+  UNUSED_ARG(maxIterations);
+  m_costFunction = function;
+  m_copies.clear();
+  const size_t nParams = function->nParams();
+
+  int populationSize = getProperty("PopulationSize");
+  size_t nMembers = populationSize > 0
+                        ? static_cast<size_t>(populationSize)
+                        : DEFAULT_POPULATION_PER_PARAMETER * nParams;
+  nMembers = std::max(nMembers, MIN_POPULATION_SIZE);
+  const double spread = getProperty("InitialSpread");
+  const int seed = getProperty("Seed");
+  m_random.setSeed(static_cast<size_t>(seed));
+
+  std::vector<double> start(nParams);
+  for (size_t i = 0; i < nParams; ++i) {
+    start[i] = function->getParameter(i);
+  }
+  const double startCost = evaluatePoint(*m_costFunction, start);
+
+  m_population.assign(nMembers, start);
+  for (size_t j = 1; j < nMembers; ++j) {
+    for (size_t i = 0; i < nParams; ++i) {
+      const double halfWidth =
+          start[i] != 0.0 ? spread * fabs(start[i]) : spread;
+      m_population[j][i] += halfWidth * m_random.nextValue(-1.0, 1.0);
+    }
+  }
+
+  createCopies(start, startCost);
+
+  std::vector<std::vector<double>> others(m_population.begin() + 1,
+                                          m_population.end());
+  std::vector<double> costs;
+  evaluate(others, costs);
+  m_costs.resize(nMembers);
+  m_costs[0] = startCost;
+  std::copy(costs.begin(), costs.end(), m_costs.begin() + 1);
+  updateBest();
+}
+
+/**
+ * Evolve the population by one generation.
+ * @return false if the population has converged.
+ */
+bool DifferentialEvolutionMinimizer::iterate(size_t) {
+  if (!m_costFunction) {
+    throw std::runtime_error("Cost function isn't set up.");
+  }
+  const size_t nParams = m_costFunction->nParams();
+  if (nParams == 0) {
+    return false;
+  }
+  const size_t nMembers = m_population.size();
+  const double weight = getProperty("DifferentialWeight");
+  const double crossover = getProperty("CrossoverProbability");
+  const int lastMember = static_cast<int>(nMembers) - 1;
+
+  std::vector<std::vector<double>> trials(m_population);
+  for (size_t j = 0; j < nMembers; ++j) {
+    // Three distinct members other than j
+    size_t r[3];
+    for (size_t k = 0; k < 3; ++k) {
+      do {
+        r[k] = static_cast<size_t>(m_random.nextInt(0, lastMember));
+      } while (r[k] == j || (k > 0 && r[k] == r[0]) ||
+               (k > 1 && r[k] == r[1]));
+    }
+    const auto &a = m_population[r[0]];
+    const auto &b = m_population[r[1]];
+    const auto &c = m_population[r[2]];
+    // At least one parameter is taken from the mutant
+    const size_t forced = static_cast<size_t>(
+        m_random.nextInt(0, static_cast<int>(nParams) - 1));
+    auto &trial = trials[j];
+    for (size_t i = 0; i < nParams; ++i) {
+      if (i == forced || m_random.nextValue(0.0, 1.0) < crossover) {
+        trial[i] = a[i] + weight * (b[i] - c[i]);
+      }
+    }
+  }
+
+  std::vector<double> costs;
+  evaluate(trials, costs);
+  for (size_t j = 0; j < nMembers; ++j) {
+    if (costs[j] <= m_costs[j]) {
+      m_population[j].swap(trials[j]);
+      m_costs[j] = costs[j];
+    }
+  }
+  updateBest();
+
+  const double relError = getProperty("RelError");
+  const double best = m_costs[m_best];
+  const double worst = *std::max_element(m_costs.begin(), m_costs.end());
+  return !(worst == best || worst - best <= relError * fabs(best));
+}
+
+/// Return the lowest cost found
+double DifferentialEvolutionMinimizer::costFunctionVal() {
+  return m_costs.empty() ? m_costFunction->val() : m_costs[m_best];
+}
+
+/**
+ * Make copies of the cost function to calculate costs in parallel. Only
+ * fitting cost functions on a 1D domain are copied, with their fitting
+ * function and values. Copies are only used if they reproduce the cost of the
+ * starting point exactly.
+ * @param start :: The starting point.
+ * @param startCost :: The cost of the starting point.
+ */
+void DifferentialEvolutionMinimizer::createCopies(
+    const std::vector<double> &start, double startCost) {
+  auto fitting =
+      boost::dynamic_pointer_cast<CostFunctions::CostFuncFitting>(
+          m_costFunction);
+  if (!fitting || !dynamic_cast<API::FunctionDomain1D *>(
+                      fitting->getDomain().get()) ||
+      !fitting->getValues()) {
+    return;
+  }
+  auto function = fitting->getFittingFunction();
+  if (function->isParallel() || PARALLEL_NUMBER_OF_THREADS != 1 ||
+      PARALLEL_GET_MAX_THREADS < 2) {
+    return;
+  }
+
+  const size_t nCopies = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  std::vector<API::ICostFunction_sptr> copies;
+  try {
+    for (size_t k = 0; k < nCopies; ++k) {
+      auto functionCopy = function->clone();
+      if (!functionCopy || functionCopy->nParams() != function->nParams()) {
+        return;
+      }
+      // The string representation may not keep all the digits
+      for (size_t i = 0; i < function->nParams(); ++i) {
+        functionCopy->setParameter(i, function->getParameter(i),
+                                   function->isExplicitlySet(i));
+      }
+      API::ICostFunction_sptr created(
+          API::CostFunctionFactory::Instance().createFunction(fitting->name()));
+      auto copy =
+          boost::dynamic_pointer_cast<CostFunctions::CostFuncFitting>(created);
+      if (!copy) {
+        return;
+      }
+      copy->setFittingFunction(
+          functionCopy, fitting->getDomain(),
+          boost::make_shared<API::FunctionValues>(*fitting->getValues()));
+      if (copy->nParams() != fitting->nParams() ||
+          evaluatePoint(*copy, start) != startCost) {
+        return;
+      }
+      copies.push_back(copy);
+    }
+  } catch (std::exception &e) {
+    g_log.debug() << "Cannot copy the cost function: " << e.what() << '\n';
+    return;
+  }
+  // The starting point must be restored after evaluating the copies
+  setPoint(*m_costFunction, start);
+  m_copies.swap(copies);
+}
+
+/**
+ * Calculate the costs of a set of points, in parallel if there are copies of
+ * the cost function.
+ * @param points :: The points.
+ * @param costs :: Set to the costs of the points.
+ */
+void DifferentialEvolutionMinimizer::evaluate(
+    const std::vector<std::vector<double>> &points,
+    std::vector<double> &costs) {
+  costs.resize(points.size());
+  if (m_copies.empty()) {
+    for (size_t j = 0; j < points.size(); ++j) {
+      costs[j] = evaluatePoint(*m_costFunction, points[j]);
+    }
+    return;
+  }
+
+  std::exception_ptr error;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t j = 0; j < static_cast<int64_t>(points.size()); ++j) {
+    try {
+      const size_t thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
+      costs[j] = evaluatePoint(*m_copies[thread], points[j]);
+    } catch (...) {
+      PARALLEL_CRITICAL(DifferentialEvolution_evaluate) {
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+/// Find the member with the lowest cost and set it to the cost function.
+void DifferentialEvolutionMinimizer::updateBest() {
+  m_best = static_cast<size_t>(std::distance(
+      m_costs.begin(), std::min_element(m_costs.begin(), m_costs.end())));
+  setPoint(*m_costFunction, m_population[m_best]);
+}
+
+} // namespace FuncMinimisers
+} // namespace CurveFitting
+} // namespace Mantid
@@ -98,28 +98,32 @@ void BackToBackExponential::function1D(double *out, const double *xValues,
   const double x0 = getParameter(3);
   const double s = getParameter(4);
 
-  // find the reasonable extent of the peak ~100 fwhm
-  double extent = expWidth();
-  if (s > extent)
-    extent = s;
-  extent *= 100;
+  const double extent = supportHalfWidth();
 
   double s2 = s * s;
   double normFactor = a * b / (a + b) / 2;
   // Needed for IntegratePeaksMD for cylinder profile fitted with b=0
   if (normFactor == 0.0)
     normFactor = 1.0;
+
+  // The shape only depends on A, B and S. Adding the logarithm of erfc to
+  // the exponent prevents overflow.
+  auto shape = [a, b, s2, normFactor](double diff) {
+    double val = exp(a / 2 * (a * s2 + 2 * diff) +
+                     gsl_sf_log_erfc((a * s2 + diff) / sqrt(2 * s2)));
+    val += exp(b / 2 * (b * s2 - 2 * diff) +
+               gsl_sf_log_erfc((b * s2 - diff) / sqrt(2 * s2)));
+    return val * normFactor;
+  };
+  if (m_profile.evaluate({a, b, s}, shape, extent, x0, I, xValues, nData,
+                         out)) {
+    return;
+  }
+
   for (size_t i = 0; i < nData; i++) {
     double diff = xValues[i] - x0;
     if (fabs(diff) < extent) {
-      double val = 0.0;
-      double arg1 = a / 2 * (a * s2 + 2 * diff);
-      val += exp(arg1 + gsl_sf_log_erfc((a * s2 + diff) /
-                                        sqrt(2 * s2))); // prevent overflow
-      double arg2 = b / 2 * (b * s2 - 2 * diff);
-      val += exp(arg2 + gsl_sf_log_erfc((b * s2 - diff) /
-                                        sqrt(2 * s2))); // prevent overflow
-      out[i] = I * val * normFactor;
+      out[i] = I * shape(diff);
     } else
       out[i] = 0.0;
   }
@@ -135,6 +139,19 @@ void BackToBackExponential::functionDeriv1D(Jacobian *jacobian,
   this->calNumericalDeriv(domain, *jacobian);
 }
 
+/**
+ * The peak is zero outside a fixed window around the centre, regardless of
+ * the peak radius.
+ * @param peakRadius :: Not used.
+ */
+std::pair<double, double>
+BackToBackExponential::getSupportInterval(int peakRadius) const {
+  UNUSED_ARG(peakRadius);
+  const double x0 = getParameter(3);
+  const double extent = supportHalfWidth();
+  return std::make_pair(x0 - extent, x0 + extent);
+}
+
 /**
  * Calculate contribution to the width by the exponentials.
  */
@@ -147,6 +164,18 @@ double BackToBackExponential::expWidth() const {
   return M_LN2 * (a + b) / (a * b);
 }
 
+/**
+ * Half-width of the window outside which the peak is set to zero: the
+ * reasonable extent of the peak ~100 fwhm.
+ */
+double BackToBackExponential::supportHalfWidth() const {
+  const double s = getParameter(4);
+  double extent = expWidth();
+  if (s > extent)
+    extent = s;
+  return extent * 100;
+}
+
 } // namespace Functions
 } // namespace CurveFitting
 } // namespace Mantid
@@ -3,10 +3,9 @@
 #include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionValues.h"
 #include "MantidCurveFitting/HalfComplex.h"
+#include "MantidKernel/Math/FFT.h"
 
 #include <gsl/gsl_errno.h>
-#include <gsl/gsl_fft_real.h>
-#include <gsl/gsl_fft_halfcomplex.h>
 #include <gsl/gsl_eigen.h>
 
 #include <algorithm>
@@ -529,11 +528,7 @@ std::vector<double> ChebfunBase::calcA(const std::vector<double> &p) const {
     std::reverse_copy(p.begin(), p.end(), tmp.begin());
     std::copy(p.begin() + 1, p.end() - 1, tmp.begin() + m_n + 1);
 
-    gsl_fft_real_workspace *workspace = gsl_fft_real_workspace_alloc(2 * m_n);
-    gsl_fft_real_wavetable *wavetable = gsl_fft_real_wavetable_alloc(2 * m_n);
-    gsl_fft_real_transform(&tmp[0], 1, 2 * m_n, wavetable, workspace);
-    gsl_fft_real_wavetable_free(wavetable);
-    gsl_fft_real_workspace_free(workspace);
+    Kernel::FFT::realForward(&tmp[0], 2 * m_n);
 
     HalfComplex fc(&tmp[0], tmp.size());
     for (size_t i = 0; i < nn; ++i) {
@@ -573,14 +568,7 @@ std::vector<double> ChebfunBase::calcP(const std::vector<double> &a) const {
         d *= 2;
       fc.set(i, d, 0.0);
     }
-    gsl_fft_real_workspace *workspace = gsl_fft_real_workspace_alloc(2 * m_n);
-    gsl_fft_halfcomplex_wavetable *wavetable =
-        gsl_fft_halfcomplex_wavetable_alloc(2 * m_n);
-
-    gsl_fft_halfcomplex_transform(tmp.data(), 1, 2 * m_n, wavetable, workspace);
-
-    gsl_fft_halfcomplex_wavetable_free(wavetable);
-    gsl_fft_real_workspace_free(workspace);
+    Kernel::FFT::halfComplexBackward(tmp.data(), 2 * m_n);
 
     std::reverse_copy(tmp.begin(), tmp.begin() + nn, p.begin());
   } else {
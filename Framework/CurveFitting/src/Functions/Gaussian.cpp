@@ -4,6 +4,8 @@
 #include "MantidCurveFitting/Functions/Gaussian.h"
 #include "MantidAPI/FunctionFactory.h"
 
+#include <algorithm>
+#include <cfloat>
 #include <cmath>
 #include <numeric>
 
@@ -17,6 +19,12 @@ using namespace API;
 
 DECLARE_FUNCTION(Gaussian)
 
+namespace {
+/// Distance from the centre in sigmas beyond which the peak is smaller than
+/// DBL_EPSILON times its height
+const double SUPPORT_IN_SIGMAS = std::sqrt(-2.0 * std::log(DBL_EPSILON));
+}
+
 Gaussian::Gaussian() : IPeakFunction(), m_intensityCache(0.0) {}
 
 void Gaussian::init() {
@@ -92,6 +100,20 @@ double Gaussian::intensity() const {
   return m_intensityCache;
 }
 
+/**
+ * The peak is negligible further than SUPPORT_IN_SIGMAS from the centre,
+ * even if the peak radius is larger or not set.
+ * @param peakRadius :: The peak radius of the domain in FWHMs, 0 if not set.
+ */
+std::pair<double, double> Gaussian::getSupportInterval(int peakRadius) const {
+  auto interval = IPeakFunction::getSupportInterval(peakRadius);
+  const double c = centre();
+  const double dx = SUPPORT_IN_SIGMAS * fabs(getParameter("Sigma"));
+  interval.first = std::max(interval.first, c - dx);
+  interval.second = std::min(interval.second, c + dx);
+  return interval;
+}
+
 void Gaussian::setCentre(const double c) { setParameter("PeakCentre", c); }
 void Gaussian::setHeight(const double h) { setParameter("Height", h); }
 void Gaussian::setFwhm(const double w) {
@@ -338,6 +338,9 @@ void NeutronBk2BkExpConvPVoigt::function(vector<double> &out,
 
   // Calcualte
   std::size_t pos(std::distance(xValues.begin(), iter)); // second loop variable
+  const auto nPeak = static_cast<size_t>(std::distance(iter, iter_end));
+  if (calTabulated(xValues.data() + pos, nPeak, out.data() + pos))
+    return;
   for (; iter != iter_end; ++iter) {
     out[pos] = HEIGHT * calOmega(*iter - m_centre, m_eta, m_N, m_Alpha, m_Beta,
                                  m_fwhm, m_Sigma2, INVERT_SQRT2SIGMA);
@@ -365,6 +368,9 @@ void NeutronBk2BkExpConvPVoigt::function1D(double *out, const double *xValues,
   g_log.debug() << "[F002] Peak centre = " << m_centre
                 << "; Calcualtion Range = " << RANGE << ".\n";
 
+  if (calTabulated(xValues, nData, out))
+    return;
+
   for (size_t i = 0; i < nData; ++i) {
     if (fabs(xValues[i] - m_centre) < RANGE) {
       // In peak range
@@ -486,6 +492,27 @@ double NeutronBk2BkExpConvPVoigt::calOmega(const double x, const double eta,
   return omega;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Calculate the peak from a table of its shape. The shape only depends on
+ * the parameters set by calculateParameters(), not on the height or the
+ * centre of the peak, so it is tabulated once for many calls.
+ * @param xValues :: The x-values to evaluate the peak at.
+ * @param nData :: The number of x-values.
+ * @param out :: The calculated peak intensities.
+ * @return false if the shape is not tabulated and out is unchanged.
+ */
+bool NeutronBk2BkExpConvPVoigt::calTabulated(const double *xValues,
+                                             const size_t nData, double *out) const {
+  const double invert_sqrt2sigma = 1.0 / sqrt(2.0 * m_Sigma2);
+  auto shape = [this, invert_sqrt2sigma](double dT) {
+    return calOmega(dT, m_eta, m_N, m_Alpha, m_Beta, m_fwhm, m_Sigma2,
+                    invert_sqrt2sigma);
+  };
+  return m_profile.evaluate({m_eta, m_N, m_Alpha, m_Beta, m_fwhm, m_Sigma2},
+                            shape, m_fwhm * PEAKRANGE, m_centre,
+                            getParameter(HEIGHTINDEX), xValues, nData, out);
+}
+
 } // namespace Functions
 } // namespace CurveFitting
 } // namespace Mantid
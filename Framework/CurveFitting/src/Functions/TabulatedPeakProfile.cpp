@@ -0,0 +1,264 @@
+#include "MantidCurveFitting/Functions/TabulatedPeakProfile.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Mantid {
+namespace CurveFitting {
+namespace Functions {
+
+namespace {
+/// static logger
+Kernel::Logger g_log("TabulatedPeakProfile");
+/// The default relative interpolation error, which switches tabulation off
+const double DEFAULT_TOLERANCE = 0.0;
+/// The number of points used to find where the shape is significant
+const size_t COARSE_POINTS = 257;
+/// The number of grid intervals of the first trial table
+const size_t MIN_INTERVALS = 64;
+/// Tables needing more intervals than this are not built
+const size_t MAX_INTERVALS = 16384;
+
+/// Interpolate a cubic through values at -1, 0, 1 and 2 at point u
+inline double cubic(const double *v, double u) {
+  const double um1 = u - 1.0;
+  const double um2 = u - 2.0;
+  const double up1 = u + 1.0;
+  return (-v[0] * u * um1 * um2 + v[3] * up1 * u * um1) / 6.0 +
+         (v[1] * up1 * um1 * um2 - v[2] * up1 * u * um2) / 2.0;
+}
+} // namespace
+
+/// A shape tabulated on a uniform grid
+struct TabulatedPeakProfile::Table {
+  /// The offset from the centre of the first grid point
+  double start;
+  /// The offset from the centre of the last grid point
+  double end;
+  /// Inverse of the grid step
+  double invStep;
+  /// The values at the grid points
+  std::vector<double> values;
+
+  /// Interpolate the shape at an offset from the centre. The shape is
+  /// negligible outside the grid.
+  double operator()(double offset) const {
+    if (offset < start || offset > end) {
+      return 0.0;
+    }
+    const double t = (offset - start) * invStep;
+    const size_t last = values.size() - 3;
+    size_t j = t > 1.0 ? static_cast<size_t>(t) : 1;
+    if (j > last) {
+      j = last;
+    }
+    return cubic(&values[j - 1], t - static_cast<double>(j));
+  }
+};
+
+/// Constructor. Reads the tolerance from the configuration.
+TabulatedPeakProfile::TabulatedPeakProfile()
+    : m_tolerance(DEFAULT_TOLERANCE) {
+  double tolerance;
+  if (Kernel::ConfigService::Instance().getValue(
+          "curvefitting.peakProfileTolerance", tolerance)) {
+    try {
+      setTolerance(tolerance);
+    } catch (std::invalid_argument &e) {
+      g_log.warning() << "curvefitting.peakProfileTolerance is ignored: "
+                      << e.what() << '\n';
+    }
+  }
+}
+
+/// Copy constructor. Only the tolerance is copied.
+TabulatedPeakProfile::TabulatedPeakProfile(const TabulatedPeakProfile &other)
+    : m_tolerance(other.m_tolerance) {}
+
+/// Copy assignment. Only the tolerance is copied, the cache is emptied.
+TabulatedPeakProfile &TabulatedPeakProfile::
+operator=(const TabulatedPeakProfile &other) {
+  if (this != &other) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tolerance = other.m_tolerance;
+    m_key.clear();
+    m_table.reset();
+  }
+  return *this;
+}
+
+/**
+ * Set the interpolation error allowed, relative to the peak maximum.
+ * @param tolerance :: The relative error. 0 switches tabulation off.
+ * @throw std::invalid_argument if the tolerance is 1 or more
+ */
+void TabulatedPeakProfile::setTolerance(double tolerance) {
+  if (!(tolerance < 1.0)) {
+    throw std::invalid_argument(
+        "The peak profile tolerance must be less than 1.");
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_tolerance = tolerance > 0.0 ? tolerance : 0.0;
+  m_key.clear();
+  m_table.reset();
+}
+
+/// Number of points in the current table, 0 if there is none
+size_t TabulatedPeakProfile::tableSize() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_table ? m_table->values.size() : 0;
+}
+
+/**
+ * Evaluate scale * shape(x - centre) at points within halfWidth of the
+ * centre and set the other points to zero, using a table of the shape.
+ * @param key :: The parameters the shape depends on.
+ * @param shape :: The shape of the peak.
+ * @param halfWidth :: The half-width of the support window of the peak.
+ * @param centre :: The centre of the peak.
+ * @param scale :: The factor to multiply the shape by.
+ * @param xValues :: The x values.
+ * @param nData :: The number of x values.
+ * @param out :: The output buffer.
+ * @return false if the shape is not tabulated and out is left unchanged.
+ */
+bool TabulatedPeakProfile::evaluate(const std::vector<double> &key,
+                                    const Shape &shape, double halfWidth,
+                                    double centre, double scale,
+                                    const double *xValues, size_t nData,
+                                    double *out) const {
+  if (m_tolerance == 0.0 || !(halfWidth > 0.0) || !std::isfinite(halfWidth)) {
+    return false;
+  }
+  std::shared_ptr<const Table> table;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const bool sameKey = m_key.size() == key.size() + 1 &&
+                         std::equal(key.begin(), key.end(), m_key.begin()) &&
+                         m_key.back() == halfWidth;
+    if (!sameKey) {
+      m_key = key;
+      m_key.push_back(halfWidth);
+      m_table = makeTable(shape, halfWidth);
+    }
+    table = m_table;
+  }
+  if (!table) {
+    return false;
+  }
+
+  for (size_t i = 0; i < nData; ++i) {
+    const double offset = xValues[i] - centre;
+    out[i] = std::fabs(offset) < halfWidth ? scale * (*table)(offset) : 0.0;
+  }
+  return true;
+}
+
+/**
+ * Tabulate a shape in the window [-halfWidth, halfWidth]. The grid covers
+ * the part of the window where the shape is larger than the tolerance times
+ * its maximum, found on a coarse grid. The number of grid intervals is
+ * doubled until the interpolation is accurate enough.
+ * @param shape :: The shape of the peak.
+ * @param halfWidth :: The half-width of the support window of the peak.
+ * @return The table or null if the shape cannot be tabulated.
+ */
+std::shared_ptr<const TabulatedPeakProfile::Table>
+TabulatedPeakProfile::makeTable(const Shape &shape, double halfWidth) const {
+  // Find where the shape is significant
+  const double coarseStep =
+      2.0 * halfWidth / static_cast<double>(COARSE_POINTS - 1);
+  std::vector<double> coarse(COARSE_POINTS);
+  double coarsePeak = 0.0;
+  for (size_t i = 0; i < COARSE_POINTS; ++i) {
+    coarse[i] = shape(-halfWidth + static_cast<double>(i) * coarseStep);
+    if (!std::isfinite(coarse[i])) {
+      return nullptr;
+    }
+    coarsePeak = std::max(coarsePeak, std::fabs(coarse[i]));
+  }
+  if (coarsePeak == 0.0) {
+    return nullptr;
+  }
+  const double threshold = m_tolerance * coarsePeak;
+  size_t first = 0;
+  while (first < COARSE_POINTS - 1 && std::fabs(coarse[first]) <= threshold) {
+    ++first;
+  }
+  size_t last = COARSE_POINTS - 1;
+  while (last > first && std::fabs(coarse[last]) <= threshold) {
+    --last;
+  }
+  const double start =
+      -halfWidth + static_cast<double>(first > 0 ? first - 1 : 0) * coarseStep;
+  const double end =
+      -halfWidth +
+      static_cast<double>(std::min(last + 1, COARSE_POINTS - 1)) * coarseStep;
+
+  size_t nIntervals = MIN_INTERVALS;
+  double step = (end - start) / static_cast<double>(nIntervals);
+  std::vector<double> values(nIntervals + 1);
+  for (size_t i = 0; i <= nIntervals; ++i) {
+    values[i] = shape(start + static_cast<double>(i) * step);
+  }
+
+  std::vector<double> midpoints;
+  while (true) {
+    midpoints.resize(nIntervals);
+    for (size_t i = 0; i < nIntervals; ++i) {
+      midpoints[i] = shape(start + (static_cast<double>(i) + 0.5) * step);
+    }
+
+    double peak = coarsePeak;
+    for (auto v : values) {
+      if (!std::isfinite(v)) {
+        return nullptr;
+      }
+      peak = std::max(peak, std::fabs(v));
+    }
+    for (auto v : midpoints) {
+      if (!std::isfinite(v)) {
+        return nullptr;
+      }
+      peak = std::max(peak, std::fabs(v));
+    }
+
+    double error = 0.0;
+    for (size_t i = 0; i < nIntervals; ++i) {
+      const size_t j = std::min(std::max(i, size_t(1)), nIntervals - 2);
+      const double u = static_cast<double>(i) + 0.5 - static_cast<double>(j);
+      error = std::max(error,
+                       std::fabs(cubic(&values[j - 1], u) - midpoints[i]));
+    }
+    if (error <= m_tolerance * peak) {
+      break;
+    }
+    if (2 * nIntervals > MAX_INTERVALS) {
+      return nullptr;
+    }
+
+    std::vector<double> refined(2 * nIntervals + 1);
+    for (size_t i = 0; i < nIntervals; ++i) {
+      refined[2 * i] = values[i];
+      refined[2 * i + 1] = midpoints[i];
+    }
+    refined.back() = values.back();
+    values.swap(refined);
+    nIntervals *= 2;
+    step /= 2.0;
+  }
+
+  auto table = std::make_shared<Table>();
+  table->start = start;
+  table->end = end;
+  table->invStep = 1.0 / step;
+  table->values.swap(values);
+  return table;
+}
+
+} // namespace Functions
+} // namespace CurveFitting
+} // namespace Mantid
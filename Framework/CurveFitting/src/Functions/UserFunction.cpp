@@ -2,11 +2,19 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Functions/UserFunction.h"
+#include "MantidAPI/CompiledExpression.h"
+#include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/Jacobian.h"
 #include "MantidAPI/MuParserUtils.h"
+#include "MantidKernel/make_unique.h"
 #include <boost/tokenizer.hpp>
 #include "MantidGeometry/muParser_Silent.h"
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
 namespace Mantid {
 namespace CurveFitting {
 namespace Functions {
@@ -16,6 +24,20 @@ using namespace CurveFitting;
 // Register the class into the function factory
 DECLARE_FUNCTION(UserFunction)
 
+namespace {
+/// Values of x at which a compiled formula is compared with muParser
+const double TEST_X[] = {-2.3, -0.7, 0.0, 0.6, 1.9, 3.7};
+
+/// Check that a compiled formula and muParser agree on a value
+bool sameValue(double a, double b) {
+  if (a == b || (std::isnan(a) && std::isnan(b))) {
+    return true;
+  }
+  const double scale = std::max(1.0, std::max(std::fabs(a), std::fabs(b)));
+  return std::fabs(a - b) <= 1e-10 * scale;
+}
+} // namespace
+
 using Mantid::API::MuParserUtils::extraOneVarFunctions;
 using namespace Kernel;
 using namespace API;
@@ -63,6 +85,7 @@ void UserFunction::setAttribute(const std::string &attName,
   }
 
   m_x_set = false;
+  m_compiled.reset();
   clearAllParameters();
 
   try {
@@ -93,6 +116,65 @@ void UserFunction::setAttribute(const std::string &attName,
   }
 
   m_parser->SetExpr(m_formula);
+  compileFormula();
+}
+
+/** Compile the formula for evaluation on whole arrays of x values and
+ * calculation of analytical derivatives. The compiled formula is only used if
+ * it gives the same values as muParser for a few test values of x and the
+ * parameters; otherwise the function keeps using muParser.
+ */
+void UserFunction::compileFormula() {
+  m_compiled.reset();
+  std::vector<std::string> names(nParams());
+  for (size_t i = 0; i < nParams(); i++) {
+    names[i] = parameterName(i);
+  }
+
+  std::unique_ptr<CompiledExpression> compiled;
+  try {
+    compiled = Kernel::make_unique<CompiledExpression>(m_formula, "x", names);
+  } catch (std::invalid_argument &) {
+    return;
+  }
+
+  const size_t nTest = sizeof(TEST_X) / sizeof(double);
+  std::vector<double> expected(nTest), actual(nTest);
+  const auto saved = parameterValues();
+  std::vector<double> params(nParams());
+  for (size_t i = 0; i < nParams(); i++) {
+    params[i] = 0.37 + 0.11 * static_cast<double>(i);
+    *getParameterAddress(i) = params[i];
+  }
+  bool ok = true;
+  try {
+    for (size_t k = 0; k < nTest; k++) {
+      m_x = TEST_X[k];
+      expected[k] = m_parser->Eval();
+    }
+    compiled->evaluate(TEST_X, nTest, params.data(), actual.data());
+  } catch (...) {
+    ok = false;
+  }
+  for (size_t i = 0; i < nParams(); i++) {
+    *getParameterAddress(i) = saved[i];
+  }
+
+  for (size_t k = 0; ok && k < nTest; k++) {
+    ok = sameValue(expected[k], actual[k]);
+  }
+  if (ok) {
+    m_compiled = std::move(compiled);
+  }
+}
+
+/// Get the current values of all parameters in the order of declaration.
+std::vector<double> UserFunction::parameterValues() const {
+  std::vector<double> values(nParams());
+  for (size_t i = 0; i < nParams(); i++) {
+    values[i] = getParameter(i);
+  }
+  return values;
 }
 
 /** Calculate the fitting function.
@@ -104,6 +186,11 @@ void UserFunction::setAttribute(const std::string &attName,
 */
 void UserFunction::function1D(double *out, const double *xValues,
                               const size_t nData) const {
+  if (m_compiled) {
+    const auto params = parameterValues();
+    m_compiled->evaluate(xValues, nData, params.data(), out);
+    return;
+  }
   for (size_t i = 0; i < nData; i++) {
     m_x = xValues[i];
     out[i] = m_parser->Eval();
@@ -111,6 +198,8 @@ void UserFunction::function1D(double *out, const double *xValues,
 }
 
 /**
+* The derivatives are calculated analytically if the formula could be
+* compiled and no parameter is tied, and numerically otherwise.
 * @param domain :: the space on which the function acts
 * @param jacobian :: the set of partial derivatives of the function with respect
 * to the
@@ -118,7 +207,29 @@ void UserFunction::function1D(double *out, const double *xValues,
 */
 void UserFunction::functionDeriv(const API::FunctionDomain &domain,
                                  API::Jacobian &jacobian) {
-  calNumericalDeriv(domain, jacobian);
+  auto domain1D = dynamic_cast<const FunctionDomain1D *>(&domain);
+  bool analytical = m_compiled && domain1D;
+  for (size_t i = 0; analytical && i < nParams(); i++) {
+    analytical = getTie(i) == nullptr;
+  }
+  if (!analytical) {
+    calNumericalDeriv(domain, jacobian);
+    return;
+  }
+
+  const size_t nData = domain1D->size();
+  const auto params = parameterValues();
+  std::vector<double> column(nData);
+  for (size_t i = 0; i < nParams(); i++) {
+    if (!isActive(i)) {
+      continue;
+    }
+    m_compiled->derivative(i, domain1D->getPointerAt(0), nData,
+                           params.data(), column.data());
+    for (size_t k = 0; k < nData; k++) {
+      jacobian.set(k, i, column[k]);
+    }
+  }
 }
 
 } // namespace Functions
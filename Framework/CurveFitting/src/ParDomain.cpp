@@ -4,6 +4,8 @@
 #include "MantidCurveFitting/ParDomain.h"
 #include "MantidKernel/MultiThreaded.h"
 
+#include <algorithm>
+
 namespace Mantid {
 namespace CurveFitting {
 
@@ -24,6 +26,54 @@ void ParDomain::getDomainAndValues(size_t i, API::FunctionDomain_sptr &domain,
   values = m_values[i];
 }
 
+namespace {
+/// Number of domains whose contributions are calculated together. It is
+/// fixed so that the order of the additions, and hence the result, does not
+/// depend on the number of threads.
+const size_t DOMAIN_BLOCK_SIZE = 64;
+
+/**
+ * Sum the first n elements of a vector in place by a pairwise tree
+ * reduction. The result is left in the first element.
+ * @param parts :: The partial sums
+ * @param n :: The number of partial sums to add
+ * @param add :: Adds its second argument to the first
+ */
+template <typename T, typename Add>
+void treeReduce(std::vector<T> &parts, size_t n, Add add) {
+  for (size_t stride = 1; stride < n; stride *= 2) {
+    const int64_t nPairs = static_cast<int64_t>((n - stride + 2 * stride - 1) /
+                                                (2 * stride));
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t k = 0; k < nPairs; ++k) {
+      const size_t i = static_cast<size_t>(k) * 2 * stride;
+      add(parts[i], parts[i + stride]);
+    }
+  }
+}
+
+/**
+ * Make one copy of the fitting function per thread, with exactly the same
+ * parameters as the original. Evaluating a function is not thread-safe.
+ * @param leastSquares :: The cost function with the fitting function
+ * @return the copies
+ */
+std::vector<API::IFunction_sptr> cloneFittingFunction(
+    const CostFunctions::CostFuncLeastSquares &leastSquares) {
+  auto fittingFunction = leastSquares.getFittingFunction();
+  std::vector<API::IFunction_sptr> funs(PARALLEL_GET_MAX_THREADS);
+  for (auto &fun : funs) {
+    fun = fittingFunction->clone();
+    for (size_t i = 0; i < fittingFunction->nParams(); ++i) {
+      fun->setParameter(i, fittingFunction->getParameter(i),
+                        fittingFunction->isExplicitlySet(i));
+    }
+    fun->applyTies();
+  }
+  return funs;
+}
+} // namespace
+
 /**
  * Calculate the value of a least squares cost function
  * @param leastSquares :: The least squares cost func to calculate the value for
@@ -31,25 +81,33 @@ void ParDomain::getDomainAndValues(size_t i, API::FunctionDomain_sptr &domain,
 void ParDomain::leastSquaresVal(
     const CostFunctions::CostFuncLeastSquares &leastSquares) {
   const int n = static_cast<int>(getNDomains());
+  std::vector<double> values(n);
+  auto funs = cloneFittingFunction(leastSquares);
+  std::vector<CostFunctions::CostFuncLeastSquares::Buffers> buffers(
+      PARALLEL_GET_MAX_THREADS);
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int i = 0; i < n; ++i) {
     API::FunctionDomain_sptr domain;
-    API::FunctionValues_sptr values;
-    getDomainAndValues(static_cast<size_t>(i), domain, values);
-    if (!values) {
+    API::FunctionValues_sptr domainValues;
+    getDomainAndValues(static_cast<size_t>(i), domain, domainValues);
+    if (!domainValues) {
       throw std::runtime_error("LeastSquares: undefined FunctionValues.");
     }
-    leastSquares.addVal(domain, values);
-    // PARALLEL_CRITICAL(printout)
-    //{
-    //  std::cerr << "val= " << leastSquares.m_value << '\n';
-    //}
+    const int thread = PARALLEL_THREAD_NUMBER;
+    values[i] = leastSquares.calVal(funs[thread], domain, domainValues,
+                                    buffers[thread]);
+  }
+  // Add the contributions in a fixed order
+  for (auto value : values) {
+    leastSquares.m_value += value;
   }
 }
 
 /**
  * Calculate the value, first and second derivatives of a least squares cost
- * function
+ * function. Each domain contributes to its own partial sums, which are then
+ * added by a tree reduction in the order of the domains, so the result does
+ * not depend on the number of threads.
  * @param leastSquares :: The least squares cost func to calculate the value for
  * @param evalDeriv :: Flag to evaluate the first derivatives
  * @param evalHessian :: Flag to evaluate the Hessian (second derivatives)
@@ -57,31 +115,59 @@ void ParDomain::leastSquaresVal(
 void ParDomain::leastSquaresValDerivHessian(
     const CostFunctions::CostFuncLeastSquares &leastSquares, bool evalDeriv,
     bool evalHessian) {
-  const int n = static_cast<int>(getNDomains());
+  UNUSED_ARG(evalDeriv);
+  const size_t n = getNDomains();
+  const size_t np = leastSquares.nParams();
   PARALLEL_SET_DYNAMIC(0);
-  std::vector<API::IFunction_sptr> funs;
-  // funs.push_back( leastSquares.getFittingFunction()->clone() );
-  PARALLEL_FOR_NO_WSP_CHECK()
-  for (int i = 0; i < n; ++i) {
-    API::FunctionDomain_sptr domain;
-    API::FunctionValues_sptr values;
-    getDomainAndValues(i, domain, values);
-    auto simpleValues =
-        boost::dynamic_pointer_cast<API::FunctionValues>(values);
-    if (!simpleValues) {
-      throw std::runtime_error("LeastSquares: undefined FunctionValues.");
-    }
-    std::vector<API::IFunction_sptr>::size_type k = PARALLEL_THREAD_NUMBER;
-    PARALLEL_CRITICAL(resize) {
-      if (k >= funs.size()) {
-        funs.resize(k + 1);
-      }
-      if (!funs[k]) {
-        funs[k] = leastSquares.getFittingFunction()->clone();
+
+  auto funs = cloneFittingFunction(leastSquares);
+  std::vector<CostFunctions::CostFuncLeastSquares::Buffers> buffers(
+      PARALLEL_GET_MAX_THREADS);
+
+  struct PartialSum {
+    double value;
+    GSLVector der;
+    GSLMatrix hessian;
+  };
+  const size_t blockSize = std::min(n, DOMAIN_BLOCK_SIZE);
+  // The Hessian is a dummy 1x1 matrix when it is not evaluated
+  const size_t nh = evalHessian ? np : 1;
+  std::vector<PartialSum> parts(
+      blockSize, PartialSum{0.0, GSLVector(np), GSLMatrix(nh, nh)});
+  auto add = [evalHessian](PartialSum &sum, const PartialSum &other) {
+    sum.value += other.value;
+    sum.der += other.der;
+    if (evalHessian)
+      sum.hessian += other.hessian;
+  };
+
+  for (size_t start = 0; start < n; start += blockSize) {
+    const size_t nInBlock = std::min(blockSize, n - start);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t k = 0; k < static_cast<int64_t>(nInBlock); ++k) {
+      API::FunctionDomain_sptr domain;
+      API::FunctionValues_sptr values;
+      getDomainAndValues(start + static_cast<size_t>(k), domain, values);
+      auto simpleValues =
+          boost::dynamic_pointer_cast<API::FunctionValues>(values);
+      if (!simpleValues) {
+        throw std::runtime_error("LeastSquares: undefined FunctionValues.");
       }
+      auto &part = parts[k];
+      part.value = 0.0;
+      part.der.zero();
+      if (evalHessian)
+        part.hessian.zero();
+      const int thread = PARALLEL_THREAD_NUMBER;
+      leastSquares.calValDerivHessian(funs[thread], domain, simpleValues,
+                                      evalHessian, part.value, part.der,
+                                      part.hessian, buffers[thread]);
     }
-    leastSquares.addValDerivHessian(funs[k], domain, simpleValues, evalDeriv,
-                                    evalHessian);
+    treeReduce(parts, nInBlock, add);
+    leastSquares.m_value += parts[0].value;
+    leastSquares.m_der += parts[0].der;
+    if (evalHessian)
+      leastSquares.m_hessian += parts[0].hessian;
   }
 }
 
@@ -0,0 +1,168 @@
+#ifndef MANTID_CURVEFITTING_FITPEAKSTEST_H_
+#define MANTID_CURVEFITTING_FITPEAKSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidCurveFitting/Algorithms/FitPeaks.h"
+
+#include "MantidAPI/ITableWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/WorkspaceFactory.h"
+
+#include <cmath>
+
+using namespace Mantid::API;
+using Mantid::CurveFitting::Algorithms::FitPeaks;
+
+class FitPeaksTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static FitPeaksTest *createSuite() { return new FitPeaksTest(); }
+  static void destroySuite(FitPeaksTest *suite) { delete suite; }
+
+  void test_Init() {
+    FitPeaks alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_fits_peaks_in_all_spectra() {
+    // More spectra than one block, so that blocks are fitted in parallel
+    const size_t nSpectra = 130;
+    auto ws = createWorkspace(nSpectra);
+    FitPeaks alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace", ws);
+    alg.setPropertyValue("PeakCentres", "3,7");
+    alg.setPropertyValue("FitWindowBoundaryList", "2,5,5,9");
+    alg.setPropertyValue("OutputWorkspace", "__unused");
+    alg.setPropertyValue("FittedPeakParametersWorkspace", "__unused_table");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    MatrixWorkspace_sptr out = alg.getProperty("OutputWorkspace");
+    TS_ASSERT_EQUALS(out->getNumberHistograms(), nSpectra);
+    TS_ASSERT_EQUALS(out->blocksize(), 2);
+    TS_ASSERT_EQUALS(out->x(0)[0], 3.0);
+    TS_ASSERT_EQUALS(out->x(0)[1], 7.0);
+    for (size_t i = 0; i < nSpectra; ++i) {
+      TS_ASSERT_DELTA(out->y(i)[0], centre1(i), 1e-6);
+      TS_ASSERT_DELTA(out->y(i)[1], centre2(i), 1e-6);
+    }
+
+    ITableWorkspace_sptr table =
+        alg.getProperty("FittedPeakParametersWorkspace");
+    TS_ASSERT_EQUALS(table->rowCount(), 2 * nSpectra);
+    TS_ASSERT_EQUALS(table->columnCount(), 11);
+    const size_t row = 2 * 77 + 1;
+    TS_ASSERT_EQUALS(table->cell<int>(row, 0), 77);
+    TS_ASSERT_EQUALS(table->cell<int>(row, 1), 1);
+    TS_ASSERT_EQUALS(table->cell<int>(row, 2), FitPeaks::Success);
+    TS_ASSERT_DELTA(table->cell<double>(row, 3), centre2(77), 1e-6);
+    TS_ASSERT_DELTA(table->cell<double>(row, 4), 5.0, 1e-5);
+    TS_ASSERT_DELTA(table->cell<double>(row, 5), 2.0 * sqrt(2.0 * M_LN2) * 0.15,
+                    1e-6);
+    TS_ASSERT_DELTA(table->cell<double>(row, 7), 1.0, 1e-5);
+    TS_ASSERT_DELTA(table->cell<double>(row, 8), 0.1, 1e-6);
+    TS_ASSERT_DELTA(table->cell<double>(row, 10), 0.0, 1e-8);
+  }
+
+  void test_default_windows_and_workspace_indices() {
+    auto ws = createWorkspace(10);
+    FitPeaks alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace", ws);
+    alg.setProperty("StartWorkspaceIndex", 3);
+    alg.setProperty("StopWorkspaceIndex", 5);
+    alg.setPropertyValue("PeakCentres", "3,7");
+    alg.setPropertyValue("OutputWorkspace", "__unused");
+    alg.setPropertyValue("FittedPeakParametersWorkspace", "__unused_table");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+
+    MatrixWorkspace_sptr out = alg.getProperty("OutputWorkspace");
+    TS_ASSERT_EQUALS(out->getNumberHistograms(), 3);
+    for (size_t i = 0; i < 3; ++i) {
+      TS_ASSERT_DELTA(out->y(i)[0], centre1(i + 3), 1e-6);
+      TS_ASSERT_DELTA(out->y(i)[1], centre2(i + 3), 1e-6);
+    }
+    ITableWorkspace_sptr table =
+        alg.getProperty("FittedPeakParametersWorkspace");
+    TS_ASSERT_EQUALS(table->cell<int>(0, 0), 3);
+    TS_ASSERT_EQUALS(table->cell<int>(5, 0), 5);
+  }
+
+  void test_spectrum_without_peaks_is_flagged() {
+    auto ws = createWorkspace(3);
+    ws->mutableY(1) = 1.0;
+    FitPeaks alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace", ws);
+    alg.setPropertyValue("PeakCentres", "3,7");
+    alg.setPropertyValue("FitWindowBoundaryList", "2,5,5,9");
+    alg.setPropertyValue("OutputWorkspace", "__unused");
+    alg.setPropertyValue("FittedPeakParametersWorkspace", "__unused_table");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+
+    MatrixWorkspace_sptr out = alg.getProperty("OutputWorkspace");
+    TS_ASSERT(std::isnan(out->y(1)[0]));
+    TS_ASSERT(std::isnan(out->y(1)[1]));
+    ITableWorkspace_sptr table =
+        alg.getProperty("FittedPeakParametersWorkspace");
+    TS_ASSERT_EQUALS(table->cell<int>(2, 2), FitPeaks::NoSignal);
+    TS_ASSERT_EQUALS(table->cell<int>(3, 2), FitPeaks::NoSignal);
+    TS_ASSERT_EQUALS(table->cell<int>(4, 2), FitPeaks::Success);
+    // The spectrum after it is fitted from its own estimates
+    TS_ASSERT_DELTA(out->y(2)[0], centre1(2), 1e-6);
+    TS_ASSERT_DELTA(out->y(2)[1], centre2(2), 1e-6);
+  }
+
+  void test_windows_must_match_peaks() {
+    FitPeaks alg;
+    alg.initialize();
+    alg.setChild(true);
+    alg.setProperty("InputWorkspace", createWorkspace(1));
+    alg.setPropertyValue("PeakCentres", "3,7");
+    alg.setPropertyValue("FitWindowBoundaryList", "2,5,5");
+    alg.setPropertyValue("OutputWorkspace", "__unused");
+    alg.setPropertyValue("FittedPeakParametersWorkspace", "__unused_table");
+    TS_ASSERT_THROWS(alg.execute(), std::runtime_error);
+
+    alg.setPropertyValue("PeakCentres", "3");
+    alg.setPropertyValue("FitWindowBoundaryList", "");
+    TS_ASSERT_THROWS(alg.execute(), std::runtime_error);
+  }
+
+private:
+  static double centre1(size_t i) {
+    return 3.0 + 0.001 * static_cast<double>(i);
+  }
+  static double centre2(size_t i) {
+    return 7.0 - 0.002 * static_cast<double>(i);
+  }
+
+  /// Two Gaussians on a linear background, moving from spectrum to spectrum
+  MatrixWorkspace_sptr createWorkspace(size_t nSpectra) {
+    const size_t nPoints = 501;
+    auto ws = WorkspaceFactory::Instance().create("Workspace2D", nSpectra,
+                                                  nPoints, nPoints);
+    for (size_t i = 0; i < nSpectra; ++i) {
+      auto &x = ws->mutableX(i);
+      auto &y = ws->mutableY(i);
+      ws->mutableE(i) = 1.0;
+      for (size_t j = 0; j < nPoints; ++j) {
+        x[j] = 0.02 * static_cast<double>(j);
+        const double d1 = (x[j] - centre1(i)) / 0.1;
+        const double d2 = (x[j] - centre2(i)) / 0.15;
+        y[j] = 1.0 + 0.1 * x[j] + 10.0 * exp(-0.5 * d1 * d1) +
+               5.0 * exp(-0.5 * d2 * d2);
+      }
+    }
+    return ws;
+  }
+};
+
+#endif /* MANTID_CURVEFITTING_FITPEAKSTEST_H_ */
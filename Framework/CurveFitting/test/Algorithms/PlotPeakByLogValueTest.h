@@ -222,6 +222,41 @@ public:
     WorkspaceCreationHelper::removeWS("PlotPeakResult");
   }
 
+  void testWorkspaceList_individual_parallel() {
+    createData();
+
+    PlotPeakByLogValue alg;
+    alg.initialize();
+    alg.setPropertyValue("Input",
+                         "PlotPeakGroup_0;PlotPeakGroup_1;PlotPeakGroup_2");
+    alg.setPropertyValue("OutputWorkspace", "PlotPeakResult");
+    alg.setPropertyValue("WorkspaceIndex", "1");
+    alg.setPropertyValue("LogValue", "var");
+    alg.setPropertyValue("FitType", "Individual");
+    alg.setProperty("Parallel", true);
+    alg.setPropertyValue("Function", "name=LinearBackground,A0=1,A1=0.3;name="
+                                     "Gaussian,PeakCentre=5,Height=2,Sigma=0."
+                                     "1");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    TWS_type result =
+        WorkspaceCreationHelper::getWS<TableWorkspace>("PlotPeakResult");
+    TS_ASSERT_EQUALS(result->columnCount(), 12);
+    TS_ASSERT_EQUALS(result->rowCount(), 3);
+
+    // The rows are in the order of the input, whichever fit finishes first
+    TS_ASSERT_DELTA(result->Double(0, 0), 1, 1e-10);
+    TS_ASSERT_DELTA(result->Double(0, 7), 5, 1e-10);
+    TS_ASSERT_DELTA(result->Double(1, 0), 1.3, 1e-10);
+    TS_ASSERT_DELTA(result->Double(1, 7), 5.03, 1e-10);
+    TS_ASSERT_DELTA(result->Double(2, 0), 1.6, 1e-10);
+    TS_ASSERT_DELTA(result->Double(2, 7), 5.06, 1e-10);
+
+    deleteData();
+    WorkspaceCreationHelper::removeWS("PlotPeakResult");
+  }
+
   void testWorkspaceList_plotting_against_ws_names() {
     createData();
 
@@ -164,6 +164,60 @@ public:
     TS_ASSERT_DELTA(g.get(1), 0.9, 1e-10);
   }
 
+  void test_weighted_derivatives_and_hessian_with_fixed_parameter() {
+    std::vector<double> x(7), y(7), w(7);
+    for (size_t i = 0; i < x.size(); ++i) {
+      x[i] = 0.5 * double(i) - 1.0;
+      y[i] = 2.0 * x[i] * x[i] - x[i] + 3.0 + 0.1 * double(i % 3);
+      w[i] = 1.0 / (1.0 + 0.2 * double(i));
+    }
+    API::FunctionDomain1D_sptr domain(new API::FunctionDomain1DVector(x));
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    values->setFitData(y);
+    values->setFitWeights(w);
+
+    boost::shared_ptr<UserFunction> fun = boost::make_shared<UserFunction>();
+    fun->setAttributeValue("Formula", "a*x^2+b*x+c");
+    fun->setParameter("a", 1.5);
+    fun->setParameter("b", -1.2);
+    fun->setParameter("c", 2.5);
+    fun->fix(1);
+
+    boost::shared_ptr<CostFuncLeastSquares> costFun =
+        boost::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, domain, values);
+
+    double value = 0.0;
+    double da = 0.0, dc = 0.0, haa = 0.0, hac = 0.0, hcc = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+      const double f = 1.5 * x[i] * x[i] - 1.2 * x[i] + 2.5;
+      const double r = (f - y[i]) * w[i];
+      const double ja = x[i] * x[i] * w[i];
+      const double jc = w[i];
+      value += 0.5 * r * r;
+      da += r * ja;
+      dc += r * jc;
+      haa += ja * ja;
+      hac += ja * jc;
+      hcc += jc * jc;
+    }
+
+    // Calculate twice to check that the buffers are reset
+    for (int k = 0; k < 2; ++k) {
+      costFun->setParameter(0, costFun->getParameter(0));
+      TS_ASSERT_DELTA(costFun->valDerivHessian(), value, 1e-10);
+      const GSLVector &g = costFun->getDeriv();
+      const GSLMatrix &H = costFun->getHessian();
+      TS_ASSERT_EQUALS(g.size(), 2);
+      TS_ASSERT_DELTA(g.get(0), da, 1e-10);
+      TS_ASSERT_DELTA(g.get(1), dc, 1e-10);
+      TS_ASSERT_DELTA(H.get(0, 0), haa, 1e-10);
+      TS_ASSERT_DELTA(H.get(0, 1), hac, 1e-10);
+      TS_ASSERT_DELTA(H.get(1, 0), hac, 1e-10);
+      TS_ASSERT_DELTA(H.get(1, 1), hcc, 1e-10);
+    }
+  }
+
   void test_linear_correction_is_good_approximation() {
     const double a = 1.0;
     const double b = 2.0;
@@ -6,6 +6,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "MantidCurveFitting/Algorithms/Fit.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
 #include "MantidCurveFitting/FitMW.h"
 #include "MantidCurveFitting/Functions/Convolution.h"
 #include "MantidCurveFitting/Functions/ExpDecay.h"
@@ -487,6 +488,53 @@ public:
     TS_ASSERT_DELTA(v1d->getFitData(0), 4.0, 1e-13);
   }
 
+  void test_ParDomain_gives_same_cost_function_as_SeqDomain() {
+    MatrixWorkspace_sptr ws2(new WorkspaceTester);
+    ws2->initialize(1, 101, 100);
+    auto &x = ws2->mutableX(0);
+    auto &y = ws2->mutableY(0);
+    for (size_t i = 0; i < ws2->blocksize(); ++i) {
+      x[i] = 0.1 * double(i);
+      y[i] = 1.0 + 0.5 * x[i] + 0.1 * x[i] * x[i] + 0.01 * double(i % 7);
+    }
+    x.back() = x[x.size() - 2] + 0.1;
+
+    auto makeCostFunction = [&ws2](FitMW::DomainType domainType) {
+      FunctionDomain_sptr domain;
+      FunctionValues_sptr values;
+      FitMW fitmw(domainType);
+      fitmw.setWorkspace(ws2);
+      fitmw.setWorkspaceIndex(0);
+      fitmw.setMaxSize(7);
+      fitmw.createDomain(domain, values);
+      auto fun = boost::make_shared<Polynomial>();
+      fun->initialize();
+      fun->setAttributeValue("n", 2);
+      fun->setParameter(0, 1.1);
+      fun->setParameter(1, 0.45);
+      fun->setParameter(2, 0.12);
+      auto costFun = boost::make_shared<
+          Mantid::CurveFitting::CostFunctions::CostFuncLeastSquares>();
+      costFun->setFittingFunction(fun, domain, values);
+      return costFun;
+    };
+
+    auto seqCost = makeCostFunction(FitMW::Sequential);
+    auto parCost = makeCostFunction(FitMW::Parallel);
+    TS_ASSERT_DELTA(parCost->valDerivHessian(), seqCost->valDerivHessian(),
+                    1e-10);
+    const auto &seqDeriv = seqCost->getDeriv();
+    const auto &parDeriv = parCost->getDeriv();
+    const auto &seqHessian = seqCost->getHessian();
+    const auto &parHessian = parCost->getHessian();
+    for (size_t i = 0; i < 3; ++i) {
+      TS_ASSERT_DELTA(parDeriv.get(i), seqDeriv.get(i), 1e-10);
+      for (size_t j = 0; j < 3; ++j) {
+        TS_ASSERT_DELTA(parHessian.get(i, j), seqHessian.get(i, j), 1e-10);
+      }
+    }
+  }
+
   void
   test_Composite_Function_With_SeparateMembers_Option_On_FitMW_Outputs_Composite_Values_Plus_Each_Member() {
     const bool histogram = true;
@@ -0,0 +1,147 @@
+#ifndef CURVEFITTING_DIFFERENTIALEVOLUTIONMINIMIZERTEST_H_
+#define CURVEFITTING_DIFFERENTIALEVOLUTIONMINIMIZERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/ICostFunction.h"
+#include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
+#include "MantidCurveFitting/FuncMinimizers/DifferentialEvolutionMinimizer.h"
+#include "MantidCurveFitting/Functions/UserFunction.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Mantid;
+using namespace Mantid::CurveFitting;
+using namespace Mantid::CurveFitting::FuncMinimisers;
+using namespace Mantid::CurveFitting::CostFunctions;
+using namespace Mantid::CurveFitting::Functions;
+using namespace Mantid::API;
+
+/// A cost function with many local minima and the global minimum at
+/// (1.1, 2.2)
+class DifferentialEvolutionTestCostFunction : public ICostFunction {
+  double a, b;
+
+public:
+  DifferentialEvolutionTestCostFunction() : a(4.0), b(-1.0) {}
+  std::string name() const override {
+    return "DifferentialEvolutionTestCostFunction";
+  }
+  double getParameter(size_t i) const override { return i == 0 ? a : b; }
+  void setParameter(size_t i, const double &value) override {
+    if (i == 0) {
+      a = value;
+    } else {
+      b = value;
+    }
+  }
+  size_t nParams() const override { return 2; }
+  double val() const override {
+    double x = a - 1.1;
+    double y = b - 2.2;
+    return 3.1 + x * x + y * y +
+           10.0 * (2.0 - cos(2 * M_PI * x) - cos(2 * M_PI * y));
+  }
+  void deriv(std::vector<double> &) const override {}
+  double valAndDeriv(std::vector<double> &) const override { return 0.0; }
+};
+
+class DifferentialEvolutionMinimizerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static DifferentialEvolutionMinimizerTest *createSuite() {
+    return new DifferentialEvolutionMinimizerTest();
+  }
+  static void destroySuite(DifferentialEvolutionMinimizerTest *suite) {
+    delete suite;
+  }
+
+  void test_finds_global_minimum() {
+    ICostFunction_sptr fun(new DifferentialEvolutionTestCostFunction);
+    DifferentialEvolutionMinimizer s;
+    s.setProperty("PopulationSize", 40);
+    s.setProperty("InitialSpread", 2.0);
+    s.setProperty("RelError", 1e-10);
+    s.initialize(fun);
+    TS_ASSERT(!s.isParallel());
+    TS_ASSERT(s.minimize(1000));
+    TS_ASSERT_DELTA(fun->val(), 3.1, 1e-6);
+    TS_ASSERT_DELTA(fun->getParameter(0), 1.1, 1e-3);
+    TS_ASSERT_DELTA(fun->getParameter(1), 2.2, 1e-3);
+    TS_ASSERT_EQUALS(s.costFunctionVal(), fun->val());
+    TS_ASSERT_EQUALS(s.getError(), "success");
+  }
+
+  void test_result_does_not_depend_on_parallel_evaluation() {
+#ifdef _OPENMP
+    // Make sure there are threads to evaluate on even on a single core
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    PARALLEL_SET_NUM_THREADS(std::max(2, maxThreads))
+#endif
+    auto fun = makeGaussian();
+    auto costFun = makeCostFunction(fun);
+    DifferentialEvolutionMinimizer s;
+    s.initialize(costFun);
+#ifdef _OPENMP
+    TS_ASSERT(s.isParallel());
+#endif
+    s.minimize(1000);
+#ifdef _OPENMP
+    PARALLEL_SET_NUM_THREADS(maxThreads)
+#endif
+    TS_ASSERT_DELTA(fun->getParameter("h"), 3.3, 1e-3);
+    TS_ASSERT_DELTA(fun->getParameter("c"), 4.4, 1e-3);
+    TS_ASSERT_DELTA(fabs(fun->getParameter("s")), 0.7, 1e-3);
+
+    // The parallel hint makes the minimizer evaluate serially
+    auto serialFun = makeGaussian();
+    serialFun->setParallel(true);
+    auto serialCostFun = makeCostFunction(serialFun);
+    DifferentialEvolutionMinimizer serial;
+    serial.initialize(serialCostFun);
+    TS_ASSERT(!serial.isParallel());
+    serial.minimize(1000);
+    for (size_t i = 0; i < fun->nParams(); ++i) {
+      TS_ASSERT_EQUALS(fun->getParameter(i), serialFun->getParameter(i));
+    }
+    TS_ASSERT_EQUALS(s.costFunctionVal(), serial.costFunctionVal());
+  }
+
+private:
+  boost::shared_ptr<UserFunction> makeGaussian() {
+    auto fun = boost::make_shared<UserFunction>();
+    fun->setAttributeValue("Formula", "h*exp(-((x-c)/s)^2/2)");
+    fun->setParameter("h", 2.0);
+    fun->setParameter("c", 5.0);
+    fun->setParameter("s", 1.0);
+    return fun;
+  }
+
+  boost::shared_ptr<CostFuncLeastSquares>
+  makeCostFunction(IFunction_sptr fun) {
+    API::FunctionDomain1D_sptr domain(
+        new API::FunctionDomain1DVector(0.0, 10.0, 50));
+    API::FunctionValues mockData(*domain);
+    UserFunction dataMaker;
+    dataMaker.setAttributeValue("Formula", "h*exp(-((x-c)/s)^2/2)");
+    dataMaker.setParameter("h", 3.3);
+    dataMaker.setParameter("c", 4.4);
+    dataMaker.setParameter("s", 0.7);
+    dataMaker.function(*domain, mockData);
+
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    values->setFitDataFromCalculated(mockData);
+    values->setFitWeights(1.0);
+
+    auto costFun = boost::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, domain, values);
+    return costFun;
+  }
+};
+
+#endif /*CURVEFITTING_DIFFERENTIALEVOLUTIONMINIMIZERTEST_H_*/
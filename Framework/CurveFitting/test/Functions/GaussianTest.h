@@ -182,6 +182,52 @@ public:
     TS_ASSERT_DELTA(fn.intensity(), intensity, 1e-6);
     TS_ASSERT_DELTA(fn.getParameter("Height"), 0.398942, 1e-6);
   }
+
+  void test_support_interval() {
+    Gaussian fn;
+    fn.initialize();
+    fn.setParameter("Height", 1.0);
+    fn.setParameter("PeakCentre", 2.0);
+    fn.setParameter("Sigma", 0.5);
+
+    // Without a peak radius the tails below DBL_EPSILON are cut off
+    auto interval = fn.getSupportInterval(0);
+    TS_ASSERT_DELTA(interval.first, 2.0 - 4.245, 1e-3);
+    TS_ASSERT_DELTA(interval.second, 2.0 + 4.245, 1e-3);
+    double x = interval.second;
+    double y = 0.0;
+    fn.function1D(&y, &x, 1);
+    TS_ASSERT_LESS_THAN(y, 1e-15);
+
+    // A smaller peak radius is used as it is
+    interval = fn.getSupportInterval(2);
+    TS_ASSERT_DELTA(interval.first, 2.0 - 2.0 * fn.fwhm(), 1e-12);
+    TS_ASSERT_DELTA(interval.second, 2.0 + 2.0 * fn.fwhm(), 1e-12);
+  }
+
+  void test_composite_of_narrow_peaks() {
+    CompositeFunction fn;
+    std::vector<double> centres{-30.0, -10.0, 5.0, 40.0};
+    for (auto c : centres) {
+      auto g = boost::make_shared<Gaussian>();
+      g->initialize();
+      g->setParameter("Height", 2.0);
+      g->setParameter("PeakCentre", c);
+      g->setParameter("Sigma", 0.3);
+      fn.addFunction(g);
+    }
+    FunctionDomain1DVector x(-50.0, 50.0, 1001);
+    FunctionValues y(x);
+    fn.function(x, y);
+    for (size_t i = 0; i < x.size(); ++i) {
+      double expected = 0.0;
+      for (auto c : centres) {
+        double diff = (x[i] - c) / 0.3;
+        expected += 2.0 * exp(-0.5 * diff * diff);
+      }
+      TS_ASSERT_DELTA(y[i], expected, 1e-14);
+    }
+  }
 };
 
 #endif /*GAUSSIANTEST_H_*/
\ No newline at end of file
@@ -3,7 +3,10 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidCurveFitting/Functions/Polynomial.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include <array>
 #include <numeric>
@@ -72,6 +75,92 @@ public:
                       1e-12);
     }
   }
+
+  void test_numerical_derivatives_match_in_parallel_and_serial() {
+    Polynomial pol;
+    pol.initialize();
+    pol.setAttributeValue("n", 11);
+    for (size_t i = 0; i < pol.nParams(); ++i) {
+      pol.setParameter(i, 1.0 / static_cast<double>(i + 3));
+    }
+    pol.fix(4);
+
+    const size_t numPoints = 30;
+    Mantid::API::FunctionDomain1DVector domain(-1.0, 1.0, numPoints);
+    Mantid::CurveFitting::Jacobian parallelJacobian(numPoints, pol.nParams());
+    Mantid::CurveFitting::Jacobian serialJacobian(numPoints, pol.nParams());
+
+    pol.calNumericalDeriv(domain, parallelJacobian);
+    // The parallel hint disables the threaded calculation
+    pol.setParallel(true);
+    pol.calNumericalDeriv(domain, serialJacobian);
+
+    for (size_t i = 0; i < numPoints; ++i) {
+      for (size_t j = 0; j < pol.nParams(); ++j) {
+        if (j == 4)
+          continue;
+        TS_ASSERT_EQUALS(parallelJacobian.get(i, j), serialJacobian.get(i, j));
+      }
+    }
+    // The parameters are unchanged
+    TS_ASSERT_EQUALS(pol.getParameter(2), 1.0 / 5.0);
+  }
+
+  void test_parallel_numerical_derivatives_follow_parameter_changes() {
+    Polynomial pol;
+    pol.initialize();
+    pol.setAttributeValue("n", 11);
+    for (size_t i = 0; i < pol.nParams(); ++i) {
+      pol.setParameter(i, 1.0 / static_cast<double>(i + 3));
+    }
+
+    const size_t numPoints = 30;
+    Mantid::API::FunctionDomain1DVector domain(-1.0, 1.0, numPoints);
+    Mantid::CurveFitting::Jacobian parallelJacobian(numPoints, pol.nParams());
+    Mantid::CurveFitting::Jacobian serialJacobian(numPoints, pol.nParams());
+
+    // The copies made by the first call are reused by the second
+    pol.calNumericalDeriv(domain, parallelJacobian);
+    for (size_t i = 0; i < pol.nParams(); ++i) {
+      pol.setParameter(i, 2.0 + static_cast<double>(i));
+    }
+    pol.calNumericalDeriv(domain, parallelJacobian);
+    pol.setParallel(true);
+    pol.calNumericalDeriv(domain, serialJacobian);
+
+    for (size_t i = 0; i < numPoints; ++i) {
+      for (size_t j = 0; j < pol.nParams(); ++j) {
+        TS_ASSERT_EQUALS(parallelJacobian.get(i, j), serialJacobian.get(i, j));
+      }
+    }
+  }
+
+  void test_parallel_numerical_derivatives_follow_new_ties() {
+    Polynomial pol;
+    pol.initialize();
+    pol.setAttributeValue("n", 11);
+    for (size_t i = 0; i < pol.nParams(); ++i) {
+      pol.setParameter(i, 1.0 / static_cast<double>(i + 3));
+    }
+
+    const size_t numPoints = 30;
+    Mantid::API::FunctionDomain1DVector domain(-1.0, 1.0, numPoints);
+    Mantid::CurveFitting::Jacobian parallelJacobian(numPoints, pol.nParams());
+    Mantid::CurveFitting::Jacobian serialJacobian(numPoints, pol.nParams());
+
+    // The copies made by the first call must not be reused after the tie
+    pol.calNumericalDeriv(domain, parallelJacobian);
+    pol.addTies("A0=2*A1");
+    pol.calNumericalDeriv(domain, parallelJacobian);
+    pol.setParallel(true);
+    pol.calNumericalDeriv(domain, serialJacobian);
+
+    for (size_t i = 0; i < numPoints; ++i) {
+      for (size_t j = 1; j < pol.nParams(); ++j) {
+        TS_ASSERT_EQUALS(parallelJacobian.get(i, j), serialJacobian.get(i, j));
+      }
+    }
+  }
 };
 
 #endif /* MANTID_CURVEFITTING_POLYNOMIALTEST_H_ */
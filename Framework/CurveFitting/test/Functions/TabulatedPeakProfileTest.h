@@ -0,0 +1,111 @@
+#ifndef MANTID_CURVEFITTING_TABULATEDPEAKPROFILETEST_H_
+#define MANTID_CURVEFITTING_TABULATEDPEAKPROFILETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidCurveFitting/Functions/TabulatedPeakProfile.h"
+
+#include <algorithm>
+#include <cmath>
+
+using Mantid::CurveFitting::Functions::TabulatedPeakProfile;
+
+class TabulatedPeakProfileTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static TabulatedPeakProfileTest *createSuite() {
+    return new TabulatedPeakProfileTest();
+  }
+  static void destroySuite(TabulatedPeakProfileTest *suite) { delete suite; }
+
+  TabulatedPeakProfileTest() : m_x(2001), m_out(m_x.size()) {
+    for (size_t i = 0; i < m_x.size(); ++i) {
+      m_x[i] = -10.0 + 0.01 * static_cast<double>(i);
+    }
+  }
+
+  void test_table_is_built_on_first_request() {
+    TabulatedPeakProfile profile;
+    profile.setTolerance(1e-6);
+    auto shape = lorentzian(0.5);
+    TS_ASSERT(evaluate(profile, {0.5}, shape, 0.0, 1.0));
+    TS_ASSERT_LESS_THAN(0, profile.tableSize());
+  }
+
+  void test_tabulated_values_are_within_tolerance() {
+    const double tolerance = 1e-7;
+    TabulatedPeakProfile profile;
+    profile.setTolerance(tolerance);
+    auto shape = gaussian(0.3);
+    evaluate(profile, {0.3}, shape, 1.0, 2.0);
+    // Different centre and height reuse the table of the shape
+    TS_ASSERT(evaluate(profile, {0.3}, shape, -1.5, 3.0));
+    for (size_t i = 0; i < m_x.size(); ++i) {
+      const double offset = m_x[i] + 1.5;
+      const double expected = std::fabs(offset) < 8.0 ? 3.0 * shape(offset) : 0.0;
+      TS_ASSERT_DELTA(m_out[i], expected, 3.0 * tolerance);
+    }
+  }
+
+  void test_changing_the_shape_replaces_the_table() {
+    TabulatedPeakProfile profile;
+    profile.setTolerance(1e-6);
+    TS_ASSERT(evaluate(profile, {0.3}, gaussian(0.3), 0.0, 1.0));
+    const size_t narrowSize = profile.tableSize();
+    TS_ASSERT(evaluate(profile, {3.0}, gaussian(3.0), 0.0, 1.0));
+    TS_ASSERT_DIFFERS(profile.tableSize(), narrowSize);
+    auto shape = gaussian(3.0);
+    for (size_t i = 0; i < m_x.size(); ++i) {
+      const double expected = std::fabs(m_x[i]) < 8.0 ? shape(m_x[i]) : 0.0;
+      TS_ASSERT_DELTA(m_out[i], expected, 1e-6);
+    }
+  }
+
+  void test_tolerance_must_be_less_than_one() {
+    TabulatedPeakProfile profile;
+    TS_ASSERT_THROWS(profile.setTolerance(1.0), std::invalid_argument);
+    TS_ASSERT_THROWS(profile.setTolerance(5.0), std::invalid_argument);
+    TS_ASSERT_THROWS_NOTHING(profile.setTolerance(0.999));
+    // Almost everything is below the threshold but the table stays in range
+    TS_ASSERT_THROWS_NOTHING(
+        evaluate(profile, {0.3}, gaussian(0.3), 0.0, 1.0));
+  }
+
+  void test_zero_tolerance_disables_tables() {
+    TabulatedPeakProfile profile;
+    profile.setTolerance(0.0);
+    TS_ASSERT(!evaluate(profile, {0.3}, gaussian(0.3), 0.0, 1.0));
+    TS_ASSERT(!evaluate(profile, {0.3}, gaussian(0.3), 0.0, 1.0));
+  }
+
+  void test_shapes_that_are_not_finite_are_not_tabulated() {
+    TabulatedPeakProfile profile;
+    profile.setTolerance(1e-6);
+    auto shape = [](double x) { return 1.0 / x; };
+    TS_ASSERT(!evaluate(profile, {1.0}, shape, 0.0, 1.0));
+    TS_ASSERT(!evaluate(profile, {1.0}, shape, 0.0, 1.0));
+  }
+
+private:
+  bool evaluate(const TabulatedPeakProfile &profile,
+                const std::vector<double> &key,
+                const TabulatedPeakProfile::Shape &shape, double centre,
+                double height) {
+    return profile.evaluate(key, shape, 8.0, centre, height, m_x.data(),
+                            m_x.size(), m_out.data());
+  }
+
+  static TabulatedPeakProfile::Shape gaussian(double sigma) {
+    return [sigma](double x) { return exp(-0.5 * x * x / (sigma * sigma)); };
+  }
+
+  static TabulatedPeakProfile::Shape lorentzian(double gamma) {
+    return [gamma](double x) { return gamma * gamma / (x * x + gamma * gamma); };
+  }
+
+  std::vector<double> m_x;
+  std::vector<double> m_out;
+};
+
+#endif /* MANTID_CURVEFITTING_TABULATEDPEAKPROFILETEST_H_ */
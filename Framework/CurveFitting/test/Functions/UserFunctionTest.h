@@ -78,6 +78,54 @@ public:
     TS_ASSERT(categories.size() == 1);
     TS_ASSERT(categories[0] == "General");
   }
+
+  void test_derivatives_are_exact_for_compiled_formula() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute(
+                                    "h*exp(-((x-c)/s)^2/2)+b*log(1+x^2)"));
+    fun.setParameter("h", 1.5);
+    fun.setParameter("c", 0.3);
+    fun.setParameter("s", 0.7);
+    fun.setParameter("b", -0.4);
+
+    const size_t nData = 20;
+    std::vector<double> x(nData);
+    for (size_t i = 0; i < nData; i++) {
+      x[i] = -1.0 + 0.1 * static_cast<double>(i);
+    }
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(nData, 4);
+    fun.functionDeriv(domain, J);
+
+    for (size_t i = 0; i < nData; i++) {
+      const double t = (x[i] - 0.3) / 0.7;
+      const double g = exp(-t * t / 2);
+      TS_ASSERT_DELTA(J.get(i, 0), g, 1e-12);
+      TS_ASSERT_DELTA(J.get(i, 1), 1.5 * g * t / 0.7, 1e-12);
+      TS_ASSERT_DELTA(J.get(i, 2), 1.5 * g * t * t / 0.7, 1e-12);
+      TS_ASSERT_DELTA(J.get(i, 3), log(1 + x[i] * x[i]), 1e-12);
+    }
+  }
+
+  void test_formulas_the_compiler_does_not_support_use_muParser() {
+    // muParser gives the unary minus a lower precedence than ^
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute("-x^2+a"));
+    fun.setParameter("a", 1.0);
+    // min() is only known to muParser
+    UserFunction fun1;
+    fun1.setAttribute("Formula", UserFunction::Attribute("a*min(x,1)"));
+    fun1.setParameter("a", 2.0);
+
+    const size_t nData = 5;
+    std::vector<double> x{-2.0, -1.0, 0.5, 1.0, 3.0}, y(nData), y1(nData);
+    fun.function1D(y.data(), x.data(), nData);
+    fun1.function1D(y1.data(), x.data(), nData);
+    for (size_t i = 0; i < nData; i++) {
+      TS_ASSERT_DELTA(y[i], 1.0 - x[i] * x[i], 1e-15);
+      TS_ASSERT_DELTA(y1[i], 2.0 * std::min(x[i], 1.0), 1e-15);
+    }
+  }
 };
 
 #endif /*USERFUNCTIONTEST_H_*/
@@ -220,6 +220,8 @@ public:
 
   size_t getMemorySize() const override;
 
+  size_t contentHash() const override;
+
   virtual size_t histogram_size() const;
 
   void compressEvents(double tolerance, EventList *destination,
@@ -67,9 +67,15 @@ public:
   const MantidVec &dataE() const override { return m_histogram.dataE(); }
 
   /// Deprecated, use mutableY() instead. Returns the y data
-  MantidVec &dataY() override { return m_histogram.dataY(); }
+  MantidVec &dataY() override {
+    markModified();
+    return m_histogram.dataY();
+  }
   /// Deprecated, use mutableE() instead. Returns the error data
-  MantidVec &dataE() override { return m_histogram.dataE(); }
+  MantidVec &dataE() override {
+    markModified();
+    return m_histogram.dataE();
+  }
 
   virtual std::size_t size() const {
     return m_histogram.readY().size();
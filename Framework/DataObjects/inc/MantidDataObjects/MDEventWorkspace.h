@@ -166,8 +166,12 @@ public:
     return dynamic_cast<MDGridBox<MDE, nd> *>(data) != nullptr;
   }
 
-  /** @returns a pointer to the box (MDBox or MDGridBox) contained within, */
-  MDBoxBase<MDE, nd> *getBox() { return data; }
+  /** @returns a pointer to the box (MDBox or MDGridBox) contained within. The
+   * box may be modified through it, so the workspace is marked as modified. */
+  MDBoxBase<MDE, nd> *getBox() {
+    this->markModified();
+    return data;
+  }
 
   /** @returns a pointer to the box (MDBox or MDGridBox) contained within, const
    * version.  */
@@ -177,6 +181,7 @@ public:
    * Used in file loading */
   void setBox(API::IMDNode *box) {
     data = dynamic_cast<MDBoxBase<MDE, nd> *>(box);
+    this->markModified();
   }
 
   /// Apply masking
@@ -575,6 +575,9 @@ TMDE(size_t MDEventWorkspace)::getMemorySize() const {
  *after adding
  * (call splitAllIfNeeded).
  *
+ * The workspace is not marked as modified for every event, which would be
+ * costly; splitAllIfNeeded() and refreshCache(), which must follow, mark it.
+ *
  * @param event :: event to add.
  */
 TMDE(size_t MDEventWorkspace)::addEvent(const MDE &event) {
@@ -589,6 +592,7 @@ TMDE(size_t MDEventWorkspace)::addEvent(const MDE &event) {
  *        MDBox'es contained within.
  */
 TMDE(size_t MDEventWorkspace)::addEvents(const std::vector<MDE> &events) {
+  this->markModified();
   return data->addEvents(events);
 }
 
@@ -610,6 +614,7 @@ TMDE(void MDEventWorkspace)::splitBox() {
     delete data;
     data = gridBox;
   }
+  this->markModified();
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -621,6 +626,7 @@ TMDE(void MDEventWorkspace)::splitBox() {
  */
 TMDE(void MDEventWorkspace)::splitAllIfNeeded(Kernel::ThreadScheduler *ts) {
   data->splitAllIfNeeded(ts);
+  this->markModified();
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -658,6 +664,7 @@ TMDE(void MDEventWorkspace)::splitTrackedBoxes(Kernel::ThreadScheduler *ts) {
 TMDE(void MDEventWorkspace)::refreshCache() {
   // Function is overloaded and recursive; will check all sub-boxes
   data->refreshCache();
+  this->markModified();
   // TODO ThreadPool
 }
 
@@ -945,6 +952,7 @@ TMDE(void MDEventWorkspace)::setMDMasking(
     }
 
     delete maskingRegion;
+    this->markModified();
   }
 }
 
@@ -958,6 +966,7 @@ TMDE(void MDEventWorkspace)::clearMDMasking() {
   for (const auto box : allBoxes) {
     box->unmask();
   }
+  this->markModified();
 }
 
 /**
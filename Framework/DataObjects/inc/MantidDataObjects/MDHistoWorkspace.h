@@ -29,6 +29,12 @@ namespace DataObjects {
 *
 * This will be used by ParaView e.g. for visualization.
 *
+* The linear arrays are allocated as zero-filled memory, which the operating
+* system only commits once a page is written to. A workspace constructed with
+* sparse storage starts with all values at zero (rather than NaN) and the bulk
+* operations avoid writing to pages that hold nothing but zeros, so that
+* mostly-empty grids only use physical memory for their populated regions.
+*
 * @author Janik Zikovsky
 * @date 2011-03-24 11:21:06.280523
 */
@@ -47,10 +53,12 @@ public:
   MDHistoWorkspace(
       std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions,
       Mantid::API::MDNormalization displayNormalization =
-          Mantid::API::NoNormalization);
+          Mantid::API::NoNormalization,
+      bool sparse = false);
   MDHistoWorkspace(std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions,
                    Mantid::API::MDNormalization displayNormalization =
-                       Mantid::API::NoNormalization);
+                       Mantid::API::NoNormalization,
+                   bool sparse = false);
   MDHistoWorkspace &operator=(const MDHistoWorkspace &other) = delete;
   ~MDHistoWorkspace() override;
 
@@ -59,8 +67,13 @@ public:
     return std::unique_ptr<MDHistoWorkspace>(doClone());
   }
 
-  void init(std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions);
-  void init(std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions);
+  void init(std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions,
+            bool sparse = false);
+  void init(std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions,
+            bool sparse = false);
+
+  /// @return true if the workspace was created with sparse storage
+  bool isSparse() const { return m_sparse; }
 
   void cacheValues();
 
@@ -467,6 +480,9 @@ private:
   /// Display normalization to use
   Mantid::API::MDNormalization m_displayNormalization;
 
+  /// True if the arrays started out zero-filled and should be kept sparse
+  bool m_sparse;
+
   // Get ordered list of boundaries in position-along-the-line coordinates
   std::set<coord_t> getBinBoundariesOnLine(const Kernel::VMD &start,
                                            const Kernel::VMD &end, size_t nd,
@@ -476,6 +492,8 @@ private:
   signal_t getNormalizationFactor(const API::MDNormalization &normalize,
                                   size_t linearIndex) const;
 
+  bool isEmptyBlock(size_t start, size_t end) const;
+
 protected:
   LinePlot getLinePoints(const Mantid::Kernel::VMD &start,
                          const Mantid::Kernel::VMD &end,
@@ -5,6 +5,7 @@
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/Unit.h"
+#include <boost/functional/hash.hpp>
 #include <cfloat>
 
 #include <cmath>
@@ -27,6 +28,25 @@ namespace {
 /// The number of events to split for parallel sorting.
 const size_t NUM_EVENTS_PARALLEL_THRESHOLD = 500000;
 
+/**
+ * Hash a list of events independently of their order, so that sorting the
+ * list does not change the hash.
+ * @param events :: The events
+ * @return The sum of the hashes of the events
+ */
+template <class T> size_t hashEvents(const std::vector<T> &events) {
+  size_t sum = 0;
+  for (const auto &event : events) {
+    size_t seed = 0;
+    boost::hash_combine(seed, event.tof());
+    boost::hash_combine(seed, event.pulseTime().totalNanoseconds());
+    boost::hash_combine(seed, event.weight());
+    boost::hash_combine(seed, event.errorSquared());
+    sum += seed;
+  }
+  return sum;
+}
+
 /**
  * Calculate the corrected full time in nanoseconds
  * @param totalNanoseconds : Time in nanoseconds
@@ -293,7 +313,7 @@ EventList &EventList::operator=(const EventList &rhs) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const TofEvent &event) {
-
+  markModified();
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -321,6 +341,7 @@ EventList &EventList::operator+=(const TofEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
+  markModified();
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -361,6 +382,7 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const WeightedEvent &event) {
+  markModified();
   this->switchTo(WEIGHTED);
   this->weightedEvents.push_back(event);
   this->order = UNSORTED;
@@ -442,6 +464,7 @@ operator+=(const std::vector<WeightedEventNoTime> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const EventList &more_events) {
+  markModified();
   // We'll let the += operator for the given vector of event lists handle it
   switch (more_events.getEventType()) {
   case TOF:
@@ -507,6 +530,7 @@ void EventList::minusHelper(std::vector<T1> &events,
  * @return reference to this
  * */
 EventList &EventList::operator-=(const EventList &more_events) {
+  markModified();
   if (this == &more_events) {
     // Special case, ticket #3844 part 2.
     // When doing this = this - this,
@@ -636,6 +660,7 @@ EventType EventList::getEventType() const { return eventType; }
  * WEIGHTED_NOTIME)
  */
 void EventList::switchTo(EventType newType) {
+  markModified();
   switch (newType) {
   case TOF:
     if (eventType != TOF)
@@ -769,6 +794,7 @@ const std::vector<TofEvent> &EventList::getEvents() const {
  * @return a reference to the list of non-weighted events
  * */
 std::vector<TofEvent> &EventList::getEvents() {
+  markModified();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -784,6 +810,7 @@ std::vector<TofEvent> &EventList::getEvents() {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEvent> &EventList::getWeightedEvents() {
+  markModified();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -812,6 +839,7 @@ const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
+  markModified();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEventNoTime. Use "
@@ -837,6 +865,7 @@ EventList::getWeightedEventsNoTime() const {
  * associated detector ID's.
  * */
 void EventList::clear(const bool removeDetIDs) {
+  markModified();
   if (mru)
     mru->deleteIndex(this);
   this->events.clear();
@@ -1390,6 +1419,40 @@ size_t EventList::getMemorySize() const {
   throw std::runtime_error("EventList: invalid event type value was found.");
 }
 
+// --------------------------------------------------------------------------
+/** Returns a hash of the content of the list: the spectrum number, the
+ * detector IDs, the X and Dx values and the events. The Y and E values are
+ * not hashed since they are calculated from the events. The hash does not
+ * depend on the order of the events.
+ * @return The hash */
+size_t EventList::contentHash() const {
+  size_t seed = 0;
+  boost::hash_combine(seed, getSpectrumNo());
+  const auto &detectorIDs = getDetectorIDs();
+  boost::hash_range(seed, detectorIDs.begin(), detectorIDs.end());
+  const auto &x = m_histogram.x().rawData();
+  boost::hash_combine(seed, x.size());
+  boost::hash_range(seed, x.begin(), x.end());
+  if (hasDx()) {
+    const auto &dx = m_histogram.dx().rawData();
+    boost::hash_combine(seed, dx.size());
+    boost::hash_range(seed, dx.begin(), dx.end());
+  }
+  boost::hash_combine(seed, static_cast<int>(eventType));
+  switch (eventType) {
+  case TOF:
+    boost::hash_combine(seed, hashEvents(events));
+    break;
+  case WEIGHTED:
+    boost::hash_combine(seed, hashEvents(weightedEvents));
+    break;
+  case WEIGHTED_NOTIME:
+    boost::hash_combine(seed, hashEvents(weightedEventsNoTime));
+    break;
+  }
+  return seed;
+}
+
 // --------------------------------------------------------------------------
 /** Return the size of the histogram data.
  * @return the size of the histogram representation of the data (size of Y) **/
@@ -1411,6 +1474,7 @@ size_t EventList::histogram_size() const {
  * @param X :: The vector of doubles to set as the histogram limits.
  */
 void EventList::setX(const Kernel::cow_ptr<HistogramData::HistogramX> &X) {
+  markModified();
   m_histogram.setX(X);
   if (mru)
     mru->deleteIndex(this);
@@ -1420,6 +1484,7 @@ void EventList::setX(const Kernel::cow_ptr<HistogramData::HistogramX> &X) {
  *  @return a reference to the X (bin) vector.
  */
 MantidVec &EventList::dataX() {
+  markModified();
   if (mru)
     mru->deleteIndex(this);
   return m_histogram.dataX();
@@ -1438,7 +1503,10 @@ Kernel::cow_ptr<HistogramData::HistogramX> EventList::ptrX() const {
 }
 
 /// Deprecated, use mutableDx() instead.
-MantidVec &EventList::dataDx() { return m_histogram.dataDx(); }
+MantidVec &EventList::dataDx() {
+  markModified();
+  return m_histogram.dataDx();
+}
 /// Deprecated, use dx() instead.
 const MantidVec &EventList::dataDx() const { return m_histogram.dataDx(); }
 /// Deprecated, use dx() instead.
@@ -1778,6 +1846,7 @@ void EventList::compressEventsParallelHelper(
  */
 void EventList::compressEvents(double tolerance, EventList *destination,
                                bool parallel) {
+  destination->markModified();
   // Must have a sorted list
   if (parallel)
     this->sortTof4();
@@ -2683,6 +2752,7 @@ void EventList::addPulsetimeHelper(std::vector<T> &events,
  * @param seconds :: The value to shift the pulsetime by, in seconds
  */
 void EventList::addPulsetime(const double seconds) {
+  markModified();
   if (this->getNumberEvents() <= 0)
     return;
 
@@ -2752,6 +2822,7 @@ std::size_t EventList::maskTofHelper(std::vector<T> &events,
  * @param tofMax :: upper bound of TOF to filter out
  */
 void EventList::maskTof(const double tofMin, const double tofMax) {
+  markModified();
   if (tofMax <= tofMin)
     throw std::runtime_error("EventList::maskTof: tofMax must be > tofMin");
 
@@ -3328,6 +3399,7 @@ void EventList::setTofsHelper(std::vector<T> &events,
  * @param tofs :: The vector of doubles to set the tofs to.
  */
 void EventList::setTofs(const MantidVec &tofs) {
+  markModified();
   this->order = UNSORTED;
 
   // Convert the list
@@ -3430,6 +3502,7 @@ EventList &EventList::operator*=(const double value) {
  * @param error: error on 'value'. Can be 0.
  */
 void EventList::multiply(const double value, const double error) {
+  markModified();
   // Do nothing if multiplying by exactly one and there is no error
   if ((value == 1.0) && (error == 0.0))
     return;
@@ -3553,6 +3626,7 @@ void EventList::multiplyHistogramHelper(std::vector<T> &events,
  */
 void EventList::multiply(const MantidVec &X, const MantidVec &Y,
                          const MantidVec &E) {
+  markModified();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3690,6 +3764,7 @@ void EventList::divideHistogramHelper(std::vector<T> &events,
  */
 void EventList::divide(const MantidVec &X, const MantidVec &Y,
                        const MantidVec &E) {
+  markModified();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3738,6 +3813,7 @@ EventList &EventList::operator/=(const double value) {
  * @throw std::invalid_argument if value == 0; cannot divide by zero.
  */
 void EventList::divide(const double value, const double error) {
+  markModified();
   if (value == 0.0)
     throw std::invalid_argument(
         "EventList::divide() called with value of 0.0. Cannot divide by zero.");
@@ -3974,6 +4050,7 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter,
  *     that will be kept. Any other events will be deleted.
  */
 void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
+  markModified();
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
 
@@ -4577,6 +4654,7 @@ void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events,
  */
 void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit,
                                    Mantid::Kernel::Unit *toUnit) {
+  markModified();
   // Check for initialized
   if (!fromUnit || !toUnit)
     throw std::runtime_error(
@@ -4625,6 +4703,7 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events,
  *  @param power :: the Power b to apply to the conversion
  */
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+  markModified();
   switch (eventType) {
   case TOF:
     convertUnitsQuicklyHelper(this->events, factor, power);
@@ -405,6 +405,7 @@ Mantid::API::EventType EventWorkspace::getEventType() const {
 void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
   for (auto &eventList : this->data)
     eventList->switchTo(type);
+  markSpectrumModified();
 }
 
 /// Returns true always - an EventWorkspace always represents histogramm-able
@@ -557,6 +558,7 @@ void EventWorkspace::setAllX(const HistogramData::BinEdges &x) {
   // just reset the whole Histogram.
   for (auto &eventList : this->data)
     eventList->setHistogram(x);
+  markSpectrumModified();
 
   // Clear MRU lists now, free up memory
   this->clearMRU();
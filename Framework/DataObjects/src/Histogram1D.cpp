@@ -41,11 +41,15 @@ void Histogram1D::clearData() {
 /// Deprecated, use setSharedX() instead. Sets the x data.
 /// @param X :: vector of X data
 void Histogram1D::setX(const Kernel::cow_ptr<HistogramData::HistogramX> &X) {
+  markModified();
   m_histogram.setX(X);
 }
 
 /// Deprecated, use mutableX() instead. Returns the x data
-MantidVec &Histogram1D::dataX() { return m_histogram.dataX(); }
+MantidVec &Histogram1D::dataX() {
+  markModified();
+  return m_histogram.dataX();
+}
 
 /// Deprecated, use x() instead. Returns the x data const
 const MantidVec &Histogram1D::dataX() const { return m_histogram.dataX(); }
@@ -59,7 +63,10 @@ Kernel::cow_ptr<HistogramData::HistogramX> Histogram1D::ptrX() const {
 }
 
 /// Deprecated, use mutableDx() instead.
-MantidVec &Histogram1D::dataDx() { return m_histogram.dataDx(); }
+MantidVec &Histogram1D::dataDx() {
+  markModified();
+  return m_histogram.dataDx();
+}
 /// Deprecated, use dx() instead.
 const MantidVec &Histogram1D::dataDx() const { return m_histogram.dataDx(); }
 /// Deprecated, use dx() instead.
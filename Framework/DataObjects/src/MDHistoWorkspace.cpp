@@ -15,12 +15,74 @@
 #include <boost/scoped_array.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/optional.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <new>
 
 using namespace Mantid::Kernel;
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
 
+namespace {
+/// Size of the blocks, in bytes, used to skip over all-zero regions. This
+/// matches the usual size of a memory page.
+constexpr size_t ZERO_BLOCK_BYTES = 4096;
+
+/** Allocate a zero-filled array. Large allocations are served by fresh
+ * anonymous mappings so the pages are only committed when first written.
+ * @param length :: number of elements
+ * @return pointer to the array; release with free()
+ */
+template <typename T> T *allocateZeroed(size_t length) {
+  void *data = std::calloc(std::max(length, size_t{1}), sizeof(T));
+  if (!data)
+    throw std::bad_alloc();
+  return static_cast<T *>(data);
+}
+
+/// @return true if every element in the range compares equal to zero
+template <typename T> bool isZeroBlock(const T *data, size_t length) {
+  return std::all_of(data, data + length,
+                     [](const T value) { return value == T(0); });
+}
+
+/** Fill an array with a value. When the value is zero, blocks that are already
+ * zero are only read, which keeps their pages uncommitted.
+ * @param data :: array to fill
+ * @param length :: number of elements
+ * @param value :: the value to set
+ */
+template <typename T> void fillArray(T *data, size_t length, const T value) {
+  if (value != T(0)) {
+    std::fill_n(data, length, value);
+    return;
+  }
+  const size_t blockLength = ZERO_BLOCK_BYTES / sizeof(T);
+  for (size_t i = 0; i < length; i += blockLength) {
+    const size_t n = std::min(blockLength, length - i);
+    if (!isZeroBlock(data + i, n))
+      std::fill_n(data + i, n, value);
+  }
+}
+
+/** Copy an array into a freshly zero-filled destination, skipping the blocks
+ * of the source that contain nothing but zeros.
+ * @param source :: array to copy from
+ * @param length :: number of elements
+ * @param dest :: zero-filled array to copy into
+ */
+template <typename T>
+void copyIntoZeroed(const T *source, size_t length, T *dest) {
+  const size_t blockLength = ZERO_BLOCK_BYTES / sizeof(T);
+  for (size_t i = 0; i < length; i += blockLength) {
+    const size_t n = std::min(blockLength, length - i);
+    if (!isZeroBlock(source + i, n))
+      std::copy_n(source + i, n, dest + i);
+  }
+}
+} // namespace
+
 namespace Mantid {
 namespace DataObjects {
 //----------------------------------------------------------------------------------------------
@@ -40,7 +102,8 @@ MDHistoWorkspace::MDHistoWorkspace(
     Mantid::API::MDNormalization displayNormalization)
     : IMDHistoWorkspace(), numDimensions(0),
       m_nEventsContributed(std::numeric_limits<uint64_t>::quiet_NaN()),
-      m_coordSystem(None), m_displayNormalization(displayNormalization) {
+      m_coordSystem(None), m_displayNormalization(displayNormalization),
+      m_sparse(false) {
   std::vector<Mantid::Geometry::MDHistoDimension_sptr> dimensions;
   if (dimX)
     dimensions.push_back(std::move(dimX));
@@ -58,29 +121,35 @@ MDHistoWorkspace::MDHistoWorkspace(
  * @param dimensions :: vector of MDHistoDimension; no limit to how many.
  * @param displayNormalization :: optional display normalization to use as the
  * default.
+ * @param sparse :: if true, start from zero-filled, lazily committed storage
+ * instead of NaN.
  */
 MDHistoWorkspace::MDHistoWorkspace(
     std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions,
-    Mantid::API::MDNormalization displayNormalization)
+    Mantid::API::MDNormalization displayNormalization, bool sparse)
     : IMDHistoWorkspace(), numDimensions(0), m_numEvents(nullptr),
       m_nEventsContributed(std::numeric_limits<uint64_t>::quiet_NaN()),
-      m_coordSystem(None), m_displayNormalization(displayNormalization) {
-  this->init(dimensions);
+      m_coordSystem(None), m_displayNormalization(displayNormalization),
+      m_sparse(sparse) {
+  this->init(dimensions, sparse);
 }
 
 //----------------------------------------------------------------------------------------------
 /** Constructor given a vector of dimensions
- * @param dimensions :: vector of MDHistoDimension; no limit to how many.
+ * @param dimensions :: vector of IMDDimension; no limit to how many.
  * @param displayNormalization :: optional display normalization to use as the
  * default.
+ * @param sparse :: if true, start from zero-filled, lazily committed storage
+ * instead of NaN.
  */
 MDHistoWorkspace::MDHistoWorkspace(
     std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions,
-    Mantid::API::MDNormalization displayNormalization)
+    Mantid::API::MDNormalization displayNormalization, bool sparse)
     : IMDHistoWorkspace(), numDimensions(0), m_numEvents(nullptr),
       m_nEventsContributed(std::numeric_limits<uint64_t>::quiet_NaN()),
-      m_coordSystem(None), m_displayNormalization(displayNormalization) {
-  this->init(dimensions);
+      m_coordSystem(None), m_displayNormalization(displayNormalization),
+      m_sparse(sparse) {
+  this->init(dimensions, sparse);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -92,67 +161,75 @@ MDHistoWorkspace::MDHistoWorkspace(const MDHistoWorkspace &other)
     : IMDHistoWorkspace(other),
       m_nEventsContributed(other.m_nEventsContributed),
       m_coordSystem(other.m_coordSystem),
-      m_displayNormalization(other.m_displayNormalization) {
+      m_displayNormalization(other.m_displayNormalization),
+      m_sparse(other.m_sparse) {
   // Dimensions are copied by the copy constructor of MDGeometry
   this->cacheValues();
   // Allocate the linear arrays
-  m_signals = new signal_t[m_length];
-  m_errorsSquared = new signal_t[m_length];
-  m_numEvents = new signal_t[m_length];
-  m_masks = new bool[m_length];
-  // Now copy all the data
-  std::copy_n(other.m_signals, m_length, m_signals);
-  std::copy_n(other.m_errorsSquared, m_length, m_errorsSquared);
-  std::copy_n(other.m_numEvents, m_length, m_numEvents);
-  std::copy_n(other.m_masks, m_length, m_masks);
+  m_signals = allocateZeroed<signal_t>(m_length);
+  m_errorsSquared = allocateZeroed<signal_t>(m_length);
+  m_numEvents = allocateZeroed<signal_t>(m_length);
+  m_masks = allocateZeroed<bool>(m_length);
+  // Now copy all the data, leaving the empty regions untouched
+  copyIntoZeroed(other.m_signals, m_length, m_signals);
+  copyIntoZeroed(other.m_errorsSquared, m_length, m_errorsSquared);
+  copyIntoZeroed(other.m_numEvents, m_length, m_numEvents);
+  copyIntoZeroed(other.m_masks, m_length, m_masks);
 }
 
 //----------------------------------------------------------------------------------------------
 /** Destructor
  */
 MDHistoWorkspace::~MDHistoWorkspace() {
-  delete[] m_signals;
-  delete[] m_errorsSquared;
-  delete[] m_numEvents;
+  std::free(m_signals);
+  std::free(m_errorsSquared);
+  std::free(m_numEvents);
   delete[] indexMultiplier;
   delete[] m_vertexesArray;
   delete[] m_boxLength;
   delete[] m_indexMaker;
   delete[] m_indexMax;
   delete[] m_origin;
-  delete[] m_masks;
+  std::free(m_masks);
 }
 
 //----------------------------------------------------------------------------------------------
 /** Constructor helper method
  * @param dimensions :: vector of MDHistoDimension; no limit to how many.
+ * @param sparse :: if true, leave the arrays zero-filled instead of NaN.
  */
 void MDHistoWorkspace::init(
-    std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions) {
+    std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions,
+    bool sparse) {
   std::vector<IMDDimension_sptr> dim2;
   for (auto &dimension : dimensions)
     dim2.push_back(boost::dynamic_pointer_cast<IMDDimension>(dimension));
-  this->init(dim2);
+  this->init(dim2, sparse);
   m_nEventsContributed = 0;
 }
 
 //----------------------------------------------------------------------------------------------
 /** Constructor helper method
  * @param dimensions :: vector of IMDDimension; no limit to how many.
+ * @param sparse :: if true, leave the arrays zero-filled instead of NaN.
  */
 void MDHistoWorkspace::init(
-    std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions) {
+    std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions,
+    bool sparse) {
   MDGeometry::initGeometry(dimensions);
   this->cacheValues();
-
-  // Allocate the linear arrays
-  m_signals = new signal_t[m_length];
-  m_errorsSquared = new signal_t[m_length];
-  m_numEvents = new signal_t[m_length];
-  m_masks = new bool[m_length];
-  // Initialize them to NAN (quickly)
-  signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
-  this->setTo(nan, nan, nan);
+  m_sparse = sparse;
+
+  // Allocate the linear arrays. They start out zero-filled.
+  m_signals = allocateZeroed<signal_t>(m_length);
+  m_errorsSquared = allocateZeroed<signal_t>(m_length);
+  m_numEvents = allocateZeroed<signal_t>(m_length);
+  m_masks = allocateZeroed<bool>(m_length);
+  // Initialize them to NAN (quickly) unless the storage is to stay sparse
+  if (!m_sparse) {
+    signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
+    this->setTo(nan, nan, nan);
+  }
   m_nEventsContributed = 0;
 }
 
@@ -254,10 +331,10 @@ void MDHistoWorkspace::initVertexesArray() {
  */
 void MDHistoWorkspace::setTo(signal_t signal, signal_t errorSquared,
                              signal_t numEvents) {
-  std::fill_n(m_signals, m_length, signal);
-  std::fill_n(m_errorsSquared, m_length, errorSquared);
-  std::fill_n(m_numEvents, m_length, numEvents);
-  std::fill_n(m_masks, m_length, false);
+  fillArray(m_signals, m_length, signal);
+  fillArray(m_errorsSquared, m_length, errorSquared);
+  fillArray(m_numEvents, m_length, numEvents);
+  fillArray(m_masks, m_length, false);
   m_nEventsContributed = static_cast<uint64_t>(numEvents) * m_length;
 }
 
@@ -769,10 +846,17 @@ MDHistoWorkspace &MDHistoWorkspace::operator+=(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "add");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] += b.m_signals[i];
-    m_errorsSquared[i] += b.m_errorsSquared[i];
-    m_numEvents[i] += b.m_numEvents[i];
+  const size_t blockLength = ZERO_BLOCK_BYTES / sizeof(signal_t);
+  for (size_t start = 0; start < m_length; start += blockLength) {
+    const size_t end = std::min(start + blockLength, m_length);
+    // Adding an empty block changes nothing: skip it without writing
+    if (b.isEmptyBlock(start, end))
+      continue;
+    for (size_t i = start; i < end; ++i) {
+      m_signals[i] += b.m_signals[i];
+      m_errorsSquared[i] += b.m_errorsSquared[i];
+      m_numEvents[i] += b.m_numEvents[i];
+    }
   }
   m_nEventsContributed += b.m_nEventsContributed;
 }
@@ -808,10 +892,17 @@ MDHistoWorkspace &MDHistoWorkspace::operator-=(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "subtract");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] -= b.m_signals[i];
-    m_errorsSquared[i] += b.m_errorsSquared[i];
-    m_numEvents[i] += b.m_numEvents[i];
+  const size_t blockLength = ZERO_BLOCK_BYTES / sizeof(signal_t);
+  for (size_t start = 0; start < m_length; start += blockLength) {
+    const size_t end = std::min(start + blockLength, m_length);
+    // Subtracting an empty block changes nothing: skip it without writing
+    if (b.isEmptyBlock(start, end))
+      continue;
+    for (size_t i = start; i < end; ++i) {
+      m_signals[i] -= b.m_signals[i];
+      m_errorsSquared[i] += b.m_errorsSquared[i];
+      m_numEvents[i] += b.m_numEvents[i];
+    }
   }
   m_nEventsContributed += b.m_nEventsContributed;
 }
@@ -1314,9 +1405,20 @@ void MDHistoWorkspace::setMDMaskAt(const size_t &index, bool mask) {
  * which was set to NaN when it was masked.
  */
 void MDHistoWorkspace::clearMDMasking() {
-  for (size_t i = 0; i < this->getNPoints(); ++i) {
-    m_masks[i] = false;
-  }
+  fillArray(m_masks, m_length, false);
+}
+
+/**
+ * Check whether a range of bins holds no signal, error or events.
+ * @param start : first linear index of the range
+ * @param end : one past the last linear index of the range
+ * @return true if all the signals, errors and event counts are zero
+ */
+bool MDHistoWorkspace::isEmptyBlock(size_t start, size_t end) const {
+  const size_t n = end - start;
+  return isZeroBlock(m_signals + start, n) &&
+         isZeroBlock(m_errorsSquared + start, n) &&
+         isZeroBlock(m_numEvents + start, n);
 }
 
 uint64_t MDHistoWorkspace::getNEvents() const {
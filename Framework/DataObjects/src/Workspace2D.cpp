@@ -264,15 +264,18 @@ void Workspace2D::setImageYAndE(const API::MantidImage &imageY,
     }
     // X values. Set first spectrum and copy/propagate that one to all the other
     // spectra
+    auto &x = data[0]->dataX();
     PARALLEL_FOR_IF(parallelExecution)
     for (int i = 0; i < static_cast<int>(width) + 1; ++i) {
-      data[0]->dataX()[i] = i * scale_1;
+      x[i] = i * scale_1;
     }
     PARALLEL_FOR_IF(parallelExecution)
     for (int i = 1; i < static_cast<int>(height); ++i) {
       data[i]->setX(data[0]->ptrX());
     }
   }
+  // The spectra were modified directly rather than through getSpectrum()
+  markSpectrumModified();
 }
 
 /// Return reference to Histogram1D at the given workspace index.
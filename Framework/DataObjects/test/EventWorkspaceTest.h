@@ -549,6 +549,31 @@ public:
     }
   }
 
+  void test_contentHash_does_not_depend_on_the_order_of_events() {
+    EventWorkspace_sptr ws =
+        WorkspaceCreationHelper::createRandomEventWorkspace(NUMBINS, 10);
+    EventWorkspace_sptr copy = ws->clone();
+    TS_ASSERT_EQUALS(ws->contentHash(), copy->contentHash());
+    copy->sortAll(TOF_SORT, nullptr);
+    TS_ASSERT_EQUALS(ws->contentHash(), copy->contentHash());
+  }
+
+  void test_contentHash_changes_when_events_are_added() {
+    const size_t hash = ew->contentHash();
+    const uint64_t stamp = ew->modificationStamp();
+    const uint64_t spectrumStamp = ew->getSpectrum(3).modificationStamp();
+    TS_ASSERT_EQUALS(ew->contentHash(), hash);
+    TS_ASSERT_LESS_THAN(stamp, ew->modificationStamp());
+
+    ew->getSpectrum(3) += TofEvent(1.5, 2);
+    TS_ASSERT_LESS_THAN(spectrumStamp,
+                        ew->getSpectrum(3).modificationStamp());
+    TS_ASSERT_DIFFERS(ew->contentHash(), hash);
+    // Equal to the hash of the whole workspace calculated from scratch
+    EventWorkspace_sptr copy = ew->clone();
+    TS_ASSERT_EQUALS(copy->contentHash(), ew->contentHash());
+  }
+
   /** Test sortAll() when there are more cores available than pixels.
    * This test will only work on machines with 2 cores at least.
    */
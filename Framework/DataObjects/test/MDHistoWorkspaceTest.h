@@ -238,6 +238,72 @@ public:
     TS_ASSERT_DELTA(data[5], 2.3456, 1e-5);
   }
 
+  //---------------------------------------------------------------------------------------------------
+  /** Sparse storage starts out at zero rather than NaN */
+  void test_constructor_sparse() {
+    std::vector<MDHistoDimension_sptr> dimensions;
+    Mantid::Geometry::GeneralFrame frame("m", "m");
+    for (size_t i = 0; i < 3; i++) {
+      dimensions.push_back(MDHistoDimension_sptr(
+          new MDHistoDimension("Dim", "Dim", frame, -10, 10, 40)));
+    }
+
+    MDHistoWorkspace ws(dimensions, NoNormalization, true);
+
+    TS_ASSERT(ws.isSparse());
+    TS_ASSERT_EQUALS(ws.getNPoints(), 40 * 40 * 40);
+    TS_ASSERT_EQUALS(ws.getMemorySize(), ws.getNPoints() * sizeOfElement());
+    for (size_t i = 0; i < ws.getNPoints(); i++) {
+      TS_ASSERT_EQUALS(ws.getSignalAt(i), 0.0);
+      TS_ASSERT_EQUALS(ws.getErrorAt(i), 0.0);
+      TS_ASSERT_EQUALS(ws.getNumEventsAt(i), 0.0);
+      TS_ASSERT(!ws.getIsMaskedAt(i));
+    }
+    TS_ASSERT_EQUALS(ws.getNEvents(), 0);
+
+    ws.setSignalAt(12345, 2.5);
+    ws.setErrorSquaredAt(12345, 4.0);
+    ws.setNumEventsAt(12345, 3.0);
+
+    // Copies keep the storage type and the populated bins
+    MDHistoWorkspace_sptr copy(ws.clone());
+    TS_ASSERT(copy->isSparse());
+    TS_ASSERT_EQUALS(copy->getSignalAt(12345), 2.5);
+    TS_ASSERT_EQUALS(copy->getErrorAt(12345), 2.0);
+    TS_ASSERT_EQUALS(copy->getNumEventsAt(12345), 3.0);
+    TS_ASSERT_EQUALS(copy->getSignalAt(12344), 0.0);
+
+    // Adding and subtracting with mostly-empty operands
+    copy->add(ws);
+    TS_ASSERT_EQUALS(copy->getSignalAt(12345), 5.0);
+    TS_ASSERT_EQUALS(copy->getErrorAt(12345), std::sqrt(8.0));
+    TS_ASSERT_EQUALS(copy->getNumEventsAt(12345), 6.0);
+    TS_ASSERT_EQUALS(copy->getSignalAt(0), 0.0);
+    copy->subtract(ws);
+    TS_ASSERT_EQUALS(copy->getSignalAt(12345), 2.5);
+    TS_ASSERT_EQUALS(copy->getNumEventsAt(12345), 9.0);
+
+    // Resetting to zero clears the populated bins
+    copy->setTo(0.0, 0.0, 0.0);
+    TS_ASSERT_EQUALS(copy->getSignalAt(12345), 0.0);
+    TS_ASSERT_EQUALS(copy->getErrorAt(12345), 0.0);
+    TS_ASSERT_EQUALS(copy->getNumEventsAt(12345), 0.0);
+  }
+
+  /** Adding an empty workspace leaves NaN values alone */
+  void test_add_empty_workspace_to_dense() {
+    MDHistoWorkspace_sptr a =
+        MDEventsTestHelper::makeFakeMDHistoWorkspace(1.23, 2, 5, 10.0, 3.234);
+    MDHistoWorkspace_sptr empty =
+        MDEventsTestHelper::makeFakeMDHistoWorkspace(0.0, 2, 5, 10.0, 0.0);
+    empty->setTo(0.0, 0.0, 0.0);
+    a->setSignalAt(3, std::numeric_limits<signal_t>::quiet_NaN());
+    a->add(*empty);
+    TS_ASSERT(std::isnan(a->getSignalAt(3)));
+    TS_ASSERT_DELTA(a->getSignalAt(4), 1.23, 1e-5);
+    TS_ASSERT_DELTA(a->getErrorAt(4), std::sqrt(3.234), 1e-5);
+  }
+
   class TestableMDHistoWorkspace : public MDHistoWorkspace {
   public:
     TestableMDHistoWorkspace(const MDHistoWorkspace &other)
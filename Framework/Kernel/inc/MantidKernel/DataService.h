@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------
 #ifndef Q_MOC_RUN
 #include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/algorithm/string.hpp>
 #endif
 #include <Poco/NotificationCenter.h>
@@ -14,7 +15,15 @@
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/ConfigService.h"
 
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
 #include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #ifdef _WIN32
 #define strcasecmp _stricmp
@@ -50,6 +59,9 @@ struct CaseInsensitiveCmp {
     This is the primary data service that  the users will interact with either
    through writing scripts or directly
     through the API. It is implemented as a singleton class.
+    The objects are spread over shards by the hash of their lower case names.
+    Lookups read a shard without waiting for writers, which replace the map of
+    the shard with an updated copy.
 
     Copyright &copy; 2008-2013 ISIS Rutherford Appleton Laboratory, NScD Oak
    Ridge National Laboratory & European Spallation Source
@@ -73,15 +85,6 @@ struct CaseInsensitiveCmp {
     Code Documentation is available at: <http://doxygen.mantidproject.org>
 */
 template <typename T> class DLLExport DataService {
-private:
-  /// Typedef for the map holding the names of and pointers to the data objects
-  typedef std::map<std::string, boost::shared_ptr<T>, CaseInsensitiveCmp>
-      svcmap;
-  /// Iterator for the data store map
-  typedef typename svcmap::iterator svc_it;
-  /// Const iterator for the data store map
-  typedef typename svcmap::const_iterator svc_constit;
-
 public:
   /// Class for named object notifications
   class NamedObjectNotification : public Poco::Notification {
@@ -206,6 +209,25 @@ public:
   private:
     std::string m_newName; ///< New object name
   };
+  /** Queues the notifications the service sends on the calling thread while
+   * it is alive and sends them in order when the outermost batch on the
+   * thread ends. Observers then see a group of changes after all of them have
+   * been made.
+   */
+  class NotificationBatch {
+  public:
+    /// Start queueing the notifications of the service on this thread
+    explicit NotificationBatch(DataService &service) : m_service(service) {
+      m_service.beginBatch();
+    }
+    /// Send the queued notifications if this is the outermost batch
+    ~NotificationBatch() { m_service.endBatch(); }
+    NotificationBatch(const NotificationBatch &) = delete;
+    NotificationBatch &operator=(const NotificationBatch &) = delete;
+
+  private:
+    DataService &m_service;
+  };
 
   //--------------------------------------------------------------------------
   /** Add an object to the service
@@ -220,15 +242,21 @@ public:
     checkForEmptyName(name);
     checkForNullPointer(Tobject);
 
+    const std::string key = toKey(name);
     bool success = false;
     {
-      // Make DataService access thread-safe
-      std::lock_guard<std::recursive_mutex> lock(m_mutex);
+      Shard &shard = m_shards[shardIndex(key)];
+      std::lock_guard<std::mutex> lock(shard.mutex);
       // At the moment, you can't overwrite an object (i.e. pass in a name
       // that's already in the map with a pointer to a different object).
       // Also, there's nothing to stop the same object from being added
       // more than once with different names.
-      success = datamap.insert(std::make_pair(name, Tobject)).second;
+      if (shard.entries->count(key) == 0) {
+        auto entries = boost::make_shared<ShardMap>(*shard.entries);
+        entries->emplace(key, Entry{name, Tobject});
+        publish(shard, entries);
+        success = true;
+      }
     }
     if (!success) {
       std::string error =
@@ -237,7 +265,58 @@ public:
       throw std::runtime_error(error);
     } else {
       g_log.debug() << "Add Data Object " << name << " successful\n";
-      notificationCenter.postNotification(new AddNotification(name, Tobject));
+      postNotification(new AddNotification(name, Tobject));
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  /** Add several objects to the service. Either all of them are added or,
+   * if one cannot be, none are. The AddNotifications are sent once all the
+   * objects are in the service.
+   * @param objects :: pairs of names and shared pointers to the objects
+   * @throw std::runtime_error if a name is empty or used more than once
+   * @throw std::runtime_error if a name exists in the map
+   * @throw std::runtime_error if a null pointer is passed for an object
+   */
+  virtual void addObjects(
+      const std::vector<std::pair<std::string, boost::shared_ptr<T>>> &
+          objects) {
+    std::vector<std::string> keys;
+    keys.reserve(objects.size());
+    std::set<size_t> indices;
+    for (const auto &object : objects) {
+      checkForEmptyName(object.first);
+      checkForNullPointer(object.second);
+      keys.push_back(toKey(object.first));
+      indices.insert(shardIndex(keys.back()));
+    }
+
+    {
+      auto locks = lockShards(indices);
+      std::map<size_t, boost::shared_ptr<ShardMap>> updated;
+      for (const auto index : indices) {
+        updated.emplace(index,
+                        boost::make_shared<ShardMap>(*m_shards[index].entries));
+      }
+      for (size_t i = 0; i < objects.size(); ++i) {
+        auto &entries = *updated[shardIndex(keys[i])];
+        if (!entries.emplace(keys[i], Entry{objects[i].first,
+                                            objects[i].second}).second) {
+          std::string error = " add : Unable to insert Data Object : '" +
+                              objects[i].first + "'";
+          g_log.error(error);
+          throw std::runtime_error(error);
+        }
+      }
+      for (const auto &shardEntries : updated) {
+        publish(m_shards[shardEntries.first], shardEntries.second);
+      }
+    }
+
+    NotificationBatch batch(*this);
+    for (const auto &object : objects) {
+      g_log.debug() << "Add Data Object " << object.first << " successful\n";
+      postNotification(new AddNotification(object.first, object.second));
     }
   }
 
@@ -253,57 +332,113 @@ public:
                             const boost::shared_ptr<T> &Tobject) {
     checkForNullPointer(Tobject);
 
-    // Make DataService access thread-safe
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
-
     // find if the Tobject already exists
-    auto it = datamap.find(name);
-    if (it != datamap.end()) {
-      lock.unlock();
-      g_log.debug("Data Object '" + name + "' replaced in data service.\n");
-
-      notificationCenter.postNotification(
-          new BeforeReplaceNotification(name, it->second, Tobject));
-
-      lock.lock();
-      it->second = Tobject;
-      lock.unlock();
-
-      notificationCenter.postNotification(
-          new AfterReplaceNotification(name, Tobject));
-    } else {
-      // Avoid double-locking
-      lock.unlock();
+    const std::string key = toKey(name);
+    Shard &shard = m_shards[shardIndex(key)];
+    boost::shared_ptr<T> existing;
+    {
+      const auto entries = snapshot(shard);
+      auto it = entries->find(key);
+      if (it != entries->end())
+        existing = it->second.object;
+    }
+    if (!existing) {
       DataService::add(name, Tobject);
+      return;
+    }
+
+    g_log.debug("Data Object '" + name + "' replaced in data service.\n");
+    postNotification(new BeforeReplaceNotification(name, existing, Tobject));
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto entries = boost::make_shared<ShardMap>(*shard.entries);
+      auto it = entries->find(key);
+      // The object may have been removed by another thread meanwhile
+      if (it != entries->end())
+        it->second.object = Tobject;
+      else
+        entries->emplace(key, Entry{name, Tobject});
+      publish(shard, entries);
     }
+    postNotification(new AfterReplaceNotification(name, Tobject));
   }
 
   //--------------------------------------------------------------------------
   /** Remove an object from the service.
    * @param name :: name of the object */
   void remove(const std::string &name) {
-    // Make DataService access thread-safe
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
-
-    auto it = datamap.find(name);
-    if (it == datamap.end()) {
-      lock.unlock();
+    const std::string key = toKey(name);
+    boost::shared_ptr<T> data;
+    {
+      Shard &shard = m_shards[shardIndex(key)];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      if (shard.entries->count(key) != 0) {
+        auto entries = boost::make_shared<ShardMap>(*shard.entries);
+        auto it = entries->find(key);
+        // The item is held in a local stack variable so that it lives until
+        // the observers have been told it is going.
+        data = std::move(it->second.object);
+        entries->erase(it);
+        publish(shard, entries);
+      }
+    }
+    if (!data) {
       g_log.debug(" remove '" + name + "' cannot be found");
       return;
     }
-    // The map is shared across threads so the item is erased from the map
-    // before unlocking the mutex and is held in a local stack variable.
-    // This protects it from being modified by another thread.
-    auto data = std::move(it->second);
-    datamap.erase(it);
-
-    // Do NOT use "it" iterator after this point. Other threads may modify the
-    // map
-    lock.unlock();
-    notificationCenter.postNotification(new PreDeleteNotification(name, data));
+    postNotification(new PreDeleteNotification(name, data));
     data.reset(); // DataService now has no references to the object
     g_log.information("Data Object '" + name + "' deleted from data service.");
-    notificationCenter.postNotification(new PostDeleteNotification(name));
+    postNotification(new PostDeleteNotification(name));
+  }
+
+  //--------------------------------------------------------------------------
+  /** Remove several objects from the service at once. Names that cannot be
+   * found are skipped. The notifications are sent once all the objects are
+   * out of the service.
+   * @param names :: names of the objects */
+  virtual void removeObjects(const std::vector<std::string> &names) {
+    std::vector<std::string> keys;
+    keys.reserve(names.size());
+    std::set<size_t> indices;
+    for (const auto &name : names) {
+      keys.push_back(toKey(name));
+      indices.insert(shardIndex(keys.back()));
+    }
+
+    std::vector<boost::shared_ptr<T>> removed(names.size());
+    {
+      auto locks = lockShards(indices);
+      std::map<size_t, boost::shared_ptr<ShardMap>> updated;
+      for (const auto index : indices) {
+        updated.emplace(index,
+                        boost::make_shared<ShardMap>(*m_shards[index].entries));
+      }
+      for (size_t i = 0; i < names.size(); ++i) {
+        auto &entries = *updated[shardIndex(keys[i])];
+        auto it = entries.find(keys[i]);
+        if (it != entries.end()) {
+          removed[i] = std::move(it->second.object);
+          entries.erase(it);
+        }
+      }
+      for (const auto &shardEntries : updated) {
+        publish(m_shards[shardEntries.first], shardEntries.second);
+      }
+    }
+
+    NotificationBatch batch(*this);
+    for (size_t i = 0; i < names.size(); ++i) {
+      if (!removed[i]) {
+        g_log.debug(" remove '" + names[i] + "' cannot be found");
+        continue;
+      }
+      postNotification(new PreDeleteNotification(names[i], removed[i]));
+      removed[i].reset();
+      g_log.information("Data Object '" + names[i] +
+                        "' deleted from data service.");
+      postNotification(new PostDeleteNotification(names[i]));
+    }
   }
 
   //--------------------------------------------------------------------------
@@ -319,59 +454,106 @@ public:
       return;
     }
 
-    // Make DataService access thread-safe
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
+    const std::string oldKey = toKey(oldName);
+    const std::string newKey = toKey(newName);
+    const size_t oldIndex = shardIndex(oldKey);
+    const size_t newIndex = shardIndex(newKey);
+
+    boost::shared_ptr<T> existingNameObject, targetNameObject;
+    // Other threads may change the names between looking them up and taking
+    // the locks. Then the replace notifications are closed and the objects
+    // looked up again, so that observers hear about whatever is overwritten.
+    bool renamed = false;
+    while (!renamed) {
+      {
+        const auto entries = snapshot(m_shards[oldIndex]);
+        auto it = entries->find(oldKey);
+        existingNameObject =
+            it != entries->end() ? it->second.object : boost::shared_ptr<T>();
+      }
+      if (!existingNameObject) {
+        g_log.warning(" rename '" + oldName + "' cannot be found");
+        return;
+      }
+      targetNameObject.reset();
+      if (newKey != oldKey) {
+        const auto entries = snapshot(m_shards[newIndex]);
+        auto it = entries->find(newKey);
+        if (it != entries->end())
+          targetNameObject = it->second.object;
+      }
 
-    auto existingNameIter = datamap.find(oldName);
-    if (existingNameIter == datamap.end()) {
-      lock.unlock();
-      g_log.warning(" rename '" + oldName + "' cannot be found");
-      return;
-    }
+      // If we are overriding send a notification for observers
+      if (targetNameObject) {
+        // As we are renaming the existing name turns into the new name
+        postNotification(new BeforeReplaceNotification(
+            newName, targetNameObject, existingNameObject));
+      }
 
-    auto existingNameObject = std::move(existingNameIter->second);
-    auto targetNameIter = datamap.find(newName);
+      {
+        auto locks = lockShards({oldIndex, newIndex});
+        auto oldEntries =
+            boost::make_shared<ShardMap>(*m_shards[oldIndex].entries);
+        auto newEntries = oldIndex == newIndex
+                              ? oldEntries
+                              : boost::make_shared<ShardMap>(
+                                    *m_shards[newIndex].entries);
+        auto existingNameIter = oldEntries->find(oldKey);
+        auto targetNameIter = newEntries->find(newKey);
+        const bool unchanged =
+            existingNameIter != oldEntries->end() &&
+            existingNameIter->second.object == existingNameObject &&
+            (newKey == oldKey ||
+             (targetNameIter != newEntries->end()
+                  ? targetNameIter->second.object == targetNameObject
+                  : !targetNameObject));
+        if (unchanged) {
+          oldEntries->erase(existingNameIter);
+          targetNameIter = newEntries->find(newKey);
+          if (targetNameIter != newEntries->end())
+            targetNameIter->second.object = existingNameObject;
+          else
+            newEntries->emplace(newKey, Entry{newName, existingNameObject});
+          publish(m_shards[oldIndex], oldEntries);
+          publish(m_shards[newIndex], newEntries);
+          renamed = true;
+        }
+      }
 
-    // If we are overriding send a notification for observers
-    if (targetNameIter != datamap.end()) {
-      auto targetNameObject = targetNameIter->second;
-      // As we are renaming the existing name turns into the new name
-      notificationCenter.postNotification(new BeforeReplaceNotification(
-          newName, targetNameObject, existingNameObject));
+      if (!renamed && targetNameObject) {
+        // Close the BeforeReplaceNotification; the target was left in place
+        postNotification(
+            new AfterReplaceNotification(newName, targetNameObject));
+      }
     }
 
-    datamap.erase(existingNameIter);
-
-    if (targetNameIter != datamap.end()) {
-      targetNameIter->second = std::move(existingNameObject);
-      notificationCenter.postNotification(
-          new AfterReplaceNotification(newName, targetNameIter->second));
-    } else {
-      if (!(datamap.emplace(newName, std::move(existingNameObject)).second)) {
-        // should never happen
-        lock.unlock();
-        std::string error =
-            " add : Unable to insert Data Object : '" + newName + "'";
-        g_log.error(error);
-        throw std::runtime_error(error);
-      }
+    if (targetNameObject) {
+      targetNameObject.reset();
+      postNotification(
+          new AfterReplaceNotification(newName, existingNameObject));
     }
-    lock.unlock();
     g_log.information("Data Object '" + oldName + "' renamed to '" + newName +
                       "'");
-    notificationCenter.postNotification(
-        new RenameNotification(oldName, newName));
+    postNotification(new RenameNotification(oldName, newName));
   }
 
   //--------------------------------------------------------------------------
   /// Empty the service
   void clear() {
+    std::vector<boost::shared_ptr<const ShardMap>> cleared;
     {
-      // Make DataService access thread-safe
-      std::lock_guard<std::recursive_mutex> lock(m_mutex);
-      datamap.clear();
+      std::set<size_t> indices;
+      for (size_t i = 0; i < NumShards; ++i)
+        indices.insert(i);
+      auto locks = lockShards(indices);
+      for (auto &shard : m_shards) {
+        cleared.push_back(snapshot(shard));
+        publish(shard, boost::make_shared<ShardMap>());
+      }
     }
-    notificationCenter.postNotification(new ClearNotification());
+    // The objects are released outside of the locks
+    cleared.clear();
+    postNotification(new ClearNotification());
     g_log.debug() << typeid(this).name() << " cleared.\n";
   }
 
@@ -382,12 +564,11 @@ public:
   /** Get a shared pointer to a stored data object
    * @param name :: name of the object */
   boost::shared_ptr<T> retrieve(const std::string &name) const {
-    // Make DataService access thread-safe
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-
-    auto it = datamap.find(name);
-    if (it != datamap.end()) {
-      return it->second;
+    const std::string key = toKey(name);
+    const auto entries = snapshot(m_shards[shardIndex(key)]);
+    auto it = entries->find(key);
+    if (it != entries->end()) {
+      return it->second.object;
     } else {
       throw Kernel::Exception::NotFoundError(
           "Unable to find Data Object type with name '" + name +
@@ -398,26 +579,26 @@ public:
 
   /// Check to see if a data object exists in the store
   bool doesExist(const std::string &name) const {
-    // Make DataService access thread-safe
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-    auto it = datamap.find(name);
-    return it != datamap.end();
+    const std::string key = toKey(name);
+    return snapshot(m_shards[shardIndex(key)])->count(key) != 0;
   }
 
   /// Return the number of objects stored by the data service
   size_t size() const {
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-
-    if (showingHiddenObjects()) {
-      return datamap.size();
-    } else {
-      size_t count = 0;
-      for (auto &it : datamap) {
-        if (!isHiddenDataServiceObject(it.first))
-          ++count;
+    const bool showingHidden = showingHiddenObjects();
+    size_t count = 0;
+    for (const auto &shard : m_shards) {
+      const auto entries = snapshot(shard);
+      if (showingHidden) {
+        count += entries->size();
+      } else {
+        for (const auto &item : *entries) {
+          if (!isHiddenDataServiceObject(item.second.name))
+            ++count;
+        }
       }
-      return count;
     }
+    return count;
   }
 
   /**
@@ -443,25 +624,13 @@ public:
       }
     }
 
-    // Use the scoping of an if to handle our lock for duration
-    if (hiddenState == DataServiceHidden::Include) {
-      // Getting hidden items
-      std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-      foundNames.reserve(datamap.size());
-      for (const auto &item : datamap) {
-        foundNames.push_back(item.first);
+    const auto entries = orderedEntries();
+    foundNames.reserve(entries.size());
+    for (const auto &entry : entries) {
+      if (hiddenState == DataServiceHidden::Include ||
+          !isHiddenDataServiceObject(entry.name)) {
+        foundNames.push_back(entry.name);
       }
-      // Lock released at end of scope here
-    } else {
-      std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-      foundNames.reserve(datamap.size());
-      for (const auto &item : datamap) {
-        if (!isHiddenDataServiceObject(item.first)) {
-          // This item is not hidden add it
-          foundNames.push_back(item.first);
-        }
-      }
-      // Lock released at end of scope here
     }
 
     // Now sort if told to
@@ -474,14 +643,13 @@ public:
 
   /// Get a vector of the pointers to the data objects stored by the service
   std::vector<boost::shared_ptr<T>> getObjects() const {
-    std::lock_guard<std::recursive_mutex> _lock(m_mutex);
-
     const bool showingHidden = showingHiddenObjects();
+    const auto entries = orderedEntries();
     std::vector<boost::shared_ptr<T>> objects;
-    objects.reserve(datamap.size());
-    for (auto it = datamap.begin(); it != datamap.end(); ++it) {
-      if (showingHidden || !isHiddenDataServiceObject(it->first)) {
-        objects.push_back(it->second);
+    objects.reserve(entries.size());
+    for (const auto &entry : entries) {
+      if (showingHidden || !isHiddenDataServiceObject(entry.name)) {
+        objects.push_back(entry.object);
       }
     }
     return objects;
@@ -516,10 +684,137 @@ public:
 
 protected:
   /// Protected constructor (singleton)
-  DataService(const std::string &name) : svcName(name), g_log(svcName) {}
+  DataService(const std::string &name)
+      : svcName(name), m_openBatches(0), g_log(svcName) {}
   virtual ~DataService() = default;
 
+  /** Send a notification to the observers, or queue it if a
+   * NotificationBatch is open on this thread.
+   * @param notification :: the notification, which the service takes
+   * ownership of
+   */
+  void postNotification(Poco::Notification *notification) {
+    Poco::Notification::Ptr ptr(notification);
+    if (m_openBatches > 0) {
+      std::lock_guard<std::mutex> lock(m_pendingMutex);
+      auto it = m_pending.find(std::this_thread::get_id());
+      if (it != m_pending.end()) {
+        it->second.notifications.push_back(ptr);
+        return;
+      }
+    }
+    notificationCenter.postNotification(ptr);
+  }
+
 private:
+  /// An object in the service along with the name it was added with
+  struct Entry {
+    std::string name;
+    boost::shared_ptr<T> object;
+  };
+  /// The entries of a shard keyed by their lower case names
+  typedef std::unordered_map<std::string, Entry> ShardMap;
+  /// A part of the store. Readers take the current map without waiting for
+  /// the writers, which replace it with an updated copy.
+  struct Shard {
+    /// Serializes the writers of the shard
+    std::mutex mutex;
+    /// The current entries. Only access through snapshot() and publish().
+    boost::shared_ptr<const ShardMap> entries{boost::make_shared<ShardMap>()};
+  };
+  /// The number of shards the objects are spread over
+  enum { NumShards = 16 };
+
+  /// The notifications queued by the batches open on a thread
+  struct PendingNotifications {
+    /// The number of nested batches
+    int depth = 0;
+    std::vector<Poco::Notification::Ptr> notifications;
+  };
+
+  /// @return The key of a name, which makes lookups case-insensitive
+  static std::string toKey(const std::string &name) {
+    return boost::algorithm::to_lower_copy(name);
+  }
+
+  /// @return The index of the shard an object with the given key is in
+  static size_t shardIndex(const std::string &key) {
+    return std::hash<std::string>()(key) % NumShards;
+  }
+
+  /// @return The current entries of a shard
+  static boost::shared_ptr<const ShardMap> snapshot(const Shard &shard) {
+    return boost::atomic_load(&shard.entries);
+  }
+
+  /// Replace the entries of a shard. The mutex of the shard must be locked.
+  static void publish(Shard &shard, boost::shared_ptr<const ShardMap> entries) {
+    boost::atomic_store(&shard.entries, std::move(entries));
+  }
+
+  /**
+   * Lock the mutexes of several shards. They are locked in the order of
+   * their indices, so writers locking overlapping sets cannot deadlock.
+   * @param indices :: the indices of the shards
+   * @return The locks, which unlock the shards when destroyed
+   */
+  std::vector<std::unique_lock<std::mutex>>
+  lockShards(const std::set<size_t> &indices) const {
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(indices.size());
+    for (const auto index : indices)
+      locks.emplace_back(m_shards[index].mutex);
+    return locks;
+  }
+
+  /// @return All entries, ordered case-insensitively by name
+  std::vector<Entry> orderedEntries() const {
+    std::vector<Entry> entries;
+    for (const auto &shard : m_shards) {
+      const auto shardEntries = snapshot(shard);
+      for (const auto &item : *shardEntries)
+        entries.push_back(item.second);
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &lhs, const Entry &rhs) {
+                return CaseInsensitiveCmp()(lhs.name, rhs.name);
+              });
+    return entries;
+  }
+
+  /// Start queueing the notifications of this thread
+  void beginBatch() {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    auto &pending = m_pending[std::this_thread::get_id()];
+    if (pending.depth++ == 0)
+      ++m_openBatches;
+  }
+
+  /// Send the queued notifications of this thread if the outermost batch
+  /// ended
+  void endBatch() {
+    std::vector<Poco::Notification::Ptr> notifications;
+    {
+      std::lock_guard<std::mutex> lock(m_pendingMutex);
+      auto it = m_pending.find(std::this_thread::get_id());
+      if (--it->second.depth > 0)
+        return;
+      notifications.swap(it->second.notifications);
+      m_pending.erase(it);
+      --m_openBatches;
+    }
+    for (auto &notification : notifications) {
+      try {
+        notificationCenter.postNotification(notification);
+      } catch (std::exception &e) {
+        // Called from a destructor so nothing may be thrown
+        g_log.error() << "Error sending a notification: " << e.what() << '\n';
+      }
+      // Release the objects the notification refers to before the next one
+      notification = Poco::Notification::Ptr();
+    }
+  }
+
   void checkForEmptyName(const std::string &name) {
     if (name.empty()) {
       const std::string error = "Add Data Object with empty name";
@@ -539,10 +834,15 @@ private:
   /// DataService name. This is set only at construction. DataService name
   /// should be provided when construction of derived classes
   const std::string svcName;
-  /// Map of objects in the data service
-  svcmap datamap;
-  /// Recursive mutex to avoid simultaneous access or notifications
-  mutable std::recursive_mutex m_mutex;
+  /// The objects in the data service, spread over the shards by the hash of
+  /// their keys
+  mutable std::array<Shard, NumShards> m_shards;
+  /// The number of threads with an open NotificationBatch
+  std::atomic<int> m_openBatches;
+  /// The notifications queued on each thread with an open NotificationBatch
+  std::map<std::thread::id, PendingNotifications> m_pending;
+  /// Guards m_pending
+  std::mutex m_pendingMutex;
   /// Logger for this DataService
   Logger g_log;
 }; // End Class Data service
@@ -7,6 +7,7 @@
 #include "MantidKernel/DllConfig.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Instantiator.h"
+#include "MantidKernel/LibraryManager.h"
 #include "MantidKernel/RegistrationHelper.h"
 #include "MantidKernel/CaseInsensitiveMap.h"
 
@@ -18,6 +19,7 @@
 // Poco
 #include <Poco/Notification.h>
 #include <Poco/NotificationCenter.h>
+#include <Poco/RWLock.h>
 
 // std
 #include <functional>
@@ -40,6 +42,17 @@ typedef std::less<std::string> CaseSensitiveStringComparator;
    response
     to requests from other classes.
 
+    Plugin libraries may be opened on demand by the LibraryManager. A class
+    that isn't registered is looked for in the libraries that haven't been
+    opened yet before the request fails. Factories constructed with a plugin
+    kind record what the libraries register under that kind, so that only the
+    library providing a class is opened when it is requested.
+
+    The registered classes are guarded by a read-write lock because a library
+    opened on demand subscribes its classes while other threads may be
+    creating objects. The lock is never held while a library is opened or an
+    object is created.
+
     @author Nick Draper, Tessella Support Services plc
     @date 10/10/2007
 
@@ -112,12 +125,7 @@ public:
   /// @param className :: the name of the class you wish to create
   /// @return a shared pointer ot the base class
   virtual boost::shared_ptr<Base> create(const std::string &className) const {
-    auto it = _map.find(className);
-    if (it != _map.end())
-      return it->second->createInstance();
-    else
-      throw Exception::NotFoundError(
-          "DynamicFactory: " + className + " is not registered.\n", className);
+    return findInstantiator(className)->createInstance();
   }
 
   /// Creates a new instance of the class with the given name, which
@@ -130,12 +138,7 @@ public:
   /// @param className :: the name of the class you wish to create
   /// @return a pointer to the base class
   virtual Base *createUnwrapped(const std::string &className) const {
-    auto it = _map.find(className);
-    if (it != _map.end())
-      return it->second->createUnwrappedInstance();
-    else
-      throw Exception::NotFoundError(
-          "DynamicFactory: " + className + " is not registered.\n", className);
+    return findInstantiator(className)->createUnwrappedInstance();
   }
 
   /// Registers the instantiator for the given class with the DynamicFactory.
@@ -167,16 +170,22 @@ public:
       throw std::invalid_argument("Cannot register empty class name");
     }
 
-    auto it = _map.find(className);
-    if (it == _map.end() || replace == OverwriteCurrent) {
-      if (it != _map.end() && it->second)
-        delete it->second;
-      _map[className] = pAbstractFactory;
-      sendUpdateNotificationIfEnabled();
-    } else {
-      delete pAbstractFactory;
-      throw std::runtime_error(className + " is already registered.\n");
+    if (!m_pluginKind.empty())
+      LibraryManager::Instance().RegisterProvided(m_pluginKind, className);
+
+    {
+      Poco::ScopedWriteRWLock lock(m_mapLock);
+      auto it = _map.find(className);
+      if (it == _map.end() || replace == OverwriteCurrent) {
+        if (it != _map.end() && it->second)
+          delete it->second;
+        _map[className] = pAbstractFactory;
+      } else {
+        delete pAbstractFactory;
+        throw std::runtime_error(className + " is already registered.\n");
+      }
     }
+    sendUpdateNotificationIfEnabled();
   }
 
   /// Unregisters the given class and deletes the instantiator
@@ -184,27 +193,33 @@ public:
   /// Throws a NotFoundException if the class has not been registered.
   /// @param className :: the name of the class you wish to unsubscribe
   void unsubscribe(const std::string &className) {
-    auto it = _map.find(className);
-    if (!className.empty() && it != _map.end()) {
+    {
+      Poco::ScopedWriteRWLock lock(m_mapLock);
+      auto it = _map.find(className);
+      if (className.empty() || it == _map.end()) {
+        throw Exception::NotFoundError(
+            "DynamicFactory:" + className + " is not registered.\n",
+            className);
+      }
       delete it->second;
       _map.erase(it);
-      sendUpdateNotificationIfEnabled();
-    } else {
-      throw Exception::NotFoundError(
-          "DynamicFactory:" + className + " is not registered.\n", className);
     }
+    sendUpdateNotificationIfEnabled();
   }
 
   /// Returns true if the given class is currently registered.
   /// @param className :: the name of the class you wish to check
   /// @returns true is the class is subscribed
   bool exists(const std::string &className) const {
-    return _map.find(className) != _map.end();
+    return isRegistered(className) ||
+           (openPluginProviding(className) && isRegistered(className));
   }
 
   /// Returns the keys in the map
   /// @return A string vector of keys
   virtual const std::vector<std::string> getKeys() const {
+    openAllPlugins();
+    Poco::ScopedReadRWLock lock(m_mapLock);
     std::vector<std::string> names;
     names.reserve(_map.size());
     std::transform(
@@ -224,8 +239,73 @@ public:
 protected:
   /// Protected constructor for base class
   DynamicFactory() : notificationCenter(), _map(), m_notifyStatus(Disabled) {}
+  /// Protected constructor for factories of classes registered by plugins
+  /// @param pluginKind :: The kind recorded for the registered classes, e.g.
+  /// algorithm
+  explicit DynamicFactory(const std::string &pluginKind)
+      : notificationCenter(), _map(), m_notifyStatus(Disabled),
+        m_pluginKind(pluginKind) {
+    // The library manager must be destroyed after us so that it does not
+    // close libraries whose instantiators we still hold
+    LibraryManager::Instance();
+  }
+
+  /// Open the plugin library that registers a class, if it isn't open yet
+  /// @param className :: the name of the class
+  /// @return true if a library was opened
+  bool openPluginProviding(const std::string &className) const {
+    auto &libraries = LibraryManager::Instance();
+    if (m_pluginKind.empty())
+      return libraries.OpenDeferredLibraries() > 0;
+    return libraries.OpenLibraryProviding(m_pluginKind, className);
+  }
+
+  /// Open the plugin libraries that register classes with this factory
+  void openAllPlugins() const {
+    auto &libraries = LibraryManager::Instance();
+    if (m_pluginKind.empty())
+      libraries.OpenDeferredLibraries();
+    else
+      libraries.OpenLibrariesProviding(m_pluginKind);
+  }
+
+  /// Guards the map, and the maps of derived factories, against libraries
+  /// subscribing classes while it is read. It is not recursive and must not
+  /// be held while libraries are opened or the base methods are called.
+  mutable Poco::RWLock m_mapLock;
 
 private:
+  /// Find the instantiator of a class, opening the plugin library that
+  /// registers it if necessary
+  /// @param className :: the name of the class
+  /// @return the instantiator, which lives until the class is unsubscribed
+  AbstractFactory *findInstantiator(const std::string &className) const {
+    AbstractFactory *instantiator = lookUp(className);
+    if (!instantiator && openPluginProviding(className))
+      instantiator = lookUp(className);
+    if (!instantiator)
+      throw Exception::NotFoundError(
+          "DynamicFactory: " + className + " is not registered.\n", className);
+    return instantiator;
+  }
+
+  /// Look up the instantiator of a registered class
+  /// @param className :: the name of the class
+  /// @return the instantiator or nullptr if the class isn't registered
+  AbstractFactory *lookUp(const std::string &className) const {
+    Poco::ScopedReadRWLock lock(m_mapLock);
+    auto it = _map.find(className);
+    return it != _map.end() ? it->second : nullptr;
+  }
+
+  /// Check if a class is registered without opening any libraries
+  /// @param className :: the name of the class
+  /// @return true if the class is registered
+  bool isRegistered(const std::string &className) const {
+    Poco::ScopedReadRWLock lock(m_mapLock);
+    return _map.find(className) != _map.end();
+  }
+
   /// Send an update notification if they are enabled
   void sendUpdateNotificationIfEnabled() {
     if (m_notifyStatus == Enabled)
@@ -242,6 +322,8 @@ private:
   FactoryMap _map;
   /// Flag marking whether we should dispatch notifications
   NotificationStatus m_notifyStatus;
+  /// The kind recorded for the classes registered by plugins, or empty
+  std::string m_pluginKind;
 };
 
 } // namespace Kernel
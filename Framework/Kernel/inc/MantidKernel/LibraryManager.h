@@ -6,12 +6,15 @@
 //----------------------------------------------------------------------
 #include <string>
 #include <map>
+#include <mutex>
+#include <vector>
 #ifndef Q_MOC_RUN
 #include <boost/shared_ptr.hpp>
 #endif
 
 #include "MantidKernel/SingletonHolder.h"
 #include "MantidKernel/DllConfig.h"
+#include "MantidKernel/PluginManifest.h"
 
 namespace Mantid {
 namespace Kernel {
@@ -48,6 +51,16 @@ class MANTID_KERNEL_DLL LibraryManagerImpl {
 public:
   // opens all suitable libraries on a given path
   int OpenAllLibraries(const std::string &, bool isRecursive = false);
+  // opens the libraries on a given path when what they register is requested
+  int OpenLibrariesOnDemand(const std::string &filePath);
+  /// Record that the library being opened registers a name of a kind
+  void RegisterProvided(const std::string &kind, const std::string &name);
+  /// Open the deferred library registering a name of a kind
+  bool OpenLibraryProviding(const std::string &kind, const std::string &name);
+  /// Open the deferred libraries registering names of a kind
+  int OpenLibrariesProviding(const std::string &kind);
+  /// Open all the deferred libraries
+  int OpenDeferredLibraries();
   LibraryManagerImpl(const LibraryManagerImpl &) = delete;
   LibraryManagerImpl &operator=(const LibraryManagerImpl &) = delete;
 
@@ -64,9 +77,29 @@ private:
   bool loadLibrary(const std::string &filepath);
   /// Returns true if the library is to be loaded
   bool skip(const std::string &filename);
+  /// Returns true if a library has been opened by this manager
+  bool isOpen(const std::string &filepath) const;
+  /// Open the deferred library at the given index
+  bool openDeferred(size_t index);
+
+  /// A library that is opened when something it registers is requested
+  struct DeferredLibrary {
+    /// The full path to the library
+    std::string path;
+    /// What the library registers
+    PluginManifest::Provided provided;
+  };
+
   /// Storage for the LibraryWrappers.
   std::map<const std::string, boost::shared_ptr<Mantid::Kernel::LibraryWrapper>>
       OpenLibs;
+  /// The libraries that haven't been opened yet
+  std::vector<DeferredLibrary> m_deferred;
+  /// Collects what the library being opened registers, if it is recorded
+  PluginManifest::Provided *m_recording;
+  /// Guards the deferred libraries. Opening a library registers its contents,
+  /// which may re-enter this manager on the same thread.
+  std::recursive_mutex m_mutex;
 };
 
 EXTERN_MANTID_KERNEL template class MANTID_KERNEL_DLL
@@ -138,6 +138,9 @@ public:
   /// Returns true if at least the given log level is set.
   bool is(int level) const;
 
+  /// Returns true if a message at the given priority would be logged
+  bool wouldLog(Priority priority) const;
+
   /// Sets the log level for all Loggers created so far, including the root
   /// logger.
   static void setLevelForAll(const int level);
@@ -154,7 +157,7 @@ private:
   Logger &operator=(const Logger &);
 
   /// Return a log stream set with the given priority
-  Priority applyLevelOffset(Priority proposedLevel);
+  Priority applyLevelOffset(Priority proposedLevel) const;
 
   /// Internal handle to third party logging objects
   Poco::Logger *m_log;
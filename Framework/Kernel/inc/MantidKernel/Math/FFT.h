@@ -0,0 +1,69 @@
+#ifndef MANTID_KERNEL_FFT_H_
+#define MANTID_KERNEL_FFT_H_
+/*
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "MantidKernel/DllConfig.h"
+#include <cstddef>
+
+namespace Mantid {
+namespace Kernel {
+/**
+  In-place fast Fourier transforms of arrays of any length, using the GSL
+  mixed-radix algorithms and storage conventions.
+
+  The trigonometric tables of a transform depend only on its type and
+  length. They are computed on first use and cached, so repeated transforms
+  of the same length (one per spectrum, or one per function evaluation in a
+  fit) don't recompute them. The scratch space is separate for every call,
+  which makes it safe to run transforms concurrently from several threads.
+  All functions throw std::runtime_error if GSL reports an error.
+*/
+namespace FFT {
+
+/// Forward transform of n complex values stored as (real, imaginary) pairs
+MANTID_KERNEL_DLL void complexForward(double *data, size_t n);
+/// Unnormalised backward transform of n complex values
+MANTID_KERNEL_DLL void complexBackward(double *data, size_t n);
+/// Inverse (backward divided by n) transform of n complex values
+MANTID_KERNEL_DLL void complexInverse(double *data, size_t n);
+/// Forward transform of n real values. The result is in half-complex storage.
+MANTID_KERNEL_DLL void realForward(double *data, size_t n);
+/// Unnormalised backward transform of n values in half-complex storage
+MANTID_KERNEL_DLL void halfComplexBackward(double *data, size_t n);
+/// Inverse transform of n values in half-complex storage
+MANTID_KERNEL_DLL void halfComplexInverse(double *data, size_t n);
+
+/// The number of cached wavetables
+MANTID_KERNEL_DLL size_t cachedWavetables();
+/// Release all cached wavetables
+MANTID_KERNEL_DLL void clearWavetableCache();
+
+} // namespace FFT
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_FFT_H_ */
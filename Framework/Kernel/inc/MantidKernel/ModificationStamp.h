@@ -0,0 +1,88 @@
+#ifndef MANTID_KERNEL_MODIFICATIONSTAMP_H_
+#define MANTID_KERNEL_MODIFICATIONSTAMP_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ModificationStamp records when an object was last modified, as a value
+  taken from a single process-wide counter that only increases.
+
+  Every value is one that no other stamp has had, so two objects with equal
+  stamps hold the same content as long as every modification of them updates
+  their stamp. Copies keep the stamp of the object they are copied from, since
+  their content is the same. Comparing stamps therefore tells whether an
+  object has changed since it was last seen, and a later value always means a
+  later modification.
+
+  An object may go on being modified through a reference after update() has
+  been called. update() therefore only marks the stamp as modified, and until
+  settle() is called every value() is a new one. settle() records that the
+  modifications are complete and takes the final value. Marking a stamp
+  touches only the stamp itself, so that parallel loops modifying many objects
+  don't contend for the shared counter.
+
+  Stamps can be read, updated and settled from several threads at once; a
+  stamp never goes back to an earlier value.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL ModificationStamp {
+public:
+  ModificationStamp() : m_value(next()) {}
+  ModificationStamp(const ModificationStamp &other) : m_value(other.value()) {}
+  ModificationStamp &operator=(const ModificationStamp &other) {
+    m_value.store(other.value(), std::memory_order_relaxed);
+    return *this;
+  }
+
+  /// The value of the stamp, a new one each time while it is being modified
+  uint64_t value() const {
+    const uint64_t current = m_value.load(std::memory_order_relaxed);
+    return (current & MODIFIED) != 0 ? next() : current;
+  }
+  /// Record a modification
+  void update() {
+    // Avoid writing to the stamp if it is already marked
+    if ((m_value.load(std::memory_order_relaxed) & MODIFIED) == 0)
+      m_value.fetch_or(MODIFIED, std::memory_order_relaxed);
+  }
+  /// Record that the modifications are complete
+  bool settle();
+
+  /// Take the next value of the process-wide counter
+  static uint64_t next();
+
+private:
+  /// The bit of m_value marking a stamp that is being modified
+  static const uint64_t MODIFIED = uint64_t(1) << 63;
+  std::atomic<uint64_t> m_value;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_MODIFICATIONSTAMP_H_ */
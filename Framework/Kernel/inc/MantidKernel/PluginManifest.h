@@ -0,0 +1,99 @@
+#ifndef MANTID_KERNEL_PLUGINMANIFEST_H_
+#define MANTID_KERNEL_PLUGINMANIFEST_H_
+
+#include "MantidKernel/DllConfig.h"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace Mantid {
+namespace Kernel {
+
+/** PluginManifest records what the libraries in a plugin directory register
+  with the factories, so that they can be opened when something they provide
+  is first requested instead of at start-up.
+
+  Each library is recorded with its size and modification time. A library
+  whose file has changed since it was recorded is not current and must be
+  opened, and recorded again, to know what it provides.
+
+  The manifest is saved as a text file with one entry per line:
+
+      directory <path>
+      library <file name> <size> <modification time>
+      provides <kind> <name>
+
+  where the fields are separated by tabs and the provides lines refer to the
+  library above them.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL PluginManifest {
+public:
+  /// The (kind, name) pairs a library registers, e.g. ("algorithm", "Rebin")
+  typedef std::set<std::pair<std::string, std::string>> Provided;
+
+  PluginManifest() = default;
+  explicit PluginManifest(const std::string &directory);
+
+  /// The directory of the libraries
+  const std::string &directory() const { return m_directory; }
+  /// Read a manifest from a file
+  bool load(const std::string &filename);
+  /// Write the manifest to a file
+  void save(const std::string &filename) const;
+
+  /// Record a library and what it provides
+  void addLibrary(const std::string &path, const Provided &provided);
+  /// Remove a library
+  void removeLibrary(const std::string &fileName);
+  /// True if the library is recorded and its file hasn't changed since
+  bool isCurrent(const std::string &path) const;
+  /// What a library provides, null if it isn't recorded
+  const Provided *provided(const std::string &fileName) const;
+  /// The number of libraries recorded
+  size_t size() const { return m_libraries.size(); }
+
+  /// The usual location of the manifest of a directory
+  static std::string defaultFilename(const std::string &directory);
+
+private:
+  /// A library recorded in the manifest
+  struct Library {
+    uint64_t size;
+    int64_t modified;
+    Provided provided;
+  };
+
+  /// The directory of the libraries
+  std::string m_directory;
+  /// The libraries by file name
+  std::map<std::string, Library> m_libraries;
+};
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_PLUGINMANIFEST_H_ */
@@ -0,0 +1,181 @@
+#ifndef MANTID_KERNEL_PROFILER_H_
+#define MANTID_KERNEL_PROFILER_H_
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/SingletonHolder.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ProfilerImpl records how long the framework spends in algorithms and
+  thread pools, and what resources they use, as a tree of spans.
+
+  A span is recorded by a ProfilerImpl::Scope for as long as it exists.
+  Algorithm::execute() records a span for every algorithm and ThreadPool one
+  for every pool from start() to joinAll(). Spans started on a thread while
+  another span is open on it are children of that span; the threads of a
+  pool record their spans as children of the pool. Each span holds:
+  - the wall and CPU time. The CPU time is that of the whole process, so it
+    includes other threads working at the same time.
+  - the change of the resident set size (RSS) and how much the peak RSS of
+    the process grew.
+  - the bytes the process read and wrote, where the operating system reports
+    them (Linux and Windows).
+  - for pools, the number of threads and the total time they spent running
+    tasks, which give the thread utilisation.
+
+  Recording is off by default, or on if the profiling.enabled property is
+  set. When it is off a scope only checks an atomic flag. The recorded spans
+  can be read with spans() or exported in the Chrome trace event format,
+  which chrome://tracing and other trace viewers display. If the
+  profiling.file property is set, the trace is saved there when the
+  framework shuts down.
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class MANTID_KERNEL_DLL ProfilerImpl {
+public:
+  /// The measurements of one span
+  struct Span {
+    /// What was running, e.g. the name and version of an algorithm
+    std::string name;
+    /// The kind of span, e.g. "algorithm" or "threadpool"
+    std::string category;
+    /// A unique number, starting at 1
+    uint64_t id = 0;
+    /// The id of the enclosing span, or 0 if there is none
+    uint64_t parent = 0;
+    /// A number identifying the thread the span started on
+    size_t thread = 0;
+    /// The start in seconds since the profiler was created or cleared
+    double start = 0.0;
+    /// The elapsed time in seconds
+    double wallTime = 0.0;
+    /// The CPU time of the process in seconds
+    double cpuTime = 0.0;
+    /// The change of the resident set size in bytes
+    int64_t rssDelta = 0;
+    /// How much the peak resident set size grew, in bytes
+    uint64_t peakRssIncrease = 0;
+    /// The bytes read by the process
+    uint64_t bytesRead = 0;
+    /// The bytes written by the process
+    uint64_t bytesWritten = 0;
+    /// The number of threads of a thread pool, 0 for other spans
+    size_t threads = 0;
+    /// The total time in seconds the threads of a pool spent running tasks
+    double busyTime = 0.0;
+  };
+
+  /// Resource usage of the process at one time
+  struct Sample {
+    double cpuTime = 0.0;
+    uint64_t rss = 0;
+    uint64_t peakRss = 0;
+    uint64_t bytesRead = 0;
+    uint64_t bytesWritten = 0;
+  };
+
+  /** Records a span from its construction to its destruction if recording
+    is enabled when it is constructed. Scopes on one thread must end in the
+    reverse order they started. */
+  class MANTID_KERNEL_DLL Scope {
+  public:
+    Scope(const std::string &name, const char *category);
+    ~Scope();
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    /// true if the span is being recorded
+    bool isActive() const { return m_active; }
+    /// The id of the span, or 0 if it is not recorded
+    uint64_t id() const { return m_span.id; }
+    void setThreadUsage(size_t threads, double busyTime);
+
+  private:
+    bool m_active;
+    Span m_span;
+    Sample m_start;
+    std::chrono::steady_clock::time_point m_startTime;
+    /// The span that was open on this thread when this one started
+    uint64_t m_previous = 0;
+  };
+
+  /** Makes the spans started on this thread children of a span that was
+    started on another thread, for as long as it exists. */
+  class MANTID_KERNEL_DLL ParentScope {
+  public:
+    explicit ParentScope(uint64_t parent);
+    ~ParentScope();
+    ParentScope(const ParentScope &) = delete;
+    ParentScope &operator=(const ParentScope &) = delete;
+
+  private:
+    uint64_t m_previous;
+  };
+
+  /// true if spans are being recorded
+  bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+  void setEnabled(bool enabled);
+  void clear();
+  std::vector<Span> spans() const;
+  std::string toChromeTrace() const;
+  void saveChromeTrace(const std::string &filename) const;
+
+  static uint64_t currentSpan();
+  static Sample sample();
+
+private:
+  friend struct CreateUsingNew<ProfilerImpl>;
+  ProfilerImpl();
+  ~ProfilerImpl();
+  ProfilerImpl(const ProfilerImpl &) = delete;
+  ProfilerImpl &operator=(const ProfilerImpl &) = delete;
+
+  double elapsed() const;
+  void record(const Span &span);
+
+  std::atomic<bool> m_enabled;
+  std::atomic<uint64_t> m_lastId;
+  mutable std::mutex m_mutex;
+  std::vector<Span> m_spans;
+  /// When the profiler was created or cleared, in steady_clock ticks
+  std::atomic<std::chrono::steady_clock::rep> m_epoch;
+  /// Where to save the trace when the profiler is destroyed
+  std::string m_filename;
+};
+
+EXTERN_MANTID_KERNEL template class MANTID_KERNEL_DLL
+    Mantid::Kernel::SingletonHolder<ProfilerImpl>;
+typedef Mantid::Kernel::SingletonHolder<ProfilerImpl> Profiler;
+
+} // namespace Kernel
+} // namespace Mantid
+
+#endif /* MANTID_KERNEL_PROFILER_H_ */
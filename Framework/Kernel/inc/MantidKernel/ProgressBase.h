@@ -58,6 +58,14 @@ public:
 
   double getEstimatedTime() const;
 
+  /// true if a report setting the loop counter to i sends a notification
+  bool notifiesAt(int64_t i) const {
+    return i - m_last_reported >= m_notifyStep;
+  }
+  /// true if a report incrementing the loop counter by inc sends a
+  /// notification
+  bool notifiesAfter(int64_t inc) const { return notifiesAt(m_i + inc); }
+
 protected:
   /// Starting progress
   double m_start;
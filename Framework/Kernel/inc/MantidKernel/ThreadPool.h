@@ -7,6 +7,9 @@
 #include "MantidKernel/ThreadScheduler.h"
 #include "MantidKernel/ThreadPoolRunnable.h"
 #include "MantidKernel/ProgressBase.h"
+#include "MantidKernel/Profiler.h"
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <Poco/Thread.h>
 
@@ -81,6 +84,11 @@ protected:
   ProgressBase *m_prog;
 
 private:
+  /// Records the pool from start() to joinAll() if profiling is enabled
+  std::unique_ptr<ProfilerImpl::Scope> m_profile;
+  /// The total time the threads spent running tasks, in microseconds
+  std::atomic<uint64_t> m_busyTime;
+
   // prohibit default copy constructor as it does not work
   ThreadPool(const ThreadPool &);
   // prohibit asighnment as it does not work
@@ -7,6 +7,9 @@
 #include <Poco/Runnable.h>
 #include <Poco/Thread.h>
 
+#include <atomic>
+#include <cstdint>
+
 namespace Mantid {
 namespace Kernel {
 
@@ -19,7 +22,9 @@ namespace Kernel {
 class MANTID_KERNEL_DLL ThreadPoolRunnable : public Poco::Runnable {
 public:
   ThreadPoolRunnable(size_t threadnum, ThreadScheduler *scheduler,
-                     ProgressBase *prog = nullptr, double waitSec = 0.0);
+                     ProgressBase *prog = nullptr, double waitSec = 0.0,
+                     uint64_t parentSpan = 0,
+                     std::atomic<uint64_t> *busyTime = nullptr);
 
   /// Return the thread number of this thread.
   size_t threadnum() { return m_threadnum; }
@@ -40,6 +45,12 @@ private:
 
   /// How many seconds you are allowed to wait with no tasks before exiting.
   double m_waitSec;
+
+  /// The profiler span that the tasks run in, or 0
+  uint64_t m_parentSpan;
+
+  /// Where to add the time spent running tasks in microseconds, or nullptr
+  std::atomic<uint64_t> *m_busyTime;
 };
 
 } // namespace Mantid
@@ -4,12 +4,14 @@
 #include "MantidKernel/LibraryManager.h"
 #include "MantidKernel/LibraryWrapper.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/PluginManifest.h"
 
 #include <Poco/Path.h>
 #include <Poco/File.h>
 #include <Poco/DirectoryIterator.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/make_shared.hpp>
+#include <algorithm>
 #include <unordered_set>
 
 namespace Mantid {
@@ -20,7 +22,7 @@ Logger g_log("LibraryManager");
 }
 
 /// Constructor
-LibraryManagerImpl::LibraryManagerImpl() {
+LibraryManagerImpl::LibraryManagerImpl() : m_recording(nullptr) {
   g_log.debug() << "LibraryManager created.\n";
 }
 
@@ -31,6 +33,7 @@ LibraryManagerImpl::LibraryManagerImpl() {
 */
 int LibraryManagerImpl::OpenAllLibraries(const std::string &filePath,
                                          bool isRecursive) {
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
   g_log.debug() << "Opening all libraries in " << filePath << "\n";
   int libCount = 0;
   // validate inputs
@@ -65,6 +68,177 @@ int LibraryManagerImpl::OpenAllLibraries(const std::string &filePath,
   return libCount;
 }
 
+/** Opens the libraries on a given path when something they register is first
+ * requested, if the plugins.lazyLoading property is set. Otherwise all the
+ * libraries are opened now.
+ *
+ * What the libraries register is read from the manifest of the directory.
+ * Libraries that are not in the manifest, or have changed since it was
+ * written, are opened now and the manifest is updated with what they
+ * register. Libraries that register nothing while they are opened, for
+ * example because they were already loaded as a dependency, are left out of
+ * the manifest and are opened at start-up.
+ *
+ * @param filePath :: The filepath to the directory where the libraries are.
+ * @return The number of libraries opened now.
+ */
+int LibraryManagerImpl::OpenLibrariesOnDemand(const std::string &filePath) {
+  int lazyLoading = 0;
+  ConfigService::Instance().getValue("plugins.lazyLoading", lazyLoading);
+  if (lazyLoading != 1) {
+    return OpenAllLibraries(filePath);
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  Poco::File libPath;
+  try {
+    libPath = Poco::File(filePath);
+    if (!libPath.exists() || !libPath.isDirectory()) {
+      g_log.error("In OpenLibrariesOnDemand: " + filePath +
+                  " must be a directory.");
+      return 0;
+    }
+  } catch (...) {
+    return 0;
+  }
+  DllOpen::addSearchDirectory(filePath);
+
+  const std::string manifestFile = PluginManifest::defaultFilename(filePath);
+  PluginManifest manifest(filePath);
+  PluginManifest previous;
+  const bool havePrevious = previous.load(manifestFile) &&
+                            previous.directory() == manifest.directory();
+  bool changed = false;
+
+  int libCount = 0;
+  size_t reusedCount = 0;
+  size_t deferredCount = 0;
+  Poco::DirectoryIterator end_itr;
+  for (Poco::DirectoryIterator itr(libPath); itr != end_itr; ++itr) {
+    const Poco::Path &item = itr.path();
+    const std::string path = item.toString();
+    if (itr->isDirectory() || skip(path) ||
+        DllOpen::ConvertToLibName(item.getFileName()).empty())
+      continue;
+    if (havePrevious && previous.isCurrent(path)) {
+      const auto &provided = *previous.provided(item.getFileName());
+      manifest.addLibrary(path, provided);
+      ++reusedCount;
+      const bool deferred = std::any_of(
+          m_deferred.begin(), m_deferred.end(),
+          [&path](const DeferredLibrary &library) {
+            return library.path == path;
+          });
+      if (!isOpen(path) && !deferred) {
+        m_deferred.push_back(DeferredLibrary{path, provided});
+        ++deferredCount;
+      }
+    } else {
+      PluginManifest::Provided provided;
+      m_recording = &provided;
+      if (loadLibrary(path)) {
+        ++libCount;
+      }
+      m_recording = nullptr;
+      if (!provided.empty()) {
+        manifest.addLibrary(path, provided);
+        changed = true;
+      }
+    }
+  }
+  if (reusedCount != previous.size()) {
+    changed = true;
+  }
+
+  if (changed) {
+    try {
+      manifest.save(manifestFile);
+      g_log.debug() << "Wrote plugin manifest " << manifestFile << '\n';
+    } catch (std::exception &e) {
+      g_log.debug() << e.what() << '\n';
+    }
+  }
+  g_log.debug() << "Opened " << libCount << " libraries in " << filePath
+                << ", deferred " << deferredCount << '\n';
+  return libCount;
+}
+
+/**
+ * Called by the factories when something is registered with them. If a
+ * library is being opened by OpenLibrariesOnDemand, the name is recorded in
+ * the manifest as something that library provides.
+ * @param kind :: What is registered, e.g. algorithm or function
+ * @param name :: The name it is registered with
+ */
+void LibraryManagerImpl::RegisterProvided(const std::string &kind,
+                                          const std::string &name) {
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  if (m_recording) {
+    m_recording->emplace(kind, name);
+  }
+}
+
+/**
+ * Open the deferred library that registers a name, if there is one. Names are
+ * compared ignoring case, like the factories do.
+ * @param kind :: What is requested, e.g. algorithm or function
+ * @param name :: The name of what is requested
+ * @return true if a library was opened
+ */
+bool LibraryManagerImpl::OpenLibraryProviding(const std::string &kind,
+                                              const std::string &name) {
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  for (size_t i = 0; i < m_deferred.size(); ++i) {
+    for (const auto &item : m_deferred[i].provided) {
+      if (item.first == kind && boost::iequals(item.second, name)) {
+        return openDeferred(i);
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * Open the deferred libraries that register anything of a kind, e.g. before
+ * listing the contents of a factory.
+ * @param kind :: What is requested, e.g. algorithm or function
+ * @return The number of libraries opened
+ */
+int LibraryManagerImpl::OpenLibrariesProviding(const std::string &kind) {
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  int libCount = 0;
+  size_t i = 0;
+  while (i < m_deferred.size()) {
+    const auto &provided = m_deferred[i].provided;
+    if (std::any_of(provided.begin(), provided.end(),
+                    [&kind](const PluginManifest::Provided::value_type &item) {
+                      return item.first == kind;
+                    })) {
+      if (openDeferred(i))
+        ++libCount;
+      // Opening may have opened other deferred libraries too
+      i = 0;
+    } else {
+      ++i;
+    }
+  }
+  return libCount;
+}
+
+/**
+ * Open all the deferred libraries.
+ * @return The number of libraries opened
+ */
+int LibraryManagerImpl::OpenDeferredLibraries() {
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  int libCount = 0;
+  while (!m_deferred.empty()) {
+    if (openDeferred(0))
+      ++libCount;
+  }
+  return libCount;
+}
+
 //-------------------------------------------------------------------------
 // Private members
 //-------------------------------------------------------------------------
@@ -123,7 +297,7 @@ bool LibraryManagerImpl::loadLibrary(const std::string &filepath) {
     if (dlwrap->OpenLibrary(libName, directory.toString())) {
       // Successfully opened, so add to map
       g_log.debug("Opened library: " + libName + ".\n");
-      OpenLibs.emplace(libName, dlwrap);
+      OpenLibs.emplace(libNameLower, dlwrap);
       return true;
     } else {
       return false;
@@ -134,5 +308,29 @@ bool LibraryManagerImpl::loadLibrary(const std::string &filepath) {
   return false;
 }
 
+/**
+ * @param filepath :: The full path to a library
+ * @return true if a library with the same name has been opened
+ */
+bool LibraryManagerImpl::isOpen(const std::string &filepath) const {
+  const std::string libName =
+      DllOpen::ConvertToLibName(Poco::Path(filepath).getFileName());
+  return OpenLibs.find(boost::algorithm::to_lower_copy(libName)) !=
+         OpenLibs.end();
+}
+
+/**
+ * Remove a library from the deferred ones and open it. Must be called with
+ * the mutex locked.
+ * @param index :: The index of the library in m_deferred
+ * @return true if the library was opened
+ */
+bool LibraryManagerImpl::openDeferred(size_t index) {
+  const std::string path = m_deferred[index].path;
+  m_deferred.erase(m_deferred.begin() + index);
+  g_log.debug() << "Opening deferred library " << path << '\n';
+  return loadLibrary(path);
+}
+
 } // namespace Kernel
 } // namespace Mantid
@@ -169,6 +169,15 @@ bool Logger::is(int level) const {
   return retVal;
 }
 
+/** Returns true if a message at the given priority would be logged, taking
+ * the level offset into account, e.g. to skip building an expensive message.
+ *  @param priority :: The priority of the message
+ *  @return true if the logger is enabled and the offset priority is set.
+ */
+bool Logger::wouldLog(Logger::Priority priority) const {
+  return m_enabled && is(applyLevelOffset(priority));
+}
+
 void Logger::setLevel(int level) {
   try {
     m_log->setLevel(level);
@@ -362,7 +371,8 @@ std::ostream &Logger::getLogStream(Logger::Priority priority) {
  * @param proposedLevel :: The proposed level
  * @returns The offseted level
  */
-Logger::Priority Logger::applyLevelOffset(Logger::Priority proposedLevel) {
+Logger::Priority
+Logger::applyLevelOffset(Logger::Priority proposedLevel) const {
   int retVal = proposedLevel;
   // fast exit is offset is 0
   if (m_levelOffset == 0) {
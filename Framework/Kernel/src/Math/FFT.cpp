@@ -0,0 +1,197 @@
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include "MantidKernel/Math/FFT.h"
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_real.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace Mantid {
+namespace Kernel {
+namespace FFT {
+
+namespace {
+/// Maximum number of cached wavetables of each type. Programs transforming
+/// arrays of many different lengths start again with an empty cache when it
+/// is full.
+const size_t MAX_CACHED_WAVETABLES = 64;
+
+/// A cache of the wavetables of one transform type, indexed by length
+template <typename Wavetable> class WavetableCache {
+public:
+  typedef Wavetable *(*Allocator)(size_t);
+  typedef void (*Deleter)(Wavetable *);
+
+  WavetableCache(Allocator alloc, Deleter free) : m_alloc(alloc), m_free(free) {}
+
+  /// Get the wavetable for arrays of length n, creating it if needed.
+  /// The returned pointer keeps the table alive after the cache is cleared.
+  std::shared_ptr<const Wavetable> get(size_t n) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_tables.find(n);
+    if (it != m_tables.end()) {
+      return it->second;
+    }
+    if (m_tables.size() >= MAX_CACHED_WAVETABLES) {
+      m_tables.clear();
+    }
+    std::shared_ptr<const Wavetable> table(m_alloc(n), m_free);
+    if (!table) {
+      throw std::runtime_error("Failed to allocate an FFT wavetable of size " +
+                               std::to_string(n));
+    }
+    m_tables.emplace(n, table);
+    return table;
+  }
+
+  size_t size() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tables.size();
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tables.clear();
+  }
+
+private:
+  Allocator m_alloc;
+  Deleter m_free;
+  std::mutex m_mutex;
+  std::map<size_t, std::shared_ptr<const Wavetable>> m_tables;
+};
+
+WavetableCache<gsl_fft_complex_wavetable> &complexTables() {
+  static WavetableCache<gsl_fft_complex_wavetable> cache(
+      gsl_fft_complex_wavetable_alloc, gsl_fft_complex_wavetable_free);
+  return cache;
+}
+
+WavetableCache<gsl_fft_real_wavetable> &realTables() {
+  static WavetableCache<gsl_fft_real_wavetable> cache(
+      gsl_fft_real_wavetable_alloc, gsl_fft_real_wavetable_free);
+  return cache;
+}
+
+WavetableCache<gsl_fft_halfcomplex_wavetable> &halfComplexTables() {
+  static WavetableCache<gsl_fft_halfcomplex_wavetable> cache(
+      gsl_fft_halfcomplex_wavetable_alloc, gsl_fft_halfcomplex_wavetable_free);
+  return cache;
+}
+
+/// Scratch space of a complex transform
+struct ComplexWorkspace {
+  explicit ComplexWorkspace(size_t n)
+      : workspace(gsl_fft_complex_workspace_alloc(n)) {
+    if (!workspace) {
+      throw std::runtime_error("Failed to allocate an FFT workspace.");
+    }
+  }
+  ~ComplexWorkspace() { gsl_fft_complex_workspace_free(workspace); }
+  gsl_fft_complex_workspace *workspace;
+};
+
+/// Scratch space of a real or half-complex transform
+struct RealWorkspace {
+  explicit RealWorkspace(size_t n)
+      : workspace(gsl_fft_real_workspace_alloc(n)) {
+    if (!workspace) {
+      throw std::runtime_error("Failed to allocate an FFT workspace.");
+    }
+  }
+  ~RealWorkspace() { gsl_fft_real_workspace_free(workspace); }
+  gsl_fft_real_workspace *workspace;
+};
+
+void checkStatus(int status) {
+  if (status != GSL_SUCCESS) {
+    throw std::runtime_error(std::string("FFT failed: ") +
+                             gsl_strerror(status));
+  }
+}
+} // namespace
+
+/**
+ * @param data :: 2*n doubles: the real and imaginary parts of n values.
+ * @param n :: The number of complex values.
+ */
+void complexForward(double *data, size_t n) {
+  auto table = complexTables().get(n);
+  ComplexWorkspace ws(n);
+  checkStatus(gsl_fft_complex_forward(data, 1, n, table.get(), ws.workspace));
+}
+
+/**
+ * @param data :: 2*n doubles: the real and imaginary parts of n values.
+ * @param n :: The number of complex values.
+ */
+void complexBackward(double *data, size_t n) {
+  auto table = complexTables().get(n);
+  ComplexWorkspace ws(n);
+  checkStatus(gsl_fft_complex_backward(data, 1, n, table.get(), ws.workspace));
+}
+
+/**
+ * @param data :: 2*n doubles: the real and imaginary parts of n values.
+ * @param n :: The number of complex values.
+ */
+void complexInverse(double *data, size_t n) {
+  auto table = complexTables().get(n);
+  ComplexWorkspace ws(n);
+  checkStatus(gsl_fft_complex_inverse(data, 1, n, table.get(), ws.workspace));
+}
+
+/**
+ * @param data :: n real values, replaced with their transform.
+ * @param n :: The number of values.
+ */
+void realForward(double *data, size_t n) {
+  auto table = realTables().get(n);
+  RealWorkspace ws(n);
+  checkStatus(gsl_fft_real_transform(data, 1, n, table.get(), ws.workspace));
+}
+
+/**
+ * @param data :: A transform of n values in half-complex storage.
+ * @param n :: The number of values.
+ */
+void halfComplexBackward(double *data, size_t n) {
+  auto table = halfComplexTables().get(n);
+  RealWorkspace ws(n);
+  checkStatus(
+      gsl_fft_halfcomplex_backward(data, 1, n, table.get(), ws.workspace));
+}
+
+/**
+ * @param data :: A transform of n values in half-complex storage.
+ * @param n :: The number of values.
+ */
+void halfComplexInverse(double *data, size_t n) {
+  auto table = halfComplexTables().get(n);
+  RealWorkspace ws(n);
+  checkStatus(
+      gsl_fft_halfcomplex_inverse(data, 1, n, table.get(), ws.workspace));
+}
+
+size_t cachedWavetables() {
+  return complexTables().size() + realTables().size() +
+         halfComplexTables().size();
+}
+
+void clearWavetableCache() {
+  complexTables().clear();
+  realTables().clear();
+  halfComplexTables().clear();
+}
+
+} // namespace FFT
+} // namespace Kernel
+} // namespace Mantid
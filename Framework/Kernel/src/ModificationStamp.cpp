@@ -0,0 +1,32 @@
+#include "MantidKernel/ModificationStamp.h"
+
+#include <atomic>
+
+namespace Mantid {
+namespace Kernel {
+namespace {
+/// The last value handed out. 0 is never a stamp.
+std::atomic<uint64_t> g_counter{0};
+} // namespace
+
+/// @return A value larger than any returned before
+uint64_t ModificationStamp::next() {
+  return g_counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+/// Give a modified stamp its final value. It keeps that value until the next
+/// update().
+/// @return true if the stamp was modified since it was last settled
+bool ModificationStamp::settle() {
+  uint64_t current = m_value.load(std::memory_order_relaxed);
+  if ((current & MODIFIED) == 0)
+    return false;
+  while ((current & MODIFIED) != 0 &&
+         !m_value.compare_exchange_weak(current, next(),
+                                        std::memory_order_relaxed)) {
+  }
+  return true;
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -0,0 +1,203 @@
+#include "MantidKernel/PluginManifest.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Logger.h"
+
+#include <Poco/Exception.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Process.h>
+
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+namespace {
+/// static logger
+Logger g_log("PluginManifest");
+
+/// Normalise a directory so that different spellings of it compare equal
+std::string absoluteDirectory(const std::string &directory) {
+  Poco::Path path(directory);
+  path.makeDirectory();
+  path.makeAbsolute();
+  return path.toString();
+}
+
+/// Split a line of the manifest into its tab-separated fields
+std::vector<std::string> splitFields(const std::string &line) {
+  std::vector<std::string> fields;
+  std::istringstream stream(line);
+  std::string field;
+  while (std::getline(stream, field, '\t')) {
+    fields.push_back(field);
+  }
+  return fields;
+}
+} // namespace
+
+/**
+ * Create an empty manifest.
+ * @param directory :: The directory of the libraries
+ */
+PluginManifest::PluginManifest(const std::string &directory)
+    : m_directory(absoluteDirectory(directory)) {}
+
+/**
+ * Read a manifest from a file, replacing the contents of this one.
+ * @param filename :: The file to read
+ * @return false if the file doesn't exist or cannot be parsed. The manifest
+ * is then empty.
+ */
+bool PluginManifest::load(const std::string &filename) {
+  m_directory.clear();
+  m_libraries.clear();
+  std::ifstream file(filename.c_str());
+  if (!file) {
+    return false;
+  }
+
+  Library *library = nullptr;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    const auto fields = splitFields(line);
+    bool valid = false;
+    if (fields[0] == "directory" && fields.size() == 2) {
+      m_directory = fields[1];
+      valid = true;
+    } else if (fields[0] == "library" && fields.size() == 4) {
+      std::istringstream size(fields[2]), modified(fields[3]);
+      Library entry;
+      valid = static_cast<bool>(size >> entry.size) &&
+              static_cast<bool>(modified >> entry.modified);
+      library = &(m_libraries[fields[1]] = entry);
+    } else if (fields[0] == "provides" && fields.size() == 3 && library) {
+      library->provided.emplace(fields[1], fields[2]);
+      valid = true;
+    }
+    if (!valid) {
+      g_log.warning() << "Ignoring the invalid plugin manifest " << filename
+                      << '\n';
+      m_directory.clear();
+      m_libraries.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Write the manifest to a file. The manifest is written to a temporary file
+ * next to it first, which then replaces the file, so that other processes
+ * never read a partly written manifest.
+ * @param filename :: The file to write
+ * @throws std::runtime_error if the file cannot be written
+ */
+void PluginManifest::save(const std::string &filename) const {
+  const std::string tempName =
+      filename + "." + std::to_string(Poco::Process::id()) + ".tmp";
+  bool written = false;
+  std::ofstream file(tempName.c_str());
+  if (file) {
+    file << "# Generated by Mantid. What the plugin libraries register.\n";
+    file << "directory\t" << m_directory << '\n';
+    for (const auto &library : m_libraries) {
+      file << "library\t" << library.first << '\t' << library.second.size
+           << '\t' << library.second.modified << '\n';
+      for (const auto &item : library.second.provided) {
+        file << "provides\t" << item.first << '\t' << item.second << '\n';
+      }
+    }
+    file.close();
+    written = static_cast<bool>(file);
+  }
+  if (written) {
+    try {
+      Poco::File(tempName).renameTo(filename);
+      return;
+    } catch (Poco::Exception &) {
+    }
+  }
+  try {
+    Poco::File(tempName).remove();
+  } catch (Poco::Exception &) {
+  }
+  throw std::runtime_error("Cannot write the plugin manifest " + filename);
+}
+
+/**
+ * Record a library, replacing any previous record of it.
+ * @param path :: The path to the library file
+ * @param provided :: What the library registers
+ */
+void PluginManifest::addLibrary(const std::string &path,
+                                const Provided &provided) {
+  Poco::File file(path);
+  Library library;
+  library.size = static_cast<uint64_t>(file.getSize());
+  library.modified = file.getLastModified().epochMicroseconds();
+  library.provided = provided;
+  m_libraries[Poco::Path(path).getFileName()] = library;
+}
+
+/**
+ * Remove a library if it is recorded.
+ * @param fileName :: The file name of the library
+ */
+void PluginManifest::removeLibrary(const std::string &fileName) {
+  m_libraries.erase(fileName);
+}
+
+/**
+ * @param path :: The path to a library file
+ * @return true if the library is recorded with the size and modification
+ * time of its file
+ */
+bool PluginManifest::isCurrent(const std::string &path) const {
+  auto library = m_libraries.find(Poco::Path(path).getFileName());
+  if (library == m_libraries.end()) {
+    return false;
+  }
+  try {
+    Poco::File file(path);
+    return static_cast<uint64_t>(file.getSize()) == library->second.size &&
+           file.getLastModified().epochMicroseconds() ==
+               library->second.modified;
+  } catch (Poco::Exception &) {
+    return false;
+  }
+}
+
+/**
+ * @param fileName :: The file name of a library
+ * @return What the library provides, or null if it isn't recorded
+ */
+const PluginManifest::Provided *
+PluginManifest::provided(const std::string &fileName) const {
+  auto library = m_libraries.find(fileName);
+  return library == m_libraries.end() ? nullptr : &library->second.provided;
+}
+
+/**
+ * The manifest of a directory is kept in the user properties directory, in a
+ * file named after a hash of the directory so that several installations can
+ * keep their manifests side by side.
+ * @param directory :: The directory of the libraries
+ * @return The path of the manifest file
+ */
+std::string PluginManifest::defaultFilename(const std::string &directory) {
+  std::ostringstream name;
+  name << "plugins-" << std::hex
+       << std::hash<std::string>()(absoluteDirectory(directory))
+       << ".manifest";
+  return ConfigService::Instance().getUserPropertiesDir() + name.str();
+}
+
+} // namespace Kernel
+} // namespace Mantid
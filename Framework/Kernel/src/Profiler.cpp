@@ -0,0 +1,281 @@
+#include "MantidKernel/Profiler.h"
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/Memory.h"
+
+#include <json/json.h>
+
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <Psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace Mantid {
+namespace Kernel {
+namespace {
+/// The last number given to a thread
+std::atomic<size_t> g_lastThread{0};
+/// The innermost span open on this thread
+thread_local uint64_t g_currentSpan = 0;
+
+/// @return A small number identifying the calling thread
+size_t threadNumber() {
+  thread_local const size_t number = ++g_lastThread;
+  return number;
+}
+
+#ifndef _WIN32
+/// @return A MemoryStats to read the resident set size with
+const MemoryStats &memoryStats() {
+  static const MemoryStats stats(MEMORY_STATS_IGNORE_SYSTEM);
+  return stats;
+}
+
+/// @return The value of a timeval in seconds
+double toSeconds(const timeval &time) {
+  return static_cast<double>(time.tv_sec) +
+         1e-6 * static_cast<double>(time.tv_usec);
+}
+#endif
+
+/// @return The difference of two unsigned values, or 0 if it is negative
+uint64_t increase(uint64_t before, uint64_t after) {
+  return after > before ? after - before : 0;
+}
+} // namespace
+
+/**
+ * Start recording a span if recording is enabled.
+ * @param name :: What is running
+ * @param category :: The kind of span, e.g. "algorithm"
+ */
+ProfilerImpl::Scope::Scope(const std::string &name, const char *category)
+    : m_active(Profiler::Instance().isEnabled()) {
+  if (!m_active)
+    return;
+  auto &profiler = Profiler::Instance();
+  m_span.name = name;
+  m_span.category = category;
+  m_span.id = ++profiler.m_lastId;
+  m_span.parent = g_currentSpan;
+  m_span.thread = threadNumber();
+  m_previous = g_currentSpan;
+  g_currentSpan = m_span.id;
+  m_start = sample();
+  m_span.start = profiler.elapsed();
+  m_startTime = std::chrono::steady_clock::now();
+}
+
+/// Finish the span and record it
+ProfilerImpl::Scope::~Scope() {
+  if (!m_active)
+    return;
+  const auto endTime = std::chrono::steady_clock::now();
+  const Sample end = sample();
+  m_span.wallTime =
+      std::chrono::duration<double>(endTime - m_startTime).count();
+  m_span.cpuTime = end.cpuTime - m_start.cpuTime;
+  m_span.rssDelta =
+      static_cast<int64_t>(end.rss) - static_cast<int64_t>(m_start.rss);
+  m_span.peakRssIncrease = increase(m_start.peakRss, end.peakRss);
+  m_span.bytesRead = increase(m_start.bytesRead, end.bytesRead);
+  m_span.bytesWritten = increase(m_start.bytesWritten, end.bytesWritten);
+  g_currentSpan = m_previous;
+  Profiler::Instance().record(m_span);
+}
+
+/**
+ * Record how many threads ran in the span and how long they were busy.
+ * @param threads :: The number of threads
+ * @param busyTime :: The total time the threads spent running tasks, in
+ * seconds
+ */
+void ProfilerImpl::Scope::setThreadUsage(size_t threads, double busyTime) {
+  m_span.threads = threads;
+  m_span.busyTime = busyTime;
+}
+
+/// @param parent :: The id of the span the spans on this thread belong to
+ProfilerImpl::ParentScope::ParentScope(uint64_t parent)
+    : m_previous(g_currentSpan) {
+  g_currentSpan = parent;
+}
+
+/// Restore the enclosing span of this thread
+ProfilerImpl::ParentScope::~ParentScope() { g_currentSpan = m_previous; }
+
+/// Constructor. Reads the profiling.* properties.
+ProfilerImpl::ProfilerImpl()
+    : m_enabled(false), m_lastId(0),
+      m_epoch(std::chrono::steady_clock::now().time_since_epoch().count()) {
+  int enabled = 0;
+  auto &config = ConfigService::Instance();
+  config.getValue("profiling.enabled", enabled);
+  m_enabled = enabled != 0;
+  m_filename = config.getString("profiling.file");
+}
+
+/// Destructor. Saves the trace if the profiling.file property is set.
+ProfilerImpl::~ProfilerImpl() {
+  if (m_filename.empty() || m_spans.empty())
+    return;
+  try {
+    saveChromeTrace(m_filename);
+  } catch (std::exception &) {
+    // Nothing can be reported this late
+  }
+}
+
+/// @param enabled :: true to record spans
+void ProfilerImpl::setEnabled(bool enabled) { m_enabled = enabled; }
+
+/// Remove the recorded spans and restart the clock the start times are
+/// measured from
+void ProfilerImpl::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_spans.clear();
+  m_epoch = std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+/// @return The recorded spans, in the order they finished
+std::vector<ProfilerImpl::Span> ProfilerImpl::spans() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_spans;
+}
+
+/**
+ * Describe the recorded spans in the Chrome trace event format. Every span is
+ * a complete event on the thread it started on, and its measurements are the
+ * arguments of the event.
+ * @return The trace as a JSON string
+ */
+std::string ProfilerImpl::toChromeTrace() const {
+  ::Json::Value events(::Json::arrayValue);
+  for (const auto &span : spans()) {
+    ::Json::Value event;
+    event["name"] = span.name;
+    event["cat"] = span.category;
+    event["ph"] = "X";
+    event["ts"] = span.start * 1e6;
+    event["dur"] = span.wallTime * 1e6;
+    event["pid"] = 1;
+    event["tid"] = static_cast<::Json::UInt64>(span.thread);
+    ::Json::Value args;
+    args["id"] = static_cast<::Json::UInt64>(span.id);
+    args["parent"] = static_cast<::Json::UInt64>(span.parent);
+    args["cpuTime"] = span.cpuTime;
+    args["rssDelta"] = static_cast<::Json::Int64>(span.rssDelta);
+    args["peakRssIncrease"] = static_cast<::Json::UInt64>(span.peakRssIncrease);
+    args["bytesRead"] = static_cast<::Json::UInt64>(span.bytesRead);
+    args["bytesWritten"] = static_cast<::Json::UInt64>(span.bytesWritten);
+    if (span.threads > 0) {
+      args["threads"] = static_cast<::Json::UInt64>(span.threads);
+      args["busyTime"] = span.busyTime;
+      if (span.wallTime > 0.0)
+        args["utilisation"] =
+            span.busyTime / (static_cast<double>(span.threads) * span.wallTime);
+    }
+    event["args"] = args;
+    events.append(event);
+  }
+  ::Json::Value trace;
+  trace["traceEvents"] = events;
+  trace["displayTimeUnit"] = "ms";
+  ::Json::FastWriter writer;
+  return writer.write(trace);
+}
+
+/**
+ * Save the recorded spans in the Chrome trace event format.
+ * @param filename :: The file to write
+ * @throws std::runtime_error if the file cannot be written
+ */
+void ProfilerImpl::saveChromeTrace(const std::string &filename) const {
+  std::ofstream file(filename.c_str());
+  if (!file)
+    throw std::runtime_error("Cannot open " + filename + " for writing");
+  file << toChromeTrace();
+}
+
+/// @return The id of the innermost span open on the calling thread, or 0
+uint64_t ProfilerImpl::currentSpan() { return g_currentSpan; }
+
+/**
+ * Measure the resources used by the process so far. Fields the operating
+ * system doesn't provide are 0.
+ * @return The measurements
+ */
+ProfilerImpl::Sample ProfilerImpl::sample() {
+  Sample sample;
+#ifdef _WIN32
+  const HANDLE process = GetCurrentProcess();
+  FILETIME creation, exit, kernel, user;
+  if (GetProcessTimes(process, &creation, &exit, &kernel, &user)) {
+    auto toSeconds = [](const FILETIME &time) {
+      ULARGE_INTEGER value;
+      value.LowPart = time.dwLowDateTime;
+      value.HighPart = time.dwHighDateTime;
+      // FILETIMEs count 100 ns intervals
+      return 1e-7 * static_cast<double>(value.QuadPart);
+    };
+    sample.cpuTime = toSeconds(kernel) + toSeconds(user);
+  }
+  PROCESS_MEMORY_COUNTERS memory;
+  if (GetProcessMemoryInfo(process, &memory, sizeof(memory))) {
+    sample.rss = memory.WorkingSetSize;
+    sample.peakRss = memory.PeakWorkingSetSize;
+  }
+  IO_COUNTERS io;
+  if (GetProcessIoCounters(process, &io)) {
+    sample.bytesRead = io.ReadTransferCount;
+    sample.bytesWritten = io.WriteTransferCount;
+  }
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    sample.cpuTime = toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+#if defined(__APPLE__) && defined(__MACH__)
+    sample.peakRss = static_cast<uint64_t>(usage.ru_maxrss);
+#else
+    sample.peakRss = static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+  }
+  sample.rss = memoryStats().getCurrentRSS();
+#ifdef __linux__
+  // Counts all reads and writes, including those served by the page cache
+  std::ifstream io("/proc/self/io");
+  std::string key;
+  uint64_t value;
+  while (io >> key >> value) {
+    if (key == "rchar:")
+      sample.bytesRead = value;
+    else if (key == "wchar:")
+      sample.bytesWritten = value;
+  }
+#endif
+#endif
+  return sample;
+}
+
+/// @return The seconds since the profiler was created or cleared
+double ProfilerImpl::elapsed() const {
+  const std::chrono::steady_clock::duration sinceEpoch(m_epoch.load());
+  const std::chrono::steady_clock::time_point epoch(sinceEpoch);
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       epoch).count();
+}
+
+/// Add a finished span if recording is still enabled
+void ProfilerImpl::record(const Span &span) {
+  if (!isEnabled())
+    return;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_spans.push_back(span);
+}
+
+} // namespace Kernel
+} // namespace Mantid
@@ -3,6 +3,7 @@
 //----------------------------------------------------------------------
 #include "MantidKernel/ThreadPool.h"
 #include "MantidKernel/ConfigService.h"
+#include "MantidKernel/make_unique.h"
 #include <sstream>
 #include <Poco/Environment.h>
 
@@ -24,7 +25,7 @@ namespace Kernel {
  */
 ThreadPool::ThreadPool(ThreadScheduler *scheduler, size_t numThreads,
                        ProgressBase *prog)
-    : m_scheduler(scheduler), m_started(false), m_prog(prog) {
+    : m_scheduler(scheduler), m_started(false), m_prog(prog), m_busyTime(0) {
   if (!m_scheduler)
     throw std::invalid_argument(
         "NULL ThreadScheduler passed to ThreadPool constructor.");
@@ -83,6 +84,15 @@ void ThreadPool::start(double waitSec) {
   for (auto &runnable : m_runnables)
     delete runnable;
 
+  // Record the pool until joinAll() when profiling
+  if (!m_profile && Profiler::Instance().isEnabled()) {
+    m_profile = Kernel::make_unique<ProfilerImpl::Scope>("ThreadPool",
+                                                        "threadpool");
+    m_busyTime = 0;
+  }
+  const uint64_t parentSpan = m_profile ? m_profile->id() : 0;
+  std::atomic<uint64_t> *busyTime = m_profile ? &m_busyTime : nullptr;
+
   // Now, launch that many threads and let them wait for new tasks.
   m_threads.clear();
   m_runnables.clear();
@@ -95,7 +105,8 @@ void ThreadPool::start(double waitSec) {
     m_threads.push_back(thread);
 
     // Make the runnable object and run it
-    auto runnable = new ThreadPoolRunnable(i, m_scheduler, m_prog, waitSec);
+    auto runnable = new ThreadPoolRunnable(i, m_scheduler, m_prog, waitSec,
+                                           parentSpan, busyTime);
     m_runnables.push_back(runnable);
 
     thread->start(*runnable);
@@ -172,6 +183,12 @@ void ThreadPool::joinAll() {
   // This will make threads restart
   m_started = false;
 
+  if (m_profile) {
+    m_profile->setThreadUsage(m_numThreads,
+                              1e-6 * static_cast<double>(m_busyTime.load()));
+    m_profile.reset();
+  }
+
   // Did one of the threads abort or throw an exception?
   if (m_scheduler->getAborted()) {
     // Re-raise the error
@@ -1,4 +1,7 @@
 #include "MantidKernel/ThreadPoolRunnable.h"
+#include "MantidKernel/Profiler.h"
+
+#include <chrono>
 
 namespace Mantid {
 namespace Kernel {
@@ -13,12 +16,18 @@ namespace Kernel {
  *        automatic progress reporting will be handled by the thread pool.
  * @param waitSec :: how many seconds the thread is allowed to wait with no
  *tasks.
+ * @param parentSpan :: the profiler span of the thread pool, or 0 if it is
+ *not profiled.
+ * @param busyTime :: optional counter to add the microseconds spent running
+ *tasks to.
  */
 ThreadPoolRunnable::ThreadPoolRunnable(size_t threadnum,
                                        ThreadScheduler *scheduler,
-                                       ProgressBase *prog, double waitSec)
+                                       ProgressBase *prog, double waitSec,
+                                       uint64_t parentSpan,
+                                       std::atomic<uint64_t> *busyTime)
     : m_threadnum(threadnum), m_scheduler(scheduler), m_prog(prog),
-      m_waitSec(waitSec) {
+      m_waitSec(waitSec), m_parentSpan(parentSpan), m_busyTime(busyTime) {
   if (!m_scheduler)
     throw std::invalid_argument(
         "NULL ThreadScheduler passed to ThreadPoolRunnable::ctor()");
@@ -33,6 +42,8 @@ void ThreadPoolRunnable::clearWait() { m_waitSec = 0.0; }
  * as scheduled to it.
  */
 void ThreadPoolRunnable::run() {
+  // Spans recorded by the tasks belong to the thread pool
+  ProfilerImpl::ParentScope parentSpan(m_parentSpan);
   Task *task;
 
   // If there are no tasks yet, wait up to m_waitSec for them to come up
@@ -54,7 +65,14 @@ void ThreadPoolRunnable::run() {
 
       try {
         // Run the task (synchronously within this thread)
-        task->run();
+        if (m_busyTime) {
+          const auto start = std::chrono::steady_clock::now();
+          task->run();
+          *m_busyTime += std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - start).count();
+        } else {
+          task->run();
+        }
       } catch (std::exception &e) {
         // The task threw an exception!
         // This will clear out the list of tasks, allowing all threads to
@@ -7,6 +7,7 @@
 #include <Poco/NObserver.h>
 #include <boost/make_shared.hpp>
 #include <mutex>
+#include <thread>
 
 using namespace Mantid;
 using namespace Mantid::Kernel;
@@ -25,6 +26,7 @@ private:
   int notificationFlag; // A flag to help with testing notifications
   std::vector<int> vector;
   std::mutex m_vectorMutex;
+  bool m_targetReplaced; // Set once the target of a rename is replaced
 
 public:
   static DataServiceTest *createSuite() { return new DataServiceTest(); }
@@ -129,6 +131,91 @@ public:
                      std::runtime_error);
   }
 
+  void test_addObjects() {
+    Poco::NObserver<DataServiceTest, FakeDataService::AddNotification> observer(
+        *this, &DataServiceTest::handleAddNotification);
+    svc.notificationCenter.addObserver(observer);
+
+    auto one = boost::make_shared<int>(1);
+    auto two = boost::make_shared<int>(2);
+    TS_ASSERT_THROWS_NOTHING(svc.addObjects({{"one", one}, {"two", two}}));
+    TS_ASSERT_EQUALS(svc.size(), 2);
+    TS_ASSERT_EQUALS(svc.retrieve("one"), one);
+    TS_ASSERT_EQUALS(svc.retrieve("Two"), two);
+    TS_ASSERT_EQUALS(notificationFlag, 2);
+
+    // Nothing is added if one of the objects can't be
+    TS_ASSERT_THROWS(svc.addObjects({{"three", one}, {"ONE", two}}),
+                     std::runtime_error);
+    TS_ASSERT_THROWS(svc.addObjects({{"three", one}, {"Three", two}}),
+                     std::runtime_error);
+    TS_ASSERT_THROWS(svc.addObjects({{"three", one}, {"", two}}),
+                     std::runtime_error);
+    TS_ASSERT_THROWS(
+        svc.addObjects({{"three", one}, {"null", boost::shared_ptr<int>()}}),
+        std::runtime_error);
+    TS_ASSERT(!svc.doesExist("three"));
+    TS_ASSERT_EQUALS(svc.size(), 2);
+    TS_ASSERT_EQUALS(notificationFlag, 2);
+    svc.notificationCenter.removeObserver(observer);
+  }
+
+  void test_removeObjects() {
+    Poco::NObserver<DataServiceTest, FakeDataService::PreDeleteNotification>
+        observer(*this, &DataServiceTest::handlePreDeleteNotification);
+    svc.notificationCenter.addObserver(observer);
+    Poco::NObserver<DataServiceTest, FakeDataService::PostDeleteNotification>
+        postobserver(*this, &DataServiceTest::handlePostDeleteNotification);
+    svc.notificationCenter.addObserver(postobserver);
+    svc.add("one", boost::make_shared<int>(1));
+    svc.add("two", boost::make_shared<int>(2));
+
+    // Names that aren't there are skipped
+    TS_ASSERT_THROWS_NOTHING(svc.removeObjects({"one", "three"}));
+    TS_ASSERT_EQUALS(svc.size(), 1);
+    TS_ASSERT(svc.doesExist("two"));
+    TS_ASSERT_EQUALS(notificationFlag, 2);
+    svc.notificationCenter.removeObserver(observer);
+    svc.notificationCenter.removeObserver(postobserver);
+  }
+
+  void test_NotificationBatch_sends_notifications_when_it_ends() {
+    Poco::NObserver<DataServiceTest, FakeDataService::AddNotification> observer(
+        *this, &DataServiceTest::handleAddNotification);
+    svc.notificationCenter.addObserver(observer);
+    {
+      FakeDataService::NotificationBatch batch(svc);
+      svc.add("one", boost::make_shared<int>(1));
+      {
+        FakeDataService::NotificationBatch nested(svc);
+        svc.add("two", boost::make_shared<int>(2));
+      }
+      TS_ASSERT_EQUALS(notificationFlag, 0);
+      // The objects are there before the observers are told
+      TS_ASSERT_EQUALS(svc.size(), 2);
+    }
+    TS_ASSERT_EQUALS(notificationFlag, 2);
+
+    // Other threads aren't affected by the batch
+    {
+      FakeDataService::NotificationBatch batch(svc);
+      std::thread other(
+          [this] { svc.add("three", boost::make_shared<int>(3)); });
+      other.join();
+      TS_ASSERT_EQUALS(notificationFlag, 3);
+    }
+    svc.notificationCenter.removeObserver(observer);
+  }
+
+  void test_rename_changing_only_the_case() {
+    auto one = boost::make_shared<int>(1);
+    svc.add("one", one);
+    TS_ASSERT_THROWS_NOTHING(svc.rename("one", "One"));
+    TS_ASSERT_EQUALS(svc.size(), 1);
+    TS_ASSERT_EQUALS(svc.retrieve("one"), one);
+    TS_ASSERT_EQUALS(svc.getObjectNames(), std::vector<std::string>(1, "One"));
+  }
+
   void handleBeforeReplaceNotification(
       const Poco::AutoPtr<FakeDataService::BeforeReplaceNotification> &) {
     ++notificationFlag;
@@ -192,6 +279,82 @@ public:
                               svc.retrieve("anotherOne"));
   }
 
+  void handleBeforeReplaceRemovingOne(
+      const Poco::AutoPtr<FakeDataService::BeforeReplaceNotification> &) {
+    // Stands in for another thread removing the object being renamed
+    svc.remove("one");
+    ++notificationFlag;
+  }
+
+  void handleAfterReplaceNotification(
+      const Poco::AutoPtr<FakeDataService::AfterReplaceNotification> &nf) {
+    TS_ASSERT_EQUALS(*nf->object(), 2);
+    ++notificationFlag;
+  }
+
+  void test_rename_of_an_object_removed_meanwhile_closes_the_replace() {
+    Poco::NObserver<DataServiceTest, FakeDataService::BeforeReplaceNotification>
+        observer(*this, &DataServiceTest::handleBeforeReplaceRemovingOne);
+    svc.notificationCenter.addObserver(observer);
+    Poco::NObserver<DataServiceTest, FakeDataService::AfterReplaceNotification>
+        observer2(*this, &DataServiceTest::handleAfterReplaceNotification);
+    svc.notificationCenter.addObserver(observer2);
+    Poco::NObserver<DataServiceTest, FakeDataService::RenameNotification>
+        observer3(*this, &DataServiceTest::handleRenameNotification);
+    svc.notificationCenter.addObserver(observer3);
+
+    auto two = boost::make_shared<int>(2);
+    svc.add("one", boost::make_shared<int>(1));
+    svc.add("two", two);
+    TS_ASSERT_THROWS_NOTHING(svc.rename("one", "two"));
+    TSM_ASSERT_EQUALS("Only the replace notifications should have been sent",
+                      notificationFlag, 2);
+    TS_ASSERT_EQUALS(svc.size(), 1);
+    TS_ASSERT_EQUALS(svc.retrieve("two"), two);
+
+    svc.notificationCenter.removeObserver(observer);
+    svc.notificationCenter.removeObserver(observer2);
+    svc.notificationCenter.removeObserver(observer3);
+  }
+
+  void handleBeforeReplaceReplacingTwo(
+      const Poco::AutoPtr<FakeDataService::BeforeReplaceNotification> &) {
+    ++notificationFlag;
+    // Stands in for another thread replacing the target of the rename once
+    if (!m_targetReplaced) {
+      m_targetReplaced = true;
+      svc.addOrReplace("two", boost::make_shared<int>(3));
+    }
+  }
+
+  void handleAfterReplaceCounting(
+      const Poco::AutoPtr<FakeDataService::AfterReplaceNotification> &) {
+    --notificationFlag;
+  }
+
+  void test_rename_over_a_target_replaced_meanwhile_notifies_the_replace() {
+    m_targetReplaced = false;
+    Poco::NObserver<DataServiceTest, FakeDataService::BeforeReplaceNotification>
+        observer(*this, &DataServiceTest::handleBeforeReplaceReplacingTwo);
+    svc.notificationCenter.addObserver(observer);
+    Poco::NObserver<DataServiceTest, FakeDataService::AfterReplaceNotification>
+        observer2(*this, &DataServiceTest::handleAfterReplaceCounting);
+    svc.notificationCenter.addObserver(observer2);
+
+    auto one = boost::make_shared<int>(1);
+    svc.add("one", one);
+    svc.add("two", boost::make_shared<int>(2));
+    TS_ASSERT_THROWS_NOTHING(svc.rename("one", "two"));
+    TS_ASSERT(m_targetReplaced);
+    TSM_ASSERT_EQUALS("Every BeforeReplace should be followed by an AfterReplace",
+                      notificationFlag, 0);
+    TS_ASSERT_EQUALS(svc.size(), 1);
+    TS_ASSERT_EQUALS(svc.retrieve("two"), one);
+
+    svc.notificationCenter.removeObserver(observer);
+    svc.notificationCenter.removeObserver(observer2);
+  }
+
   void handleClearNotification(
       const Poco::AutoPtr<FakeDataService::ClearNotification> &) {
     ++notificationFlag;
@@ -0,0 +1,85 @@
+#ifndef MANTID_KERNEL_FFTTEST_H_
+#define MANTID_KERNEL_FFTTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/Math/FFT.h"
+
+#include <cmath>
+#include <vector>
+
+namespace FFT = Mantid::Kernel::FFT;
+
+class FFTTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static FFTTest *createSuite() { return new FFTTest(); }
+  static void destroySuite(FFTTest *suite) { delete suite; }
+
+  void test_complex_forward_of_delta_is_constant() {
+    const size_t n = 12;
+    std::vector<double> data(2 * n, 0.0);
+    data[0] = 1.0;
+    FFT::complexForward(data.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      TS_ASSERT_DELTA(data[2 * i], 1.0, 1e-14);
+      TS_ASSERT_DELTA(data[2 * i + 1], 0.0, 1e-14);
+    }
+  }
+
+  void test_complex_inverse_restores_data() {
+    const size_t n = 15;
+    std::vector<double> data(2 * n);
+    for (size_t i = 0; i < data.size(); ++i) {
+      data[i] = sin(0.3 * static_cast<double>(i)) + 0.1;
+    }
+    auto original = data;
+    FFT::complexForward(data.data(), n);
+    FFT::complexInverse(data.data(), n);
+    for (size_t i = 0; i < data.size(); ++i) {
+      TS_ASSERT_DELTA(data[i], original[i], 1e-13);
+    }
+    FFT::complexForward(data.data(), n);
+    FFT::complexBackward(data.data(), n);
+    for (size_t i = 0; i < data.size(); ++i) {
+      TS_ASSERT_DELTA(data[i], static_cast<double>(n) * original[i], 1e-12);
+    }
+  }
+
+  void test_real_transform_restores_data() {
+    const size_t n = 21;
+    std::vector<double> data(n);
+    for (size_t i = 0; i < n; ++i) {
+      data[i] = exp(-0.1 * static_cast<double>(i));
+    }
+    auto original = data;
+    FFT::realForward(data.data(), n);
+    // the zero frequency term is the sum of the data
+    double sum = 0.0;
+    for (auto value : original) {
+      sum += value;
+    }
+    TS_ASSERT_DELTA(data[0], sum, 1e-13);
+    FFT::halfComplexInverse(data.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      TS_ASSERT_DELTA(data[i], original[i], 1e-14);
+    }
+  }
+
+  void test_wavetables_are_cached() {
+    FFT::clearWavetableCache();
+    TS_ASSERT_EQUALS(FFT::cachedWavetables(), 0);
+    std::vector<double> data(2 * 10, 1.0);
+    FFT::complexForward(data.data(), 10);
+    FFT::complexInverse(data.data(), 10);
+    TS_ASSERT_EQUALS(FFT::cachedWavetables(), 1);
+    FFT::realForward(data.data(), 10);
+    FFT::realForward(data.data(), 8);
+    TS_ASSERT_EQUALS(FFT::cachedWavetables(), 3);
+    FFT::clearWavetableCache();
+    TS_ASSERT_EQUALS(FFT::cachedWavetables(), 0);
+  }
+};
+
+#endif /* MANTID_KERNEL_FFTTEST_H_ */
@@ -124,6 +124,20 @@ public:
     }
   }
 
+  void test_wouldLog_applies_the_level_offset() {
+    Logger logger("LoggerTestWouldLog");
+    logger.setLevel(Logger::Priority::PRIO_NOTICE);
+    TS_ASSERT(logger.wouldLog(Logger::Priority::PRIO_WARNING));
+    TS_ASSERT(!logger.wouldLog(Logger::Priority::PRIO_INFORMATION));
+    logger.setLevelOffset(-1);
+    TS_ASSERT(logger.wouldLog(Logger::Priority::PRIO_INFORMATION));
+    logger.setLevelOffset(1);
+    TS_ASSERT(!logger.wouldLog(Logger::Priority::PRIO_NOTICE));
+    logger.setLevelOffset(0);
+    logger.setEnabled(false);
+    TS_ASSERT(!logger.wouldLog(Logger::Priority::PRIO_FATAL));
+  }
+
   void test_Logging_At_High_Frequency_At_Lower_Than_Current_Level() {
     Logger logger("LoggerTestPerformance");
     logger.setLevel(Logger::Priority::PRIO_INFORMATION);
@@ -0,0 +1,85 @@
+#ifndef MANTID_KERNEL_MODIFICATIONSTAMPTEST_H_
+#define MANTID_KERNEL_MODIFICATIONSTAMPTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/ModificationStamp.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <vector>
+
+using Mantid::Kernel::ModificationStamp;
+
+class ModificationStampTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ModificationStampTest *createSuite() {
+    return new ModificationStampTest();
+  }
+  static void destroySuite(ModificationStampTest *suite) { delete suite; }
+
+  void test_new_stamps_differ() {
+    ModificationStamp first;
+    ModificationStamp second;
+    TS_ASSERT_DIFFERS(first.value(), 0);
+    TS_ASSERT_LESS_THAN(first.value(), second.value());
+  }
+
+  void test_update_increases_the_value() {
+    ModificationStamp stamp;
+    ModificationStamp other;
+    const uint64_t before = stamp.value();
+    stamp.update();
+    TS_ASSERT_LESS_THAN(before, stamp.value());
+    TS_ASSERT_LESS_THAN(other.value(), stamp.value());
+  }
+
+  void test_copy_keeps_the_value() {
+    ModificationStamp stamp;
+    ModificationStamp copy(stamp);
+    TS_ASSERT_EQUALS(copy.value(), stamp.value());
+    copy.update();
+    copy.settle();
+    TS_ASSERT_DIFFERS(copy.value(), stamp.value());
+    stamp = copy;
+    TS_ASSERT_EQUALS(copy.value(), stamp.value());
+  }
+
+  void test_value_changes_until_the_stamp_is_settled() {
+    ModificationStamp stamp;
+    stamp.update();
+    const uint64_t first = stamp.value();
+    const uint64_t second = stamp.value();
+    TS_ASSERT_LESS_THAN(first, second);
+    stamp.settle();
+    const uint64_t settled = stamp.value();
+    TS_ASSERT_LESS_THAN(second, settled);
+    TS_ASSERT_EQUALS(stamp.value(), settled);
+    stamp.settle();
+    TS_ASSERT_EQUALS(stamp.value(), settled);
+  }
+
+  void test_settle_tells_whether_the_stamp_was_modified() {
+    ModificationStamp stamp;
+    TS_ASSERT(!stamp.settle());
+    stamp.update();
+    TS_ASSERT(stamp.settle());
+    TS_ASSERT(!stamp.settle());
+  }
+
+  void test_values_are_unique_across_threads() {
+    const int n = 1000;
+    std::vector<uint64_t> values(n);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < n; ++i) {
+      values[i] = ModificationStamp::next();
+    }
+    std::sort(values.begin(), values.end());
+    TS_ASSERT(std::adjacent_find(values.begin(), values.end()) ==
+              values.end());
+  }
+};
+
+#endif /* MANTID_KERNEL_MODIFICATIONSTAMPTEST_H_ */
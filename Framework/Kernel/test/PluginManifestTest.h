@@ -0,0 +1,170 @@
+#ifndef MANTID_KERNEL_PLUGINMANIFESTTEST_H_
+#define MANTID_KERNEL_PLUGINMANIFESTTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/ConfigService.h"
+#include "MantidKernel/PluginManifest.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+#include <fstream>
+#include <vector>
+
+using Mantid::Kernel::ConfigService;
+using Mantid::Kernel::PluginManifest;
+
+class PluginManifestTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PluginManifestTest *createSuite() { return new PluginManifestTest(); }
+  static void destroySuite(PluginManifestTest *suite) { delete suite; }
+
+  void setUp() override {
+    Poco::Path directory(ConfigService::Instance().getTempDir());
+    directory.pushDirectory("PluginManifestTest");
+    m_directory = directory.toString();
+    Poco::File(m_directory).createDirectories();
+    m_library = Poco::Path(directory, "libPluginManifestTest.so").toString();
+    m_manifest = Poco::Path(directory, "test.manifest").toString();
+    writeFile(m_library, "library");
+  }
+
+  void tearDown() override { Poco::File(m_directory).remove(true); }
+
+  void test_a_new_manifest_is_empty() {
+    PluginManifest manifest(m_directory);
+    TS_ASSERT_EQUALS(manifest.size(), 0);
+    TS_ASSERT(!manifest.isCurrent(m_library));
+    TS_ASSERT(!manifest.provided("libPluginManifestTest.so"));
+  }
+
+  void test_added_library_is_current() {
+    PluginManifest manifest(m_directory);
+    manifest.addLibrary(m_library, provided());
+    TS_ASSERT_EQUALS(manifest.size(), 1);
+    TS_ASSERT(manifest.isCurrent(m_library));
+    auto result = manifest.provided("libPluginManifestTest.so");
+    TS_ASSERT(result);
+    if (result) {
+      TS_ASSERT_EQUALS(*result, provided());
+    }
+  }
+
+  void test_removed_library_is_not_current() {
+    PluginManifest manifest(m_directory);
+    manifest.addLibrary(m_library, provided());
+    manifest.removeLibrary("libPluginManifestTest.so");
+    TS_ASSERT_EQUALS(manifest.size(), 0);
+    TS_ASSERT(!manifest.isCurrent(m_library));
+  }
+
+  void test_library_that_has_changed_is_not_current() {
+    PluginManifest manifest(m_directory);
+    manifest.addLibrary(m_library, provided());
+    writeFile(m_library, "a library that has been rebuilt");
+    TS_ASSERT(!manifest.isCurrent(m_library));
+  }
+
+  void test_library_that_has_been_deleted_is_not_current() {
+    PluginManifest manifest(m_directory);
+    manifest.addLibrary(m_library, provided());
+    Poco::File(m_library).remove();
+    TS_ASSERT(!manifest.isCurrent(m_library));
+  }
+
+  void test_save_and_load_give_the_same_manifest() {
+    PluginManifest manifest(m_directory);
+    manifest.addLibrary(m_library, provided());
+    TS_ASSERT_THROWS_NOTHING(manifest.save(m_manifest));
+
+    PluginManifest loaded;
+    TS_ASSERT(loaded.load(m_manifest));
+    TS_ASSERT_EQUALS(loaded.directory(), manifest.directory());
+    TS_ASSERT_EQUALS(loaded.size(), 1);
+    TS_ASSERT(loaded.isCurrent(m_library));
+    auto result = loaded.provided("libPluginManifestTest.so");
+    TS_ASSERT(result);
+    if (result) {
+      TS_ASSERT_EQUALS(*result, provided());
+    }
+  }
+
+  void test_save_replaces_an_existing_manifest() {
+    writeFile(m_manifest, "not a manifest");
+    PluginManifest manifest(m_directory);
+    manifest.addLibrary(m_library, provided());
+    TS_ASSERT_THROWS_NOTHING(manifest.save(m_manifest));
+
+    PluginManifest loaded;
+    TS_ASSERT(loaded.load(m_manifest));
+    TS_ASSERT_EQUALS(loaded.size(), 1);
+    std::vector<std::string> files;
+    Poco::File(m_directory).list(files);
+    TS_ASSERT_EQUALS(files.size(), 2);
+  }
+
+  void test_save_throws_if_the_directory_does_not_exist() {
+    PluginManifest manifest(m_directory);
+    Poco::Path filename(m_directory);
+    filename.pushDirectory("missing");
+    filename.setFileName("test.manifest");
+    TS_ASSERT_THROWS(manifest.save(filename.toString()), std::runtime_error);
+  }
+
+  void test_load_returns_false_for_missing_file() {
+    PluginManifest manifest;
+    TS_ASSERT(!manifest.load(m_manifest));
+    TS_ASSERT_EQUALS(manifest.size(), 0);
+  }
+
+  void test_load_returns_false_for_invalid_file() {
+    PluginManifest manifest(m_directory);
+    manifest.addLibrary(m_library, provided());
+    manifest.save(m_manifest);
+    writeFile(m_manifest, "directory\t" + m_directory +
+                              "\nlibrary\tlibPluginManifestTest.so\tbig\t1\n");
+
+    PluginManifest loaded;
+    TS_ASSERT(!loaded.load(m_manifest));
+    TS_ASSERT_EQUALS(loaded.size(), 0);
+    TS_ASSERT(loaded.directory().empty());
+  }
+
+  void test_provides_line_before_library_is_invalid() {
+    writeFile(m_manifest, "provides\talgorithm\tRebin\n");
+    PluginManifest loaded;
+    TS_ASSERT(!loaded.load(m_manifest));
+  }
+
+  void test_defaultFilename_depends_on_the_directory() {
+    const std::string filename = PluginManifest::defaultFilename(m_directory);
+    TS_ASSERT_EQUALS(filename.find(
+                         ConfigService::Instance().getUserPropertiesDir()),
+                     0);
+    TS_ASSERT_EQUALS(filename, PluginManifest::defaultFilename(m_directory));
+    TS_ASSERT_DIFFERS(filename,
+                      PluginManifest::defaultFilename(m_directory + "other"));
+  }
+
+private:
+  PluginManifest::Provided provided() const {
+    return {{"algorithm", "Rebin"},
+            {"algorithm", "Rebin|1"},
+            {"function", "Gaussian"},
+            {"loader", "LoadNexus"}};
+  }
+
+  void writeFile(const std::string &filename, const std::string &contents) {
+    std::ofstream file(filename.c_str());
+    file << contents;
+  }
+
+  std::string m_directory;
+  std::string m_library;
+  std::string m_manifest;
+};
+
+#endif /* MANTID_KERNEL_PLUGINMANIFESTTEST_H_ */
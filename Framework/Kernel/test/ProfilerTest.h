@@ -0,0 +1,138 @@
+#ifndef MANTID_KERNEL_PROFILERTEST_H_
+#define MANTID_KERNEL_PROFILERTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/Profiler.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using Mantid::Kernel::FunctionTask;
+using Mantid::Kernel::Profiler;
+using Mantid::Kernel::ProfilerImpl;
+using Mantid::Kernel::ThreadPool;
+using Mantid::Kernel::ThreadSchedulerFIFO;
+
+class ProfilerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ProfilerTest *createSuite() { return new ProfilerTest(); }
+  static void destroySuite(ProfilerTest *suite) { delete suite; }
+
+  void setUp() override {
+    m_wasEnabled = Profiler::Instance().isEnabled();
+    Profiler::Instance().setEnabled(true);
+    Profiler::Instance().clear();
+  }
+
+  void tearDown() override {
+    Profiler::Instance().setEnabled(m_wasEnabled);
+    Profiler::Instance().clear();
+  }
+
+  void test_nothing_is_recorded_when_disabled() {
+    Profiler::Instance().setEnabled(false);
+    {
+      ProfilerImpl::Scope scope("test", "test");
+      TS_ASSERT(!scope.isActive());
+      TS_ASSERT_EQUALS(scope.id(), 0);
+    }
+    TS_ASSERT(Profiler::Instance().spans().empty());
+  }
+
+  void test_nested_scopes_are_children() {
+    uint64_t outerId = 0;
+    {
+      ProfilerImpl::Scope outer("outer", "test");
+      outerId = outer.id();
+      TS_ASSERT_EQUALS(ProfilerImpl::currentSpan(), outerId);
+      {
+        ProfilerImpl::Scope inner("inner", "test");
+        TS_ASSERT_EQUALS(ProfilerImpl::currentSpan(), inner.id());
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      TS_ASSERT_EQUALS(ProfilerImpl::currentSpan(), outerId);
+    }
+    TS_ASSERT_EQUALS(ProfilerImpl::currentSpan(), 0);
+
+    const auto spans = Profiler::Instance().spans();
+    TS_ASSERT_EQUALS(spans.size(), 2);
+    // Spans are recorded as they finish
+    TS_ASSERT_EQUALS(spans[0].name, "inner");
+    TS_ASSERT_EQUALS(spans[0].parent, outerId);
+    TS_ASSERT_EQUALS(spans[1].name, "outer");
+    TS_ASSERT_EQUALS(spans[1].id, outerId);
+    TS_ASSERT_EQUALS(spans[1].parent, 0);
+    TS_ASSERT_EQUALS(spans[1].category, "test");
+    TS_ASSERT_LESS_THAN_EQUALS(spans[1].start, spans[0].start);
+    TS_ASSERT_LESS_THAN_EQUALS(spans[0].wallTime, spans[1].wallTime);
+    TS_ASSERT_LESS_THAN_EQUALS(0.01, spans[0].wallTime);
+  }
+
+  void test_parent_scope_sets_the_parent_of_spans_on_a_thread() {
+    std::thread thread([] {
+      ProfilerImpl::ParentScope parent(42);
+      ProfilerImpl::Scope scope("worker", "test");
+    });
+    thread.join();
+    const auto spans = Profiler::Instance().spans();
+    TS_ASSERT_EQUALS(spans.size(), 1);
+    TS_ASSERT_EQUALS(spans[0].parent, 42);
+  }
+
+  void test_tasks_of_a_thread_pool_are_children_of_the_pool() {
+    {
+      ThreadPool pool(new ThreadSchedulerFIFO(), 2);
+      for (int i = 0; i < 4; ++i) {
+        pool.schedule(new FunctionTask([] {
+          ProfilerImpl::Scope scope("task", "test");
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }));
+      }
+      pool.joinAll();
+    }
+    const auto spans = Profiler::Instance().spans();
+    TS_ASSERT_EQUALS(spans.size(), 5);
+    const auto poolSpan = std::find_if(
+        spans.begin(), spans.end(), [](const ProfilerImpl::Span &span) {
+          return span.category == "threadpool";
+        });
+    TS_ASSERT(poolSpan != spans.end());
+    if (poolSpan == spans.end())
+      return;
+    TS_ASSERT_EQUALS(poolSpan->threads, 2);
+    TS_ASSERT_LESS_THAN_EQUALS(0.02, poolSpan->busyTime);
+    for (const auto &span : spans) {
+      if (span.name == "task")
+        TS_ASSERT_EQUALS(span.parent, poolSpan->id);
+    }
+  }
+
+  void test_toChromeTrace() {
+    { ProfilerImpl::Scope scope("Rebin v1", "algorithm"); }
+    const std::string trace = Profiler::Instance().toChromeTrace();
+    TS_ASSERT_DIFFERS(trace.find("\"traceEvents\""), std::string::npos);
+    TS_ASSERT_DIFFERS(trace.find("\"name\":\"Rebin v1\""), std::string::npos);
+    TS_ASSERT_DIFFERS(trace.find("\"ph\":\"X\""), std::string::npos);
+    TS_ASSERT_DIFFERS(trace.find("\"cpuTime\""), std::string::npos);
+  }
+
+  void test_sample_reports_resources() {
+    const auto sample = ProfilerImpl::sample();
+#if defined(__linux__) || defined(_WIN32)
+    TS_ASSERT(sample.rss > 0);
+    TS_ASSERT_LESS_THAN_EQUALS(sample.rss, sample.peakRss);
+#endif
+    TS_ASSERT_LESS_THAN_EQUALS(0.0, sample.cpuTime);
+  }
+
+private:
+  bool m_wasEnabled = false;
+};
+
+#endif /* MANTID_KERNEL_PROFILERTEST_H_ */
@@ -108,6 +108,23 @@ public:
     TS_ASSERT_EQUALS(p.last_report_counter, 6);
   }
 
+  void test_notifiesAfter_and_notifiesAt_predict_notifications() {
+    // 500 steps, default = only notify every 1 % = 5 calls
+    MyTestProgress p(0.0, 1.0, 500);
+    TS_ASSERT(p.notifiesAfter(1));
+    p.report();
+    for (int i = 0; i < 4; ++i) {
+      TS_ASSERT(!p.notifiesAfter(1));
+      p.report();
+    }
+    TS_ASSERT(p.notifiesAfter(1));
+    TS_ASSERT(p.notifiesAt(6));
+    TS_ASSERT(!p.notifiesAt(5));
+    p.last_report_counter = -1;
+    p.reportIncrement(1, "");
+    TS_ASSERT_EQUALS(p.last_report_counter, 6);
+  }
+
   void test_setNotifyStep() {
     // Make a progress reporter that will report each time, even though it is
     // less than 1 percent
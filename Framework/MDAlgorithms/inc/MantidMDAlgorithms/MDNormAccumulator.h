@@ -0,0 +1,81 @@
+#ifndef MANTID_MDALGORITHMS_MDNORMACCUMULATOR_H_
+#define MANTID_MDALGORITHMS_MDNORMACCUMULATOR_H_
+
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidKernel/System.h"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** MDNormAccumulator : Sums the contributions to an MDHistoWorkspace signal
+  made from several threads, as done by the MDNorm algorithms.
+
+  When there is enough memory each thread adds into its own copy of the
+  signal array without any locking and finalize() sums the copies into the
+  workspace. Otherwise the contributions are queued per thread and added to
+  the workspace under a single lock on each flush().
+
+  Copyright &copy; 2017 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge
+  National Laboratory & European Spallation Source
+
+  This file is part of Mantid.
+
+  Mantid is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  Mantid is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+  File change history is stored at: <https://github.com/mantidproject/mantid>
+  Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport MDNormAccumulator {
+public:
+  MDNormAccumulator(DataObjects::MDHistoWorkspace &workspace, int numThreads);
+  MDNormAccumulator(DataObjects::MDHistoWorkspace &workspace, int numThreads,
+                    bool useThreadBuffers);
+
+  /// @return true if each thread accumulates into its own signal array
+  bool usesThreadBuffers() const { return !m_threadSignals.empty(); }
+
+  /** Add to the signal of a bin
+   * @param thread :: index of the calling thread
+   * @param linearIndex :: linear index of the bin in the workspace
+   * @param signal :: value to add
+   */
+  inline void add(int thread, size_t linearIndex, signal_t signal) {
+    if (m_threadSignals.empty())
+      m_pending[thread].emplace_back(linearIndex, signal);
+    else
+      m_threadSignals[thread][linearIndex] += signal;
+  }
+
+  void flush(int thread);
+  void finalize();
+
+private:
+  /// The workspace receiving the sums
+  DataObjects::MDHistoWorkspace &m_workspace;
+  /// One copy of the signal array per thread, if they fit in memory
+  std::vector<std::vector<signal_t>> m_threadSignals;
+  /// Contributions waiting to be added to the workspace, per thread
+  std::vector<std::vector<std::pair<size_t, signal_t>>> m_pending;
+  /// Protects the workspace when there are no per-thread copies
+  std::mutex m_mutex;
+};
+
+} // namespace MDAlgorithms
+} // namespace Mantid
+
+#endif /* MANTID_MDALGORITHMS_MDNORMACCUMULATOR_H_ */
@@ -4,6 +4,8 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidMDAlgorithms/SlicingAlgorithm.h"
 
+#include <array>
+
 namespace Mantid {
 namespace DataObjects {
 class EventWorkspace;
@@ -60,8 +62,9 @@ private:
   void calculateNormalization(const std::vector<coord_t> &otherValues,
                               const Kernel::Matrix<coord_t> &affineTrans);
 
-  std::vector<Kernel::VMD> calculateIntersections(const double theta,
-                                                  const double phi);
+  void
+  calculateIntersections(std::vector<std::array<coord_t, 4>> &intersections,
+                         const double theta, const double phi);
 
   /// Normalization workspace
   DataObjects::MDHistoWorkspace_sptr m_normWS;
@@ -4,6 +4,8 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidMDAlgorithms/SlicingAlgorithm.h"
 
+#include <array>
+
 namespace Mantid {
 namespace DataObjects {
 class EventWorkspace;
@@ -63,8 +65,9 @@ private:
                                      const API::MatrixWorkspace &integrFlux,
                                      size_t sp,
                                      std::vector<double> &yValues) const;
-  std::vector<Kernel::VMD> calculateIntersections(const double theta,
-                                                  const double phi);
+  void
+  calculateIntersections(std::vector<std::array<coord_t, 4>> &intersections,
+                         const double theta, const double phi);
 
   /// Normalization workspace
   DataObjects::MDHistoWorkspace_sptr m_normWS;
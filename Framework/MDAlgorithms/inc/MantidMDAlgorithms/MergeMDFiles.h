@@ -72,7 +72,13 @@ private:
 
   void finalizeOutput(const std::string &outputFile);
 
-  uint64_t loadEventsFromSubBoxes(API::IMDNode *TargetBox);
+  /// Events read for a group of consecutive boxes of the output workspace
+  struct BoxBatch;
+
+  std::vector<std::vector<API::IMDNode *>> makeBoxBatches() const;
+  void readBoxBatch(BoxBatch &batch);
+  static void fillBoxBatch(BoxBatch &batch, bool parallel);
+  void writeBoxBatch(BoxBatch &batch);
 
   // the class which flatten the box structure and deal with it
   DataObjects::MDBoxFlatTree m_BoxStruct;
@@ -99,9 +105,6 @@ protected:
   /// # of events from ALL input files
   uint64_t totalEvents;
 
-  /// # of events loaded from all tasks
-  uint64_t totalLoaded;
-
   /// Mutex for file access
   std::mutex fileMutex;
 
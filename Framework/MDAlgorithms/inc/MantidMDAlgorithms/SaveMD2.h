@@ -5,6 +5,8 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 
+#include <vector>
+
 namespace Mantid {
 
 namespace MDAlgorithms {
@@ -48,6 +50,10 @@ public:
     return "MDAlgorithms\\DataHandling";
   }
 
+  /// Chunk shape used for the compressed arrays of a MDHistoWorkspace
+  static std::vector<int> histoChunks(const std::vector<int> &size,
+                                      size_t elementSize);
+
 private:
   /// Initialise the properties
   void init() override;
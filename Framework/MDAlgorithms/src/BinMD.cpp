@@ -375,8 +375,10 @@ void BinMD::exec() {
   // This gets deleted by the thread pool; don't delete it in here.
   prog = new Progress(this, 0, 1.0, 1);
 
-  // Create the dense histogram. This allocates the memory
-  outWS = MDHistoWorkspace_sptr(new MDHistoWorkspace(m_binDimensions));
+  // Create the histogram. Start from sparse storage: memory is only committed
+  // for the regions of the grid that receive events.
+  outWS = MDHistoWorkspace_sptr(
+      new MDHistoWorkspace(m_binDimensions, NoNormalization, true));
 
   // Saves the geometry transformation from original to binned in the workspace
   outWS->setTransformFromOriginal(this->m_transformFromOriginal, 0);
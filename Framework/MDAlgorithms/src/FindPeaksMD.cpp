@@ -3,13 +3,17 @@
 #include "MantidMDAlgorithms/FindPeaksMD.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/VMD.h"
 #include "MantidAPI/Run.h"
 
 #include <cmath>
+#include <boost/functional/hash.hpp>
 #include <boost/type_traits/integral_constant.hpp>
 
-#include <map>
+#include <algorithm>
+#include <array>
+#include <unordered_map>
 #include <vector>
 
 using namespace Mantid::Kernel;
@@ -55,6 +59,89 @@ template <typename MDE, size_t nd> bool isFullMDEvent() {
   return isFullMDEvent<MDE, nd>(IsFullEvent<MDE, nd>());
 }
 
+/**
+ * The centres of the peaks found so far, binned on a uniform grid of the
+ * first three dimensions with cells as wide as the peak radius. Any centre
+ * closer than the radius to a point is then in one of the 27 cells around
+ * it, so a candidate is compared with a few neighbours rather than with
+ * every peak found.
+ */
+class PeakCentreGrid {
+public:
+  PeakCentreGrid(size_t nd, coord_t radiusSquared)
+      : m_nd(nd), m_radiusSquared(radiusSquared),
+        m_cellSize(radiusSquared > 0 ? std::sqrt(radiusSquared) : 1) {}
+
+  /// @return true if the centre is within the radius of a stored centre
+  bool isNear(const coord_t *centre) const {
+    const Cell cell = cellOf(centre);
+    Cell neighbour;
+    for (int i = 0; i < 27; ++i) {
+      neighbour[0] = cell[0] + i % 3 - 1;
+      neighbour[1] = cell[1] + (i / 3) % 3 - 1;
+      neighbour[2] = cell[2] + i / 9 - 1;
+      auto found = m_cells.find(neighbour);
+      if (found == m_cells.end())
+        continue;
+      const std::vector<coord_t> &points = found->second;
+      for (size_t start = 0; start < points.size(); start += m_nd) {
+        // Distance between this box and a box we already put in.
+        coord_t distSquared = 0.0;
+        for (size_t d = 0; d < m_nd; d++) {
+          coord_t dist = points[start + d] - centre[d];
+          distSquared += (dist * dist);
+        }
+        if (distSquared < m_radiusSquared)
+          return true;
+      }
+    }
+    return false;
+  }
+
+  /// Store a new centre
+  void add(const coord_t *centre) {
+    auto &points = m_cells[cellOf(centre)];
+    points.insert(points.end(), centre, centre + m_nd);
+  }
+
+private:
+  typedef std::array<int64_t, 3> Cell;
+
+  Cell cellOf(const coord_t *centre) const {
+    Cell cell;
+    for (size_t d = 0; d < 3; d++)
+      cell[d] = static_cast<int64_t>(std::floor(centre[d] / m_cellSize));
+    return cell;
+  }
+
+  struct CellHash {
+    size_t operator()(const Cell &cell) const {
+      return boost::hash_range(cell.begin(), cell.end());
+    }
+  };
+
+  const size_t m_nd;
+  const coord_t m_radiusSquared;
+  const coord_t m_cellSize;
+  /// The coordinates of the centres in each occupied cell
+  std::unordered_map<Cell, std::vector<coord_t>, CellHash> m_cells;
+};
+
+/**
+ * Order candidate boxes from the highest to the lowest density. Boxes of
+ * equal density keep the reverse of their original order.
+ * @param candidates :: pairs of <density, box>; sorted in place
+ */
+template <typename T>
+void sortByDecreasingDensity(std::vector<std::pair<double, T>> &candidates) {
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const std::pair<double, T> &a,
+                      const std::pair<double, T> &b) {
+                     return a.first < b.first;
+                   });
+  std::reverse(candidates.begin(), candidates.end());
+}
+
 /**
  * Add the detectors from the given box as contributing detectors to the peak
  * @param peak :: The peak that relates to the box
@@ -291,25 +378,27 @@ void FindPeaksMD::findPeaks(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     // This pair is the <density, ptr to the box>
     typedef std::pair<double, API::IMDNode *> dens_box;
 
-    // Map that will sort the boxes by increasing density. The key = density;
-    // value = box *.
-    typename std::multimap<double, API::IMDNode *> sortedBoxes;
-
     // --------------- Sort and Filter by Density -----------------------------
     progress(0.20, "Sorting Boxes by Density");
-    auto it1 = boxes.begin();
-    auto it1_end = boxes.end();
-    for (; it1 != it1_end; it1++) {
-      auto box = *it1;
-      double density = box->getSignalNormalized() * m_densityScaleFactor;
+    const int64_t numBoxes = static_cast<int64_t>(boxes.size());
+    std::vector<double> densities(boxes.size());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numBoxes; i++)
+      densities[i] = boxes[i]->getSignalNormalized() * m_densityScaleFactor;
+
+    // The boxes, sorted by decreasing density
+    std::vector<dens_box> sortedBoxes;
+    for (size_t i = 0; i < boxes.size(); i++) {
       // Skip any boxes with too small a signal density.
-      if (density > thresholdDensity)
-        sortedBoxes.insert(dens_box(density, box));
+      if (densities[i] > thresholdDensity)
+        sortedBoxes.emplace_back(densities[i], boxes[i]);
     }
+    sortByDecreasingDensity(sortedBoxes);
 
     // --------------- Find Peak Boxes -----------------------------
     // List of chosen possible peak boxes.
     std::vector<API::IMDNode *> peakBoxes;
+    PeakCentreGrid peakCentres(nd, peakRadiusSquared);
 
     prog = new Progress(this, 0.30, 0.95, m_maxPeaks);
 
@@ -317,13 +406,10 @@ void FindPeaksMD::findPeaks(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     bool isMDEvent(ws->id().find("MDEventWorkspace") != std::string::npos);
 
     int64_t numBoxesFound = 0;
-    // Now we go (backwards) through the map
-    // e.g. from highest density down to lowest density.
-    typename std::multimap<double, boxPtr>::reverse_iterator it2;
-    auto it2_end = sortedBoxes.rend();
-    for (it2 = sortedBoxes.rbegin(); it2 != it2_end; it2++) {
-      signal_t density = it2->first;
-      boxPtr box = it2->second;
+    // Now we go through the boxes from highest density down to lowest density.
+    for (const auto &candidate : sortedBoxes) {
+      signal_t density = candidate.first;
+      boxPtr box = candidate.second;
 #ifndef MDBOX_TRACK_CENTROID
       coord_t boxCenter[nd];
       box->calculateCentroid(boxCenter);
@@ -331,33 +417,8 @@ void FindPeaksMD::findPeaks(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       const coord_t *boxCenter = box->getCentroid();
 #endif
 
-      // Compare to all boxes already picked.
-      bool badBox = false;
-      for (auto &peakBoxe : peakBoxes) {
-
-#ifndef MDBOX_TRACK_CENTROID
-        coord_t otherCenter[nd];
-        (*it3)->calculateCentroid(otherCenter);
-#else
-        const coord_t *otherCenter = peakBoxe->getCentroid();
-#endif
-
-        // Distance between this box and a box we already put in.
-        coord_t distSquared = 0.0;
-        for (size_t d = 0; d < nd; d++) {
-          coord_t dist = otherCenter[d] - boxCenter[d];
-          distSquared += (dist * dist);
-        }
-
-        // Reject this box if it is too close to another previously found box.
-        if (distSquared < peakRadiusSquared) {
-          badBox = true;
-          break;
-        }
-      }
-
-      // The box was not rejected for another reason.
-      if (!badBox) {
+      // Reject this box if it is too close to another previously found box.
+      if (!peakCentres.isNear(boxCenter)) {
         if (numBoxesFound++ >= m_maxPeaks) {
           g_log.notice() << "Number of peaks found exceeded the limit of "
                          << m_maxPeaks << ". Stopping peak finding.\n";
@@ -365,6 +426,7 @@ void FindPeaksMD::findPeaks(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         }
 
         peakBoxes.push_back(box);
+        peakCentres.add(boxCenter);
         g_log.debug() << "Found box at ";
         for (size_t d = 0; d < nd; d++)
           g_log.debug() << (d > 0 ? "," : "") << boxCenter[d];
@@ -452,10 +514,6 @@ void FindPeaksMD::findPeaksHisto(
     // This pair is the <density, box index>
     typedef std::pair<double, size_t> dens_box;
 
-    // Map that will sort the boxes by increasing density. The key = density;
-    // value = box index.
-    std::multimap<double, size_t> sortedBoxes;
-
     size_t numBoxes = ws->getNPoints();
 
     // --------- Count the overall signal density -----------------------------
@@ -478,51 +536,39 @@ void FindPeaksMD::findPeaksHisto(
 
     // -------------- Sort and Filter by Density -----------------------------
     progress(0.20, "Sorting Boxes by Density");
+    std::vector<double> densities(numBoxes);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < static_cast<int64_t>(numBoxes); i++)
+      densities[i] = ws->getSignalNormalizedAt(static_cast<size_t>(i)) *
+                     m_densityScaleFactor;
+
+    // The boxes, sorted by decreasing density
+    std::vector<dens_box> sortedBoxes;
     for (size_t i = 0; i < numBoxes; i++) {
-      double density = ws->getSignalNormalizedAt(i) * m_densityScaleFactor;
       // Skip any boxes with too small a signal density.
-      if (density > thresholdDensity)
-        sortedBoxes.insert(dens_box(density, i));
+      if (densities[i] > thresholdDensity)
+        sortedBoxes.emplace_back(densities[i], i);
     }
+    sortByDecreasingDensity(sortedBoxes);
 
     // --------------- Find Peak Boxes -----------------------------
     // List of chosen possible peak boxes.
     std::vector<size_t> peakBoxes;
+    PeakCentreGrid peakCentres(nd, peakRadiusSquared);
 
     prog = new Progress(this, 0.30, 0.95, m_maxPeaks);
 
     int64_t numBoxesFound = 0;
-    // Now we go (backwards) through the map
-    // e.g. from highest density down to lowest density.
-    std::multimap<double, size_t>::reverse_iterator it2;
-    auto it2_end = sortedBoxes.rend();
-    for (it2 = sortedBoxes.rbegin(); it2 != it2_end; ++it2) {
-      signal_t density = it2->first;
-      size_t index = it2->second;
+    // Now we go through the boxes from highest density down to lowest density.
+    for (const auto &candidate : sortedBoxes) {
+      signal_t density = candidate.first;
+      size_t index = candidate.second;
       // Get the center of the box
-      VMD boxCenter = ws->getCenter(index);
-
-      // Compare to all boxes already picked.
-      bool badBox = false;
-      for (auto &peakBoxe : peakBoxes) {
-        VMD otherCenter = ws->getCenter(peakBoxe);
-
-        // Distance between this box and a box we already put in.
-        coord_t distSquared = 0.0;
-        for (size_t d = 0; d < nd; d++) {
-          coord_t dist = otherCenter[d] - boxCenter[d];
-          distSquared += (dist * dist);
-        }
-
-        // Reject this box if it is too close to another previously found box.
-        if (distSquared < peakRadiusSquared) {
-          badBox = true;
-          break;
-        }
-      }
+      const std::vector<coord_t> boxCenter =
+          ws->getCenter(index).toVector<coord_t>();
 
-      // The box was not rejected for another reason.
-      if (!badBox) {
+      // Reject this box if it is too close to another previously found box.
+      if (!peakCentres.isNear(boxCenter.data())) {
         if (numBoxesFound++ >= m_maxPeaks) {
           g_log.notice() << "Number of peaks found exceeded the limit of "
                          << m_maxPeaks << ". Stopping peak finding.\n";
@@ -530,6 +576,7 @@ void FindPeaksMD::findPeaksHisto(
         }
 
         peakBoxes.push_back(index);
+        peakCentres.add(boxCenter.data());
         g_log.debug() << "Found box at index " << index;
         g_log.debug() << "; Density = " << density << '\n';
         // Report progres for each box found.
@@ -18,6 +18,7 @@
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/System.h"
 #include "MantidMDAlgorithms/LoadMD.h"
+#include "MantidMDAlgorithms/SaveMD2.h"
 #include "MantidMDAlgorithms/SetMDFrame.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDBoxFlatTree.h"
@@ -28,6 +29,8 @@
 #include <nexus/NeXusException.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/regex.hpp>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -261,9 +264,11 @@ void LoadMD::exec() {
 
 /**
 * Load a slab of double data into a bare array.
-* Checks that the size is correct.
+* Checks that the size is correct. The data is read in chunks along the
+* slowest-varying dimension and only the non-zero parts are copied, so that
+* the empty regions of a sparse workspace are never written to.
 * @param name
-* @param data bare pointer to double array
+* @param data bare pointer to a zero-filled array
 * @param ws
 * @param dataType
 */
@@ -285,11 +290,42 @@ void LoadMD::loadSlab(std::string name, void *data, MDHistoWorkspace_sptr ws,
     throw std::runtime_error(
         "Inconsistency between the number of points in '" + name +
         "' and the number of bins defined by the dimensions.");
+  // Size of one element in the file and the number of points in a "row" of
+  // the slowest-varying dimension
+  const size_t elementSize =
+      dataType == ::NeXus::INT8 ? sizeof(bool) : sizeof(signal_t);
+  const size_t rowPoints = static_cast<size_t>(nPoints / size[0]);
+  // Read roughly 16 MB at a time, in whole chunks of the compressed data set
+  // so that no chunk is decompressed twice
+  const size_t fileChunkRows = std::max(
+      size_t(1),
+      static_cast<size_t>(SaveMD2::histoChunks(size, elementSize)[0]));
+  const size_t chunkRows =
+      std::max(size_t(1), (size_t(16) << 20) /
+                              (rowPoints * elementSize * fileChunkRows)) *
+      fileChunkRows;
+  // Zero regions are skipped in blocks of a memory page
+  const size_t blockBytes = 4096;
+
+  std::vector<char> buffer;
   std::vector<int> start(numDims, 0);
-  try {
-    m_file->getSlab(data, start, size);
-  } catch (...) {
-    std::cout << " start: " << start[0] << " size: " << size[0] << '\n';
+  std::vector<int> count(size);
+  char *dest = static_cast<char *>(data);
+  for (size_t row = 0; row < static_cast<size_t>(size[0]); row += chunkRows) {
+    const size_t nRows =
+        std::min(chunkRows, static_cast<size_t>(size[0]) - row);
+    start[0] = static_cast<int>(row);
+    count[0] = static_cast<int>(nRows);
+    const size_t chunkBytes = nRows * rowPoints * elementSize;
+    buffer.resize(chunkBytes);
+    m_file->getSlab(buffer.data(), start, count);
+    char *chunkDest = dest + row * rowPoints * elementSize;
+    for (size_t offset = 0; offset < chunkBytes; offset += blockBytes) {
+      const size_t n = std::min(blockBytes, chunkBytes - offset);
+      const char *block = buffer.data() + offset;
+      if (std::any_of(block, block + n, [](char c) { return c != 0; }))
+        std::memcpy(chunkDest + offset, block, n);
+    }
   }
   m_file->closeData();
 }
@@ -299,15 +335,16 @@ void LoadMD::loadSlab(std::string name, void *data, MDHistoWorkspace_sptr ws,
 * The entry should be open already.
 */
 void LoadMD::loadHisto() {
-  // Create the initial MDHisto.
+  // Create the initial MDHisto. All values are read from the file so start
+  // from sparse (zero-filled) storage and only write the populated regions.
   MDHistoWorkspace_sptr ws;
   // If display normalization has been provided. Use that.
   if (m_visualNormalization) {
-    ws = boost::make_shared<MDHistoWorkspace>(m_dims,
-                                              m_visualNormalization.get());
-  } else {
     ws = boost::make_shared<MDHistoWorkspace>(
-        m_dims); // Whatever MDHistoWorkspace defaults to.
+        m_dims, m_visualNormalization.get(), true);
+  } else {
+    // Whatever MDHistoWorkspace defaults to.
+    ws = boost::make_shared<MDHistoWorkspace>(m_dims, NoNormalization, true);
   }
 
   // Now the ExperimentInfo
@@ -0,0 +1,104 @@
+#include "MantidMDAlgorithms/MDNormAccumulator.h"
+#include "MantidKernel/Memory.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+namespace {
+/**
+ * Decide whether one copy of the signal array per thread fits in memory.
+ * @param numThreads :: number of threads
+ * @param nPoints :: number of bins in the workspace
+ * @return true if the copies would use less than half the available memory
+ */
+bool threadBuffersFit(int numThreads, size_t nPoints) {
+  if (numThreads < 2)
+    return false;
+  // availMem() is in kiB
+  const size_t available = Kernel::MemoryStats().availMem() * size_t(1024);
+  const size_t required =
+      static_cast<size_t>(numThreads) * nPoints * sizeof(signal_t);
+  return required < available / 2;
+}
+} // namespace
+
+/**
+ * Constructor. Per-thread copies of the signal are used if they fit in memory.
+ * @param workspace :: the workspace to accumulate into
+ * @param numThreads :: the number of threads that will call add()
+ */
+MDNormAccumulator::MDNormAccumulator(DataObjects::MDHistoWorkspace &workspace,
+                                     int numThreads)
+    : MDNormAccumulator(workspace, numThreads,
+                        threadBuffersFit(numThreads, workspace.getNPoints())) {
+}
+
+/**
+ * Constructor
+ * @param workspace :: the workspace to accumulate into
+ * @param numThreads :: the number of threads that will call add()
+ * @param useThreadBuffers :: if true, each thread gets its own copy of the
+ * signal array
+ */
+MDNormAccumulator::MDNormAccumulator(DataObjects::MDHistoWorkspace &workspace,
+                                     int numThreads, bool useThreadBuffers)
+    : m_workspace(workspace), m_threadSignals(), m_pending() {
+  const size_t nThreads = static_cast<size_t>(std::max(numThreads, 1));
+  if (useThreadBuffers) {
+    m_threadSignals.resize(nThreads);
+    for (auto &signal : m_threadSignals)
+      signal.resize(m_workspace.getNPoints(), 0.0);
+  } else {
+    m_pending.resize(nThreads);
+  }
+}
+
+/**
+ * Add the queued contributions of a thread to the workspace. Does nothing when
+ * per-thread copies are in use.
+ * @param thread :: index of the calling thread
+ */
+void MDNormAccumulator::flush(int thread) {
+  if (!m_threadSignals.empty())
+    return;
+  auto &pending = m_pending[thread];
+  if (pending.empty())
+    return;
+  signal_t *signal = m_workspace.getSignalArray();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto &contribution : pending)
+      signal[contribution.first] += contribution.second;
+  }
+  pending.clear();
+}
+
+/**
+ * Sum all the contributions into the workspace. The per-thread copies are
+ * added in thread order and released.
+ */
+void MDNormAccumulator::finalize() {
+  if (m_threadSignals.empty()) {
+    for (size_t thread = 0; thread < m_pending.size(); ++thread)
+      flush(static_cast<int>(thread));
+    return;
+  }
+  signal_t *signal = m_workspace.getSignalArray();
+  const int64_t nPoints = static_cast<int64_t>(m_workspace.getNPoints());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < nPoints; ++i) {
+    signal_t sum = 0.0;
+    for (const auto &threadSignal : m_threadSignals)
+      sum += threadSignal[i];
+    // Leave untouched bins alone so sparse storage stays uncommitted
+    if (sum != 0.0)
+      signal[i] += sum;
+  }
+  m_threadSignals.clear();
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
@@ -15,6 +15,7 @@
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidMDAlgorithms/MDNormAccumulator.h"
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -27,10 +28,18 @@ using namespace Mantid::Kernel;
 
 namespace {
 // function to  compare two intersections (h,k,l,Momentum) by Momentum
-bool compareMomentum(const Mantid::Kernel::VMD &v1,
-                     const Mantid::Kernel::VMD &v2) {
+bool compareMomentum(const std::array<coord_t, 4> &v1,
+                     const std::array<coord_t, 4> &v2) {
   return (v1[3] < v2[3]);
 }
+
+// append an intersection (h,k,l,Momentum)
+void addIntersection(std::vector<std::array<coord_t, 4>> &intersections,
+                     double h, double k, double l, double momentum) {
+  intersections.push_back({{static_cast<coord_t>(h), static_cast<coord_t>(k),
+                            static_cast<coord_t>(l),
+                            static_cast<coord_t>(momentum)}});
+}
 }
 
 // Register the algorithm into the AlgorithmFactory
@@ -457,6 +466,16 @@ void MDNormDirectSC::calculateNormalization(
   }
 
   auto prog = make_unique<API::Progress>(this, 0.3, 1.0, ndets);
+  // Each thread sums its contributions separately; they are reduced into
+  // m_normWS at the end rather than locking the workspace for every bin
+  const int numThreads = PARALLEL_GET_MAX_THREADS;
+  MDNormAccumulator accumulator(*m_normWS, numThreads);
+  // Intersections of each thread, reused from one detector to the next
+  std::vector<std::vector<std::array<coord_t, 4>>> threadIntersections(
+      numThreads);
+  const size_t vmdDims = 4;
+  const size_t nOutDims = affineTrans.numRows();
+  const size_t nInDims = affineTrans.numCols();
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t i = 0; i < ndets; i++) {
     PARALLEL_START_INTERUPT_REGION
@@ -472,7 +491,9 @@ void MDNormDirectSC::calculateNormalization(
     const auto detID = detector.getID();
 
     // Intersections
-    auto intersections = calculateIntersections(theta, phi);
+    const int thread = PARALLEL_THREAD_NUMBER;
+    auto &intersections = threadIntersections[thread];
+    calculateIntersections(intersections, theta, phi);
     if (intersections.empty())
       continue;
 
@@ -483,11 +504,11 @@ void MDNormDirectSC::calculateNormalization(
               protonCharge;
     }
     // Compute final position in HKL
-    const size_t vmdDims = intersections.front().size();
     // pre-allocate for efficiency and copy non-hkl dim values into place
     std::vector<coord_t> pos(vmdDims + otherValues.size() + 1);
     std::copy(otherValues.begin(), otherValues.end(), pos.begin() + vmdDims);
     pos.push_back(1.);
+    std::vector<coord_t> posNew(nOutDims);
     auto intersectionsBegin = intersections.begin();
     for (auto it = intersectionsBegin + 1; it != intersections.end(); ++it) {
       const auto &curIntSec = *it;
@@ -500,14 +521,19 @@ void MDNormDirectSC::calculateNormalization(
         continue; // Assume zero contribution if difference is small
 
       // Average between two intersections for final position
-      std::transform(curIntSec.getBareArray(),
-                     curIntSec.getBareArray() + vmdDims,
-                     prevIntSec.getBareArray(), pos.begin(),
+      std::transform(curIntSec.data(), curIntSec.data() + vmdDims,
+                     prevIntSec.data(), pos.begin(),
                      VectorHelper::SimpleAverage<coord_t>());
 
       // transform kf to energy transfer
       pos[3] = static_cast<coord_t>(m_Ei - pos[3] * pos[3] / energyToK);
-      std::vector<coord_t> posNew = affineTrans * pos;
+      // posNew = affineTrans * pos, without allocating
+      for (size_t row = 0; row < nOutDims; ++row) {
+        coord_t value = 0;
+        for (size_t col = 0; col < nInDims; ++col)
+          value += affineTrans[row][col] * pos[col];
+        posNew[row] = value;
+      }
       size_t linIndex = m_normWS->getLinearIndexAtCoord(posNew.data());
       if (linIndex == size_t(-1))
         continue;
@@ -515,29 +541,29 @@ void MDNormDirectSC::calculateNormalization(
       // signal = integral between two consecutive intersections *solid angle
       // *PC
       double signal = solid * delta;
-
-      PARALLEL_CRITICAL(updateMD) {
-        signal += m_normWS->getSignalAt(linIndex);
-        m_normWS->setSignalAt(linIndex, signal);
-      }
+      accumulator.add(thread, linIndex, signal);
     }
+    accumulator.flush(thread);
     prog->report();
 
     PARALLEL_END_INTERUPT_REGION
   }
   PARALLEL_CHECK_INTERUPT_REGION
+  accumulator.finalize();
 }
 
 /**
  * Calculate the points of intersection for the given detector with cuboid
  * surrounding the
  * detector position in HKL
+ * @param intersections [Out] The intersections in HKL space, plus final
+ * momentum, sorted by momentum. Any previous content is cleared.
  * @param theta Polar angle withd detector
  * @param phi Azimuthal angle with detector
- * @return A list of intersections in HKL space
  */
-std::vector<Kernel::VMD>
-MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
+void MDNormDirectSC::calculateIntersections(
+    std::vector<std::array<coord_t, 4>> &intersections, const double theta,
+    const double phi) {
   V3D qout(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta)),
       qin(0., 0., m_ki);
 
@@ -558,7 +584,7 @@ MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
   auto kNBins = m_kX.size();
   auto lNBins = m_lX.size();
   auto eNBins = m_eX.size();
-  std::vector<Kernel::VMD> intersections;
+  intersections.clear();
   intersections.reserve(hNBins + kNBins + lNBins + eNBins +
                         8); // 8 is 3*(min,max for each Q component)+kfmin+kfmax
 
@@ -580,7 +606,7 @@ MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
           if ((ki >= m_kmin) && (ki <= m_kmax) && (li >= m_lmin) &&
               (li <= m_lmax)) {
             double momi = fmom * (hi - hStart) + m_kfmin;
-            intersections.emplace_back(hi, ki, li, momi);
+            addIntersection(intersections, hi, ki, li, momi);
           }
         }
       }
@@ -593,7 +619,7 @@ MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
       double lhmin = fl * (m_hmin - hStart) + lStart;
       if ((khmin >= m_kmin) && (khmin <= m_kmax) && (lhmin >= m_lmin) &&
           (lhmin <= m_lmax)) {
-        intersections.emplace_back(m_hmin, khmin, lhmin, momhMin);
+        addIntersection(intersections, m_hmin, khmin, lhmin, momhMin);
       }
     }
     double momhMax = fmom * (m_hmax - hStart) + m_kfmin;
@@ -603,7 +629,7 @@ MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
       double lhmax = fl * (m_hmax - hStart) + lStart;
       if ((khmax >= m_kmin) && (khmax <= m_kmax) && (lhmax >= m_lmin) &&
           (lhmax <= m_lmax)) {
-        intersections.emplace_back(m_hmax, khmax, lhmax, momhMax);
+        addIntersection(intersections, m_hmax, khmax, lhmax, momhMax);
       }
     }
   }
@@ -626,7 +652,7 @@ MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
           if ((hi >= m_hmin) && (hi <= m_hmax) && (li >= m_lmin) &&
               (li <= m_lmax)) {
             double momi = fmom * (ki - kStart) + m_kfmin;
-            intersections.emplace_back(hi, ki, li, momi);
+            addIntersection(intersections, hi, ki, li, momi);
           }
         }
       }
@@ -638,7 +664,7 @@ MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
       double lkmin = fl * (m_kmin - kStart) + lStart;
       if ((hkmin >= m_hmin) && (hkmin <= m_hmax) && (lkmin >= m_lmin) &&
           (lkmin <= m_lmax)) {
-        intersections.emplace_back(hkmin, m_kmin, lkmin, momkMin);
+        addIntersection(intersections, hkmin, m_kmin, lkmin, momkMin);
       }
     }
     double momkMax = fmom * (m_kmax - kStart) + m_kfmin;
@@ -648,7 +674,7 @@ MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
       double lkmax = fl * (m_kmax - kStart) + lStart;
       if ((hkmax >= m_hmin) && (hkmax <= m_hmax) && (lkmax >= m_lmin) &&
           (lkmax <= m_lmax)) {
-        intersections.emplace_back(hkmax, m_kmax, lkmax, momkMax);
+        addIntersection(intersections, hkmax, m_kmax, lkmax, momkMax);
       }
     }
   }
@@ -668,7 +694,7 @@ MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
           if ((hi >= m_hmin) && (hi <= m_hmax) && (ki >= m_kmin) &&
               (ki <= m_kmax)) {
             double momi = fmom * (li - lStart) + m_kfmin;
-            intersections.emplace_back(hi, ki, li, momi);
+            addIntersection(intersections, hi, ki, li, momi);
           }
         }
       }
@@ -680,7 +706,7 @@ MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
       double klmin = fk * (m_lmin - lStart) + kStart;
       if ((hlmin >= m_hmin) && (hlmin <= m_hmax) && (klmin >= m_kmin) &&
           (klmin <= m_kmax)) {
-        intersections.emplace_back(hlmin, klmin, m_lmin, momlMin);
+        addIntersection(intersections, hlmin, klmin, m_lmin, momlMin);
       }
     }
     double momlMax = fmom * (m_lmax - lStart) + m_kfmin;
@@ -690,7 +716,7 @@ MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
       double klmax = fk * (m_lmax - lStart) + kStart;
       if ((hlmax >= m_hmin) && (hlmax <= m_hmax) && (klmax >= m_kmin) &&
           (klmax <= m_kmax)) {
-        intersections.emplace_back(hlmax, klmax, m_lmax, momlMax);
+        addIntersection(intersections, hlmax, klmax, m_lmax, momlMax);
       }
     }
   }
@@ -705,7 +731,7 @@ MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
         double l = qin.Z() - qout.Z() * kfi;
         if ((h >= m_hmin) && (h <= m_hmax) && (k >= m_kmin) && (k <= m_kmax) &&
             (l >= m_lmin) && (l <= m_lmax)) {
-          intersections.emplace_back(h, k, l, kfi);
+          addIntersection(intersections, h, k, l, kfi);
         }
       }
     }
@@ -714,16 +740,15 @@ MDNormDirectSC::calculateIntersections(const double theta, const double phi) {
   // endpoints
   if ((hStart >= m_hmin) && (hStart <= m_hmax) && (kStart >= m_kmin) &&
       (kStart <= m_kmax) && (lStart >= m_lmin) && (lStart <= m_lmax)) {
-    intersections.emplace_back(hStart, kStart, lStart, m_kfmin);
+    addIntersection(intersections, hStart, kStart, lStart, m_kfmin);
   }
   if ((hEnd >= m_hmin) && (hEnd <= m_hmax) && (kEnd >= m_kmin) &&
       (kEnd <= m_kmax) && (lEnd >= m_lmin) && (lEnd <= m_lmax)) {
-    intersections.emplace_back(hEnd, kEnd, lEnd, m_kfmax);
+    addIntersection(intersections, hEnd, kEnd, lEnd, m_kfmax);
   }
 
   // sort intersections by final momentum
   std::stable_sort(intersections.begin(), intersections.end(), compareMomentum);
-  return intersections;
 }
 
 } // namespace MDAlgorithms
@@ -15,6 +15,7 @@
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidMDAlgorithms/MDNormAccumulator.h"
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -27,10 +28,18 @@ using namespace Mantid::Kernel;
 
 namespace {
 // function to  compare two intersections (h,k,l,Momentum) by Momentum
-bool compareMomentum(const Mantid::Kernel::VMD &v1,
-                     const Mantid::Kernel::VMD &v2) {
+bool compareMomentum(const std::array<coord_t, 4> &v1,
+                     const std::array<coord_t, 4> &v2) {
   return (v1[3] < v2[3]);
 }
+
+// append an intersection (h,k,l,Momentum)
+void addIntersection(std::vector<std::array<coord_t, 4>> &intersections,
+                     double h, double k, double l, double momentum) {
+  intersections.push_back({{static_cast<coord_t>(h), static_cast<coord_t>(k),
+                            static_cast<coord_t>(l),
+                            static_cast<coord_t>(momentum)}});
+}
 }
 
 // Register the algorithm into the AlgorithmFactory
@@ -403,7 +412,18 @@ void MDNormSCD::calculateNormalization(
       solidAngleWS->getDetectorIDToWorkspaceIndexMap();
 
   auto prog = make_unique<API::Progress>(this, 0.3, 1.0, ndets);
-  PARALLEL_FOR_IF(Kernel::threadSafe(*integrFlux))
+  // Each thread sums its contributions separately; they are reduced into
+  // m_normWS at the end rather than locking the workspace for every bin
+  const bool parallel = Kernel::threadSafe(*integrFlux);
+  const int numThreads = parallel ? PARALLEL_GET_MAX_THREADS : 1;
+  MDNormAccumulator accumulator(*m_normWS, numThreads);
+  // Intersections of each thread, reused from one detector to the next
+  std::vector<std::vector<std::array<coord_t, 4>>> threadIntersections(
+      numThreads);
+  const size_t vmdDims = 4;
+  const size_t nOutDims = affineTrans.numRows();
+  const size_t nInDims = affineTrans.numCols();
+  PARALLEL_FOR_IF(parallel)
   for (int64_t i = 0; i < ndets; i++) {
     PARALLEL_START_INTERUPT_REGION
 
@@ -418,7 +438,9 @@ void MDNormSCD::calculateNormalization(
     const auto detID = detector.getID();
 
     // Intersections
-    auto intersections = calculateIntersections(theta, phi);
+    const int thread = PARALLEL_THREAD_NUMBER;
+    auto &intersections = threadIntersections[thread];
+    calculateIntersections(intersections, theta, phi);
     if (intersections.empty())
       continue;
 
@@ -446,12 +468,12 @@ void MDNormSCD::calculateNormalization(
     calcIntegralsForIntersections(xValues, *integrFlux, wsIdx, yValues);
 
     // Compute final position in HKL
-    const size_t vmdDims = intersections.front().size();
     // pre-allocate for efficiency and copy non-hkl dim values into place
     std::vector<coord_t> pos(vmdDims + otherValues.size());
     std::copy(otherValues.begin(), otherValues.end(),
               pos.begin() + vmdDims - 1);
     pos.push_back(1.);
+    std::vector<coord_t> posNew(nOutDims);
 
     for (auto it = intersectionsBegin + 1; it != intersections.end(); ++it) {
       const auto &curIntSec = *it;
@@ -462,11 +484,16 @@ void MDNormSCD::calculateNormalization(
         continue; // Assume zero contribution if difference is small
 
       // Average between two intersections for final position
-      std::transform(curIntSec.getBareArray(),
-                     curIntSec.getBareArray() + vmdDims - 1,
-                     prevIntSec.getBareArray(), pos.begin(),
+      std::transform(curIntSec.data(), curIntSec.data() + vmdDims - 1,
+                     prevIntSec.data(), pos.begin(),
                      VectorHelper::SimpleAverage<coord_t>());
-      std::vector<coord_t> posNew = affineTrans * pos;
+      // posNew = affineTrans * pos, without allocating
+      for (size_t row = 0; row < nOutDims; ++row) {
+        coord_t value = 0;
+        for (size_t col = 0; col < nInDims; ++col)
+          value += affineTrans[row][col] * pos[col];
+        posNew[row] = value;
+      }
       size_t linIndex = m_normWS->getLinearIndexAtCoord(posNew.data());
       if (linIndex == size_t(-1))
         continue;
@@ -475,17 +502,15 @@ void MDNormSCD::calculateNormalization(
       size_t k = static_cast<size_t>(std::distance(intersectionsBegin, it));
       // signal = integral between two consecutive intersections
       double signal = (yValues[k] - yValues[k - 1]) * solid;
-
-      PARALLEL_CRITICAL(updateMD) {
-        signal += m_normWS->getSignalAt(linIndex);
-        m_normWS->setSignalAt(linIndex, signal);
-      }
+      accumulator.add(thread, linIndex, signal);
     }
+    accumulator.flush(thread);
     prog->report();
 
     PARALLEL_END_INTERUPT_REGION
   }
   PARALLEL_CHECK_INTERUPT_REGION
+  accumulator.finalize();
 }
 
 /**
@@ -568,12 +593,14 @@ void MDNormSCD::calcIntegralsForIntersections(
  * Calculate the points of intersection for the given detector with cuboid
  * surrounding the
  * detector position in HKL
+ * @param intersections [Out] The intersections in HKL space, plus momentum,
+ * sorted by momentum. Any previous content is cleared.
  * @param theta Polar angle withd detector
  * @param phi Azimuthal angle with detector
- * @return A list of intersections in HKL space
  */
-std::vector<Kernel::VMD> MDNormSCD::calculateIntersections(const double theta,
-                                                           const double phi) {
+void MDNormSCD::calculateIntersections(
+    std::vector<std::array<coord_t, 4>> &intersections, const double theta,
+    const double phi) {
   V3D q(-sin(theta) * cos(phi), -sin(theta) * sin(phi), 1. - cos(theta));
   q = m_rubw * q;
   if (convention == "Crystallography") {
@@ -589,7 +616,7 @@ std::vector<Kernel::VMD> MDNormSCD::calculateIntersections(const double theta,
   auto hNBins = m_hX.size();
   auto kNBins = m_kX.size();
   auto lNBins = m_lX.size();
-  std::vector<Kernel::VMD> intersections;
+  intersections.clear();
   intersections.reserve(hNBins + kNBins + lNBins + 8);
 
   // calculate intersections with planes perpendicular to h
@@ -610,8 +637,7 @@ std::vector<Kernel::VMD> MDNormSCD::calculateIntersections(const double theta,
           if ((ki >= m_kmin) && (ki <= m_kmax) && (li >= m_lmin) &&
               (li <= m_lmax)) {
             double momi = fmom * (hi - hStart) + m_kiMin;
-            Mantid::Kernel::VMD v(hi, ki, li, momi);
-            intersections.push_back(v);
+            addIntersection(intersections, hi, ki, li, momi);
           }
         }
       }
@@ -624,8 +650,7 @@ std::vector<Kernel::VMD> MDNormSCD::calculateIntersections(const double theta,
       double lhmin = fl * (m_hmin - hStart) + lStart;
       if ((khmin >= m_kmin) && (khmin <= m_kmax) && (lhmin >= m_lmin) &&
           (lhmin <= m_lmax)) {
-        Mantid::Kernel::VMD v(m_hmin, khmin, lhmin, momhMin);
-        intersections.push_back(v);
+        addIntersection(intersections, m_hmin, khmin, lhmin, momhMin);
       }
     }
     double momhMax = fmom * (m_hmax - hStart) + m_kiMin;
@@ -635,8 +660,7 @@ std::vector<Kernel::VMD> MDNormSCD::calculateIntersections(const double theta,
       double lhmax = fl * (m_hmax - hStart) + lStart;
       if ((khmax >= m_kmin) && (khmax <= m_kmax) && (lhmax >= m_lmin) &&
           (lhmax <= m_lmax)) {
-        Mantid::Kernel::VMD v(m_hmax, khmax, lhmax, momhMax);
-        intersections.push_back(v);
+        addIntersection(intersections, m_hmax, khmax, lhmax, momhMax);
       }
     }
   }
@@ -658,8 +682,7 @@ std::vector<Kernel::VMD> MDNormSCD::calculateIntersections(const double theta,
           if ((hi >= m_hmin) && (hi <= m_hmax) && (li >= m_lmin) &&
               (li <= m_lmax)) {
             double momi = fmom * (ki - kStart) + m_kiMin;
-            Mantid::Kernel::VMD v(hi, ki, li, momi);
-            intersections.push_back(v);
+            addIntersection(intersections, hi, ki, li, momi);
           }
         }
       }
@@ -672,8 +695,7 @@ std::vector<Kernel::VMD> MDNormSCD::calculateIntersections(const double theta,
       double lkmin = fl * (m_kmin - kStart) + lStart;
       if ((hkmin >= m_hmin) && (hkmin <= m_hmax) && (lkmin >= m_lmin) &&
           (lkmin <= m_lmax)) {
-        Mantid::Kernel::VMD v(hkmin, m_kmin, lkmin, momkMin);
-        intersections.push_back(v);
+        addIntersection(intersections, hkmin, m_kmin, lkmin, momkMin);
       }
     }
     double momkMax = fmom * (m_kmax - kStart) + m_kiMin;
@@ -683,8 +705,7 @@ std::vector<Kernel::VMD> MDNormSCD::calculateIntersections(const double theta,
       double lkmax = fl * (m_kmax - kStart) + lStart;
       if ((hkmax >= m_hmin) && (hkmax <= m_hmax) && (lkmax >= m_lmin) &&
           (lkmax <= m_lmax)) {
-        Mantid::Kernel::VMD v(hkmax, m_kmax, lkmax, momkMax);
-        intersections.push_back(v);
+        addIntersection(intersections, hkmax, m_kmax, lkmax, momkMax);
       }
     }
   }
@@ -706,8 +727,7 @@ std::vector<Kernel::VMD> MDNormSCD::calculateIntersections(const double theta,
           if ((hi >= m_hmin) && (hi <= m_hmax) && (ki >= m_kmin) &&
               (ki <= m_kmax)) {
             double momi = fmom * (li - lStart) + m_kiMin;
-            Mantid::Kernel::VMD v(hi, ki, li, momi);
-            intersections.push_back(v);
+            addIntersection(intersections, hi, ki, li, momi);
           }
         }
       }
@@ -720,8 +740,7 @@ std::vector<Kernel::VMD> MDNormSCD::calculateIntersections(const double theta,
       double klmin = fk * (m_lmin - lStart) + kStart;
       if ((hlmin >= m_hmin) && (hlmin <= m_hmax) && (klmin >= m_kmin) &&
           (klmin <= m_kmax)) {
-        Mantid::Kernel::VMD v(hlmin, klmin, m_lmin, momlMin);
-        intersections.push_back(v);
+        addIntersection(intersections, hlmin, klmin, m_lmin, momlMin);
       }
     }
     double momlMax = fmom * (m_lmax - lStart) + m_kiMin;
@@ -731,8 +750,7 @@ std::vector<Kernel::VMD> MDNormSCD::calculateIntersections(const double theta,
       double klmax = fk * (m_lmax - lStart) + kStart;
       if ((hlmax >= m_hmin) && (hlmax <= m_hmax) && (klmax >= m_kmin) &&
           (klmax <= m_kmax)) {
-        Mantid::Kernel::VMD v(hlmax, klmax, m_lmax, momlMax);
-        intersections.push_back(v);
+        addIntersection(intersections, hlmax, klmax, m_lmax, momlMax);
       }
     }
   }
@@ -740,22 +758,15 @@ std::vector<Kernel::VMD> MDNormSCD::calculateIntersections(const double theta,
   // add endpoints
   if ((hStart >= m_hmin) && (hStart <= m_hmax) && (kStart >= m_kmin) &&
       (kStart <= m_kmax) && (lStart >= m_lmin) && (lStart <= m_lmax)) {
-    Mantid::Kernel::VMD v(hStart, kStart, lStart, m_kiMin);
-    intersections.push_back(v);
+    addIntersection(intersections, hStart, kStart, lStart, m_kiMin);
   }
   if ((hEnd >= m_hmin) && (hEnd <= m_hmax) && (kEnd >= m_kmin) &&
       (kEnd <= m_kmax) && (lEnd >= m_lmin) && (lEnd <= m_lmax)) {
-    Mantid::Kernel::VMD v(hEnd, kEnd, lEnd, m_kiMax);
-    intersections.push_back(v);
+    addIntersection(intersections, hEnd, kEnd, lEnd, m_kiMax);
   }
 
   // sort intersections by momentum
-  typedef std::vector<Mantid::Kernel::VMD>::iterator IterType;
-  std::stable_sort<IterType, bool (*)(const Mantid::Kernel::VMD &,
-                                      const Mantid::Kernel::VMD &)>(
-      intersections.begin(), intersections.end(), compareMomentum);
-
-  return intersections;
+  std::stable_sort(intersections.begin(), intersections.end(), compareMomentum);
 }
 
 } // namespace MDAlgorithms
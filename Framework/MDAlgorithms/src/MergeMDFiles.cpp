@@ -1,6 +1,7 @@
 #include "MantidAPI/FileProperty.h"
 #include "MantidAPI/MultipleFileProperty.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/VectorHelper.h"
@@ -12,6 +13,10 @@
 #include <boost/scoped_ptr.hpp>
 #include <Poco/File.h>
 
+#include <future>
+#include <numeric>
+#include <tuple>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
@@ -22,12 +27,34 @@ namespace MDAlgorithms {
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(MergeMDFiles)
 
+namespace {
+/// Number of events (summed over all input files) read in one batch of boxes
+const uint64_t EVENTS_PER_BATCH = 10000000;
+/// Largest gap, in events, between two boxes in an input file that is still
+/// read as part of one contiguous block
+const uint64_t MAX_READ_GAP = 4096;
+} // namespace
+
+/** The events of a batch of output boxes. The events are read from each input
+ * file as a few large blocks; each box then refers to its rows in the blocks.
+ */
+struct MergeMDFiles::BoxBatch {
+  /// Boxes of the output workspace that are filled by this batch
+  std::vector<API::IMDNode *> boxes;
+  /// Event data read from the input files
+  std::vector<std::vector<coord_t>> blocks;
+  /// For each box: (block index, first row, number of rows) of every input
+  std::vector<std::vector<std::tuple<size_t, size_t, size_t>>> slices;
+  /// Number of values per event in the blocks
+  size_t nColumns = 0;
+};
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
 MergeMDFiles::MergeMDFiles()
     : m_nDims(0), m_MDEventType(), m_fileBasedTargetWS(false), m_Filenames(),
-      m_EventLoader(), m_OutIWS(), totalEvents(0), totalLoaded(0), fileMutex(),
+      m_EventLoader(), m_OutIWS(), totalEvents(0), fileMutex(),
       statsMutex(), prog(nullptr) {}
 
 //----------------------------------------------------------------------------------------------
@@ -54,8 +81,9 @@ void MergeMDFiles::init() {
       "If not, it will be created in memory.");
 
   declareProperty("Parallel", false,
-                  "Run the loading tasks in parallel.\n"
-                  "This can be faster but might use more memory.");
+                  "Convert the loaded events into boxes in parallel, while\n"
+                  "the next batch of boxes is read from the input files.\n"
+                  "This can be faster but uses more memory.");
 
   declareProperty(make_unique<WorkspaceProperty<IMDEventWorkspace>>(
                       "OutputWorkspace", "", Direction::Output),
@@ -146,39 +174,143 @@ void MergeMDFiles::loadBoxData() {
                  << " files.\n";
 }
 
-/** Task that loads all of the events from corresponded boxes of all files
-  * that is being merged into a particular box in the output workspace.
-*/
-
-uint64_t MergeMDFiles::loadEventsFromSubBoxes(API::IMDNode *TargetBox) {
-  /// get rid of the events and averages which are in the memory erroneously
-  /// (from cloning)
-  TargetBox->clear();
+/** Split the leaf boxes of the output workspace into groups of consecutive
+ * boxes that contain about EVENTS_PER_BATCH events in total.
+ * @return the boxes of each batch
+ */
+std::vector<std::vector<API::IMDNode *>> MergeMDFiles::makeBoxBatches() const {
+  const std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
+  const std::vector<uint64_t> &targetEventIndexes = m_BoxStruct.getEventIndex();
 
-  uint64_t nBoxEvents(0);
-  std::vector<size_t> numFileEvents(m_EventLoader.size());
+  std::vector<std::vector<API::IMDNode *>> batches(1);
+  uint64_t eventsInBatch = 0;
+  for (auto box : boxes) {
+    if (!box->isBox())
+      continue;
+    if (eventsInBatch >= EVENTS_PER_BATCH) {
+      batches.emplace_back();
+      eventsInBatch = 0;
+    }
+    batches.back().push_back(box);
+    eventsInBatch += targetEventIndexes[2 * box->getID() + 1];
+  }
+  if (batches.back().empty())
+    batches.pop_back();
+  return batches;
+}
 
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    numFileEvents[iw] = static_cast<size_t>(
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 1]);
-    nBoxEvents += numFileEvents[iw];
+/** Read the events of all the input files that belong to a batch of boxes.
+ * The ranges of each file are sorted by position and neighbouring ranges are
+ * read together, so that the reads are large and sequential.
+ * @param batch :: the batch; its boxes must be set
+ */
+void MergeMDFiles::readBoxBatch(BoxBatch &batch) {
+  const size_t nBoxes = batch.boxes.size();
+  batch.slices.assign(nBoxes, {});
+  for (auto box : batch.boxes) {
+    // get rid of the events and averages which are in the memory erroneously
+    // (from cloning)
+    box->clear();
   }
 
-  // At this point memory required is known, so it is reserved all in one go
-  TargetBox->reserveMemoryForLoad(nBoxEvents);
+  std::vector<size_t> order(nBoxes);
+  for (size_t iw = 0; iw < m_EventLoader.size(); iw++) {
+    const std::vector<uint64_t> &eventIndex =
+        m_fileComponentsStructure[iw].getEventIndex();
+    auto start = [&](size_t i) {
+      return eventIndex[2 * batch.boxes[i]->getID()];
+    };
+    auto count = [&](size_t i) {
+      return eventIndex[2 * batch.boxes[i]->getID() + 1];
+    };
+
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return start(a) < start(b); });
+
+    size_t first = 0;
+    while (first < nBoxes) {
+      if (count(order[first]) == 0) {
+        ++first;
+        continue;
+      }
+      // Extend the block while the next box follows closely in the file
+      const uint64_t blockStart = start(order[first]);
+      uint64_t blockEnd = blockStart + count(order[first]);
+      size_t last = first + 1;
+      for (; last < nBoxes; ++last) {
+        const size_t i = order[last];
+        if (count(i) == 0)
+          continue;
+        if (start(i) > blockEnd + MAX_READ_GAP)
+          break;
+        blockEnd = std::max(blockEnd, start(i) + count(i));
+      }
 
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    uint64_t fileLocation =
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 0];
-    if (numFileEvents[iw] == 0)
+      const size_t blockIndex = batch.blocks.size();
+      batch.blocks.emplace_back();
+      auto &block = batch.blocks.back();
+      m_EventLoader[iw]->loadBlock(block, blockStart,
+                                   static_cast<size_t>(blockEnd - blockStart));
+      batch.nColumns = block.size() / static_cast<size_t>(blockEnd - blockStart);
+
+      for (size_t j = first; j < last; ++j) {
+        const size_t i = order[j];
+        if (count(i) > 0)
+          batch.slices[i].emplace_back(
+              blockIndex, static_cast<size_t>(start(i) - blockStart),
+              static_cast<size_t>(count(i)));
+      }
+      first = last;
+    }
+  }
+}
+
+/** Convert the events read for a batch into the events of its boxes. This
+ * does not touch the files, so it can run while the next batch is read.
+ * @param batch :: the batch, as filled by readBoxBatch
+ * @param parallel :: if true, fill the boxes in parallel
+ */
+void MergeMDFiles::fillBoxBatch(BoxBatch &batch, bool parallel) {
+  const int64_t nBoxes = static_cast<int64_t>(batch.boxes.size());
+  const size_t nColumns = batch.nColumns;
+  PARALLEL_FOR_IF(parallel)
+  for (int64_t i = 0; i < nBoxes; ++i) {
+    const auto &slices = batch.slices[i];
+    if (slices.empty())
       continue;
-    TargetBox->loadAndAddFrom(m_EventLoader[iw], fileLocation,
-                              numFileEvents[iw]);
+    size_t nRows = 0;
+    for (const auto &slice : slices)
+      nRows += std::get<2>(slice);
+
+    // At this point memory required is known, so it is reserved all in one go
+    std::vector<coord_t> table;
+    table.reserve(nRows * nColumns);
+    for (const auto &slice : slices) {
+      const auto &block = batch.blocks[std::get<0>(slice)];
+      auto begin = block.begin() + std::get<1>(slice) * nColumns;
+      table.insert(table.end(), begin, begin + std::get<2>(slice) * nColumns);
+    }
+    batch.boxes[i]->setEventsData(table);
   }
+  // The raw data is no longer needed
+  std::vector<std::vector<coord_t>>().swap(batch.blocks);
+}
 
-  return nBoxEvents;
+/** Save the boxes of a batch to the output file, if the output is
+ * file-backed, and free their memory.
+ * @param batch :: the batch, as filled by fillBoxBatch
+ */
+void MergeMDFiles::writeBoxBatch(BoxBatch &batch) {
+  if (!m_fileBasedTargetWS)
+    return;
+  for (auto box : batch.boxes) {
+    // data position has been already pre-calculated
+    if (box->getDataInMemorySize() > 0) {
+      box->getISaveable()->save();
+      box->clearDataFromMemory();
+    }
+  }
 }
 
 //----------------------------------------------------------------------------------------------
@@ -195,8 +327,8 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
   m_OutIWS = ws;
   m_MDEventType = ws->getEventTypeName();
 
-  // Run the tasks in parallel? TODO: enable
-  // bool Parallel = this->getProperty("Parallel");
+  // Convert the events of each batch in parallel, while the next is read?
+  const bool parallel = this->getProperty("Parallel");
 
   // Fix the box controller settings in the output workspace so that it splits
   // normally
@@ -233,65 +365,46 @@ void MergeMDFiles::doExecByCloning(Mantid::API::IMDEventWorkspace_sptr ws,
   this->prog = new Progress(this, 0.1, 0.9, size_t(numBoxes));
   prog->setNotifyStep(0.1);
 
-  // For tracking progress
-  // uint64_t totalEventsInTasks = 0;
-
-  // Prepare thread pool
   CPUTimer overallTime;
 
-  auto ts = new ThreadSchedulerFIFO();
-  ThreadPool tp(ts);
-
   Kernel::DiskBuffer *DiskBuf(nullptr);
   if (m_fileBasedTargetWS) {
     DiskBuf = bc->getFileIO();
   }
 
-  this->totalLoaded = 0;
-  std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
-
-  for (size_t ib = 0; ib < numBoxes; ib++) {
-    auto box = boxes[ib];
-    if (!box->isBox())
-      continue;
-    // load all contributed events into current box;
-    this->loadEventsFromSubBoxes(boxes[ib]);
-
-    if (DiskBuf) {
-      if (box->getDataInMemorySize() >
-          0) { // data position has been already pre-calculated
-        box->getISaveable()->save();
-        box->clearDataFromMemory();
-        // Kernel::ISaveable *Saver = box->getISaveable();
-        // DiskBuf->toWrite(Saver);
-      }
+  // The boxes are merged in batches, as a pipeline: while the events of one
+  // batch are converted into box events (in a separate thread if parallel),
+  // the next batch is read from the input files. All the file access stays
+  // in this thread.
+  auto batches = makeBoxBatches();
+  std::unique_ptr<BoxBatch> pending;
+  std::future<void> filling;
+  for (size_t ib = 0; ib <= batches.size(); ib++) {
+    std::unique_ptr<BoxBatch> batch;
+    if (ib < batches.size()) {
+      batch = make_unique<BoxBatch>();
+      batch->boxes.swap(batches[ib]);
+      this->readBoxBatch(*batch);
+    }
+    if (pending) {
+      filling.get();
+      this->writeBoxBatch(*pending);
+      prog->reportIncrement(pending->boxes.size(),
+                            "Loading and merging box data");
+    }
+    if (batch) {
+      BoxBatch &toFill = *batch;
+      filling = std::async(parallel ? std::launch::async : std::launch::deferred,
+                           [&toFill, parallel]() {
+                             MergeMDFiles::fillBoxBatch(toFill, parallel);
+                           });
     }
-    // else
-    //{   size_t ID = box->getID();
-    //    uint64_t filePosition = targetEventIndexes[2*ID];
-    //    box->saveAt(saver.get(), filePosition);
-    //}
-    //
-    // if (!Parallel)
-    //{
-    //  // Run the task serially only
-    //  task->run();
-    //  delete task;
-    //}
-    // else
-    //{
-    //  // Enqueue to run in parallel (at the joinAll() call below).
-    //  ts->push(task);
-    //}
-
-    prog->reportIncrement(ib, "Loading and merging box data");
+    pending = std::move(batch);
   }
   if (DiskBuf) {
     DiskBuf->flushCache();
     bc->getFileIO()->flushData();
   }
-  //// Run any final tasks
-  // tp.joinAll();
   g_log.information() << overallTime << " to do all the adding.\n";
 
   // Close any open file handle
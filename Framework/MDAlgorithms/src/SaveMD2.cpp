@@ -13,6 +13,7 @@
 #include "MantidAPI/Progress.h"
 #include "MantidKernel/EnabledWhenProperty.h"
 #include <Poco/File.h>
+#include <algorithm>
 #include "MantidDataObjects/MDHistoWorkspace.h"
 #include "MantidDataObjects/MDBoxFlatTree.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
@@ -66,6 +67,34 @@ void SaveMD2::init() {
       make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
 }
 
+//----------------------------------------------------------------------------------------------
+/** Choose the chunk shape of a compressed histogram array. Chunks of about
+ * 1 MB are compressed well and fit in the default HDF5 chunk cache. They
+ * cover whole rows of the fastest varying dimensions, so a reader that reads
+ * whole rows of the slowest dimension decompresses every chunk only once.
+ *
+ * @param size :: size of the array, in "C" order (slowest dimension first)
+ * @param elementSize :: size in bytes of one element of the array
+ * @return the chunk size in each dimension
+ */
+std::vector<int> SaveMD2::histoChunks(const std::vector<int> &size,
+                                      size_t elementSize) {
+  const size_t targetBytes = size_t(1) << 20;
+  std::vector<int> chunks(size);
+  size_t bytes = elementSize;
+  for (auto n : size)
+    bytes *= static_cast<size_t>(std::max(n, 1));
+  // Shrink the slowest varying dimensions first
+  for (auto &chunk : chunks) {
+    if (bytes <= targetBytes)
+      break;
+    const size_t inner = bytes / static_cast<size_t>(std::max(chunk, 1));
+    chunk = static_cast<int>(std::max(size_t(1), targetBytes / inner));
+    bytes = inner * static_cast<size_t>(chunk);
+  }
+  return chunks;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Save a MDHistoWorkspace to a .nxs file
  *
@@ -157,9 +186,7 @@ void SaveMD2::doSaveHisto(Mantid::DataObjects::MDHistoWorkspace_sptr ws) {
     size[numDims - 1 - d] = int(dim->getNBins());
   }
 
-  std::vector<int> chunks = size;
-  chunks[0] = 1; // Drop the largest stride for chunking, I don't know
-                 // if this is the best but appears to work
+  std::vector<int> chunks = histoChunks(size, sizeof(signal_t));
 
   file->makeCompData("signal", ::NeXus::FLOAT64, size, ::NeXus::LZW, chunks,
                      true);
@@ -178,7 +205,8 @@ void SaveMD2::doSaveHisto(Mantid::DataObjects::MDHistoWorkspace_sptr ws) {
   file->putData(ws->getNumEventsArray());
   file->closeData();
 
-  file->makeCompData("mask", ::NeXus::INT8, size, ::NeXus::LZW, chunks, true);
+  file->makeCompData("mask", ::NeXus::INT8, size, ::NeXus::LZW,
+                     histoChunks(size, sizeof(bool)), true);
   file->putData(ws->getMaskArray());
   file->closeData();
 
@@ -0,0 +1,72 @@
+#ifndef MANTID_MDALGORITHMS_MDNORMACCUMULATORTEST_H_
+#define MANTID_MDALGORITHMS_MDNORMACCUMULATORTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidMDAlgorithms/MDNormAccumulator.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+using Mantid::MDAlgorithms::MDNormAccumulator;
+using namespace Mantid::DataObjects;
+
+class MDNormAccumulatorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDNormAccumulatorTest *createSuite() {
+    return new MDNormAccumulatorTest();
+  }
+  static void destroySuite(MDNormAccumulatorTest *suite) { delete suite; }
+
+  void test_thread_buffers_are_summed_on_finalize() {
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 2, 5);
+    MDNormAccumulator accumulator(*ws, 3, true);
+    TS_ASSERT(accumulator.usesThreadBuffers());
+
+    addContributions(accumulator);
+    // Nothing reaches the workspace before finalize()
+    TS_ASSERT_EQUALS(ws->getSignalAt(0), 1.0);
+    TS_ASSERT_EQUALS(ws->getSignalAt(7), 1.0);
+
+    accumulator.finalize();
+    checkSums(*ws);
+  }
+
+  void test_contributions_are_added_on_flush_without_thread_buffers() {
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 2, 5);
+    MDNormAccumulator accumulator(*ws, 3, false);
+    TS_ASSERT(!accumulator.usesThreadBuffers());
+
+    addContributions(accumulator);
+    accumulator.flush(0);
+    TS_ASSERT_EQUALS(ws->getSignalAt(0), 3.0);
+    TS_ASSERT_EQUALS(ws->getSignalAt(7), 1.0);
+
+    accumulator.finalize();
+    checkSums(*ws);
+  }
+
+  void test_single_thread_does_not_use_thread_buffers() {
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 2, 5);
+    MDNormAccumulator accumulator(*ws, 1);
+    TS_ASSERT(!accumulator.usesThreadBuffers());
+  }
+
+private:
+  void addContributions(MDNormAccumulator &accumulator) {
+    accumulator.add(0, 0, 2.0);
+    accumulator.add(1, 0, 0.5);
+    accumulator.add(1, 7, 4.0);
+    accumulator.add(2, 7, 1.5);
+    accumulator.add(2, 24, 3.0);
+  }
+
+  void checkSums(const MDHistoWorkspace &ws) {
+    TS_ASSERT_EQUALS(ws.getSignalAt(0), 3.5);
+    TS_ASSERT_EQUALS(ws.getSignalAt(7), 6.5);
+    TS_ASSERT_EQUALS(ws.getSignalAt(24), 4.0);
+    TS_ASSERT_EQUALS(ws.getSignalAt(1), 1.0);
+  }
+};
+
+#endif /* MANTID_MDALGORITHMS_MDNORMACCUMULATORTEST_H_ */
@@ -298,6 +298,33 @@ public:
         2.5, 2, 10, 10.0, 3.5, "histo2", 4.5);
     doTestHisto(ws);
   }
+
+  void test_histoChunks_small_array_is_one_chunk() {
+    std::vector<int> size{10, 20, 30};
+    TS_ASSERT_EQUALS(SaveMD2::histoChunks(size, sizeof(double)), size);
+  }
+
+  void test_histoChunks_splits_slowest_dimension_first() {
+    // 1000 x 1000 doubles: 8 kB per row, so 128 rows per 1 MB chunk
+    std::vector<int> size{1000, 1000};
+    auto chunks = SaveMD2::histoChunks(size, sizeof(double));
+    TS_ASSERT_EQUALS(chunks[0], 128);
+    TS_ASSERT_EQUALS(chunks[1], 1000);
+  }
+
+  void test_histoChunks_splits_rows_larger_than_a_chunk() {
+    std::vector<int> size{10, 500, 500};
+    auto chunks = SaveMD2::histoChunks(size, sizeof(double));
+    TS_ASSERT_EQUALS(chunks[0], 1);
+    TS_ASSERT_EQUALS(chunks[1], 262);
+    TS_ASSERT_EQUALS(chunks[2], 500);
+  }
+
+  void test_histoChunks_1D() {
+    std::vector<int> size{1000000};
+    auto chunks = SaveMD2::histoChunks(size, sizeof(double));
+    TS_ASSERT_EQUALS(chunks[0], 131072);
+  }
 };
 
 class SaveMD2TestPerformance : public CxxTest::TestSuite {
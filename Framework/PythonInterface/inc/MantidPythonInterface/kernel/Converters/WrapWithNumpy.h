@@ -40,6 +40,24 @@ PyObject *wrapWithNDArray(const ElementType *, const int ndims,
                           Py_intptr_t *dims, const NumpyWrapMode);
 }
 
+/// Wrap strided data in a read-only numpy array that keeps its owner alive
+template <typename ElementType>
+PyObject *wrapReadOnlyView(const ElementType *data, const int ndims,
+                           Py_intptr_t *dims, Py_intptr_t *strides,
+                           PyObject *owner);
+
+/**
+ * Create a Python object holding a copy of a value, e.g. a shared pointer to
+ * the data a view looks at, for use as the owner given to wrapReadOnlyView.
+ * @param value :: The value to copy
+ * @return A new reference to a PyCapsule that deletes the copy with itself
+ */
+template <typename OwnerType> PyObject *ownerCapsule(const OwnerType &value) {
+  return PyCapsule_New(new OwnerType(value), nullptr, [](PyObject *capsule) {
+    delete static_cast<OwnerType *>(PyCapsule_GetPointer(capsule, nullptr));
+  });
+}
+
 /**
  * WrapReadOnly is a policy for VectorToNDArray
  * to wrap the vector in a read-only numpy array
@@ -61,6 +61,24 @@ private:
   /// Current GIL state
   PyGILState_STATE m_state;
 };
+
+/**
+ * Defines a structure for releasing the Python GIL while C++ code that does
+ * not use Python runs, using the RAII pattern. The GIL must be held when it
+ * is created.
+ */
+class PYTHON_KERNEL_DLL ReleaseGlobalInterpreterLock {
+public:
+  /// Release the GIL
+  ReleaseGlobalInterpreterLock();
+  /// Reacquire the GIL
+  ~ReleaseGlobalInterpreterLock();
+
+private:
+  ReleaseGlobalInterpreterLock(const ReleaseGlobalInterpreterLock &);
+  /// The thread state to restore
+  PyThreadState *m_saved;
+};
 }
 }
 }
@@ -41,3 +41,9 @@ from . import _workspaceops
 _workspaceops.attach_binary_operators_to_workspace()
 _workspaceops.attach_unary_operators_to_workspace()
 _workspaceops.attach_tableworkspaceiterator()
+
+###############################################################################
+# Allow algorithms to run in the background
+###############################################################################
+from . import _asyncexecute
+_asyncexecute.attach_execute_async()
@@ -0,0 +1,51 @@
+"""
+    This module adds an executeAsync method to the IAlgorithm class
+    so that algorithms can run in the background and be waited on
+    with the concurrent.futures API.
+
+    It is intended for internal use.
+"""
+from __future__ import (absolute_import, division,
+                        print_function)
+
+from . import _api
+
+import threading as _threading
+
+
+def attach_execute_async():
+    """
+        Attaches the executeAsync method to the IAlgorithm class
+    """
+    def executeAsync(self):
+        """
+            Starts running the algorithm in a new thread and returns a
+            concurrent.futures.Future for the result of execute(). The
+            GIL is released while the C++ part of the algorithm runs so
+            several algorithms can run at the same time as Python code.
+        """
+        try:
+            from concurrent.futures import Future
+        except ImportError:
+            raise ImportError("executeAsync requires the concurrent.futures "
+                              "module. On Python 2 install the 'futures' "
+                              "package.")
+        future = Future()
+
+        def run():
+            if not future.set_running_or_notify_cancel():
+                return
+            try:
+                result = self.execute()
+            except BaseException as exc:
+                future.set_exception(exc)
+            else:
+                future.set_result(result)
+
+        thread = _threading.Thread(target=run,
+                                   name="executeAsync-" + self.name())
+        thread.daemon = True
+        thread.start()
+        return future
+
+    setattr(_api.IAlgorithm, "executeAsync", executeAsync)
@@ -160,6 +160,100 @@ void setDxFromPyObject(MatrixWorkspace &self, const size_t wsIndex,
   setSpectrumFromPyObject(self, &MatrixWorkspace::dataDx, wsIndex, values);
 }
 
+/**
+ * Wrap the values of a spectrum in a read-only numpy array without copying
+ * them. The array shares ownership of the values, so it stays valid when the
+ * workspace is deleted. Changing the workspace afterwards copies the values
+ * first, so the array keeps showing the values at the time of the call.
+ * @param data :: The values to wrap
+ * @return A read-only numpy array
+ */
+template <typename HistogramType>
+PyObject *wrapHistogramData(const cow_ptr<HistogramType> &data) {
+  if (!data)
+    throw std::invalid_argument("The spectrum does not have these values");
+  Py_intptr_t dims[1] = {static_cast<Py_intptr_t>(data->size())};
+  Py_intptr_t strides[1] = {sizeof(double)};
+  return wrapReadOnlyView(data->rawData().data(), 1, dims, strides,
+                          ownerCapsule(data));
+}
+
+/**
+ * Throw if a workspace index is invalid
+ * @param self :: A reference to the calling object
+ * @param wsIndex :: The workspace index
+ * @throws std::out_of_range if there is no spectrum at the index
+ */
+void checkIndex(const MatrixWorkspace &self, const size_t wsIndex) {
+  if (wsIndex >= self.getNumberHistograms())
+    throw std::out_of_range("Workspace index " + std::to_string(wsIndex) +
+                            " is out of range");
+}
+
+/**
+ * @param self :: A reference to the calling object
+ * @param wsIndex :: The workspace index of the spectrum
+ * @return A read-only view of the X values of the spectrum
+ */
+PyObject *viewX(const MatrixWorkspace &self, const size_t wsIndex) {
+  checkIndex(self, wsIndex);
+  return wrapHistogramData(self.sharedX(wsIndex));
+}
+
+/**
+ * @param self :: A reference to the calling object
+ * @param wsIndex :: The workspace index of the spectrum
+ * @return A read-only view of the Y values of the spectrum
+ */
+PyObject *viewY(const MatrixWorkspace &self, const size_t wsIndex) {
+  checkIndex(self, wsIndex);
+  return wrapHistogramData(self.sharedY(wsIndex));
+}
+
+/**
+ * @param self :: A reference to the calling object
+ * @param wsIndex :: The workspace index of the spectrum
+ * @return A read-only view of the E values of the spectrum
+ */
+PyObject *viewE(const MatrixWorkspace &self, const size_t wsIndex) {
+  checkIndex(self, wsIndex);
+  return wrapHistogramData(self.sharedE(wsIndex));
+}
+
+/**
+ * @param self :: A reference to the calling object
+ * @param wsIndex :: The workspace index of the spectrum
+ * @return A read-only view of the Dx values of the spectrum
+ */
+PyObject *viewDx(const MatrixWorkspace &self, const size_t wsIndex) {
+  checkIndex(self, wsIndex);
+  return wrapHistogramData(self.sharedDx(wsIndex));
+}
+
+/**
+ * Create a 2D read-only view of the X values of a workspace whose spectra all
+ * share the same X values. Every row of the view looks at the same memory.
+ * @param self :: A reference to the calling object
+ * @return A read-only numpy array of shape (histograms, X values)
+ * @throws std::invalid_argument if the spectra do not share their X values
+ */
+PyObject *viewCommonX(const MatrixWorkspace &self) {
+  const size_t numberHistograms = self.getNumberHistograms();
+  if (numberHistograms == 0)
+    throw std::invalid_argument("The workspace has no spectra");
+  const auto x = self.sharedX(0);
+  for (size_t i = 1; i < numberHistograms; ++i) {
+    if (&self.x(i) != &*x)
+      throw std::invalid_argument("The spectra do not share their X values, "
+                                  "use extractX to copy them");
+  }
+  Py_intptr_t dims[2] = {static_cast<Py_intptr_t>(numberHistograms),
+                         static_cast<Py_intptr_t>(x->size())};
+  Py_intptr_t strides[2] = {0, sizeof(double)};
+  return wrapReadOnlyView(x->rawData().data(), 2, dims, strides,
+                          ownerCapsule(x));
+}
+
 /**
  * Adds a deprecation warning to the getNumberBins call to warn about using
  * blocksize instead
@@ -290,6 +384,26 @@ void export_MatrixWorkspace() {
            args("self", "workspaceIndex"), "Creates a read-only numpy wrapper "
                                            "around the original Dx data at the "
                                            "given index")
+      .def("viewX", &viewX, args("self", "workspaceIndex"),
+           "Creates a read-only numpy view of the X data at the given index "
+           "without copying it. The view remains valid when the workspace is "
+           "deleted and is not affected by later changes to the workspace.")
+      .def("viewY", &viewY, args("self", "workspaceIndex"),
+           "Creates a read-only numpy view of the Y data at the given index "
+           "without copying it. The view remains valid when the workspace is "
+           "deleted and is not affected by later changes to the workspace.")
+      .def("viewE", &viewE, args("self", "workspaceIndex"),
+           "Creates a read-only numpy view of the E data at the given index "
+           "without copying it. The view remains valid when the workspace is "
+           "deleted and is not affected by later changes to the workspace.")
+      .def("viewDx", &viewDx, args("self", "workspaceIndex"),
+           "Creates a read-only numpy view of the Dx data at the given index "
+           "without copying it. The view remains valid when the workspace is "
+           "deleted and is not affected by later changes to the workspace.")
+      .def("viewCommonX", &viewCommonX, args("self"),
+           "Creates a read-only 2D numpy view of the X data of a workspace "
+           "whose spectra all share the same X values, without copying it. "
+           "Raises a ValueError if the spectra do not share their X values.")
       .def("hasDx", &MatrixWorkspace::hasDx, args("self", "workspaceIndex"),
            "Returns True if the spectrum uses the DX (X Error) array, else "
            "False.")
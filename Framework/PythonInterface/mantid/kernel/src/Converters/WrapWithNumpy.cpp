@@ -4,6 +4,7 @@
 #include "MantidPythonInterface/kernel/Converters/WrapWithNumpy.h"
 #include "MantidPythonInterface/kernel/Converters/NDArrayTypeIndex.h"
 
+#include <boost/python/errors.hpp>
 #include <boost/python/list.hpp>
 #define PY_ARRAY_UNIQUE_SYMBOL KERNEL_ARRAY_API
 #define NO_IMPORT_ARRAY
@@ -73,7 +74,62 @@ INSTANTIATE_WRAPNUMPY(unsigned long long)
 INSTANTIATE_WRAPNUMPY(double)
 INSTANTIATE_WRAPNUMPY(float)
 ///@endcond
+} // namespace Impl
+
+/**
+ * Wraps data in a read-only numpy array without copying it. The data need not
+ * be contiguous, e.g. it may be one field of an array of structures. The
+ * array holds a reference to an owner object that keeps the data alive for as
+ * long as the array, or any view of it, exists.
+ * @param data :: A pointer to the first element
+ * @param ndims :: The dimensionality of the array
+ * @param dims :: The length of the array in each dimension
+ * @param strides :: The bytes between consecutive elements in each dimension
+ * @param owner :: A new reference to the owner of the data. The reference is
+ * stolen, also if wrapping fails.
+ * @return A pointer to a numpy ndarray object
+ */
+template <typename ElementType>
+PyObject *wrapReadOnlyView(const ElementType *data, const int ndims,
+                           Py_intptr_t *dims, Py_intptr_t *strides,
+                           PyObject *owner) {
+  int datatype = NDArrayTypeIndex<ElementType>::typenum;
+  PyArrayObject *nparray = reinterpret_cast<PyArrayObject *>(PyArray_New(
+      &PyArray_Type, ndims, dims, datatype, strides,
+      static_cast<void *>(const_cast<ElementType *>(data)), 0, 0, nullptr));
+  if (!nparray) {
+    Py_XDECREF(owner);
+    boost::python::throw_error_already_set();
+  }
+  Impl::markReadOnly(nparray);
+#if NPY_API_VERSION >= 0x00000007 //(1.7)
+  PyArray_UpdateFlags(nparray, NPY_ARRAY_ALIGNED);
+  PyArray_SetBaseObject(nparray, owner);
+#else
+  PyArray_UpdateFlags(nparray, NPY_ALIGNED);
+  nparray->base = owner;
+#endif
+  return reinterpret_cast<PyObject *>(nparray);
 }
+
+//-----------------------------------------------------------------------
+// Explicit instantiations
+//-----------------------------------------------------------------------
+#define INSTANTIATE_WRAPVIEW(ElementType)                                      \
+  template DLLExport PyObject *wrapReadOnlyView<ElementType>(                  \
+      const ElementType *, const int ndims, Py_intptr_t *dims,                 \
+      Py_intptr_t *strides, PyObject *owner);
+
+///@cond
+INSTANTIATE_WRAPVIEW(int)
+INSTANTIATE_WRAPVIEW(long)
+INSTANTIATE_WRAPVIEW(long long)
+INSTANTIATE_WRAPVIEW(unsigned int)
+INSTANTIATE_WRAPVIEW(unsigned long)
+INSTANTIATE_WRAPVIEW(unsigned long long)
+INSTANTIATE_WRAPVIEW(double)
+INSTANTIATE_WRAPVIEW(float)
+///@endcond
 }
 }
 }
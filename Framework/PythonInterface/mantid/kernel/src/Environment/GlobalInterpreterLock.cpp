@@ -39,6 +39,23 @@ GlobalInterpreterLock::GlobalInterpreterLock() : m_state(this->acquire()) {}
  * this object was created.
  */
 GlobalInterpreterLock::~GlobalInterpreterLock() { this->release(m_state); }
+
+//------------------------------------------------------------------------------
+// ReleaseGlobalInterpreterLock Public members
+//------------------------------------------------------------------------------
+
+/**
+ * Releases the GIL and saves the Python threadstate of this thread
+ */
+ReleaseGlobalInterpreterLock::ReleaseGlobalInterpreterLock()
+    : m_saved(PyEval_SaveThread()) {}
+
+/**
+ * Reacquires the GIL and restores the threadstate
+ */
+ReleaseGlobalInterpreterLock::~ReleaseGlobalInterpreterLock() {
+  PyEval_RestoreThread(m_saved);
+}
 }
 }
 }
@@ -1,10 +1,12 @@
 #include "MantidKernel/Logger.h"
+#include "MantidPythonInterface/kernel/Environment/GlobalInterpreterLock.h"
 #include <boost/make_shared.hpp>
 #include <boost/python/class.hpp>
 #include <boost/python/register_ptr_to_python.hpp>
 #include <boost/python/reference_existing_object.hpp>
 
 using Mantid::Kernel::Logger;
+using Mantid::PythonInterface::Environment::ReleaseGlobalInterpreterLock;
 using namespace boost::python;
 
 namespace {
@@ -18,42 +20,54 @@ boost::shared_ptr<Logger> getLogger(const std::string &name) {
                                        "Simply use Logger(\"name\") instead");
   return boost::make_shared<Logger>(name);
 }
+
+/**
+ * Log a message at a fixed priority. The GIL is released while the message is
+ * written to the channels but filtered messages return straight away, so
+ * debug messages in tight loops stay cheap.
+ * @param self A reference to the logger
+ * @param message The message to log
+ */
+template <Logger::Priority priority>
+void logAt(Logger &self, const std::string &message) {
+  if (!self.wouldLog(priority))
+    return;
+  ReleaseGlobalInterpreterLock releaseGIL;
+  self.log(message, priority);
+}
 }
 
 void export_Logger() {
   register_ptr_to_python<boost::shared_ptr<Logger>>();
 
-  // To distinguish between the overloaded functions
-  typedef void (Logger::*LogLevelFunction)(const std::string &);
-
   class_<Logger, boost::noncopyable>(
       "Logger", init<std::string>((arg("self"), arg("name"))))
-      .def("fatal", (LogLevelFunction)&Logger::fatal,
+      .def("fatal", &logAt<Logger::Priority::PRIO_FATAL>,
            (arg("self"), arg("message")),
            "Send a message at fatal priority: "
            "An unrecoverable error has occured and the application will "
            "terminate")
-      .def("error", (LogLevelFunction)&Logger::error,
+      .def("error", &logAt<Logger::Priority::PRIO_ERROR>,
            (arg("self"), arg("message")),
            "Send a message at error priority: "
            "An error has occured but the framework is able to handle it and "
            "continue")
-      .def("warning", (LogLevelFunction)&Logger::warning,
+      .def("warning", &logAt<Logger::Priority::PRIO_WARNING>,
            (arg("self"), arg("message")),
            "Send a message at warning priority: "
            "Something was wrong but the framework was able to continue despite "
            "the problem.")
-      .def("notice", (LogLevelFunction)&Logger::notice,
+      .def("notice", &logAt<Logger::Priority::PRIO_NOTICE>,
            (arg("self"), arg("message")),
            "Sends a message at notice priority: "
            "Really important information that should be displayed to the user, "
            "this should be minimal. The default logging level is set here "
            "unless it is altered.")
-      .def("information", (LogLevelFunction)&Logger::information,
+      .def("information", &logAt<Logger::Priority::PRIO_INFORMATION>,
            (arg("self"), arg("message")),
            "Send a message at information priority: "
            "Useful but not vital information to be relayed back to the user.")
-      .def("debug", (LogLevelFunction)&Logger::debug,
+      .def("debug", &logAt<Logger::Priority::PRIO_DEBUG>,
            (arg("self"), arg("message")),
            "Send a message at debug priority:"
            ". Anything that may be useful to understand what the code has been "
@@ -0,0 +1,84 @@
+#include "MantidPythonInterface/kernel/GetPointer.h"
+#include "MantidKernel/Profiler.h"
+#include <boost/python/class.hpp>
+#include <boost/python/list.hpp>
+#include <boost/python/reference_existing_object.hpp>
+
+using Mantid::Kernel::Profiler;
+using Mantid::Kernel::ProfilerImpl;
+using namespace boost::python;
+
+GET_POINTER_SPECIALIZATION(ProfilerImpl)
+
+namespace {
+/// @return The recorded spans as a Python list
+list getSpans(ProfilerImpl &self) {
+  list spans;
+  for (const auto &span : self.spans()) {
+    spans.append(span);
+  }
+  return spans;
+}
+} // namespace
+
+void export_Profiler() {
+
+  class_<ProfilerImpl::Span>("ProfilerSpan", no_init)
+      .def_readonly("name", &ProfilerImpl::Span::name,
+                    "What was running, e.g. the name and version of an "
+                    "algorithm.")
+      .def_readonly("category", &ProfilerImpl::Span::category,
+                    "The kind of span, e.g. algorithm or threadpool.")
+      .def_readonly("id", &ProfilerImpl::Span::id,
+                    "A unique number identifying the span.")
+      .def_readonly("parent", &ProfilerImpl::Span::parent,
+                    "The id of the enclosing span, or 0 if there is none.")
+      .def_readonly("thread", &ProfilerImpl::Span::thread,
+                    "A number identifying the thread the span started on.")
+      .def_readonly("start", &ProfilerImpl::Span::start,
+                    "The start in seconds since the profiler was created or "
+                    "cleared.")
+      .def_readonly("wallTime", &ProfilerImpl::Span::wallTime,
+                    "The elapsed time in seconds.")
+      .def_readonly("cpuTime", &ProfilerImpl::Span::cpuTime,
+                    "The CPU time of the process in seconds.")
+      .def_readonly("rssDelta", &ProfilerImpl::Span::rssDelta,
+                    "The change of the resident set size in bytes.")
+      .def_readonly("peakRssIncrease", &ProfilerImpl::Span::peakRssIncrease,
+                    "How much the peak resident set size grew, in bytes.")
+      .def_readonly("bytesRead", &ProfilerImpl::Span::bytesRead,
+                    "The bytes read by the process.")
+      .def_readonly("bytesWritten", &ProfilerImpl::Span::bytesWritten,
+                    "The bytes written by the process.")
+      .def_readonly("threads", &ProfilerImpl::Span::threads,
+                    "The number of threads of a thread pool.")
+      .def_readonly("busyTime", &ProfilerImpl::Span::busyTime,
+                    "The total time in seconds the threads of a pool spent "
+                    "running tasks.");
+
+  class_<ProfilerImpl, boost::noncopyable>("ProfilerImpl", no_init)
+      .def("isEnabled", &ProfilerImpl::isEnabled, arg("self"),
+           "Returns True if algorithms and thread pools are being profiled.")
+
+      .def("setEnabled", &ProfilerImpl::setEnabled,
+           (arg("self"), arg("enabled")),
+           "Enables or disables profiling.")
+
+      .def("clear", &ProfilerImpl::clear, arg("self"),
+           "Removes the recorded spans.")
+
+      .def("spans", &getSpans, arg("self"),
+           "Returns the recorded spans in the order they finished.")
+
+      .def("toChromeTrace", &ProfilerImpl::toChromeTrace, arg("self"),
+           "Returns the recorded spans in the Chrome trace event format.")
+
+      .def("saveChromeTrace", &ProfilerImpl::saveChromeTrace,
+           (arg("self"), arg("filename")),
+           "Saves the recorded spans in the Chrome trace event format.")
+
+      .def("Instance", &Profiler::Instance,
+           return_value_policy<reference_existing_object>(),
+           "Returns a reference to the Profiler")
+      .staticmethod("Instance");
+}
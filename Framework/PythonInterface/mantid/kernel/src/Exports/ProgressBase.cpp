@@ -1,30 +1,67 @@
 #include "MantidKernel/ProgressBase.h"
+#include "MantidPythonInterface/kernel/Environment/GlobalInterpreterLock.h"
 #include <boost/python/class.hpp>
 
 using Mantid::Kernel::ProgressBase;
+using Mantid::PythonInterface::Environment::ReleaseGlobalInterpreterLock;
 using namespace boost::python;
 
+namespace {
+// Most reports only increment the counter, so the GIL is only released for
+// those that notify the observers. The observers may take a while, e.g. to
+// update a GUI, and releasing the GIL on every call would slow tight loops.
+
+void report(ProgressBase &self) {
+  if (self.notifiesAfter(1)) {
+    ReleaseGlobalInterpreterLock releaseGIL;
+    self.report();
+  } else {
+    self.report();
+  }
+}
+
+void reportWithMessage(ProgressBase &self, const std::string &msg) {
+  if (self.notifiesAfter(1)) {
+    ReleaseGlobalInterpreterLock releaseGIL;
+    self.report(msg);
+  } else {
+    self.report(msg);
+  }
+}
+
+void reportAt(ProgressBase &self, int64_t i, const std::string &msg) {
+  if (self.notifiesAt(i)) {
+    ReleaseGlobalInterpreterLock releaseGIL;
+    self.report(i, msg);
+  } else {
+    self.report(i, msg);
+  }
+}
+
+void reportIncrement(ProgressBase &self, size_t inc, const std::string &msg) {
+  if (self.notifiesAfter(static_cast<int64_t>(inc))) {
+    ReleaseGlobalInterpreterLock releaseGIL;
+    self.reportIncrement(inc, msg);
+  } else {
+    self.reportIncrement(inc, msg);
+  }
+}
+} // namespace
+
 void export_ProgressBase() {
   class_<ProgressBase, boost::noncopyable>("ProgressBase", no_init)
-      .def("report", (void (ProgressBase::*)()) & ProgressBase::report,
-           arg("self"),
+      .def("report", &report, arg("self"),
            "Increment the progress by 1 and report with no message")
 
-      .def("report",
-           (void (ProgressBase::*)(const std::string &)) & ProgressBase::report,
-           (arg("self"), arg("msg")),
+      .def("report", &reportWithMessage, (arg("self"), arg("msg")),
            "Increment the progress by 1 and report along with "
            "the given message")
 
-      .def("report", (void (ProgressBase::*)(int64_t, const std::string &)) &
-                         ProgressBase::report,
-           (arg("self"), arg("i"), arg("msg")),
+      .def("report", &reportAt, (arg("self"), arg("i"), arg("msg")),
            "Set the progress to given amount and "
            "report along with the given message")
 
-      .def("reportIncrement",
-           (void (ProgressBase::*)(size_t, const std::string &)) &
-               ProgressBase::reportIncrement,
+      .def("reportIncrement", &reportIncrement,
            (arg("self"), arg("i"), arg("msg")),
            "Increment the progress by given amount and "
            "report along with the given message")
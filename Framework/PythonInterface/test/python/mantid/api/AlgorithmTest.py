@@ -4,6 +4,12 @@ import unittest
 from mantid.api import AlgorithmID, AlgorithmManager
 from testhelpers import run_algorithm
 
+try:
+    import concurrent.futures
+    HAVE_FUTURES = True
+except ImportError:
+    HAVE_FUTURES = False
+
 ###########################################################
 
 class AlgorithmTest(unittest.TestCase):
@@ -90,6 +96,34 @@ class AlgorithmTest(unittest.TestCase):
         # Unknown keyword
         self.assertRaises(Exception, parent_alg.createChildAlgorithm, name='Rebin',version=1,startProgress=0.5,endProgress=0.9,enableLogging=True, unknownKW=1)
 
+    @unittest.skipIf(not HAVE_FUTURES, "concurrent.futures is not available")
+    def test_executeAsync_runs_algorithms_in_the_background(self):
+        data = [1.0,2.0,3.0]
+        algs, futures = [], []
+        for nspec in (1, 3):
+            alg = AlgorithmManager.createUnmanaged('CreateWorkspace')
+            alg.initialize()
+            alg.setChild(True)
+            alg.setProperty('DataX', data * nspec)
+            alg.setProperty('DataY', data * nspec)
+            alg.setProperty('NSpec', nspec)
+            alg.setProperty('OutputWorkspace', 'UNUSED_NAME_FOR_CHILD')
+            algs.append(alg)
+            futures.append(alg.executeAsync())
+
+        for alg, future, nspec in zip(algs, futures, (1, 3)):
+            self.assertTrue(future.result(timeout=60))
+            self.assertTrue(alg.isExecuted())
+            ws = alg.getProperty('OutputWorkspace').value
+            self.assertEquals(ws.getNumberHistograms(), nspec)
+
+    @unittest.skipIf(not HAVE_FUTURES, "concurrent.futures is not available")
+    def test_executeAsync_future_holds_the_error_of_a_failed_algorithm(self):
+        alg = AlgorithmManager.createUnmanaged('Load')
+        alg.initialize()
+        future = alg.executeAsync()
+        self.assertRaises(RuntimeError, future.result, 60)
+
 if __name__ == '__main__':
     unittest.main()
 
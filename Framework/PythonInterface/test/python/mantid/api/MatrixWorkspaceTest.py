@@ -233,6 +233,38 @@ class MatrixWorkspaceTest(unittest.TestCase):
             # Extra X boundary
             self.assertEquals(x_arr[blocksize], workspace.readX(i)[blocksize])
 
+    def test_views_give_readonly_numpy_arrays_of_the_data(self):
+        test_ws = WorkspaceFactory.create("Workspace2D", 2, 4, 3)
+        test_ws.setY(1, np.array([1.0, 2.0, 3.0]))
+        for view, read in [(test_ws.viewX(1), test_ws.readX(1)),
+                           (test_ws.viewY(1), test_ws.readY(1)),
+                           (test_ws.viewE(1), test_ws.readE(1))]:
+            self.assertEquals(type(view), np.ndarray)
+            self.assertFalse(view.flags.writeable)
+            np.testing.assert_array_equal(view, read)
+        self.assertRaises(IndexError, test_ws.viewY, 2)
+
+    def test_views_are_not_affected_by_later_changes_or_deletion(self):
+        test_ws = WorkspaceFactory.create("Workspace2D", 2, 4, 3)
+        test_ws.setY(0, np.array([1.0, 2.0, 3.0]))
+        y = test_ws.viewY(0)
+        test_ws.dataY(0)[0] = 5.0
+        self.assertEquals(test_ws.readY(0)[0], 5.0)
+        self.assertEquals(y[0], 1.0)
+        del test_ws
+        np.testing.assert_array_equal(y, [1.0, 2.0, 3.0])
+
+    def test_viewCommonX_gives_2D_view_of_shared_x(self):
+        test_ws = WorkspaceFactory.create("Workspace2D", 3, 4, 3)
+        x = test_ws.viewCommonX()
+        self.assertEquals(x.shape, (3, 4))
+        self.assertFalse(x.flags.writeable)
+        for i in range(3):
+            np.testing.assert_array_equal(x[i], test_ws.readX(i))
+        # Writing to the X values of a spectrum stops it sharing them
+        test_ws.dataX(1)[0] = 5.0
+        self.assertRaises(ValueError, test_ws.viewCommonX)
+
     def test_data_members_give_writable_numpy_array(self):
         def do_numpy_test(arr):
             self.assertEquals(type(arr), np.ndarray)
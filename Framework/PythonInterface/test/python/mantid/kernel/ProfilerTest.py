@@ -0,0 +1,47 @@
+from __future__ import (absolute_import, division, print_function)
+
+import json
+import unittest
+
+from mantid.kernel import (Profiler, ProfilerImpl)
+from mantid.api import AnalysisDataService
+from mantid.simpleapi import CreateSingleValuedWorkspace
+
+
+class ProfilerTest(unittest.TestCase):
+
+    def setUp(self):
+        self._was_enabled = Profiler.isEnabled()
+        Profiler.setEnabled(True)
+        Profiler.clear()
+
+    def tearDown(self):
+        Profiler.setEnabled(self._was_enabled)
+        Profiler.clear()
+        if "profiled" in AnalysisDataService:
+            AnalysisDataService.remove("profiled")
+
+    def test_singleton_returns_instance_of_Profiler(self):
+        self.assertTrue(isinstance(Profiler, ProfilerImpl))
+
+    def test_algorithms_are_recorded(self):
+        CreateSingleValuedWorkspace(DataValue=1.0, OutputWorkspace="profiled")
+        names = [span.name for span in Profiler.spans()]
+        self.assertTrue("CreateSingleValuedWorkspace v1" in names)
+        span = Profiler.spans()[-1]
+        self.assertEquals(span.category, "algorithm")
+        self.assertTrue(span.wallTime >= 0.0)
+
+    def test_nothing_is_recorded_when_disabled(self):
+        Profiler.setEnabled(False)
+        CreateSingleValuedWorkspace(DataValue=1.0, OutputWorkspace="profiled")
+        self.assertEquals(len(Profiler.spans()), 0)
+
+    def test_toChromeTrace_is_json(self):
+        CreateSingleValuedWorkspace(DataValue=1.0, OutputWorkspace="profiled")
+        trace = json.loads(Profiler.toChromeTrace())
+        self.assertTrue(len(trace["traceEvents"]) > 0)
+        self.assertEquals(trace["traceEvents"][-1]["ph"], "X")
+
+if __name__ == '__main__':
+    unittest.main()